@@ -67,6 +67,27 @@ Ref<Resource> ResourceLoader::load_threaded_get(const String &p_path) {
 	return res;
 }
 
+Error ResourceLoader::load_threaded_set_priority(const String &p_path, int p_priority) {
+	return ::ResourceLoader::load_threaded_set_priority(p_path, p_priority);
+}
+
+Error ResourceLoader::load_threaded_cancel(const String &p_path) {
+	return ::ResourceLoader::load_threaded_cancel(p_path);
+}
+
+Dictionary ResourceLoader::load_threaded_get_metrics(const String &p_path) {
+	::ResourceLoader::ThreadLoadMetrics metrics;
+	if (!::ResourceLoader::load_threaded_get_metrics(p_path, metrics)) {
+		return Dictionary();
+	}
+
+	Dictionary ret;
+	ret["priority"] = metrics.priority;
+	ret["wait_usec"] = metrics.wait_usec;
+	ret["load_usec"] = metrics.load_usec;
+	return ret;
+}
+
 Ref<Resource> ResourceLoader::load(const String &p_path, const String &p_type_hint, CacheMode p_cache_mode) {
 	Error err = OK;
 	Ref<Resource> ret = ::ResourceLoader::load(p_path, p_type_hint, ResourceFormatLoader::CacheMode(p_cache_mode), &err);
@@ -127,6 +148,9 @@ void ResourceLoader::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("load_threaded_request", "path", "type_hint", "use_sub_threads", "cache_mode"), &ResourceLoader::load_threaded_request, DEFVAL(""), DEFVAL(false), DEFVAL(CACHE_MODE_REUSE));
 	ClassDB::bind_method(D_METHOD("load_threaded_get_status", "path", "progress"), &ResourceLoader::load_threaded_get_status, DEFVAL(Array()));
 	ClassDB::bind_method(D_METHOD("load_threaded_get", "path"), &ResourceLoader::load_threaded_get);
+	ClassDB::bind_method(D_METHOD("load_threaded_set_priority", "path", "priority"), &ResourceLoader::load_threaded_set_priority);
+	ClassDB::bind_method(D_METHOD("load_threaded_cancel", "path"), &ResourceLoader::load_threaded_cancel);
+	ClassDB::bind_method(D_METHOD("load_threaded_get_metrics", "path"), &ResourceLoader::load_threaded_get_metrics);
 
 	ClassDB::bind_method(D_METHOD("load", "path", "type_hint", "cache_mode"), &ResourceLoader::load, DEFVAL(""), DEFVAL(CACHE_MODE_REUSE));
 	ClassDB::bind_method(D_METHOD("get_recognized_extensions_for_type", "type"), &ResourceLoader::get_recognized_extensions_for_type);
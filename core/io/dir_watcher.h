@@ -0,0 +1,69 @@
+/**************************************************************************/
+/*  dir_watcher.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#ifndef DIR_WATCHER_H
+#define DIR_WATCHER_H
+
+#include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
+
+// Reports changes made to the contents of watched directories. Only available
+// on platforms that register an implementation, check is_supported() first.
+class DirWatcher : public RefCounted {
+protected:
+	static DirWatcher *(*_create)();
+
+public:
+	enum EventType {
+		EVENT_CHANGED, // A file or subdirectory was created, modified or renamed inside the directory.
+		EVENT_REMOVED, // A file or subdirectory was removed from the directory, or moved out of it.
+		EVENT_WATCH_REMOVED, // The directory itself was removed or moved, it's no longer watched.
+		EVENT_OVERFLOW, // Events were lost, anything may have changed.
+	};
+
+	struct Event {
+		EventType type = EVENT_CHANGED;
+		int watch_id = -1;
+		String name; // Of the file or subdirectory, empty if the event is about the directory itself.
+	};
+
+	static bool is_supported() { return _create != nullptr; }
+	static DirWatcher *create();
+
+	// Takes an absolute path, returns the ID of the watch or -1 on failure.
+	virtual int add_watch(const String &p_path) = 0;
+	virtual void remove_watch(int p_watch_id) = 0;
+
+	// Appends the events received since the last call, doesn't block.
+	virtual void poll(LocalVector<Event> &r_events) = 0;
+};
+
+#endif // DIR_WATCHER_H
@@ -149,6 +149,8 @@ public:
 	Variant get_var(bool p_allow_objects = false) const;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const; ///< get an array of bytes
+	virtual const uint8_t *map_contents() { return nullptr; } ///< map the whole contents of a file opened for reading in memory, returns nullptr if it can't be mapped
+	virtual const uint8_t *get_mapped_ptr() const { return nullptr; } ///< get the contents of the file if they are in memory, valid until the file is closed
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
 	virtual String get_line() const;
 	virtual String get_token() const;
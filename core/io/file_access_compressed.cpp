@@ -32,6 +32,16 @@
 
 #include "core/string/print_string.h"
 
+bool FileAccessCompressed::read_ahead_enabled = true;
+
+void FileAccessCompressed::set_read_ahead_enabled(bool p_enabled) {
+	read_ahead_enabled = p_enabled;
+}
+
+bool FileAccessCompressed::is_read_ahead_enabled() {
+	return read_ahead_enabled;
+}
+
 void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size) {
 	magic = p_magic.ascii().get_data();
 	magic = (magic + "    ").substr(0, 4);
@@ -74,18 +84,118 @@ Error FileAccessCompressed::open_after_magic(Ref<FileAccess> p_base) {
 	}
 
 	comp_buffer.resize(max_bs);
-	buffer.resize(block_size);
-	read_ptr = buffer.ptrw();
-	f->get_buffer(comp_buffer.ptrw(), read_blocks[0].csize);
+	// Single block files only need room for their contents, which matters when using large blocks.
+	buffer.resize(bc == 1 ? MAX(read_total, (uint64_t)1) : block_size);
 	at_end = false;
 	read_eof = false;
 	read_block_count = bc;
-	read_block_size = read_blocks.size() == 1 ? read_total : block_size;
+	read_ahead_active = read_ahead_enabled && block_size >= READ_AHEAD_MIN_BLOCK_SIZE && read_total > block_size && WorkerThreadPool::get_singleton();
+
+	return _load_block(0);
+}
+
+void FileAccessCompressed::_read_ahead_decompress(void *p_userdata) {
+	ReadAhead *ra = (ReadAhead *)p_userdata;
+	ra->result = Compression::decompress(ra->dst, ra->data_size, ra->src, ra->compressed_size, ra->mode);
+}
+
+bool FileAccessCompressed::_has_block(uint32_t p_block) const {
+	// The last block is empty when the size is a multiple of the block size.
+	return p_block < read_block_count && (uint64_t)p_block * block_size < read_total;
+}
 
-	int ret = Compression::decompress(buffer.ptrw(), read_block_size, comp_buffer.ptr(), read_blocks[0].csize, cmode);
-	read_block = 0;
+void FileAccessCompressed::_schedule_read_ahead(uint32_t p_first_block) const {
+	// Drop blocks outside of the new window, i.e. after a seek.
+	for (ReadAhead &ra : read_ahead) {
+		if (ra.block != UINT32_MAX && (ra.block < p_first_block || ra.block >= p_first_block + READ_AHEAD_BLOCKS)) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(ra.task);
+			ra.task = WorkerThreadPool::INVALID_TASK_ID;
+			ra.block = UINT32_MAX;
+		}
+	}
+
+	for (uint32_t i = 0; i < READ_AHEAD_BLOCKS; i++) {
+		uint32_t block = p_first_block + i;
+		if (!_has_block(block)) {
+			break;
+		}
+
+		ReadAhead *slot = nullptr;
+		bool scheduled = false;
+		for (ReadAhead &ra : read_ahead) {
+			if (ra.block == block) {
+				scheduled = true;
+				break;
+			}
+			if (ra.block == UINT32_MAX && !slot) {
+				slot = &ra;
+			}
+		}
+		if (scheduled || !slot) {
+			continue;
+		}
+
+		// Reading stays on this thread since the base file is not thread safe, only decompression is deferred.
+		const ReadBlock &rb = read_blocks[block];
+		slot->compressed.resize(rb.csize);
+		slot->data.resize(block_size);
+		f->seek(rb.offset);
+		f->get_buffer(slot->compressed.ptrw(), rb.csize);
+
+		slot->block = block;
+		slot->mode = cmode;
+		slot->src = slot->compressed.ptr();
+		slot->compressed_size = rb.csize;
+		slot->dst = slot->data.ptrw();
+		slot->data_size = block_size;
+		slot->result = -1;
+		slot->task = WorkerThreadPool::get_singleton()->add_native_task(&FileAccessCompressed::_read_ahead_decompress, slot, false, "Decompress file block");
+	}
+}
+
+void FileAccessCompressed::_cancel_read_ahead() const {
+	for (ReadAhead &ra : read_ahead) {
+		if (ra.block != UINT32_MAX) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(ra.task);
+		}
+		ra.task = WorkerThreadPool::INVALID_TASK_ID;
+		ra.block = UINT32_MAX;
+		ra.compressed.clear();
+		ra.data.clear();
+	}
+}
+
+Error FileAccessCompressed::_load_block(uint32_t p_block) const {
+	int ret = -1;
+	bool prefetched = false;
+	for (ReadAhead &ra : read_ahead) {
+		if (ra.block == p_block) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(ra.task);
+			ra.task = WorkerThreadPool::INVALID_TASK_ID;
+			ra.block = UINT32_MAX;
+			// Swapping keeps both buffers allocated for the next blocks.
+			SWAP(buffer, ra.data);
+			ret = ra.result;
+			prefetched = true;
+			break;
+		}
+	}
+
+	if (!prefetched) {
+		f->seek(read_blocks[p_block].offset);
+		f->get_buffer(comp_buffer.ptrw(), read_blocks[p_block].csize);
+		ret = Compression::decompress(buffer.ptrw(), buffer.size(), comp_buffer.ptr(), read_blocks[p_block].csize, cmode);
+	}
+
+	read_ptr = buffer.ptrw();
+	read_block = p_block;
+	read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
 	read_pos = 0;
 
+	if (read_ahead_active) {
+		_schedule_read_ahead(p_block + 1);
+	}
+
 	return ret == -1 ? ERR_FILE_CORRUPT : OK;
 }
 
@@ -167,6 +277,8 @@ void FileAccessCompressed::_close() {
 		buffer.clear();
 
 	} else {
+		_cancel_read_ahead();
+		read_ahead_active = false;
 		comp_buffer.clear();
 		buffer.clear();
 		read_blocks.clear();
@@ -211,12 +323,8 @@ void FileAccessCompressed::seek(uint64_t p_position) {
 			read_eof = false;
 			uint32_t block_idx = p_position / block_size;
 			if (block_idx != read_block) {
-				read_block = block_idx;
-				f->seek(read_blocks[read_block].offset);
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				int ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				ERR_FAIL_COND_MSG(ret == -1, "Compressed file is corrupt.");
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+				Error err = _load_block(block_idx);
+				ERR_FAIL_COND_MSG(err != OK, "Compressed file is corrupt.");
 			}
 
 			read_pos = p_position % block_size;
@@ -273,18 +381,11 @@ uint8_t FileAccessCompressed::get_8() const {
 
 	read_pos++;
 	if (read_pos >= read_block_size) {
-		read_block++;
-
-		if (read_block < read_block_count) {
+		if (_has_block(read_block + 1)) {
 			//read another block of compressed data
-			f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-			int total = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-			ERR_FAIL_COND_V_MSG(total == -1, 0, "Compressed file is corrupt.");
-			read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
-			read_pos = 0;
-
+			Error err = _load_block(read_block + 1);
+			ERR_FAIL_COND_V_MSG(err != OK, 0, "Compressed file is corrupt.");
 		} else {
-			read_block--;
 			at_end = true;
 		}
 	}
@@ -302,32 +403,31 @@ uint64_t FileAccessCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) con
 		return 0;
 	}
 
-	for (uint64_t i = 0; i < p_length; i++) {
-		p_dst[i] = read_ptr[read_pos];
-		read_pos++;
-		if (read_pos >= read_block_size) {
-			read_block++;
+	uint64_t copied = 0;
+	while (true) {
+		uint64_t to_copy = MIN(p_length - copied, (uint64_t)(read_block_size - read_pos));
+		memcpy(p_dst + copied, read_ptr + read_pos, to_copy);
+		copied += to_copy;
+		read_pos += to_copy;
 
-			if (read_block < read_block_count) {
+		if (read_pos >= read_block_size) {
+			if (_has_block(read_block + 1)) {
 				//read another block of compressed data
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				int ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				ERR_FAIL_COND_V_MSG(ret == -1, -1, "Compressed file is corrupt.");
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
-				read_pos = 0;
-
+				Error err = _load_block(read_block + 1);
+				ERR_FAIL_COND_V_MSG(err != OK, -1, "Compressed file is corrupt.");
 			} else {
-				read_block--;
 				at_end = true;
-				if (i + 1 < p_length) {
+				if (copied < p_length) {
 					read_eof = true;
 				}
-				return i + 1;
+				return copied;
 			}
 		}
-	}
 
-	return p_length;
+		if (copied == p_length) {
+			return p_length;
+		}
+	}
 }
 
 Error FileAccessCompressed::get_error() const {
@@ -33,8 +33,22 @@
 
 #include "core/io/compression.h"
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
 
 class FileAccessCompressed : public FileAccess {
+public:
+	enum {
+		DEFAULT_BLOCK_SIZE = 4096,
+		// Larger blocks compress better and are big enough to be worth decompressing ahead on worker threads.
+		LARGE_BLOCK_SIZE = 256 * 1024,
+	};
+
+private:
+	enum {
+		READ_AHEAD_BLOCKS = 2,
+		READ_AHEAD_MIN_BLOCK_SIZE = 64 * 1024,
+	};
+
 	Compression::Mode cmode = Compression::MODE_ZSTD;
 	bool writing = false;
 	uint64_t write_pos = 0;
@@ -50,8 +64,27 @@ class FileAccessCompressed : public FileAccess {
 		uint64_t offset;
 	};
 
+	// A block decompressed in the background before the reader gets to it.
+	struct ReadAhead {
+		WorkerThreadPool::TaskID task = WorkerThreadPool::INVALID_TASK_ID;
+		uint32_t block = UINT32_MAX;
+		Compression::Mode mode = Compression::MODE_ZSTD;
+		Vector<uint8_t> compressed;
+		Vector<uint8_t> data;
+		int compressed_size = 0;
+		int data_size = 0;
+		const uint8_t *src = nullptr;
+		uint8_t *dst = nullptr;
+		int result = -1;
+	};
+
+	static bool read_ahead_enabled;
+
+	mutable ReadAhead read_ahead[READ_AHEAD_BLOCKS];
+	bool read_ahead_active = false;
+
 	mutable Vector<uint8_t> comp_buffer;
-	uint8_t *read_ptr = nullptr;
+	mutable uint8_t *read_ptr = nullptr;
 	mutable uint32_t read_block = 0;
 	uint32_t read_block_count = 0;
 	mutable uint32_t read_block_size = 0;
@@ -63,10 +96,19 @@ class FileAccessCompressed : public FileAccess {
 	mutable Vector<uint8_t> buffer;
 	Ref<FileAccess> f;
 
+	static void _read_ahead_decompress(void *p_userdata);
+	void _schedule_read_ahead(uint32_t p_first_block) const;
+	void _cancel_read_ahead() const;
+	bool _has_block(uint32_t p_block) const;
+	Error _load_block(uint32_t p_block) const;
+
 	void _close();
 
 public:
-	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, uint32_t p_block_size = 4096);
+	static void set_read_ahead_enabled(bool p_enabled);
+	static bool is_read_ahead_enabled();
+
+	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, uint32_t p_block_size = DEFAULT_BLOCK_SIZE);
 
 	Error open_after_magic(Ref<FileAccess> p_base);
 
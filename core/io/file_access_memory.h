@@ -58,6 +58,7 @@ public:
 	virtual uint8_t get_8() const override; ///< get a byte
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override; ///< get an array of bytes
+	virtual const uint8_t *get_mapped_ptr() const override { return data; }
 
 	virtual Error get_error() const override; ///< get last error
 
@@ -131,11 +131,14 @@ PackedData::~PackedData() {
 
 //////////////////////////////////////////////////////////////////
 
+bool PackedSourcePCK::memory_mapping_enabled = true;
+
 bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) {
 	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
 	if (f.is_null()) {
 		return false;
 	}
+	Ref<FileAccess> pack_file = f;
 
 	bool pck_header_found = false;
 
@@ -262,10 +265,45 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED));
 	}
 
+	if (memory_mapping_enabled) {
+		uint64_t modified_time = FileAccess::get_modified_time(p_path);
+		{
+			// The same pack added again keeps its mapping.
+			MutexLock lock(mapped_packs_mutex);
+			const MappedPack *existing = mapped_packs.getptr(p_path);
+			if (existing && existing->size == pack_file->get_length() && existing->modified_time == modified_time) {
+				return true;
+			}
+		}
+
+		const uint8_t *data = pack_file->map_contents();
+		if (data) {
+			MappedPack mapped_pack;
+			mapped_pack.file = pack_file;
+			mapped_pack.data = data;
+			mapped_pack.size = pack_file->get_length();
+			mapped_pack.modified_time = modified_time;
+
+			// A superseded mapping stays alive until the files opened from it are closed.
+			MutexLock lock(mapped_packs_mutex);
+			mapped_packs[p_path] = mapped_pack;
+		} else {
+			print_verbose("Pack '" + p_path + "' can't be memory mapped, files will be read from it instead.");
+		}
+	}
+
 	return true;
 }
 
 Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
+	// Encrypted files need to be decrypted, so they are always read through a file.
+	if (!p_file->encrypted) {
+		MutexLock lock(mapped_packs_mutex);
+		const MappedPack *mapped_pack = mapped_packs.getptr(p_file->pack);
+		if (mapped_pack && p_file->offset + p_file->size <= mapped_pack->size) {
+			return memnew(FileAccessPack(p_path, *p_file, mapped_pack->file));
+		}
+	}
 	return memnew(FileAccessPack(p_path, *p_file));
 }
 
@@ -277,7 +315,9 @@ Error FileAccessPack::open_internal(const String &p_path, int p_mode_flags) {
 }
 
 bool FileAccessPack::is_open() const {
-	if (f.is_valid()) {
+	if (mapped) {
+		return true;
+	} else if (f.is_valid()) {
 		return f->is_open();
 	} else {
 		return false;
@@ -285,7 +325,7 @@ bool FileAccessPack::is_open() const {
 }
 
 void FileAccessPack::seek(uint64_t p_position) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(f.is_null() && !mapped, "File must be opened before use.");
 
 	if (p_position > pf.size) {
 		eof = true;
@@ -293,7 +333,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (!mapped) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -314,18 +356,21 @@ bool FileAccessPack::eof_reached() const {
 }
 
 uint8_t FileAccessPack::get_8() const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), 0, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(f.is_null() && !mapped, 0, "File must be opened before use.");
 	if (pos >= pf.size) {
 		eof = true;
 		return 0;
 	}
 
+	if (mapped) {
+		return mapped[pos++];
+	}
 	pos++;
 	return f->get_8();
 }
 
 uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(f.is_null() && !mapped, -1, "File must be opened before use.");
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 
 	if (eof) {
@@ -338,21 +383,27 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 		to_read = (int64_t)pf.size - (int64_t)pos;
 	}
 
-	pos += to_read;
-
 	if (to_read <= 0) {
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+
+	if (mapped) {
+		memcpy(p_dst, mapped + pos, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
+	pos += to_read;
 
 	return to_read;
 }
 
 void FileAccessPack::set_big_endian(bool p_big_endian) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(f.is_null() && !mapped, "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (f.is_valid()) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -380,15 +431,26 @@ bool FileAccessPack::file_exists(const String &p_name) {
 
 void FileAccessPack::close() {
 	f = Ref<FileAccess>();
+	mapped = nullptr;
+	mapped_pack = Ref<FileAccess>();
 }
 
-FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) :
-		pf(p_file),
-		f(FileAccess::open(pf.pack, FileAccess::READ)) {
+FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Ref<FileAccess> &p_mapped_pack) :
+		pf(p_file) {
+	pos = 0;
+	eof = false;
+	off = pf.offset;
+
+	if (p_mapped_pack.is_valid()) {
+		mapped_pack = p_mapped_pack;
+		mapped = mapped_pack->map_contents() + pf.offset;
+		return;
+	}
+
+	f = FileAccess::open(pf.pack, FileAccess::READ);
 	ERR_FAIL_COND_MSG(f.is_null(), "Can't open pack-referenced file '" + String(pf.pack) + "'.");
 
 	f->seek(pf.offset);
-	off = pf.offset;
 
 	if (pf.encrypted) {
 		Ref<FileAccessEncrypted> fae;
@@ -406,8 +468,6 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 		f = fae;
 		off = 0;
 	}
-	pos = 0;
-	eof = false;
 }
 
 //////////////////////////////////////////////////////////////////////////////////
@@ -33,6 +33,7 @@
 
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/os/mutex.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
@@ -136,7 +137,25 @@ public:
 };
 
 class PackedSourcePCK : public PackSource {
+	// Packs are memory mapped once when added, files in them are then read without copies or syscalls.
+	// Files opened from a mapped pack hold a reference to its FileAccess, which owns the mapping,
+	// so re-adding a pack doesn't unmap the data they read from.
+	struct MappedPack {
+		Ref<FileAccess> file;
+		const uint8_t *data = nullptr;
+		uint64_t size = 0;
+		uint64_t modified_time = 0;
+	};
+
+	Mutex mapped_packs_mutex;
+	HashMap<String, MappedPack> mapped_packs;
+
+	static bool memory_mapping_enabled;
+
 public:
+	static void set_memory_mapping_enabled(bool p_enabled) { memory_mapping_enabled = p_enabled; }
+	static bool is_memory_mapping_enabled() { return memory_mapping_enabled; }
+
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) override;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) override;
 };
@@ -148,6 +167,11 @@ class FileAccessPack : public FileAccess {
 	mutable bool eof;
 	uint64_t off;
 
+	// Contents of the file, if the pack is memory mapped. Otherwise reads go through f.
+	// The mapping belongs to mapped_pack, which is kept open as long as this file is.
+	const uint8_t *mapped = nullptr;
+	Ref<FileAccess> mapped_pack;
+
 	Ref<FileAccess> f;
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
@@ -172,6 +196,7 @@ public:
 	virtual uint8_t get_8() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_mapped_ptr() const override { return mapped; }
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
@@ -187,7 +212,7 @@ public:
 
 	virtual void close() override;
 
-	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
+	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Ref<FileAccess> &p_mapped_pack = Ref<FileAccess>());
 };
 
 Ref<FileAccess> PackedData::try_open_path(const String &p_path) {
@@ -153,20 +153,36 @@ static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 	return OK;
 }
 
+String ResourceLoaderBinary::_read_utf8(uint32_t p_length) {
+	// Parse straight from the file contents when they are mapped in memory.
+	const uint8_t *mapped = f->get_mapped_ptr();
+	if (mapped) {
+		uint64_t pos = f->get_position();
+		if (pos + p_length <= f->get_length()) {
+			String s;
+			s.parse_utf8((const char *)mapped + pos, p_length);
+			f->seek(pos + p_length);
+			return s;
+		}
+	}
+
+	if ((int)p_length > str_buf.size()) {
+		str_buf.resize(p_length);
+	}
+	f->get_buffer((uint8_t *)&str_buf[0], p_length);
+	String s;
+	s.parse_utf8(&str_buf[0]);
+	return s;
+}
+
 StringName ResourceLoaderBinary::_get_string() {
 	uint32_t id = f->get_32();
 	if (id & 0x80000000) {
 		uint32_t len = id & 0x7FFFFFFF;
-		if ((int)len > str_buf.size()) {
-			str_buf.resize(len);
-		}
 		if (len == 0) {
 			return StringName();
 		}
-		f->get_buffer((uint8_t *)&str_buf[0], len);
-		String s;
-		s.parse_utf8(&str_buf[0]);
-		return s;
+		return _read_utf8(len);
 	}
 
 	return string_map[id];
@@ -409,6 +425,20 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 						path += res_path + "::" + itos(index);
 					}
 
+					if (!sub_resource_id.is_empty() && !internal_index_cache.has(path) && (int)index < internal_resources.size() - 1) {
+						// Loading a single sub-resource, materialize what it references on demand.
+						uint64_t pos = f->get_position();
+						Ref<Resource> res;
+						Error err = _load_internal_resource(index, res);
+						f->seek(pos);
+						if (err != OK) {
+							return err;
+						}
+						if (using_named_scene_ids) {
+							path = internal_resources[index].path;
+						}
+					}
+
 					//always use internal cache for loading internal resources
 					if (!internal_index_cache.has(path)) {
 						WARN_PRINT(String("Couldn't load resource (no cache): " + path).utf8().get_data());
@@ -448,6 +478,12 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 						WARN_PRINT("Broken external resource! (index out of size)");
 						r_v = Variant();
 					} else {
+						if (!external_resources[erindex].requested) {
+							Error err = _request_external_resource(erindex);
+							if (err != OK) {
+								return err;
+							}
+						}
 						Ref<ResourceLoader::LoadToken> &load_token = external_resources.write[erindex].load_token;
 						if (load_token.is_valid()) { // If not valid, it's OK since then we know this load accepts broken dependencies.
 							Error err;
@@ -680,206 +716,237 @@ Ref<Resource> ResourceLoaderBinary::get_resource() {
 	return resource;
 }
 
-Error ResourceLoaderBinary::load() {
-	if (error != OK) {
-		return error;
-	}
-
-	for (int i = 0; i < external_resources.size(); i++) {
-		String path = external_resources[i].path;
+Error ResourceLoaderBinary::_request_external_resource(int p_index) {
+	String path = external_resources[p_index].path;
 
-		if (remaps.has(path)) {
-			path = remaps[path];
-		}
+	if (remaps.has(path)) {
+		path = remaps[path];
+	}
 
-		if (!path.contains("://") && path.is_relative_path()) {
-			// path is relative to file being loaded, so convert to a resource path
-			path = ProjectSettings::get_singleton()->localize_path(path.get_base_dir().path_join(external_resources[i].path));
-		}
+	if (!path.contains("://") && path.is_relative_path()) {
+		// path is relative to file being loaded, so convert to a resource path
+		path = ProjectSettings::get_singleton()->localize_path(path.get_base_dir().path_join(external_resources[p_index].path));
+	}
 
-		external_resources.write[i].path = path; //remap happens here, not on load because on load it can actually be used for filesystem dock resource remap
-		external_resources.write[i].load_token = ResourceLoader::_load_start(path, external_resources[i].type, use_sub_threads ? ResourceLoader::LOAD_THREAD_DISTRIBUTE : ResourceLoader::LOAD_THREAD_FROM_CURRENT, cache_mode_for_external);
-		if (!external_resources[i].load_token.is_valid()) {
-			if (!ResourceLoader::get_abort_on_missing_resources()) {
-				ResourceLoader::notify_dependency_error(local_path, path, external_resources[i].type);
-			} else {
-				error = ERR_FILE_MISSING_DEPENDENCIES;
-				ERR_FAIL_V_MSG(error, "Can't load dependency: " + path + ".");
-			}
+	external_resources.write[p_index].path = path; //remap happens here, not on load because on load it can actually be used for filesystem dock resource remap
+	external_resources.write[p_index].requested = true;
+	external_resources.write[p_index].load_token = ResourceLoader::_load_start(path, external_resources[p_index].type, use_sub_threads ? ResourceLoader::LOAD_THREAD_DISTRIBUTE : ResourceLoader::LOAD_THREAD_FROM_CURRENT, cache_mode_for_external);
+	if (!external_resources[p_index].load_token.is_valid()) {
+		if (!ResourceLoader::get_abort_on_missing_resources()) {
+			ResourceLoader::notify_dependency_error(local_path, path, external_resources[p_index].type);
+		} else {
+			error = ERR_FILE_MISSING_DEPENDENCIES;
+			ERR_FAIL_V_MSG(error, "Can't load dependency: " + path + ".");
 		}
 	}
 
-	for (int i = 0; i < internal_resources.size(); i++) {
-		bool main = i == (internal_resources.size() - 1);
+	return OK;
+}
 
-		//maybe it is loaded already
-		String path;
-		String id;
+Error ResourceLoaderBinary::_load_internal_resource(int p_index, Ref<Resource> &r_res) {
+	// The main resource is never part of a sub-resource load.
+	bool main = p_index == (internal_resources.size() - 1) && sub_resource_id.is_empty();
 
-		if (!main) {
-			path = internal_resources[i].path;
+	//maybe it is loaded already
+	String path;
+	String id;
 
-			if (path.begins_with("local://")) {
-				path = path.replace_first("local://", "");
-				id = path;
-				path = res_path + "::" + path;
+	if (!main) {
+		path = internal_resources[p_index].path;
 
-				internal_resources.write[i].path = path; // Update path.
-			}
+		if (path.begins_with("local://")) {
+			path = path.replace_first("local://", "");
+			id = path;
+			path = res_path + "::" + path;
 
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached.is_valid()) {
-					//already loaded, don't do anything
-					error = OK;
-					internal_index_cache[path] = cached;
-					continue;
-				}
-			}
-		} else {
-			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
-				path = res_path;
+			internal_resources.write[p_index].path = path; // Update path.
+		}
+
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
+			Ref<Resource> cached = ResourceCache::get_ref(path);
+			if (cached.is_valid()) {
+				//already loaded, don't do anything
+				error = OK;
+				internal_index_cache[path] = cached;
+				return OK;
 			}
 		}
+	} else {
+		if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
+			path = res_path;
+		}
+	}
 
-		uint64_t offset = internal_resources[i].offset;
+	uint64_t offset = internal_resources[p_index].offset;
 
-		f->seek(offset);
+	f->seek(offset);
 
-		String t = get_unicode_string();
+	String t = get_unicode_string();
 
-		Ref<Resource> res;
-		Resource *r = nullptr;
+	Ref<Resource> res;
+	Resource *r = nullptr;
 
-		MissingResource *missing_resource = nullptr;
+	MissingResource *missing_resource = nullptr;
 
-		if (main) {
-			res = ResourceLoader::get_resource_ref_override(local_path);
-			r = res.ptr();
-		}
-		if (!r) {
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
-				//use the existing one
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached->get_class() == t) {
-					cached->reset_state();
-					res = cached;
-				}
+	if (main) {
+		res = ResourceLoader::get_resource_ref_override(local_path);
+		r = res.ptr();
+	}
+	if (!r) {
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
+			//use the existing one
+			Ref<Resource> cached = ResourceCache::get_ref(path);
+			if (cached->get_class() == t) {
+				cached->reset_state();
+				res = cached;
 			}
+		}
 
-			if (res.is_null()) {
-				//did not replace
-
-				Object *obj = ClassDB::instantiate(t);
-				if (!obj) {
-					if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-						//create a missing resource
-						missing_resource = memnew(MissingResource);
-						missing_resource->set_original_class(t);
-						missing_resource->set_recording_properties(true);
-						obj = missing_resource;
-					} else {
-						error = ERR_FILE_CORRUPT;
-						ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
-					}
-				}
-
-				r = Object::cast_to<Resource>(obj);
-				if (!r) {
-					String obj_class = obj->get_class();
+		if (res.is_null()) {
+			//did not replace
+
+			Object *obj = ClassDB::instantiate(t);
+			if (!obj) {
+				if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+					//create a missing resource
+					missing_resource = memnew(MissingResource);
+					missing_resource->set_original_class(t);
+					missing_resource->set_recording_properties(true);
+					obj = missing_resource;
+				} else {
 					error = ERR_FILE_CORRUPT;
-					memdelete(obj); //bye
-					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
+					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
 				}
+			}
 
-				res = Ref<Resource>(r);
+			r = Object::cast_to<Resource>(obj);
+			if (!r) {
+				String obj_class = obj->get_class();
+				error = ERR_FILE_CORRUPT;
+				memdelete(obj); //bye
+				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
 			}
+
+			res = Ref<Resource>(r);
 		}
+	}
 
-		if (r) {
-			if (!path.is_empty()) {
-				if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
-					r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
-				} else {
-					r->set_path_cache(path);
-				}
+	if (r) {
+		if (!path.is_empty()) {
+			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
+				r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
+			} else {
+				r->set_path_cache(path);
 			}
-			r->set_scene_unique_id(id);
 		}
+		r->set_scene_unique_id(id);
+	}
 
-		if (!main) {
-			internal_index_cache[path] = res;
-		}
+	if (!main) {
+		internal_index_cache[path] = res;
+	}
 
-		int pc = f->get_32();
+	int pc = f->get_32();
 
-		//set properties
+	//set properties
 
-		Dictionary missing_resource_properties;
+	Dictionary missing_resource_properties;
 
-		for (int j = 0; j < pc; j++) {
-			StringName name = _get_string();
+	for (int j = 0; j < pc; j++) {
+		StringName name = _get_string();
 
-			if (name == StringName()) {
-				error = ERR_FILE_CORRUPT;
-				ERR_FAIL_V(ERR_FILE_CORRUPT);
-			}
+		if (name == StringName()) {
+			error = ERR_FILE_CORRUPT;
+			ERR_FAIL_V(ERR_FILE_CORRUPT);
+		}
 
-			Variant value;
+		Variant value;
 
-			error = parse_variant(value);
-			if (error) {
-				return error;
-			}
+		error = parse_variant(value);
+		if (error) {
+			return error;
+		}
 
-			bool set_valid = true;
-			if (value.get_type() == Variant::OBJECT && missing_resource != nullptr) {
-				// If the property being set is a missing resource (and the parent is not),
-				// then setting it will most likely not work.
-				// Instead, save it as metadata.
+		bool set_valid = true;
+		if (value.get_type() == Variant::OBJECT && missing_resource != nullptr) {
+			// If the property being set is a missing resource (and the parent is not),
+			// then setting it will most likely not work.
+			// Instead, save it as metadata.
 
-				Ref<MissingResource> mr = value;
-				if (mr.is_valid()) {
-					missing_resource_properties[name] = mr;
-					set_valid = false;
-				}
+			Ref<MissingResource> mr = value;
+			if (mr.is_valid()) {
+				missing_resource_properties[name] = mr;
+				set_valid = false;
 			}
+		}
 
-			if (value.get_type() == Variant::ARRAY) {
-				Array set_array = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
-					Array get_array = get_value;
-					if (!set_array.is_same_typed(get_array)) {
-						value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
-					}
+		if (value.get_type() == Variant::ARRAY) {
+			Array set_array = value;
+			bool is_get_valid = false;
+			Variant get_value = res->get(name, &is_get_valid);
+			if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
+				Array get_array = get_value;
+				if (!set_array.is_same_typed(get_array)) {
+					value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
 				}
 			}
-
-			if (set_valid) {
-				res->set(name, value);
-			}
 		}
 
-		if (missing_resource) {
-			missing_resource->set_recording_properties(false);
+		if (set_valid) {
+			res->set(name, value);
 		}
+	}
 
-		if (!missing_resource_properties.is_empty()) {
-			res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
-		}
+	if (missing_resource) {
+		missing_resource->set_recording_properties(false);
+	}
+
+	if (!missing_resource_properties.is_empty()) {
+		res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+	}
 
 #ifdef TOOLS_ENABLED
-		res->set_edited(false);
+	res->set_edited(false);
 #endif
 
+	resource_cache.push_back(res);
+	r_res = res;
+	return OK;
+}
+
+Error ResourceLoaderBinary::load() {
+	if (error != OK) {
+		return error;
+	}
+
+	if (!sub_resource_id.is_empty()) {
+		return _load_sub_resource();
+	}
+
+	for (int i = 0; i < external_resources.size(); i++) {
+		error = _request_external_resource(i);
+		if (error != OK) {
+			return error;
+		}
+	}
+
+	for (int i = 0; i < internal_resources.size(); i++) {
+		bool main = i == (internal_resources.size() - 1);
+
+		Ref<Resource> res;
+		error = _load_internal_resource(i, res);
+		if (error != OK) {
+			return error;
+		}
+		if (res.is_null()) {
+			// Already loaded, reused from the cache.
+			continue;
+		}
+
 		if (progress) {
 			*progress = (i + 1) / float(internal_resources.size());
 		}
 
-		resource_cache.push_back(res);
-
 		if (main) {
 			f.unref();
 			resource = res;
@@ -892,6 +959,40 @@ Error ResourceLoaderBinary::load() {
 	return ERR_FILE_EOF;
 }
 
+Error ResourceLoaderBinary::_load_sub_resource() {
+	// Only the requested sub-resource is parsed up front. Everything it references, internal or
+	// external, is loaded when first found while parsing, using the offsets from the resource table.
+	int index = -1;
+	for (int i = 0; i < internal_resources.size() - 1; i++) {
+		if (internal_resources[i].path == "local://" + sub_resource_id) {
+			index = i;
+			break;
+		}
+	}
+	if (index == -1) {
+		error = ERR_DOES_NOT_EXIST;
+		ERR_FAIL_V_MSG(error, "Sub-resource '" + sub_resource_id + "' not found in: " + local_path + ".");
+	}
+
+	Ref<Resource> res;
+	error = _load_internal_resource(index, res);
+	if (error != OK) {
+		return error;
+	}
+	if (res.is_null()) {
+		res = internal_index_cache[internal_resources[index].path];
+	}
+
+	if (progress) {
+		*progress = 1.0;
+	}
+
+	f.unref();
+	resource = res;
+	error = OK;
+	return OK;
+}
+
 void ResourceLoaderBinary::set_translation_remapped(bool p_remapped) {
 	translation_remapped = p_remapped;
 }
@@ -914,16 +1015,10 @@ static String get_ustring(Ref<FileAccess> f) {
 
 String ResourceLoaderBinary::get_unicode_string() {
 	int len = f->get_32();
-	if (len > str_buf.size()) {
-		str_buf.resize(len);
-	}
-	if (len == 0) {
+	if (len <= 0) {
 		return String();
 	}
-	f->get_buffer((uint8_t *)&str_buf[0], len);
-	String s;
-	s.parse_utf8(&str_buf[0]);
-	return s;
+	return _read_utf8(len);
 }
 
 void ResourceLoaderBinary::get_classes_used(Ref<FileAccess> p_f, HashSet<StringName> *p_classes) {
@@ -1203,15 +1298,23 @@ String ResourceLoaderBinary::recognize_script_class(Ref<FileAccess> p_f) {
 	}
 }
 
+bool ResourceFormatLoaderBinary::recognize_path(const String &p_path, const String &p_for_type) const {
+	// Sub-resource paths are recognized by the file they are stored in.
+	return ResourceFormatLoader::recognize_path(p_path.get_slice("::", 0), p_for_type);
+}
+
 Ref<Resource> ResourceFormatLoaderBinary::load(const String &p_path, const String &p_original_path, Error *r_error, bool p_use_sub_threads, float *r_progress, CacheMode p_cache_mode) {
 	if (r_error) {
 		*r_error = ERR_FILE_CANT_OPEN;
 	}
 
+	// A path like "res://library.res::Animation_abc12" only loads that sub-resource and what it references.
+	const String file_path = p_path.get_slice("::", 0);
+
 	Error err;
-	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+	Ref<FileAccess> f = FileAccess::open(file_path, FileAccess::READ, &err);
 
-	ERR_FAIL_COND_V_MSG(err != OK, Ref<Resource>(), "Cannot open file '" + p_path + "'.");
+	ERR_FAIL_COND_V_MSG(err != OK, Ref<Resource>(), "Cannot open file '" + file_path + "'.");
 
 	ResourceLoaderBinary loader;
 	switch (p_cache_mode) {
@@ -1233,8 +1336,9 @@ Ref<Resource> ResourceFormatLoaderBinary::load(const String &p_path, const Strin
 	loader.use_sub_threads = p_use_sub_threads;
 	loader.progress = r_progress;
 	String path = !p_original_path.is_empty() ? p_original_path : p_path;
-	loader.local_path = ProjectSettings::get_singleton()->localize_path(path);
+	loader.local_path = ProjectSettings::get_singleton()->localize_path(path.get_slice("::", 0));
 	loader.res_path = loader.local_path;
+	loader.sub_resource_id = p_path.get_slice("::", 1);
 	loader.open(f);
 
 	err = loader.load();
@@ -1311,7 +1415,7 @@ Error ResourceFormatLoaderBinary::rename_dependencies(const String &p_path, cons
 
 		Ref<FileAccessCompressed> facw;
 		facw.instantiate();
-		facw->configure("RSCC");
+		facw->configure("RSCC", Compression::MODE_ZSTD, FileAccessCompressed::LARGE_BLOCK_SIZE);
 		err = facw->open_internal(p_path + ".depren", FileAccess::WRITE);
 		ERR_FAIL_COND_V_MSG(err, ERR_FILE_CORRUPT, "Cannot create file '" + p_path + ".depren'.");
 
@@ -2124,7 +2228,7 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Re
 	if (p_flags & ResourceSaver::FLAG_COMPRESS) {
 		Ref<FileAccessCompressed> fac;
 		fac.instantiate();
-		fac->configure("RSCC");
+		fac->configure("RSCC", Compression::MODE_ZSTD, FileAccessCompressed::LARGE_BLOCK_SIZE);
 		f = fac;
 		err = fac->open_internal(p_path, FileAccess::WRITE);
 	} else {
@@ -2380,7 +2484,7 @@ Error ResourceFormatSaverBinaryInstance::set_uid(const String &p_path, ResourceU
 
 		Ref<FileAccessCompressed> facw;
 		facw.instantiate();
-		facw->configure("RSCC");
+		facw->configure("RSCC", Compression::MODE_ZSTD, FileAccessCompressed::LARGE_BLOCK_SIZE);
 		err = facw->open_internal(p_path + ".uidren", FileAccess::WRITE);
 		ERR_FAIL_COND_V_MSG(err, ERR_FILE_CORRUPT, "Cannot create file '" + p_path + ".uidren'.");
 
@@ -55,12 +55,14 @@ class ResourceLoaderBinary {
 	Vector<StringName> string_map;
 
 	StringName _get_string();
+	String _read_utf8(uint32_t p_length);
 
 	struct ExtResource {
 		String path;
 		String type;
 		ResourceUID::ID uid = ResourceUID::INVALID_ID;
 		Ref<ResourceLoader::LoadToken> load_token;
+		bool requested = false;
 	};
 
 	bool using_named_scene_ids = false;
@@ -91,6 +93,13 @@ class ResourceLoaderBinary {
 
 	Error parse_variant(Variant &r_v);
 
+	// When set, only this sub-resource (and what it references) is loaded, see `ResourceFormatLoaderBinary::load()`.
+	String sub_resource_id;
+
+	Error _request_external_resource(int p_index);
+	Error _load_internal_resource(int p_index, Ref<Resource> &r_res);
+	Error _load_sub_resource();
+
 	HashMap<String, Ref<Resource>> dependency_cache;
 
 public:
@@ -110,6 +119,7 @@ public:
 
 class ResourceFormatLoaderBinary : public ResourceFormatLoader {
 public:
+	virtual bool recognize_path(const String &p_path, const String &p_for_type = String()) const override;
 	virtual Ref<Resource> load(const String &p_path, const String &p_original_path = "", Error *r_error = nullptr, bool p_use_sub_threads = false, float *r_progress = nullptr, CacheMode p_cache_mode = CACHE_MODE_REUSE) override;
 	virtual void get_recognized_extensions_for_type(const String &p_type, List<String> *p_extensions) const override;
 	virtual void get_recognized_extensions(List<String> *p_extensions) const override;
@@ -141,6 +141,12 @@ public:
 
 	virtual Error import(const String &p_source_file, const String &p_save_path, const HashMap<StringName, Variant> &p_options, List<String> *r_platform_variants, List<String> *r_gen_files = nullptr, Variant *r_metadata = nullptr) = 0;
 	virtual bool can_import_threaded() const { return true; }
+	// Source files (res:// paths) that must be imported before p_path can be, when both are reimported together.
+	virtual void get_import_dependencies(const String &p_path, Vector<String> &r_dependencies) const {}
+	// Whether the result of importing p_path with p_options only depends on the source file contents and the options, so it can be shared through the editor import cache.
+	virtual bool is_import_cacheable(const String &p_path, const HashMap<StringName, Variant> &p_options) const { return false; }
+	// Project settings, besides those in get_import_settings_string(), that change the imported files. Part of the editor import cache key.
+	virtual String get_import_cache_settings_string() const { return String(); }
 	virtual void import_threaded_begin() {}
 	virtual void import_threaded_end() {}
 
@@ -333,9 +333,13 @@ void ResourceLoader::_run_load_task(void *p_userdata) {
 	thread_load_mutex.lock();
 	if (cleaning_tasks) {
 		load_task.status = THREAD_LOAD_FAILED;
+		_release_request_slot(&load_task);
 		thread_load_mutex.unlock();
 		return;
 	}
+	if (load_task.start_usec == 0) {
+		load_task.start_usec = OS::get_singleton()->get_ticks_usec();
+	}
 	thread_load_mutex.unlock();
 
 	ThreadLoadTask *curr_load_task_backup = curr_load_task;
@@ -382,6 +386,8 @@ void ResourceLoader::_run_load_task(void *p_userdata) {
 	} else {
 		load_task.status = THREAD_LOAD_LOADED;
 	}
+	load_task.end_usec = OS::get_singleton()->get_ticks_usec();
+	_release_request_slot(&load_task);
 
 	if (load_task.cond_var && load_task.need_wait) {
 		load_task.cond_var->notify_all();
@@ -486,8 +492,8 @@ static String _validate_local_path(const String &p_path) {
 	}
 }
 
-Error ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint, bool p_use_sub_threads, ResourceFormatLoader::CacheMode p_cache_mode) {
-	Ref<ResourceLoader::LoadToken> token = _load_start(p_path, p_type_hint, p_use_sub_threads ? LOAD_THREAD_DISTRIBUTE : LOAD_THREAD_SPAWN_SINGLE, p_cache_mode, true);
+Error ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint, bool p_use_sub_threads, ResourceFormatLoader::CacheMode p_cache_mode, int p_priority) {
+	Ref<ResourceLoader::LoadToken> token = _load_start(p_path, p_type_hint, p_use_sub_threads ? LOAD_THREAD_DISTRIBUTE : LOAD_THREAD_SPAWN_SINGLE, p_cache_mode, true, p_priority);
 	return token.is_valid() ? OK : FAILED;
 }
 
@@ -536,7 +542,7 @@ Ref<Resource> ResourceLoader::load(const String &p_path, const String &p_type_hi
 	return res;
 }
 
-Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode, bool p_for_user) {
+Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode, bool p_for_user, int p_priority) {
 	String local_path = _validate_local_path(p_path);
 
 	bool ignoring_cache = p_cache_mode == ResourceFormatLoader::CACHE_MODE_IGNORE || p_cache_mode == ResourceFormatLoader::CACHE_MODE_IGNORE_DEEP;
@@ -585,6 +591,8 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 			load_task.type_hint = p_type_hint;
 			load_task.cache_mode = p_cache_mode;
 			load_task.use_sub_threads = p_thread_mode == LOAD_THREAD_DISTRIBUTE;
+			load_task.priority = p_priority;
+			load_task.request_usec = OS::get_singleton()->get_ticks_usec();
 			if (p_cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE) {
 				Ref<Resource> existing = ResourceCache::get_ref(local_path);
 				if (existing.is_valid()) {
@@ -592,6 +600,8 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 					load_task.resource = existing;
 					load_task.status = THREAD_LOAD_LOADED;
 					load_task.progress = 1.0;
+					load_task.start_usec = load_task.request_usec;
+					load_task.end_usec = load_task.request_usec;
 					DEV_ASSERT(!thread_load_tasks.has(local_path));
 					thread_load_tasks[local_path] = load_task;
 					return load_token;
@@ -623,6 +633,10 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 			} else {
 				load_task_ptr->thread_id = Thread::get_caller_id();
 			}
+		} else if (p_for_user && !must_not_register) {
+			load_task_ptr->queued = true;
+			queued_load_tasks.push_back(load_task_ptr);
+			_dispatch_queued_load_tasks();
 		} else {
 			load_task_ptr->task_id = WorkerThreadPool::get_singleton()->add_native_task(&ResourceLoader::_run_load_task, load_task_ptr);
 		}
@@ -635,6 +649,81 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 	return load_token;
 }
 
+ResourceLoader::ThreadLoadTask *ResourceLoader::_get_user_load_task(const String &p_path) {
+	HashMap<String, LoadToken *>::Iterator E = user_load_tokens.find(p_path);
+	if (!E) {
+		return nullptr;
+	}
+	if (E->value->task_if_unregistered) {
+		return E->value->task_if_unregistered;
+	}
+	return thread_load_tasks.getptr(E->value->local_path);
+}
+
+// The functions below must be called with the thread load mutex locked.
+
+void ResourceLoader::_dispatch_queued_load_tasks() {
+	// Read every time, so a changed limit applies to the loads still queued.
+	int max_requests = GLOBAL_GET("threading/resource_loading/max_concurrent_requests");
+	if (max_requests <= 0) {
+		// Starting more would only queue them in the pool, where priorities are unknown.
+		max_requests = WorkerThreadPool::get_singleton()->get_max_low_priority_threads();
+	}
+	max_requests = MAX(max_requests, 1);
+
+	while (running_requests < max_requests && !queued_load_tasks.is_empty()) {
+		// Highest priority first, then in order of request.
+		uint32_t next = 0;
+		for (uint32_t i = 1; i < queued_load_tasks.size(); i++) {
+			if (queued_load_tasks[i]->priority > queued_load_tasks[next]->priority) {
+				next = i;
+			}
+		}
+		ThreadLoadTask *load_task = queued_load_tasks[next];
+		queued_load_tasks.remove_at(next);
+		load_task->queued = false;
+		_start_queued_load_task(load_task);
+	}
+}
+
+void ResourceLoader::_start_queued_load_task(ThreadLoadTask *p_load_task) {
+	DEV_ASSERT(!p_load_task->queued && !p_load_task->task_id);
+	p_load_task->takes_request_slot = true;
+	running_requests++;
+	p_load_task->task_id = WorkerThreadPool::get_singleton()->add_native_task(&ResourceLoader::_run_load_task, p_load_task);
+}
+
+bool ResourceLoader::_unqueue_load_task(ThreadLoadTask *p_load_task) {
+	if (!p_load_task->queued) {
+		return false;
+	}
+	int64_t index = queued_load_tasks.find(p_load_task);
+	DEV_ASSERT(index >= 0);
+	queued_load_tasks.remove_at(index);
+	p_load_task->queued = false;
+	return true;
+}
+
+void ResourceLoader::_cancel_queued_load_task(ThreadLoadTask *p_load_task) {
+	p_load_task->status = THREAD_LOAD_FAILED;
+	p_load_task->error = ERR_SKIP;
+	p_load_task->need_wait = false;
+	p_load_task->end_usec = OS::get_singleton()->get_ticks_usec();
+	// Release the reference the load task would have released when done.
+	p_load_task->load_token->unreference();
+}
+
+void ResourceLoader::_release_request_slot(ThreadLoadTask *p_load_task) {
+	if (!p_load_task->takes_request_slot) {
+		return; // Not a user request, or released already by a load restarted to break a cycle.
+	}
+	p_load_task->takes_request_slot = false;
+	running_requests--;
+	if (!cleaning_tasks) {
+		_dispatch_queued_load_tasks();
+	}
+}
+
 float ResourceLoader::_dependency_get_progress(const String &p_path) {
 	if (thread_load_tasks.has(p_path)) {
 		ThreadLoadTask &load_task = thread_load_tasks[p_path];
@@ -717,7 +806,11 @@ Ref<Resource> ResourceLoader::load_threaded_get(const String &p_path, Error *r_e
 
 		// Support userland requesting on the main thread before the load is reported to be complete.
 		if (Thread::is_main_thread() && !load_token->local_path.is_empty()) {
-			const ThreadLoadTask &load_task = thread_load_tasks[load_token->local_path];
+			ThreadLoadTask &load_task = thread_load_tasks[load_token->local_path];
+			if (_unqueue_load_task(&load_task)) {
+				// Needed right now, so it can't wait for its turn.
+				_start_queued_load_task(&load_task);
+			}
 			while (load_task.status == THREAD_LOAD_IN_PROGRESS) {
 				thread_load_lock.~MutexLock();
 				bool exit = !_ensure_load_progress();
@@ -747,6 +840,75 @@ Ref<Resource> ResourceLoader::load_threaded_get(const String &p_path, Error *r_e
 	return res;
 }
 
+Error ResourceLoader::load_threaded_set_priority(const String &p_path, int p_priority) {
+	MutexLock thread_load_lock(thread_load_mutex);
+
+	ThreadLoadTask *load_task = _get_user_load_task(p_path);
+	if (!load_task) {
+		print_verbose("load_threaded_set_priority(): No threaded load for resource path '" + p_path + "' has been initiated or its result has already been collected.");
+		return ERR_INVALID_PARAMETER;
+	}
+
+	// Only matters while the load is queued.
+	load_task->priority = p_priority;
+	return OK;
+}
+
+Error ResourceLoader::load_threaded_cancel(const String &p_path) {
+	MutexLock thread_load_lock(thread_load_mutex);
+
+	HashMap<String, LoadToken *>::Iterator E = user_load_tokens.find(p_path);
+	if (!E) {
+		print_verbose("load_threaded_cancel(): No threaded load for resource path '" + p_path + "' has been initiated or its result has already been collected.");
+		return ERR_INVALID_PARAMETER;
+	}
+
+	LoadToken *load_token = E->value;
+	if (load_token->user_rc > 1) {
+		// Other requests for the same path still want the resource.
+		load_token->user_rc--;
+		return OK;
+	}
+
+	// The load can only be dropped if it hasn't started and no one but the user request and the queue hold its token.
+	ThreadLoadTask *load_task = _get_user_load_task(p_path);
+	if (!load_task || !load_task->queued || load_token->get_reference_count() > 2) {
+		return ERR_BUSY;
+	}
+
+	_unqueue_load_task(load_task);
+	_cancel_queued_load_task(load_task);
+
+	load_token->user_rc = 0;
+	load_token->user_path.clear();
+	user_load_tokens.remove(E);
+	if (load_token->unreference()) {
+		memdelete(load_token);
+	}
+
+	print_lt("CANCEL: user load tokens: " + itos(user_load_tokens.size()));
+
+	return OK;
+}
+
+bool ResourceLoader::load_threaded_get_metrics(const String &p_path, ThreadLoadMetrics &r_metrics) {
+	MutexLock thread_load_lock(thread_load_mutex);
+
+	const ThreadLoadTask *load_task = _get_user_load_task(p_path);
+	if (!load_task) {
+		return false;
+	}
+
+	const uint64_t now = OS::get_singleton()->get_ticks_usec();
+	const uint64_t end_usec = load_task->end_usec ? load_task->end_usec : now;
+	const uint64_t start_usec = load_task->start_usec ? load_task->start_usec : end_usec;
+
+	r_metrics.priority = load_task->priority;
+	r_metrics.wait_usec = start_usec - load_task->request_usec;
+	r_metrics.load_usec = end_usec - start_usec;
+	return true;
+}
+
 Ref<Resource> ResourceLoader::_load_complete(LoadToken &p_load_token, Error *r_error) {
 	MutexLock thread_load_lock(thread_load_mutex);
 	return _load_complete_inner(p_load_token, r_error, thread_load_lock);
@@ -771,6 +933,11 @@ Ref<Resource> ResourceLoader::_load_complete_inner(LoadToken &p_load_token, Erro
 		ThreadLoadTask &load_task = thread_load_tasks[p_load_token.local_path];
 
 		if (load_task.status == THREAD_LOAD_IN_PROGRESS) {
+			if (_unqueue_load_task(&load_task)) {
+				// Another load depends on this one, so it can't wait for its turn.
+				_start_queued_load_task(&load_task);
+			}
+
 			DEV_ASSERT((load_task.task_id == 0) != (load_task.thread_id == 0));
 
 			if ((load_task.task_id != 0 && load_task.task_id == WorkerThreadPool::get_singleton()->get_caller_task_id()) ||
@@ -1314,6 +1481,13 @@ void ResourceLoader::clear_thread_load_tasks() {
 	thread_load_mutex.lock();
 	cleaning_tasks = true;
 
+	// Queued loads would never start now.
+	for (ThreadLoadTask *load_task : queued_load_tasks) {
+		load_task->queued = false;
+		_cancel_queued_load_task(load_task);
+	}
+	queued_load_tasks.clear();
+
 	while (true) {
 		bool none_running = true;
 		if (thread_load_tasks.size()) {
@@ -1476,6 +1650,9 @@ bool ResourceLoader::cleaning_tasks = false;
 
 HashMap<String, ResourceLoader::LoadToken *> ResourceLoader::user_load_tokens;
 
+LocalVector<ResourceLoader::ThreadLoadTask *> ResourceLoader::queued_load_tasks;
+int ResourceLoader::running_requests = 0;
+
 SelfList<Resource>::List ResourceLoader::remapped_list;
 HashMap<String, Vector<String>> ResourceLoader::translation_remaps;
 HashMap<String, String> ResourceLoader::path_remaps;
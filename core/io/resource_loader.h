@@ -101,6 +101,7 @@ typedef void (*ResourceLoadedCallback)(Ref<Resource> p_resource, const String &p
 
 class ResourceLoader {
 	friend class LoadToken;
+	friend class TestResourceLoaderInternalsAccessor;
 
 	enum {
 		MAX_LOADERS = 64
@@ -135,7 +136,13 @@ public:
 
 	static const int BINARY_MUTEX_TAG = 1;
 
-	static Ref<LoadToken> _load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode, bool p_for_user = false);
+	struct ThreadLoadMetrics {
+		int priority = 0;
+		uint64_t wait_usec = 0; // From the request until the load started, or until now if still queued.
+		uint64_t load_usec = 0; // From the start of the load until it finished, or until now if in progress.
+	};
+
+	static Ref<LoadToken> _load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode, bool p_for_user = false, int p_priority = 0);
 	static Ref<Resource> _load_complete(LoadToken &p_load_token, Error *r_error);
 
 private:
@@ -190,6 +197,13 @@ private:
 		bool use_sub_threads = false;
 		HashSet<String> sub_tasks;
 
+		int priority = 0;
+		bool queued = false; // User request waiting for a free slot, see _dispatch_queued_load_tasks().
+		bool takes_request_slot = false;
+		uint64_t request_usec = 0;
+		uint64_t start_usec = 0;
+		uint64_t end_usec = 0;
+
 		struct ResourceChangedConnection {
 			Resource *source = nullptr;
 			Callable callable;
@@ -213,14 +227,28 @@ private:
 
 	static HashMap<String, LoadToken *> user_load_tokens;
 
+	// User requests beyond the maximum of concurrent ones wait here, and start in order of priority.
+	static LocalVector<ThreadLoadTask *> queued_load_tasks;
+	static int running_requests;
+
+	static ThreadLoadTask *_get_user_load_task(const String &p_path);
+	static void _dispatch_queued_load_tasks();
+	static void _start_queued_load_task(ThreadLoadTask *p_load_task);
+	static bool _unqueue_load_task(ThreadLoadTask *p_load_task);
+	static void _cancel_queued_load_task(ThreadLoadTask *p_load_task);
+	static void _release_request_slot(ThreadLoadTask *p_load_task);
+
 	static float _dependency_get_progress(const String &p_path);
 
 	static bool _ensure_load_progress();
 
 public:
-	static Error load_threaded_request(const String &p_path, const String &p_type_hint = "", bool p_use_sub_threads = false, ResourceFormatLoader::CacheMode p_cache_mode = ResourceFormatLoader::CACHE_MODE_REUSE);
+	static Error load_threaded_request(const String &p_path, const String &p_type_hint = "", bool p_use_sub_threads = false, ResourceFormatLoader::CacheMode p_cache_mode = ResourceFormatLoader::CACHE_MODE_REUSE, int p_priority = 0);
 	static ThreadLoadStatus load_threaded_get_status(const String &p_path, float *r_progress = nullptr);
 	static Ref<Resource> load_threaded_get(const String &p_path, Error *r_error = nullptr);
+	static Error load_threaded_set_priority(const String &p_path, int p_priority);
+	static Error load_threaded_cancel(const String &p_path);
+	static bool load_threaded_get_metrics(const String &p_path, ThreadLoadMetrics &r_metrics);
 
 	static bool is_within_load() { return load_nesting > 0; };
 
@@ -31,6 +31,16 @@
 #ifndef BVH_ABB_H
 #define BVH_ABB_H
 
+#ifndef REAL_T_IS_DOUBLE
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BVH_ABB_SIMD_SSE2
+#elif defined(__ARM_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+#include <arm_neon.h>
+#define BVH_ABB_SIMD_NEON
+#endif
+#endif
+
 // special optimized version of axis aligned bounding box
 template <typename BOUNDS = AABB, typename POINT = Vector3>
 struct BVH_ABB {
@@ -225,23 +235,11 @@ struct BVH_ABB {
 
 	// for pre-swizzled tester (this object)
 	bool intersects_swizzled(const BVH_ABB &p_o) const {
-		if (_any_lessthan(min, p_o.min)) {
-			return false;
-		}
-		if (_any_lessthan(neg_max, p_o.neg_max)) {
-			return false;
-		}
-		return true;
+		return !_any_lessthan_both(*this, p_o);
 	}
 
 	bool is_other_within(const BVH_ABB &p_o) const {
-		if (_any_lessthan(p_o.neg_max, neg_max)) {
-			return false;
-		}
-		if (_any_lessthan(p_o.min, min)) {
-			return false;
-		}
-		return true;
+		return !_any_lessthan_both(p_o, *this);
 	}
 
 	void grow(const POINT &p_change) {
@@ -287,6 +285,32 @@ struct BVH_ABB {
 		}
 		return false;
 	}
+
+	// Same as _any_lessthan() on both min and neg_max, but tests all the axes at once
+	// when the extents are packed floats. Used by the hot loops in culling.
+	static bool _any_lessthan_both(const BVH_ABB &p_a, const BVH_ABB &p_b) {
+#if defined(BVH_ABB_SIMD_SSE2) || defined(BVH_ABB_SIMD_NEON)
+		if constexpr (sizeof(BVH_ABB) == sizeof(float) * 2 * POINT::AXIS_COUNT && (POINT::AXIS_COUNT == 2 || POINT::AXIS_COUNT == 3)) {
+			const float *a = reinterpret_cast<const float *>(&p_a);
+			const float *b = reinterpret_cast<const float *>(&p_b);
+#ifdef BVH_ABB_SIMD_SSE2
+			__m128 lt = _mm_cmplt_ps(_mm_loadu_ps(a), _mm_loadu_ps(b));
+			if constexpr (POINT::AXIS_COUNT == 3) {
+				// 6 floats, the middle two lanes are tested twice.
+				lt = _mm_or_ps(lt, _mm_cmplt_ps(_mm_loadu_ps(a + 2), _mm_loadu_ps(b + 2)));
+			}
+			return _mm_movemask_ps(lt) != 0;
+#else
+			uint32x4_t lt = vcltq_f32(vld1q_f32(a), vld1q_f32(b));
+			if constexpr (POINT::AXIS_COUNT == 3) {
+				lt = vorrq_u32(lt, vcltq_f32(vld1q_f32(a + 2), vld1q_f32(b + 2)));
+			}
+			return vmaxvq_u32(lt) != 0;
+#endif
+		}
+#endif
+		return p_a._any_lessthan(p_a.min, p_b.min) || p_a._any_lessthan(p_a.neg_max, p_b.neg_max);
+	}
 };
 
 #endif // BVH_ABB_H
@@ -43,6 +43,7 @@
 #include "core/math/bvh_abb.h"
 #include "core/math/geometry_3d.h"
 #include "core/math/vector3.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/pooled_list.h"
 #include <limits.h>
@@ -84,6 +85,12 @@ struct BVHCommon {
 	// or use zero for invalid and +1 based indices.
 	static const uint32_t INVALID = (0xffffffff);
 	static const uint32_t INACTIVE = (0xfffffffe);
+
+	// refits with fewer dirty leaves than this run on the calling thread,
+	// as waiting on the pool costs more than refitting a few branches
+	static const uint32_t REFIT_PARALLEL_MIN_DIRTY_LEAVES = 64;
+	// large trees are split into up to 2^depth subtrees for refitting in parallel
+	static const int REFIT_PARALLEL_DEPTH = 4;
 };
 
 // really a handle, can be anything
@@ -155,7 +162,7 @@ public:
 template <typename T>
 class BVH_DummyPairTestFunction {
 public:
-	static bool user_collision_check(T *p_a, T *p_b) {
+	static bool user_pair_check(const T *p_a, const T *p_b) {
 		// return false if no collision, decided by masks etc
 		return true;
 	}
@@ -164,7 +171,7 @@ public:
 template <typename T>
 class BVH_DummyCullTestFunction {
 public:
-	static bool user_cull_check(T *p_a, T *p_b) {
+	static bool user_cull_check(const T *p_a, const T *p_b) {
 		// return false if no collision
 		return true;
 	}
@@ -362,8 +369,9 @@ private:
 			// only have to refit if it is an edge item
 			// This is a VERY EXPENSIVE STEP
 			// we defer the refit updates until the update function is called once per frame
-			if (refit) {
+			if (refit && !leaf.is_dirty()) {
 				leaf.set_dirty(true);
+				_refit_dirty_leaf_count++;
 			}
 		} else {
 			// remove node if empty
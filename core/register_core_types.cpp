@@ -309,6 +309,7 @@ void register_core_settings() {
 
 	GLOBAL_DEF("threading/worker_pool/max_threads", -1);
 	GLOBAL_DEF("threading/worker_pool/low_priority_thread_ratio", 0.3);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "threading/resource_loading/max_concurrent_requests", PROPERTY_HINT_RANGE, "0,64,1,or_greater"), 0);
 }
 
 void register_core_singletons() {
@@ -33,9 +33,57 @@
 #include "core/config/project_settings.h"
 #include "core/os/os.h"
 
+void CommandQueueMT::_add_chunk(uint32_t p_min_size) {
+	const uint32_t chunk_size = DEFAULT_COMMAND_MEM_SIZE_KB * 1024;
+
+	CommandChunk *chunk = nullptr;
+	if (free_chunks && p_min_size <= chunk_size) {
+		chunk = free_chunks;
+		free_chunks = chunk->next;
+		free_chunk_count--;
+	} else {
+		const uint32_t capacity = MAX(chunk_size, p_min_size);
+		chunk = memnew_placement(memalloc(sizeof(CommandChunk) + capacity), CommandChunk);
+		chunk->capacity = capacity;
+	}
+
+	chunk->next = nullptr;
+	chunk->used = 0;
+
+	if (write_chunk) {
+		write_chunk->next = chunk;
+	} else {
+		read_chunk = chunk;
+	}
+	write_chunk = chunk;
+}
+
+void CommandQueueMT::_release_chunk(CommandChunk *p_chunk) {
+	// Keep a few around for bursts, oversized ones are never reused.
+	if (free_chunk_count < MAX_FREE_CHUNKS && p_chunk->capacity == DEFAULT_COMMAND_MEM_SIZE_KB * 1024) {
+		p_chunk->next = free_chunks;
+		free_chunks = p_chunk;
+		free_chunk_count++;
+	} else {
+		memfree(p_chunk);
+	}
+}
+
 CommandQueueMT::CommandQueueMT() {
-	command_mem.reserve(DEFAULT_COMMAND_MEM_SIZE_KB * 1024);
+	_add_chunk(0);
 }
 
 CommandQueueMT::~CommandQueueMT() {
+	CommandChunk *chunk = read_chunk;
+	while (chunk) {
+		CommandChunk *next = chunk->next;
+		memfree(chunk);
+		chunk = next;
+	}
+	chunk = free_chunks;
+	while (chunk) {
+		CommandChunk *next = chunk->next;
+		memfree(chunk);
+		chunk = next;
+	}
 }
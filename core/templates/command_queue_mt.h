@@ -36,7 +36,7 @@
 #include "core/os/memory.h"
 #include "core/os/mutex.h"
 #include "core/string/print_string.h"
-#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/simple_type.h"
 #include "core/typedefs.h"
 
@@ -326,24 +326,50 @@ class CommandQueueMT {
 	/***** BASE *******/
 
 	static const uint32_t DEFAULT_COMMAND_MEM_SIZE_KB = 64;
+	static const uint32_t MAX_FREE_CHUNKS = 4;
+
+	// Commands are stored in a linked list of chunks. Chunks never move once allocated, so the
+	// consumer can run the commands it has seen without holding the mutex while more are pushed.
+	struct CommandChunk {
+		CommandChunk *next = nullptr;
+		uint32_t capacity = 0;
+		uint32_t used = 0; // Guarded by the mutex.
+
+		_FORCE_INLINE_ uint8_t *get_data() { return reinterpret_cast<uint8_t *>(this + 1); }
+	};
+	static_assert(sizeof(CommandChunk) % 8 == 0);
 
 	BinaryMutex mutex;
-	LocalVector<uint8_t> command_mem;
+	CommandChunk *read_chunk = nullptr;
+	CommandChunk *write_chunk = nullptr;
+	CommandChunk *free_chunks = nullptr;
+	uint32_t free_chunk_count = 0;
+	uint32_t read_offset = 0;
+	bool flushing = false;
+	SafeFlag pending;
 	ConditionVariable sync_cond_var;
 	uint32_t sync_head = 0;
 	uint32_t sync_tail = 0;
 	uint32_t sync_awaiters = 0;
 	WorkerThreadPool::TaskID pump_task_id = WorkerThreadPool::INVALID_TASK_ID;
-	uint64_t flush_read_ptr = 0;
+
+	void _add_chunk(uint32_t p_min_size);
+	void _release_chunk(CommandChunk *p_chunk);
 
 	template <typename T>
 	T *allocate() {
 		// alloc size is size+T+safeguard
 		uint32_t alloc_size = ((sizeof(T) + 8 - 1) & ~(8 - 1));
-		uint64_t size = command_mem.size();
-		command_mem.resize(size + alloc_size + 8);
-		*(uint64_t *)&command_mem[size] = alloc_size;
-		T *cmd = memnew_placement(&command_mem[size + 8], T);
+		uint32_t total_size = alloc_size + 8;
+		if (unlikely(write_chunk->used + total_size > write_chunk->capacity)) {
+			_add_chunk(total_size);
+		}
+		uint8_t *ptr = write_chunk->get_data() + write_chunk->used;
+		*(uint64_t *)ptr = alloc_size;
+		T *cmd = memnew_placement(ptr + 8, T);
+		// Not visible to the consumer until the mutex is released.
+		write_chunk->used += total_size;
+		pending.set();
 		return cmd;
 	}
 
@@ -357,42 +383,59 @@ class CommandQueueMT {
 	}
 
 	void _flush() {
-		if (unlikely(flush_read_ptr)) {
+		if (unlikely(flushing)) {
 			// Re-entrant call.
 			return;
 		}
+		flushing = true;
+
+		mutex.lock();
+
+		while (true) {
+			CommandChunk *chunk = read_chunk;
+			const uint32_t end = chunk->used;
+
+			if (read_offset == end) {
+				if (chunk == write_chunk) {
+					// All consumed, start over from the beginning of the chunk.
+					chunk->used = 0;
+					read_offset = 0;
+					pending.clear();
+					break;
+				}
+				read_chunk = chunk->next;
+				read_offset = 0;
+				_release_chunk(chunk);
+				continue;
+			}
 
-		MutexLock lock(mutex);
+			// Commands up to the end are fully written, producers only append past it.
+			mutex.unlock();
 
-		while (flush_read_ptr < command_mem.size()) {
-			uint64_t size = *(uint64_t *)&command_mem[flush_read_ptr];
-			flush_read_ptr += 8;
-			CommandBase *cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
-			uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(lock);
-			cmd->call();
-			WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
-
-			// Handle potential realloc due to the command and unlock allowance.
-			cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
-
-			if (unlikely(cmd->sync)) {
-				sync_head++;
-				lock.~MutexLock(); // Give an opportunity to awaiters right away.
-				sync_cond_var.notify_all();
-				new (&lock) MutexLock(mutex);
-				// Handle potential realloc happened during unlock.
-				cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
-			}
+			uint8_t *data = chunk->get_data();
+			while (read_offset < end) {
+				uint64_t size = *(uint64_t *)&data[read_offset];
+				CommandBase *cmd = reinterpret_cast<CommandBase *>(&data[read_offset + 8]);
+				cmd->call();
 
-			cmd->~CommandBase();
+				if (unlikely(cmd->sync)) {
+					mutex.lock();
+					sync_head++;
+					mutex.unlock();
+					sync_cond_var.notify_all();
+				}
 
-			flush_read_ptr += size;
-		}
+				cmd->~CommandBase();
+				read_offset += size + 8;
+			}
 
-		command_mem.clear();
-		flush_read_ptr = 0;
+			mutex.lock();
+		}
 
 		_prevent_sync_wraparound();
+		mutex.unlock();
+
+		flushing = false;
 	}
 
 	_FORCE_INLINE_ void _wait_for_sync(MutexLock<BinaryMutex> &p_lock) {
@@ -421,7 +464,7 @@ public:
 	SPACE_SEP_LIST(DECL_PUSH_AND_SYNC, 15)
 
 	_FORCE_INLINE_ void flush_if_pending() {
-		if (unlikely(command_mem.size() > 0)) {
+		if (unlikely(pending.is_set())) {
 			_flush();
 		}
 	}
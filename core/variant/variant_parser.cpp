@@ -36,6 +36,7 @@
 #include "core/object/script_language.h"
 #include "core/os/keyboard.h"
 #include "core/string/string_buffer.h"
+#include "core/templates/local_vector.h"
 
 char32_t VariantParser::Stream::get_char() {
 	// is within buffer?
@@ -157,6 +158,72 @@ static double stor_fix(const String &p_str) {
 	return -1;
 }
 
+// Reads a number starting with p_first into r_num, returns the first character after it.
+static char32_t _scan_number(VariantParser::Stream *p_stream, char32_t p_first, StringBuffer<> &r_num, bool &r_is_float) {
+#define READING_SIGN 0
+#define READING_INT 1
+#define READING_DEC 2
+#define READING_EXP 3
+#define READING_DONE 4
+	int reading = READING_INT;
+
+	char32_t c = p_first;
+	if (c == '-') {
+		r_num += '-';
+		c = p_stream->get_char();
+	}
+
+	bool exp_sign = false;
+	bool exp_beg = false;
+
+	while (true) {
+		switch (reading) {
+			case READING_INT: {
+				if (is_digit(c)) {
+					//pass
+				} else if (c == '.') {
+					reading = READING_DEC;
+					r_is_float = true;
+				} else if (c == 'e') {
+					reading = READING_EXP;
+					r_is_float = true;
+				} else {
+					reading = READING_DONE;
+				}
+
+			} break;
+			case READING_DEC: {
+				if (is_digit(c)) {
+				} else if (c == 'e') {
+					reading = READING_EXP;
+				} else {
+					reading = READING_DONE;
+				}
+
+			} break;
+			case READING_EXP: {
+				if (is_digit(c)) {
+					exp_beg = true;
+
+				} else if ((c == '-' || c == '+') && !exp_sign && !exp_beg) {
+					exp_sign = true;
+
+				} else {
+					reading = READING_DONE;
+				}
+			} break;
+		}
+
+		if (reading == READING_DONE) {
+			break;
+		}
+		r_num += c;
+		c = p_stream->get_char();
+	}
+
+	return c;
+}
+
 Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, String &r_err_str) {
 	bool string_name = false;
 
@@ -273,7 +340,10 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 				[[fallthrough]];
 			}
 			case '"': {
-				String str;
+				// UTF-8 streams provide bytes, collect them as such and decode once at the end.
+				const bool utf8 = p_stream->is_utf8();
+				LocalVector<char> utf8_str;
+				StringBuffer<> str_buf;
 				char32_t prev = 0;
 				while (true) {
 					char32_t ch = p_stream->get_char();
@@ -376,7 +446,15 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 							r_token.type = TK_ERROR;
 							return ERR_PARSE_ERROR;
 						}
-						str += res;
+						if (utf8) {
+							if (res > 0xff) {
+								print_error(vformat("Unicode parsing error: Invalid unicode codepoint (%x), cannot represent as ASCII/Latin-1", (uint32_t)res));
+								res = 0x20;
+							}
+							utf8_str.push_back(res);
+						} else {
+							str_buf += res;
+						}
 					} else {
 						if (prev != 0) {
 							r_err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
@@ -386,7 +464,11 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 						if (ch == '\n') {
 							line++;
 						}
-						str += ch;
+						if (utf8) {
+							utf8_str.push_back(ch);
+						} else {
+							str_buf += ch;
+						}
 					}
 				}
 				if (prev != 0) {
@@ -395,8 +477,12 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 					return ERR_PARSE_ERROR;
 				}
 
-				if (p_stream->is_utf8()) {
-					str.parse_utf8(str.ascii(true).get_data());
+				String str;
+				if (utf8) {
+					utf8_str.push_back(0);
+					str.parse_utf8(utf8_str.ptr());
+				} else {
+					str = str_buf.as_string();
 				}
 				if (string_name) {
 					r_token.type = TK_STRING_NAME;
@@ -417,68 +503,8 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 					//a number
 
 					StringBuffer<> num;
-#define READING_SIGN 0
-#define READING_INT 1
-#define READING_DEC 2
-#define READING_EXP 3
-#define READING_DONE 4
-					int reading = READING_INT;
-
-					if (cchar == '-') {
-						num += '-';
-						cchar = p_stream->get_char();
-					}
-
-					char32_t c = cchar;
-					bool exp_sign = false;
-					bool exp_beg = false;
 					bool is_float = false;
-
-					while (true) {
-						switch (reading) {
-							case READING_INT: {
-								if (is_digit(c)) {
-									//pass
-								} else if (c == '.') {
-									reading = READING_DEC;
-									is_float = true;
-								} else if (c == 'e') {
-									reading = READING_EXP;
-									is_float = true;
-								} else {
-									reading = READING_DONE;
-								}
-
-							} break;
-							case READING_DEC: {
-								if (is_digit(c)) {
-								} else if (c == 'e') {
-									reading = READING_EXP;
-								} else {
-									reading = READING_DONE;
-								}
-
-							} break;
-							case READING_EXP: {
-								if (is_digit(c)) {
-									exp_beg = true;
-
-								} else if ((c == '-' || c == '+') && !exp_sign && !exp_beg) {
-									exp_sign = true;
-
-								} else {
-									reading = READING_DONE;
-								}
-							} break;
-						}
-
-						if (reading == READING_DONE) {
-							break;
-						}
-						num += c;
-						c = p_stream->get_char();
-					}
-
+					char32_t c = _scan_number(p_stream, cchar, num, is_float);
 					p_stream->saved = c;
 
 					r_token.type = TK_NUMBER;
@@ -547,6 +573,28 @@ Error VariantParser::_parse_enginecfg(Stream *p_stream, Vector<String> &strings,
 	}
 }
 
+// Returns the next character that is not a blank, counting lines. Returns 0 on EOF.
+static char32_t _skip_blanks(VariantParser::Stream *p_stream, int &line) {
+	while (true) {
+		char32_t c;
+		if (p_stream->saved) {
+			c = p_stream->saved;
+			p_stream->saved = 0;
+		} else {
+			c = p_stream->get_char();
+			if (p_stream->is_eof()) {
+				return 0;
+			}
+		}
+
+		if (c == '\n') {
+			line++;
+		} else if (c == 0 || c > 32) {
+			return c;
+		}
+	}
+}
+
 template <typename T>
 Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct, int &line, String &r_err_str) {
 	Token token;
@@ -556,20 +604,50 @@ Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct,
 		return ERR_PARSE_ERROR;
 	}
 
+	// Plain numbers and separators, which make up nearly all of large packed arrays, are scanned
+	// directly without going through tokens. Anything else (comments, inf, nan) takes the token path.
 	bool first = true;
 	while (true) {
 		if (!first) {
-			get_token(p_stream, token, line, r_err_str);
-			if (token.type == TK_COMMA) {
+			char32_t c = _skip_blanks(p_stream, line);
+			if (c == ',') {
 				//do none
-			} else if (token.type == TK_PARENTHESIS_CLOSE) {
+			} else if (c == ')') {
 				break;
 			} else {
-				r_err_str = "Expected ',' or ')' in constructor";
-				return ERR_PARSE_ERROR;
+				if (c == 0) {
+					token.type = TK_EOF;
+				} else {
+					p_stream->saved = c;
+					get_token(p_stream, token, line, r_err_str);
+				}
+				if (token.type == TK_COMMA) {
+					//do none
+				} else if (token.type == TK_PARENTHESIS_CLOSE) {
+					break;
+				} else {
+					r_err_str = "Expected ',' or ')' in constructor";
+					return ERR_PARSE_ERROR;
+				}
 			}
 		}
-		get_token(p_stream, token, line, r_err_str);
+
+		char32_t c = _skip_blanks(p_stream, line);
+		if (c == '-' || is_digit(c)) {
+			StringBuffer<> num;
+			bool is_float = false;
+			p_stream->saved = _scan_number(p_stream, c, num, is_float);
+			r_construct.push_back(is_float ? T(num.as_double()) : T(num.as_int()));
+			first = false;
+			continue;
+		}
+
+		if (c == 0) {
+			token.type = TK_EOF;
+		} else {
+			p_stream->saved = c;
+			get_token(p_stream, token, line, r_err_str);
+		}
 
 		if (first && token.type == TK_PARENTHESIS_CLOSE) {
 			break;
@@ -1248,17 +1326,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				return err;
 			}
 
-			Vector<int32_t> arr;
-			{
-				int32_t len = args.size();
-				arr.resize(len);
-				int32_t *w = arr.ptrw();
-				for (int32_t i = 0; i < len; i++) {
-					w[i] = int32_t(args[i]);
-				}
-			}
-
-			value = arr;
+			value = args;
 		} else if (id == "PackedInt64Array") {
 			Vector<int64_t> args;
 			Error err = _parse_construct<int64_t>(p_stream, args, line, r_err_str);
@@ -1266,17 +1334,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				return err;
 			}
 
-			Vector<int64_t> arr;
-			{
-				int64_t len = args.size();
-				arr.resize(len);
-				int64_t *w = arr.ptrw();
-				for (int64_t i = 0; i < len; i++) {
-					w[i] = int64_t(args[i]);
-				}
-			}
-
-			value = arr;
+			value = args;
 		} else if (id == "PackedFloat32Array" || id == "PackedRealArray" || id == "PoolRealArray" || id == "FloatArray") {
 			Vector<float> args;
 			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
@@ -1284,17 +1342,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				return err;
 			}
 
-			Vector<float> arr;
-			{
-				int len = args.size();
-				arr.resize(len);
-				float *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = args[i];
-				}
-			}
-
-			value = arr;
+			value = args;
 		} else if (id == "PackedFloat64Array") {
 			Vector<double> args;
 			Error err = _parse_construct<double>(p_stream, args, line, r_err_str);
@@ -1302,17 +1350,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				return err;
 			}
 
-			Vector<double> arr;
-			{
-				int len = args.size();
-				arr.resize(len);
-				double *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = args[i];
-				}
-			}
-
-			value = arr;
+			value = args;
 		} else if (id == "PackedStringArray" || id == "PoolStringArray" || id == "StringArray") {
 			get_token(p_stream, token, line, r_err_str);
 			if (token.type != TK_PARENTHESIS_OPEN) {
@@ -1972,6 +1972,50 @@ void MeshStorage::multimesh_set_buffer(RID p_multimesh, const Vector<float> &p_b
 	}
 }
 
+void MeshStorage::multimesh_set_buffer_range(RID p_multimesh, int p_first_instance, const Vector<float> &p_buffer) {
+	MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+	ERR_FAIL_NULL(multimesh);
+
+	// The buffer uses the unpacked layout, colors and custom data are packed into half floats here.
+	uint32_t xform_stride = multimesh->xform_format == RS::MULTIMESH_TRANSFORM_2D ? 8 : 12;
+	uint32_t old_stride = xform_stride;
+	old_stride += multimesh->uses_colors ? 4 : 0;
+	old_stride += multimesh->uses_custom_data ? 4 : 0;
+	ERR_FAIL_COND(p_buffer.size() % old_stride != 0);
+	int count = p_buffer.size() / old_stride;
+	ERR_FAIL_COND(p_first_instance < 0 || p_first_instance + count > multimesh->instances);
+	if (count == 0) {
+		return;
+	}
+
+	// Write through the data cache, so only the dirty regions covering the range get uploaded.
+	_multimesh_make_local(multimesh);
+
+	const float *r = p_buffer.ptr();
+	float *w = multimesh->data_cache.ptrw();
+	for (int i = 0; i < count; i++) {
+		const float *dataptr = r + i * old_stride;
+		float *newptr = w + (p_first_instance + i) * multimesh->stride_cache;
+		memcpy(newptr, dataptr, xform_stride * sizeof(float));
+
+		if (multimesh->uses_colors) {
+			const float *color = dataptr + xform_stride;
+			uint16_t val[4] = { Math::make_half_float(color[0]), Math::make_half_float(color[1]), Math::make_half_float(color[2]), Math::make_half_float(color[3]) };
+			memcpy(newptr + multimesh->color_offset_cache, val, 2 * 4);
+		}
+		if (multimesh->uses_custom_data) {
+			const float *custom_data = dataptr + xform_stride + (multimesh->uses_colors ? 4 : 0);
+			uint16_t val[4] = { Math::make_half_float(custom_data[0]), Math::make_half_float(custom_data[1]), Math::make_half_float(custom_data[2]), Math::make_half_float(custom_data[3]) };
+			memcpy(newptr + multimesh->custom_data_offset_cache, val, 2 * 4);
+		}
+	}
+
+	uint32_t last_region = (p_first_instance + count - 1) / MULTIMESH_DIRTY_REGION_SIZE;
+	for (uint32_t region = p_first_instance / MULTIMESH_DIRTY_REGION_SIZE; region <= last_region; region++) {
+		_multimesh_mark_dirty(multimesh, region * MULTIMESH_DIRTY_REGION_SIZE, true);
+	}
+}
+
 Vector<float> MeshStorage::multimesh_get_buffer(RID p_multimesh) const {
 	MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
 	ERR_FAIL_NULL_V(multimesh, Vector<float>());
@@ -2087,22 +2131,38 @@ void MeshStorage::_update_dirty_multimeshes() {
 
 				GLint region_size = multimesh->stride_cache * MULTIMESH_DIRTY_REGION_SIZE * sizeof(float);
 
-				if (multimesh->data_cache_used_dirty_regions > 32 || multimesh->data_cache_used_dirty_regions > visible_region_count / 2) {
+				// Adjacent dirty regions are uploaded together, so count the runs of them.
+				uint32_t dirty_runs = 0;
+				for (uint32_t i = 0; i < visible_region_count; i++) {
+					if (multimesh->data_cache_dirty_regions[i] && (i == 0 || !multimesh->data_cache_dirty_regions[i - 1])) {
+						dirty_runs++;
+					}
+				}
+
+				if (dirty_runs > 32 || multimesh->data_cache_used_dirty_regions > visible_region_count / 2) {
 					// If there too many dirty regions, or represent the majority of regions, just copy all, else transfer cost piles up too much
 					glBindBuffer(GL_ARRAY_BUFFER, multimesh->buffer);
 					glBufferSubData(GL_ARRAY_BUFFER, 0, MIN(visible_region_count * region_size, multimesh->instances * multimesh->stride_cache * sizeof(float)), data);
 					glBindBuffer(GL_ARRAY_BUFFER, 0);
 				} else {
-					// Not that many regions? update them all
+					// Not that many runs? update them all
 					// TODO: profile the performance cost on low end
+					GLint size = multimesh->stride_cache * (uint32_t)multimesh->instances * (uint32_t)sizeof(float);
 					glBindBuffer(GL_ARRAY_BUFFER, multimesh->buffer);
-					for (uint32_t i = 0; i < visible_region_count; i++) {
-						if (multimesh->data_cache_dirty_regions[i]) {
-							GLint offset = i * region_size;
-							GLint size = multimesh->stride_cache * (uint32_t)multimesh->instances * (uint32_t)sizeof(float);
-							uint32_t region_start_index = multimesh->stride_cache * MULTIMESH_DIRTY_REGION_SIZE * i;
-							glBufferSubData(GL_ARRAY_BUFFER, offset, MIN(region_size, size - offset), &data[region_start_index]);
+					uint32_t i = 0;
+					while (i < visible_region_count) {
+						if (!multimesh->data_cache_dirty_regions[i]) {
+							i++;
+							continue;
+						}
+						uint32_t run_end = i + 1;
+						while (run_end < visible_region_count && multimesh->data_cache_dirty_regions[run_end]) {
+							run_end++;
 						}
+						GLint offset = i * region_size;
+						uint32_t region_start_index = multimesh->stride_cache * MULTIMESH_DIRTY_REGION_SIZE * i;
+						glBufferSubData(GL_ARRAY_BUFFER, offset, MIN(GLint(run_end - i) * region_size, size - offset), &data[region_start_index]);
+						i = run_end;
 					}
 					glBindBuffer(GL_ARRAY_BUFFER, 0);
 				}
@@ -515,6 +515,7 @@ public:
 	virtual Color multimesh_instance_get_color(RID p_multimesh, int p_index) const override;
 	virtual Color multimesh_instance_get_custom_data(RID p_multimesh, int p_index) const override;
 	virtual void multimesh_set_buffer(RID p_multimesh, const Vector<float> &p_buffer) override;
+	virtual void multimesh_set_buffer_range(RID p_multimesh, int p_first_instance, const Vector<float> &p_buffer) override;
 	virtual Vector<float> multimesh_get_buffer(RID p_multimesh) const override;
 
 	virtual void multimesh_set_visible_instances(RID p_multimesh, int p_visible) override;
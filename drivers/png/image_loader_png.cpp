@@ -38,6 +38,13 @@
 
 Error ImageLoaderPNG::load_image(Ref<Image> p_image, Ref<FileAccess> f, BitField<ImageFormatLoader::LoaderFlags> p_flags, float p_scale) {
 	const uint64_t buffer_size = f->get_length();
+	const uint8_t *mapped = f->get_mapped_ptr();
+	if (mapped && f->get_position() == 0) {
+		// Decode straight from the file contents when they are mapped in memory.
+		f->seek_end();
+		return PNGDriverCommon::png_to_image(mapped, buffer_size, p_flags & FLAG_FORCE_LINEAR, p_image);
+	}
+
 	Vector<uint8_t> file_buffer;
 	Error err = file_buffer.resize(buffer_size);
 	if (err) {
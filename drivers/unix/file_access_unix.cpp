@@ -37,6 +37,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -138,6 +139,12 @@ Error FileAccessUnix::open_internal(const String &p_path, int p_mode_flags) {
 }
 
 void FileAccessUnix::_close() {
+	if (mapped) {
+		munmap(mapped, mapped_size);
+		mapped = nullptr;
+		mapped_size = 0;
+	}
+
 	if (!f) {
 		return;
 	}
@@ -282,6 +289,30 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+const uint8_t *FileAccessUnix::map_contents() {
+	if (mapped) {
+		return mapped;
+	}
+	ERR_FAIL_NULL_V_MSG(f, nullptr, "File must be opened before use.");
+
+	if (flags != READ) {
+		return nullptr;
+	}
+	uint64_t length = get_length();
+	if (length == 0 || length > SIZE_MAX) {
+		return nullptr;
+	}
+
+	void *ptr = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fileno(f), 0);
+	if (ptr == MAP_FAILED) {
+		return nullptr;
+	}
+
+	mapped = (uint8_t *)ptr;
+	mapped_size = length;
+	return mapped;
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
@@ -49,6 +49,9 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	uint8_t *mapped = nullptr;
+	uint64_t mapped_size = 0;
+
 	void _close();
 
 public:
@@ -72,6 +75,8 @@ public:
 	virtual uint32_t get_32() const override;
 	virtual uint64_t get_64() const override;
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *map_contents() override;
+	virtual const uint8_t *get_mapped_ptr() const override { return mapped; }
 
 	virtual Error get_error() const override; ///< get last error
 
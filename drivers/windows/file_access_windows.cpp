@@ -214,6 +214,15 @@ Error FileAccessWindows::open_internal(const String &p_path, int p_mode_flags) {
 }
 
 void FileAccessWindows::_close() {
+	if (mapped) {
+		UnmapViewOfFile(mapped);
+		mapped = nullptr;
+	}
+	if (mapping_handle) {
+		CloseHandle(mapping_handle);
+		mapping_handle = nullptr;
+	}
+
 	if (!f) {
 		return;
 	}
@@ -411,6 +420,39 @@ uint64_t FileAccessWindows::get_buffer(uint8_t *p_dst, uint64_t p_length) const
 	return read;
 }
 
+const uint8_t *FileAccessWindows::map_contents() {
+	if (mapped) {
+		return mapped;
+	}
+	ERR_FAIL_NULL_V(f, nullptr);
+
+	if (flags != READ) {
+		return nullptr;
+	}
+	uint64_t length = get_length();
+	if (length == 0 || length > SIZE_MAX) {
+		return nullptr;
+	}
+
+	HANDLE file = (HANDLE)_get_osfhandle(_fileno(f));
+	if (file == INVALID_HANDLE_VALUE) {
+		return nullptr;
+	}
+	HANDLE file_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!file_mapping) {
+		return nullptr;
+	}
+	void *view = MapViewOfFile(file_mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!view) {
+		CloseHandle(file_mapping);
+		return nullptr;
+	}
+
+	mapping_handle = file_mapping;
+	mapped = (uint8_t *)view;
+	return mapped;
+}
+
 Error FileAccessWindows::get_error() const {
 	return last_error;
 }
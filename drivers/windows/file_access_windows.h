@@ -48,6 +48,9 @@ class FileAccessWindows : public FileAccess {
 	String path_src;
 	String save_path;
 
+	void *mapping_handle = nullptr;
+	uint8_t *mapped = nullptr;
+
 	void _close();
 
 	static HashSet<String> invalid_files;
@@ -74,6 +77,8 @@ public:
 	virtual uint32_t get_32() const override;
 	virtual uint64_t get_64() const override;
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *map_contents() override;
+	virtual const uint8_t *get_mapped_ptr() const override { return mapped; }
 
 	virtual Error get_error() const override; ///< get last error
 
@@ -44,6 +44,7 @@
 #include "editor/editor_paths.h"
 #include "editor/editor_resource_preview.h"
 #include "editor/editor_settings.h"
+#include "editor/import/editor_import_scheduler.h"
 #include "editor/project_settings_editor.h"
 #include "scene/resources/packed_scene.h"
 
@@ -233,7 +234,7 @@ void EditorFileSystem::_first_scan_filesystem() {
 	first_scan_root_dir->full_path = "res://";
 	HashSet<String> existing_class_names;
 
-	nb_files_total = _scan_new_dir(first_scan_root_dir, d);
+	nb_files_total = _scan_new_dir(first_scan_root_dir, d, use_threads);
 
 	// This loads the global class names from the scripts and ensures that even if the
 	// global_script_class_cache.cfg was missing or invalid, the global class names are valid in ScriptServer.
@@ -392,9 +393,10 @@ void EditorFileSystem::_scan_filesystem() {
 		Ref<DirAccess> d = DirAccess::create(DirAccess::ACCESS_RESOURCES);
 		sd = memnew(ScannedDirectory);
 		sd->full_path = "res://";
-		nb_files_total = _scan_new_dir(sd, d);
+		nb_files_total = _scan_new_dir(sd, d, use_threads);
 	}
 
+	_check_scanned_files(sd);
 	_process_file_system(sd, new_filesystem, sp);
 
 	dep_update_list.clear();
@@ -423,6 +425,36 @@ void EditorFileSystem::_save_filesystem_cache() {
 	_save_filesystem_cache(filesystem, f);
 }
 
+void EditorFileSystem::_test_for_reimport_thread(uint32_t p_index, ReimportTest *p_tests) {
+	p_tests[p_index].need_reimport = _test_for_reimport(p_tests[p_index].path, false);
+}
+
+String EditorFileSystem::_get_files_stamp(const Vector<String> &p_files) {
+	// Modification time and size of each file, compared before hashing to skip unchanged files.
+	String stamp;
+	for (const String &file : p_files) {
+		Ref<FileAccess> f = FileAccess::open(file, FileAccess::READ);
+		if (f.is_null()) {
+			return String();
+		}
+		if (!stamp.is_empty()) {
+			stamp += ";";
+		}
+		stamp += itos(FileAccess::get_modified_time(file)) + ":" + itos(f->get_length());
+	}
+	return stamp;
+}
+
+bool EditorFileSystem::_is_md5_outdated(const Vector<String> &p_files, const String &p_md5, const String &p_stamp) {
+	// Only hash when the modification time or size differ from the ones stored at import time.
+	if (!p_stamp.is_empty() && p_stamp == _get_files_stamp(p_files)) {
+		return false;
+	}
+
+	const String md5 = p_files.size() == 1 ? FileAccess::get_md5(p_files[0]) : FileAccess::get_multiple_md5(p_files);
+	return md5 != p_md5;
+}
+
 void EditorFileSystem::_thread_func(void *_userdata) {
 	EditorFileSystem *sd = (EditorFileSystem *)_userdata;
 	sd->_scan_filesystem();
@@ -459,8 +491,10 @@ bool EditorFileSystem::_test_for_reimport(const String &p_path, bool p_only_impo
 	String importer_name;
 	String source_file = "";
 	String source_md5 = "";
+	String source_stamp;
 	Vector<String> dest_files;
 	String dest_md5 = "";
+	String dest_stamp;
 	int version = 0;
 	bool found_uid = false;
 
@@ -559,8 +593,12 @@ bool EditorFileSystem::_test_for_reimport(const String &p_path, bool p_only_impo
 			if (!p_only_imported_files) {
 				if (assign == "source_md5") {
 					source_md5 = value;
+				} else if (assign == "source_stamp") {
+					source_stamp = value;
 				} else if (assign == "dest_md5") {
 					dest_md5 = value;
+				} else if (assign == "dest_stamp") {
+					dest_stamp = value;
 				}
 			}
 		}
@@ -583,16 +621,12 @@ bool EditorFileSystem::_test_for_reimport(const String &p_path, bool p_only_impo
 			return true; //lacks md5, so just reimport
 		}
 
-		String md5 = FileAccess::get_md5(p_path);
-		if (md5 != source_md5) {
+		if (_is_md5_outdated({ p_path }, source_md5, source_stamp)) {
 			return true;
 		}
 
-		if (dest_files.size() && !dest_md5.is_empty()) {
-			md5 = FileAccess::get_multiple_md5(dest_files);
-			if (md5 != dest_md5) {
-				return true;
-			}
+		if (dest_files.size() && !dest_md5.is_empty() && _is_md5_outdated(dest_files, dest_md5, dest_stamp)) {
+			return true;
 		}
 	}
 
@@ -650,6 +684,22 @@ bool EditorFileSystem::_update_scan_actions() {
 	Vector<String> reimports;
 	Vector<String> reloads;
 
+	// Hashing the sources of the files to test is the slow part, so run all the tests in parallel first.
+	LocalVector<ReimportTest> reimport_tests;
+	for (const ItemAction &ia : scan_actions) {
+		if (ia.action == ItemAction::ACTION_FILE_TEST_REIMPORT) {
+			ReimportTest test;
+			test.path = ia.dir->get_path().path_join(ia.file);
+			reimport_tests.push_back(test);
+		}
+	}
+
+	if (!reimport_tests.is_empty()) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &EditorFileSystem::_test_for_reimport_thread, reimport_tests.ptr(), reimport_tests.size(), -1, false, "Scan filesystem");
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	uint32_t reimport_test_idx = 0;
 	for (const ItemAction &ia : scan_actions) {
 		switch (ia.action) {
 			case ItemAction::ACTION_NONE: {
@@ -729,11 +779,12 @@ bool EditorFileSystem::_update_scan_actions() {
 
 			} break;
 			case ItemAction::ACTION_FILE_TEST_REIMPORT: {
+				const ReimportTest &test = reimport_tests[reimport_test_idx++];
 				int idx = ia.dir->find_file_index(ia.file);
 				ERR_CONTINUE(idx == -1);
 				String full_path = ia.dir->get_file_path(idx);
 
-				bool need_reimport = _test_for_reimport(full_path, false);
+				bool need_reimport = test.need_reimport;
 				// Workaround GH-94416 for the Android editor for now.
 				// `import_mt` seems to always be 0 and force a reimport on any fs scan.
 #ifndef ANDROID_ENABLED
@@ -783,6 +834,13 @@ bool EditorFileSystem::_update_scan_actions() {
 		}
 	}
 
+	if (use_watcher && (watcher.is_active() || watcher.start())) {
+		_update_watched_dirs(filesystem);
+		_update_imported_files_watch();
+	} else {
+		use_watcher = false;
+	}
+
 	if (_scan_extensions()) {
 		//needs editor restart
 		//extensions also may provide filetypes to be imported, so they must run before importing
@@ -884,7 +942,7 @@ void EditorFileSystem::ScanProgress::increment() {
 	EditorFileSystem::singleton->scan_total = ratio;
 }
 
-int EditorFileSystem::_scan_new_dir(ScannedDirectory *p_dir, Ref<DirAccess> &da) {
+void EditorFileSystem::_scan_dir_entries(ScannedDirectory *p_dir, Ref<DirAccess> &da) {
 	List<String> dirs;
 	List<String> files;
 
@@ -922,36 +980,122 @@ int EditorFileSystem::_scan_new_dir(ScannedDirectory *p_dir, Ref<DirAccess> &da)
 	dirs.sort_custom<FileNoCaseComparator>();
 	files.sort_custom<FileNoCaseComparator>();
 
-	int nb_files_total_scan = 0;
-
 	for (List<String>::Element *E = dirs.front(); E; E = E->next()) {
 		if (da->change_dir(E->get()) == OK) {
 			String d = da->get_current_dir();
 
-			if (d == cd || !d.begins_with(cd)) {
-				da->change_dir(cd); //avoid recursion
-			} else {
+			if (d != cd && d.begins_with(cd)) { // Avoid recursion.
 				ScannedDirectory *sd = memnew(ScannedDirectory);
 				sd->name = E->get();
 				sd->full_path = p_dir->full_path.path_join(sd->name);
-
-				nb_files_total_scan += _scan_new_dir(sd, da);
-
 				p_dir->subdirs.push_back(sd);
-
-				da->change_dir("..");
 			}
+
+			da->change_dir(cd);
 		} else {
 			ERR_PRINT("Cannot go into subdir '" + E->get() + "'.");
 		}
 	}
 
 	p_dir->files = files;
-	nb_files_total_scan += files.size();
+}
+
+void EditorFileSystem::_scan_dir_thread(void *p_dirs, uint32_t p_index) {
+	ScannedDirectory *sd = static_cast<ScannedDirectory **>(p_dirs)[p_index];
+	Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_RESOURCES);
+	if (da->change_dir(sd->full_path) != OK) {
+		ERR_PRINT("Cannot go into subdir '" + sd->full_path + "'.");
+		return;
+	}
+	_scan_dir_entries(sd, da);
+}
+
+int EditorFileSystem::_scan_new_dir(ScannedDirectory *p_dir, Ref<DirAccess> &da, bool p_use_threads) {
+	_scan_dir_entries(p_dir, da);
+
+	int nb_files_total_scan = p_dir->files.size();
+
+	// Walk the tree one depth level at a time, listing all the directories of a level in parallel.
+	// Each directory only writes to its own ScannedDirectory, so the result matches a sequential walk.
+	LocalVector<ScannedDirectory *> level;
+	for (ScannedDirectory *sd : p_dir->subdirs) {
+		level.push_back(sd);
+	}
+
+	while (!level.is_empty()) {
+		if (p_use_threads && level.size() > 1) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&EditorFileSystem::_scan_dir_thread, level.ptr(), level.size(), -1, false, "Scan filesystem");
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			for (uint32_t i = 0; i < level.size(); i++) {
+				_scan_dir_thread(level.ptr(), i);
+			}
+		}
+
+		LocalVector<ScannedDirectory *> next_level;
+		for (ScannedDirectory *scanned : level) {
+			nb_files_total_scan += scanned->files.size();
+			for (ScannedDirectory *sd : scanned->subdirs) {
+				next_level.push_back(sd);
+			}
+		}
+		level = next_level;
+	}
 
 	return nb_files_total_scan;
 }
 
+void EditorFileSystem::_gather_file_checks(ScannedDirectory *p_scan_dir, LocalVector<ScannedDirectory::FileCheck *> &r_checks) {
+	for (ScannedDirectory *scan_sub_dir : p_scan_dir->subdirs) {
+		_gather_file_checks(scan_sub_dir, r_checks);
+	}
+
+	p_scan_dir->file_checks.resize(p_scan_dir->files.size());
+
+	uint32_t i = 0;
+	for (const String &scan_file : p_scan_dir->files) {
+		ScannedDirectory::FileCheck &check = p_scan_dir->file_checks[i++];
+		String ext = scan_file.get_extension().to_lower();
+		if (!valid_extensions.has(ext)) {
+			continue;
+		}
+
+		check.path = p_scan_dir->full_path.path_join(scan_file);
+		check.imported = import_extensions.has(ext);
+		r_checks.push_back(&check);
+	}
+}
+
+void EditorFileSystem::_file_check_thread(uint32_t p_index, ScannedDirectory::FileCheck **p_checks) {
+	ScannedDirectory::FileCheck *check = p_checks[p_index];
+	check->modified_time = FileAccess::get_modified_time(check->path);
+
+	if (!check->imported) {
+		return;
+	}
+
+	if (FileAccess::exists(check->path + ".import")) {
+		check->import_modified_time = FileAccess::get_modified_time(check->path + ".import");
+	}
+
+	const FileCache *fc = file_cache.getptr(check->path);
+	check->cache_valid = fc && fc->modification_time == check->modified_time && fc->import_modification_time == check->import_modified_time && !_test_for_reimport(check->path, true);
+}
+
+void EditorFileSystem::_check_scanned_files(ScannedDirectory *p_scan_dir) {
+	// Stat every file and validate the .import files of the cached ones in parallel,
+	// file_cache is only read here so it can be shared by all the tasks.
+	LocalVector<ScannedDirectory::FileCheck *> checks;
+	_gather_file_checks(p_scan_dir, checks);
+
+	if (checks.is_empty()) {
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &EditorFileSystem::_file_check_thread, checks.ptr(), checks.size(), -1, false, "Scan filesystem");
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 void EditorFileSystem::_process_file_system(const ScannedDirectory *p_scan_dir, EditorFileSystemDirectory *p_dir, ScanProgress &p_progress) {
 	p_dir->modified_time = FileAccess::get_modified_time(p_scan_dir->full_path);
 
@@ -963,30 +1107,29 @@ void EditorFileSystem::_process_file_system(const ScannedDirectory *p_scan_dir,
 		_process_file_system(scan_sub_dir, sub_dir, p_progress);
 	}
 
+	ERR_FAIL_COND(p_scan_dir->file_checks.size() != (uint32_t)p_scan_dir->files.size());
+
+	uint32_t check_idx = 0;
 	for (const String &scan_file : p_scan_dir->files) {
-		String ext = scan_file.get_extension().to_lower();
-		if (!valid_extensions.has(ext)) {
+		const ScannedDirectory::FileCheck &check = p_scan_dir->file_checks[check_idx++];
+		if (check.path.is_empty()) {
 			p_progress.increment();
 			continue; //invalid
 		}
 
-		String path = p_scan_dir->full_path.path_join(scan_file);
+		String ext = scan_file.get_extension().to_lower();
+		const String &path = check.path;
 
 		EditorFileSystemDirectory::FileInfo *fi = memnew(EditorFileSystemDirectory::FileInfo);
 		fi->file = scan_file;
 		p_dir->files.push_back(fi);
 
 		FileCache *fc = file_cache.getptr(path);
-		uint64_t mt = FileAccess::get_modified_time(path);
+		uint64_t mt = check.modified_time;
 
-		if (import_extensions.has(ext)) {
+		if (check.imported) {
 			//is imported
-			uint64_t import_mt = 0;
-			if (FileAccess::exists(path + ".import")) {
-				import_mt = FileAccess::get_modified_time(path + ".import");
-			}
-
-			if (fc && fc->modification_time == mt && fc->import_modification_time == import_mt && !_test_for_reimport(path, true)) {
+			if (check.cache_valid) {
 				fi->type = fc->type;
 				fi->resource_script_class = fc->resource_script_class;
 				fi->uid = fc->uid;
@@ -1102,7 +1245,68 @@ void EditorFileSystem::_process_file_system(const ScannedDirectory *p_scan_dir,
 	}
 }
 
+void EditorFileSystem::_update_watched_dirs(EditorFileSystemDirectory *p_dir) {
+	String path = p_dir->get_path();
+	if (!watcher.is_watching(path) && !watcher.add_directory(path)) {
+		WARN_PRINT("Cannot watch '" + path + "' for changes (the limit of watched directories may have been reached), falling back to full filesystem scans.");
+		watcher.stop();
+		use_watcher = false;
+		return;
+	}
+
+	for (int i = 0; i < p_dir->get_subdir_count() && use_watcher; i++) {
+		_update_watched_dirs(p_dir->get_subdir(i));
+	}
+}
+
+void EditorFileSystem::_update_imported_files_watch() {
+	if (!use_watcher || watcher.is_watching_imported_files()) {
+		return;
+	}
+
+	const String imported_files_path = ProjectSettings::get_singleton()->get_imported_files_path();
+	if (DirAccess::dir_exists_absolute(imported_files_path) && !watcher.watch_imported_files(imported_files_path)) {
+		WARN_PRINT("Cannot watch '" + imported_files_path + "' for changes (the limit of watched directories may have been reached), falling back to full filesystem scans.");
+		watcher.stop();
+		use_watcher = false;
+	}
+}
+
+void EditorFileSystem::_poll_watched_changes() {
+	changed_dirs.clear();
+	changed_dir_parents.clear();
+
+	scan_changed_dirs_only = use_watcher && watcher.poll_changes(changed_dirs);
+	if (!scan_changed_dirs_only) {
+		return;
+	}
+
+	for (const String &dir : changed_dirs) {
+		String parent = dir;
+		while (parent != "res://") {
+			parent = parent.trim_suffix("/").get_base_dir();
+			if (!parent.ends_with("/")) {
+				parent += "/";
+			}
+			if (changed_dir_parents.has(parent)) {
+				break; // Its parents were added already.
+			}
+			changed_dir_parents.insert(parent);
+		}
+	}
+}
+
 void EditorFileSystem::_scan_fs_changes(EditorFileSystemDirectory *p_dir, ScanProgress &p_progress) {
+	if (scan_changed_dirs_only && !changed_dirs.has(p_dir->get_path())) {
+		// Nothing changed here according to the watcher, only visit the subdirectories with changes.
+		if (changed_dir_parents.has(p_dir->get_path())) {
+			for (int i = 0; i < p_dir->subdirs.size(); i++) {
+				_scan_fs_changes(p_dir->get_subdir(i), p_progress);
+			}
+		}
+		return;
+	}
+
 	uint64_t current_mtime = FileAccess::get_modified_time(p_dir->get_path());
 
 	bool updated_dir = false;
@@ -1166,9 +1370,10 @@ void EditorFileSystem::_scan_fs_changes(EditorFileSystemDirectory *p_dir, ScanPr
 
 					Ref<DirAccess> d = DirAccess::create(DirAccess::ACCESS_RESOURCES);
 					d->change_dir(dir_path);
-					int nb_files_dir = _scan_new_dir(&sd, d);
+					int nb_files_dir = _scan_new_dir(&sd, d, use_threads);
 					p_progress.hi += nb_files_dir;
 					diff_nb_files += nb_files_dir;
+					_check_scanned_files(&sd);
 					_process_file_system(&sd, efd, p_progress);
 
 					ItemAction ia;
@@ -1386,7 +1591,12 @@ String EditorFileSystem::_get_file_by_class_name(EditorFileSystemDirectory *p_di
 	return "";
 }
 
-void EditorFileSystem::scan_changes() {
+void EditorFileSystem::scan_changes(bool p_full_scan) {
+	if (p_full_scan && use_watcher) {
+		// Also check the files in the directories without reported changes, when this has to wait too.
+		watcher.request_full_scan();
+	}
+
 	if (first_scan || // Prevent a premature changes scan from inhibiting the first full scan
 			scanning || scanning_changes || thread.is_started()) {
 		scan_changes_pending = true;
@@ -1395,6 +1605,7 @@ void EditorFileSystem::scan_changes() {
 	}
 
 	_update_extensions();
+	_poll_watched_changes();
 	sources_changed.clear();
 	scanning_changes = true;
 	scanning_changes_done.clear();
@@ -2306,8 +2517,10 @@ Error EditorFileSystem::_reimport_group(const String &p_group_file, const Vector
 			ERR_FAIL_COND_V_MSG(md5s.is_null(), ERR_FILE_CANT_OPEN, "Cannot open MD5 file '" + base_path + ".md5'.");
 
 			md5s->store_line("source_md5=\"" + FileAccess::get_md5(file) + "\"");
+			md5s->store_line("source_stamp=\"" + _get_files_stamp({ file }) + "\"");
 			if (dest_paths.size()) {
-				md5s->store_line("dest_md5=\"" + FileAccess::get_multiple_md5(dest_paths) + "\"\n");
+				md5s->store_line("dest_md5=\"" + FileAccess::get_multiple_md5(dest_paths) + "\"");
+				md5s->store_line("dest_stamp=\"" + _get_files_stamp(dest_paths) + "\"\n");
 			}
 		}
 
@@ -2468,7 +2681,28 @@ Error EditorFileSystem::_reimport_file(const String &p_file, const HashMap<Strin
 	List<String> import_variants;
 	List<String> gen_files;
 	Variant meta;
-	Error err = importer->import(p_file, base_path, params, &import_variants, &gen_files, &meta);
+	Error err = OK;
+
+	const String source_md5 = FileAccess::get_md5(p_file);
+	String cache_key;
+	if (import_cache.is_enabled() && importer->is_import_cacheable(p_file, params)) {
+		cache_key = EditorImportCache::make_key(importer, p_file, source_md5, opts, params);
+	}
+
+	if (cache_key.is_empty() || !import_cache.restore(cache_key, base_path, import_variants, meta)) {
+		err = importer->import(p_file, base_path, params, &import_variants, &gen_files, &meta);
+
+		if (!cache_key.is_empty() && err == OK && gen_files.is_empty() && !importer->get_save_extension().is_empty()) {
+			Vector<String> suffixes;
+			for (const String &E : import_variants) {
+				suffixes.push_back("." + E + "." + importer->get_save_extension());
+			}
+			if (suffixes.is_empty()) {
+				suffixes.push_back("." + importer->get_save_extension());
+			}
+			import_cache.store(cache_key, base_path, suffixes, import_variants, meta);
+		}
+	}
 
 	// As import is complete, save the .import file.
 
@@ -2570,9 +2804,11 @@ Error EditorFileSystem::_reimport_file(const String &p_file, const HashMap<Strin
 		Ref<FileAccess> md5s = FileAccess::open(base_path + ".md5", FileAccess::WRITE);
 		ERR_FAIL_COND_V_MSG(md5s.is_null(), ERR_FILE_CANT_OPEN, "Cannot open MD5 file '" + base_path + ".md5'.");
 
-		md5s->store_line("source_md5=\"" + FileAccess::get_md5(p_file) + "\"");
+		md5s->store_line("source_md5=\"" + source_md5 + "\"");
+		md5s->store_line("source_stamp=\"" + _get_files_stamp({ p_file }) + "\"");
 		if (dest_paths.size()) {
-			md5s->store_line("dest_md5=\"" + FileAccess::get_multiple_md5(dest_paths) + "\"\n");
+			md5s->store_line("dest_md5=\"" + FileAccess::get_multiple_md5(dest_paths) + "\"");
+			md5s->store_line("dest_stamp=\"" + _get_files_stamp(dest_paths) + "\"\n");
 		}
 	}
 
@@ -2642,10 +2878,89 @@ void EditorFileSystem::reimport_file_with_custom_parameters(const String &p_file
 	emit_signal(SNAME("resources_reimported"), reloads);
 }
 
-void EditorFileSystem::_reimport_thread(uint32_t p_index, ImportThreadData *p_import_data) {
-	int current_max = p_import_data->reimport_from + int(p_index);
-	p_import_data->max_index.exchange_if_greater(current_max);
-	_reimport_file(p_import_data->reimport_files[current_max].path);
+void EditorFileSystem::_reimport_thread(void *p_userdata, uint32_t p_index) {
+	ImportThreadData *data = (ImportThreadData *)p_userdata;
+	data->efs->_reimport_file(data->reimport_files[p_index].path);
+}
+
+void EditorFileSystem::_reimport_progress(void *p_userdata, uint32_t p_index, uint32_t p_completed) {
+	ImportThreadData *data = (ImportThreadData *)p_userdata;
+	data->progress->step(data->reimport_files[p_index].path.get_file(), data->progress_from + p_completed);
+}
+
+void EditorFileSystem::_reimport_files_scheduled(const ImportFile *p_files, int p_count, bool p_use_threads, EditorProgress &p_progress, int p_progress_from) {
+	// All these files share the same import order. Each of them waits for the files it depends on,
+	// as declared by its importer or as found after its previous import. Files whose importer can't
+	// run on threads also wait for all the files sorted before them, as they were imported serially.
+	EditorImportScheduler scheduler;
+	HashMap<String, uint32_t> file_tasks;
+	HashSet<String> threaded_importers;
+
+	for (int i = 0; i < p_count; i++) {
+		scheduler.add_task(p_files[i].threaded);
+		file_tasks[p_files[i].path] = i;
+		if (p_use_threads && p_files[i].threaded) {
+			threaded_importers.insert(p_files[i].importer);
+		}
+	}
+
+	int last_serial = -1;
+	for (int i = 0; i < p_count; i++) {
+		const ImportFile &ifile = p_files[i];
+
+		if (!ifile.threaded) {
+			for (int j = MAX(last_serial, 0); j < i; j++) {
+				scheduler.add_dependency(i, j);
+			}
+			last_serial = i;
+		}
+
+		Vector<String> dependencies;
+		Ref<ResourceImporter> importer = ResourceFormatImporter::get_singleton()->get_importer_by_name(ifile.importer);
+		if (importer.is_valid()) {
+			importer->get_import_dependencies(ifile.path, dependencies);
+		}
+
+		EditorFileSystemDirectory *fs = nullptr;
+		int cpos = -1;
+		if (_find_file(ifile.path, &fs, cpos)) {
+			dependencies.append_array(fs->files[cpos]->deps);
+		}
+
+		for (const String &dep : dependencies) {
+			String dependency_path = dep.get_slice("::", 0);
+			if (dependency_path.begins_with("uid://")) {
+				ResourceUID::ID uid = ResourceUID::get_singleton()->text_to_id(dependency_path);
+				dependency_path = ResourceUID::get_singleton()->has_id(uid) ? ResourceUID::get_singleton()->get_id_path(uid) : dep.get_slice("::", 2);
+			}
+
+			HashMap<String, uint32_t>::ConstIterator E = file_tasks.find(dependency_path);
+			if (E) {
+				scheduler.add_dependency(i, E->value);
+			}
+		}
+	}
+
+	for (const String &importer_name : threaded_importers) {
+		Ref<ResourceImporter> importer = ResourceFormatImporter::get_singleton()->get_importer_by_name(importer_name);
+		if (importer.is_valid()) {
+			importer->import_threaded_begin();
+		}
+	}
+
+	ImportThreadData tdata;
+	tdata.efs = this;
+	tdata.reimport_files = p_files;
+	tdata.progress = &p_progress;
+	tdata.progress_from = p_progress_from;
+	scheduler.run(&EditorFileSystem::_reimport_thread, &EditorFileSystem::_reimport_progress, &tdata, p_use_threads);
+
+	for (const String &importer_name : threaded_importers) {
+		Ref<ResourceImporter> importer = ResourceFormatImporter::get_singleton()->get_importer_by_name(importer_name);
+		if (importer.is_valid()) {
+			importer->import_threaded_end();
+		}
+	}
 }
 
 void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
@@ -2709,60 +3024,29 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 	bool use_multiple_threads = false;
 #endif
 
-	int from = 0;
-	for (int i = 0; i < reimport_files.size(); i++) {
-		if (groups_to_reimport.has(reimport_files[i].path)) {
-			from = i + 1;
-			continue;
+	if (EditorSettings::get_singleton()) {
+		String cache_path = EDITOR_GET("filesystem/import/import_cache/path");
+		if (cache_path.is_empty()) {
+			cache_path = EditorPaths::get_singleton()->get_cache_dir().path_join("import_cache");
 		}
+		const uint64_t cache_max_size = uint64_t(int64_t(EDITOR_GET("filesystem/import/import_cache/max_size_mb"))) * 1024 * 1024;
+		import_cache.configure(EDITOR_GET("filesystem/import/import_cache/enabled"), cache_path, cache_max_size);
+	}
+	import_cache.reset_stats();
 
-		if (use_multiple_threads && reimport_files[i].threaded) {
-			if (i + 1 == reimport_files.size() || reimport_files[i + 1].importer != reimport_files[from].importer || groups_to_reimport.has(reimport_files[i + 1].path)) {
-				if (from - i == 0) {
-					// Single file, do not use threads.
-					pr.step(reimport_files[i].path.get_file(), i);
-					_reimport_file(reimport_files[i].path);
-				} else {
-					Ref<ResourceImporter> importer = ResourceFormatImporter::get_singleton()->get_importer_by_name(reimport_files[from].importer);
-					if (importer.is_null()) {
-						ERR_PRINT(vformat("Invalid importer for \"%s\".", reimport_files[from].importer));
-						from = i + 1;
-						continue;
-					}
-
-					importer->import_threaded_begin();
-
-					ImportThreadData tdata;
-					tdata.max_index.set(from);
-					tdata.reimport_from = from;
-					tdata.reimport_files = reimport_files.ptr();
-
-					WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &EditorFileSystem::_reimport_thread, &tdata, i - from + 1, -1, false, vformat(TTR("Import resources of type: %s"), reimport_files[from].importer));
-					int current_index = from - 1;
-					do {
-						if (current_index < tdata.max_index.get()) {
-							current_index = tdata.max_index.get();
-							pr.step(reimport_files[current_index].path.get_file(), current_index);
-						}
-						OS::get_singleton()->delay_usec(1);
-					} while (!WorkerThreadPool::get_singleton()->is_group_task_completed(group_task));
-
-					WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
-
-					importer->import_threaded_end();
-				}
-
-				from = i + 1;
+	// Import the files one import order at a time, lower orders first.
+	int from = 0;
+	while (from < reimport_files.size()) {
+		Vector<ImportFile> order_files;
+		int to = from;
+		for (; to < reimport_files.size() && reimport_files[to].order == reimport_files[from].order; to++) {
+			if (!groups_to_reimport.has(reimport_files[to].path)) {
+				order_files.push_back(reimport_files[to]);
 			}
-
-		} else {
-			pr.step(reimport_files[i].path.get_file(), i);
-			_reimport_file(reimport_files[i].path);
-
-			// We need to increment the counter, maybe the next file is multithreaded
-			// and doesn't have the same importer.
-			from = i + 1;
 		}
+
+		_reimport_files_scheduled(order_files.ptr(), order_files.size(), use_multiple_threads, pr, from);
+		from = to;
 	}
 
 	// Reimport groups.
@@ -2783,6 +3067,13 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 		}
 	}
 
+	if (import_cache.is_enabled()) {
+		print_verbose(vformat("EditorFileSystem: Import cache: %d hits, %d misses (%.1f%% hit rate), %d new entries.", import_cache.get_hit_count(), import_cache.get_miss_count(), import_cache.get_hit_rate() * 100.0, import_cache.get_store_count()));
+		if (import_cache.get_store_count() > 0) {
+			import_cache.trim();
+		}
+	}
+
 	ResourceUID::get_singleton()->update_cache(); // After reimporting, update the cache.
 
 	_save_filesystem_cache();
@@ -2991,12 +3282,17 @@ bool EditorFileSystem::_scan_extensions() {
 	return needs_restart;
 }
 
+void EditorFileSystem::_scan_sources() {
+	// Scripts may call this after changes the watcher can't see, e.g. to the import settings.
+	scan_changes(true);
+}
+
 void EditorFileSystem::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_filesystem"), &EditorFileSystem::get_filesystem);
 	ClassDB::bind_method(D_METHOD("is_scanning"), &EditorFileSystem::is_scanning);
 	ClassDB::bind_method(D_METHOD("get_scanning_progress"), &EditorFileSystem::get_scanning_progress);
 	ClassDB::bind_method(D_METHOD("scan"), &EditorFileSystem::scan);
-	ClassDB::bind_method(D_METHOD("scan_sources"), &EditorFileSystem::scan_changes);
+	ClassDB::bind_method(D_METHOD("scan_sources"), &EditorFileSystem::_scan_sources);
 	ClassDB::bind_method(D_METHOD("update_file", "path"), &EditorFileSystem::update_file);
 	ClassDB::bind_method(D_METHOD("get_filesystem_path", "path"), &EditorFileSystem::get_filesystem_path);
 	ClassDB::bind_method(D_METHOD("get_file_type", "path"), &EditorFileSystem::get_file_type);
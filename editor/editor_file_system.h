@@ -35,11 +35,15 @@
 #include "core/os/thread.h"
 #include "core/os/thread_safe.h"
 #include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/safe_refcount.h"
+#include "editor/editor_file_system_watcher.h"
+#include "editor/import/editor_import_cache.h"
 #include "scene/main/node.h"
 
 class FileAccess;
 
+struct EditorProgress;
 struct EditorProgressBG;
 class EditorFileSystemDirectory : public Object {
 	GDCLASS(EditorFileSystemDirectory, Object);
@@ -142,6 +146,8 @@ class EditorFileSystem : public Node {
 
 	_THREAD_SAFE_CLASS_
 
+	friend class TestEditorFileSystemInternalsAccessor;
+
 	struct ItemAction {
 		enum Action {
 			ACTION_NONE,
@@ -161,10 +167,20 @@ class EditorFileSystem : public Node {
 	};
 
 	struct ScannedDirectory {
+		// Result of the per-file checks done on worker threads before building the filesystem tree.
+		struct FileCheck {
+			String path;
+			bool imported = false;
+			bool cache_valid = false;
+			uint64_t modified_time = 0;
+			uint64_t import_modified_time = 0;
+		};
+
 		String name;
 		String full_path;
 		Vector<ScannedDirectory *> subdirs;
 		List<String> files;
+		LocalVector<FileCheck> file_checks; // Same order as files, filled by _check_scanned_files().
 
 		~ScannedDirectory();
 	};
@@ -229,6 +245,18 @@ class EditorFileSystem : public Node {
 
 	void _scan_fs_changes(EditorFileSystemDirectory *p_dir, ScanProgress &p_progress);
 
+	// Directories reported as changed by the watcher, and their parents. When the
+	// changes are known only these are rescanned by _scan_fs_changes().
+	EditorFileSystemWatcher watcher;
+	bool use_watcher = true;
+	bool scan_changed_dirs_only = false;
+	HashSet<String> changed_dirs;
+	HashSet<String> changed_dir_parents;
+
+	void _update_watched_dirs(EditorFileSystemDirectory *p_dir);
+	void _update_imported_files_watch();
+	void _poll_watched_changes();
+
 	void _delete_internal_files(const String &p_file);
 	int _insert_actions_delete_files_directory(EditorFileSystemDirectory *p_dir);
 
@@ -236,7 +264,12 @@ class EditorFileSystem : public Node {
 	HashSet<String> valid_extensions;
 	HashSet<String> import_extensions;
 
-	int _scan_new_dir(ScannedDirectory *p_dir, Ref<DirAccess> &da);
+	static int _scan_new_dir(ScannedDirectory *p_dir, Ref<DirAccess> &da, bool p_use_threads);
+	static void _scan_dir_entries(ScannedDirectory *p_dir, Ref<DirAccess> &da);
+	static void _scan_dir_thread(void *p_dirs, uint32_t p_index);
+	void _gather_file_checks(ScannedDirectory *p_scan_dir, LocalVector<ScannedDirectory::FileCheck *> &r_checks);
+	void _check_scanned_files(ScannedDirectory *p_scan_dir);
+	void _file_check_thread(uint32_t p_index, ScannedDirectory::FileCheck **p_checks);
 	void _process_file_system(const ScannedDirectory *p_scan_dir, EditorFileSystemDirectory *p_dir, ScanProgress &p_progress);
 
 	Thread thread_sources;
@@ -257,6 +290,15 @@ class EditorFileSystem : public Node {
 
 	bool _test_for_reimport(const String &p_path, bool p_only_imported_files);
 
+	struct ReimportTest {
+		String path;
+		bool need_reimport = false;
+	};
+
+	void _test_for_reimport_thread(uint32_t p_index, ReimportTest *p_tests);
+	static String _get_files_stamp(const Vector<String> &p_files);
+	static bool _is_md5_outdated(const Vector<String> &p_files, const String &p_md5, const String &p_stamp);
+
 	bool reimport_on_missing_imported_files;
 
 	Vector<String> _get_dependencies(const String &p_path);
@@ -307,12 +349,17 @@ class EditorFileSystem : public Node {
 	HashMap<String, String> file_icon_cache;
 
 	struct ImportThreadData {
-		const ImportFile *reimport_files;
-		int reimport_from;
-		SafeNumeric<int> max_index;
+		EditorFileSystem *efs = nullptr;
+		const ImportFile *reimport_files = nullptr;
+		EditorProgress *progress = nullptr;
+		int progress_from = 0;
 	};
 
-	void _reimport_thread(uint32_t p_index, ImportThreadData *p_import_data);
+	EditorImportCache import_cache;
+
+	static void _reimport_thread(void *p_userdata, uint32_t p_index);
+	static void _reimport_progress(void *p_userdata, uint32_t p_index, uint32_t p_completed);
+	void _reimport_files_scheduled(const ImportFile *p_files, int p_count, bool p_use_threads, EditorProgress &p_progress, int p_progress_from);
 
 	static ResourceUID::ID _resource_saver_get_resource_id_for_path(const String &p_path, bool p_generate);
 
@@ -330,6 +377,7 @@ class EditorFileSystem : public Node {
 
 protected:
 	void _notification(int p_what);
+	void _scan_sources();
 	static void _bind_methods();
 
 public:
@@ -341,7 +389,8 @@ public:
 	bool doing_first_scan() const { return first_scan; }
 	float get_scanning_progress() const;
 	void scan();
-	void scan_changes();
+	// With p_full_scan, files in directories without changes reported by the watcher are checked too.
+	void scan_changes(bool p_full_scan = false);
 	void update_file(const String &p_file);
 	void update_files(const Vector<String> &p_script_paths);
 	HashSet<String> get_valid_extensions() const;
@@ -0,0 +1,151 @@
+/**************************************************************************/
+/*  editor_file_system_watcher.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "editor_file_system_watcher.h"
+
+#include "core/config/project_settings.h"
+
+bool EditorFileSystemWatcher::start() {
+	ERR_FAIL_COND_V(dir_watcher.is_valid(), true);
+
+	dir_watcher = Ref<DirWatcher>(DirWatcher::create());
+	if (dir_watcher.is_null()) {
+		return false;
+	}
+
+	// Nothing is known about the changes made before the directories get watched.
+	full_scan_needed = true;
+	return true;
+}
+
+void EditorFileSystemWatcher::stop() {
+	dir_watcher.unref();
+	watched_dirs.clear();
+	watch_ids.clear();
+	pending_dirs.clear();
+	imported_files_watch = -1;
+}
+
+bool EditorFileSystemWatcher::add_directory(const String &p_path) {
+	ERR_FAIL_COND_V(dir_watcher.is_null(), false);
+
+	int id = dir_watcher->add_watch(ProjectSettings::get_singleton()->globalize_path(p_path));
+	if (id == -1) {
+		return false;
+	}
+
+	HashMap<int, String>::Iterator E = watched_dirs.find(id);
+	if (E) {
+		// Already watched under the path it had before being moved.
+		watch_ids.erase(E->value);
+	}
+	watched_dirs[id] = p_path;
+	watch_ids[p_path] = id;
+
+	// It may have changed between being scanned and being watched.
+	pending_dirs.insert(p_path);
+	return true;
+}
+
+bool EditorFileSystemWatcher::watch_imported_files(const String &p_path) {
+	ERR_FAIL_COND_V(dir_watcher.is_null(), false);
+
+	imported_files_watch = dir_watcher->add_watch(ProjectSettings::get_singleton()->globalize_path(p_path));
+	return imported_files_watch != -1;
+}
+
+void EditorFileSystemWatcher::_mark_changed(const String &p_dir, const String &p_name, HashSet<String> &r_changed_dirs) const {
+	r_changed_dirs.insert(p_dir);
+
+	if ((p_name == ".gdignore" || p_name == "project.godot") && p_dir != "res://") {
+		// These decide whether the directory is scanned at all, which is checked from its parent.
+		String parent = p_dir.trim_suffix("/").get_base_dir();
+		if (!parent.ends_with("/")) {
+			parent += "/";
+		}
+		r_changed_dirs.insert(parent);
+	}
+}
+
+bool EditorFileSystemWatcher::poll_changes(HashSet<String> &r_changed_dirs) {
+	if (dir_watcher.is_null()) {
+		return false;
+	}
+
+	events.clear();
+	dir_watcher->poll(events);
+
+	for (const DirWatcher::Event &event : events) {
+		if (event.type == DirWatcher::EVENT_OVERFLOW) {
+			full_scan_needed = true;
+			continue;
+		}
+
+		if (event.watch_id == imported_files_watch) {
+			if (event.type == DirWatcher::EVENT_WATCH_REMOVED) {
+				imported_files_watch = -1;
+				full_scan_needed = true;
+			} else if (event.type == DirWatcher::EVENT_REMOVED) {
+				full_scan_needed = true;
+			}
+			continue;
+		}
+
+		HashMap<int, String>::Iterator E = watched_dirs.find(event.watch_id);
+		if (!E) {
+			continue;
+		}
+
+		if (event.type == DirWatcher::EVENT_WATCH_REMOVED) {
+			// Either removed, and the event for its parent covers it, or moved, and it gets
+			// watched again under its new path after the rescan.
+			watch_ids.erase(E->value);
+			watched_dirs.remove(E);
+			continue;
+		}
+
+		_mark_changed(E->value, event.name, r_changed_dirs);
+	}
+
+	for (const String &dir : pending_dirs) {
+		r_changed_dirs.insert(dir);
+	}
+	pending_dirs.clear();
+
+	if (full_scan_needed) {
+		full_scan_needed = false;
+		return false;
+	}
+	return true;
+}
+
+EditorFileSystemWatcher::~EditorFileSystemWatcher() {
+	stop();
+}
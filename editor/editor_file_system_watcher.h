@@ -0,0 +1,82 @@
+/**************************************************************************/
+/*  editor_file_system_watcher.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef EDITOR_FILE_SYSTEM_WATCHER_H
+#define EDITOR_FILE_SYSTEM_WATCHER_H
+
+#include "core/io/dir_watcher.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+
+// Watches the directories of the project and reports which of them changed, so
+// EditorFileSystem only has to rescan those. On platforms without a DirWatcher
+// start() fails and the full rescan is used instead.
+class EditorFileSystemWatcher {
+	Ref<DirWatcher> dir_watcher;
+	bool full_scan_needed = false;
+
+	HashMap<int, String> watched_dirs; // Watch ID to "res://" directory path.
+	HashMap<String, int> watch_ids;
+	HashSet<String> pending_dirs; // Watched since the last poll.
+	int imported_files_watch = -1;
+	LocalVector<DirWatcher::Event> events;
+
+	void _mark_changed(const String &p_dir, const String &p_name, HashSet<String> &r_changed_dirs) const;
+
+public:
+	static bool is_supported() { return DirWatcher::is_supported(); }
+
+	bool start();
+	void stop();
+	bool is_active() const { return dir_watcher.is_valid(); }
+
+	bool add_directory(const String &p_path);
+	bool is_watching(const String &p_path) const { return watch_ids.has(p_path); }
+	int get_watched_directory_count() const { return watch_ids.size(); }
+
+	// The imported files directory isn't scanned, but when files are removed from it
+	// their sources must be imported again, so this requests a full rescan.
+	bool watch_imported_files(const String &p_path);
+	bool is_watching_imported_files() const { return imported_files_watch != -1; }
+
+	// Makes the next poll_changes() return false, e.g. to check every file again
+	// after the import settings changed.
+	void request_full_scan() { full_scan_needed = true; }
+
+	// Adds the paths of the directories with changes to r_changed_dirs.
+	// Returns false when the changes are unknown (events were lost, watching just
+	// started or a full rescan was requested), in which case a full rescan is needed.
+	bool poll_changes(HashSet<String> &r_changed_dirs);
+
+	~EditorFileSystemWatcher();
+};
+
+#endif // EDITOR_FILE_SYSTEM_WATCHER_H
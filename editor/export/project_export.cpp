@@ -57,7 +57,8 @@
 void ProjectExportTextureFormatError::_on_fix_texture_format_pressed() {
 	ProjectSettings::get_singleton()->set_setting(setting_identifier, true);
 	ProjectSettings::get_singleton()->save();
-	EditorFileSystem::get_singleton()->scan_changes();
+	// Only the import settings changed, every texture has to be checked again.
+	EditorFileSystem::get_singleton()->scan_changes(true);
 	emit_signal("texture_format_enabled");
 }
 
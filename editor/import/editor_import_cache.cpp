@@ -0,0 +1,250 @@
+/**************************************************************************/
+/*  editor_import_cache.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "editor_import_cache.h"
+
+#include "core/io/config_file.h"
+#include "core/io/dir_access.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/variant/variant_parser.h"
+#include "core/version.h"
+
+static void _remove_dir(const String &p_dir) {
+	Ref<DirAccess> da = DirAccess::open(p_dir);
+	if (da.is_valid()) {
+		da->erase_contents_recursive();
+		DirAccess::remove_absolute(p_dir);
+	}
+}
+
+// trim() removes the least recently used entries first. File modification times only have a
+// resolution of seconds, so the time of the last use is stored in the entry.
+static void _mark_used(const String &p_entry_dir) {
+	Ref<FileAccess> used = FileAccess::open(p_entry_dir.path_join("used"), FileAccess::WRITE);
+	if (used.is_valid()) {
+		used->store_double(OS::get_singleton()->get_unix_time());
+	}
+}
+
+static double _get_used_time(const String &p_entry_dir) {
+	Ref<FileAccess> used = FileAccess::open(p_entry_dir.path_join("used"), FileAccess::READ);
+	if (used.is_valid() && used->get_length() == sizeof(double)) {
+		return used->get_double();
+	}
+	return FileAccess::get_modified_time(p_entry_dir.path_join("entry.cfg"));
+}
+
+String EditorImportCache::_get_entry_dir(const String &p_key) const {
+	return path.path_join(p_key.substr(0, 2)).path_join(p_key);
+}
+
+void EditorImportCache::configure(bool p_enabled, const String &p_path, uint64_t p_max_size) {
+	enabled = p_enabled && !p_path.is_empty();
+	path = p_path;
+	max_size = p_max_size;
+}
+
+String EditorImportCache::make_key(const Ref<ResourceImporter> &p_importer, const String &p_source_file, const String &p_source_md5, const List<ResourceImporter::ImportOption> &p_options, const HashMap<StringName, Variant> &p_params) {
+	ERR_FAIL_COND_V(p_importer.is_null(), String());
+
+	String key = p_importer->get_importer_name() + "\n";
+	key += itos(p_importer->get_format_version()) + "\n";
+	key += String(VERSION_FULL_BUILD) + "." + VERSION_HASH + "\n";
+	key += p_importer->get_import_settings_string() + "\n";
+	key += p_importer->get_import_cache_settings_string() + "\n";
+	key += p_source_file.get_extension().to_lower() + "\n";
+	key += p_source_md5 + "\n";
+
+	for (const ResourceImporter::ImportOption &E : p_options) {
+		const Variant *param = p_params.getptr(E.option.name);
+		String value;
+		VariantWriter::write_to_string(param ? *param : E.default_value, value);
+		key += E.option.name + "=" + value + "\n";
+	}
+
+	return key.sha256_text();
+}
+
+bool EditorImportCache::restore(const String &p_key, const String &p_base_path, List<String> &r_variants, Variant &r_metadata) {
+	const String entry_dir = _get_entry_dir(p_key);
+
+	Ref<ConfigFile> entry;
+	entry.instantiate();
+	if (entry->load(entry_dir.path_join("entry.cfg")) != OK) {
+		misses.increment();
+		return false;
+	}
+
+	const Vector<String> files = entry->get_value("entry", "files", Vector<String>());
+	for (const String &suffix : files) {
+		if (DirAccess::copy_absolute(entry_dir.path_join(suffix.trim_prefix(".")), p_base_path + suffix) != OK) {
+			misses.increment();
+			return false;
+		}
+	}
+
+	const Vector<String> variants = entry->get_value("entry", "variants", Vector<String>());
+	for (const String &variant : variants) {
+		r_variants.push_back(variant);
+	}
+	r_metadata = entry->get_value("entry", "metadata", Variant());
+
+	_mark_used(entry_dir);
+
+	hits.increment();
+	return true;
+}
+
+void EditorImportCache::store(const String &p_key, const String &p_base_path, const Vector<String> &p_suffixes, const List<String> &p_variants, const Variant &p_metadata) {
+	const String entry_dir = _get_entry_dir(p_key);
+	if (DirAccess::dir_exists_absolute(entry_dir)) {
+		return; // Stored meanwhile, maybe by another editor sharing the cache.
+	}
+
+	// Fill a temporary directory then rename it, so other editors sharing the cache never see partial entries.
+	const String tmp_dir = path.path_join(vformat("tmp_%s_%d_%d", p_key, OS::get_singleton()->get_process_id(), (uint64_t)Thread::get_caller_id()));
+	ERR_FAIL_COND_MSG(DirAccess::make_dir_recursive_absolute(tmp_dir) != OK, "Cannot create import cache directory '" + tmp_dir + "'.");
+
+	bool ok = true;
+	for (const String &suffix : p_suffixes) {
+		if (DirAccess::copy_absolute(p_base_path + suffix, tmp_dir.path_join(suffix.trim_prefix("."))) != OK) {
+			ok = false;
+			break;
+		}
+	}
+
+	if (ok) {
+		PackedStringArray variants;
+		for (const String &variant : p_variants) {
+			variants.push_back(variant);
+		}
+
+		Ref<ConfigFile> entry;
+		entry.instantiate();
+		entry->set_value("entry", "files", p_suffixes);
+		entry->set_value("entry", "variants", variants);
+		entry->set_value("entry", "metadata", p_metadata);
+		ok = entry->save(tmp_dir.path_join("entry.cfg")) == OK;
+		_mark_used(tmp_dir);
+	}
+
+	if (ok) {
+		DirAccess::make_dir_recursive_absolute(entry_dir.get_base_dir());
+		ok = DirAccess::rename_absolute(tmp_dir, entry_dir) == OK;
+	}
+
+	if (ok) {
+		stores.increment();
+	} else {
+		_remove_dir(tmp_dir);
+	}
+}
+
+void EditorImportCache::trim() {
+	if (!enabled || max_size == 0) {
+		return;
+	}
+
+	struct Entry {
+		String dir;
+		uint64_t size = 0;
+		double used_time = 0.0;
+
+		bool operator<(const Entry &p_entry) const {
+			return used_time < p_entry.used_time;
+		}
+	};
+
+	Ref<DirAccess> root = DirAccess::open(path);
+	if (root.is_null()) {
+		return;
+	}
+
+	LocalVector<Entry> entries;
+	uint64_t total_size = 0;
+
+	for (const String &prefix : root->get_directories()) {
+		if (prefix.length() != 2) {
+			continue; // Temporary directory of an entry being stored.
+		}
+
+		const String prefix_dir = path.path_join(prefix);
+		Ref<DirAccess> prefix_da = DirAccess::open(prefix_dir);
+		if (prefix_da.is_null()) {
+			continue;
+		}
+
+		for (const String &name : prefix_da->get_directories()) {
+			Entry entry;
+			entry.dir = prefix_dir.path_join(name);
+
+			Ref<DirAccess> entry_da = DirAccess::open(entry.dir);
+			if (entry_da.is_null()) {
+				continue;
+			}
+			for (const String &file : entry_da->get_files()) {
+				Ref<FileAccess> f = FileAccess::open(entry.dir.path_join(file), FileAccess::READ);
+				if (f.is_valid()) {
+					entry.size += f->get_length();
+				}
+			}
+
+			entry.used_time = _get_used_time(entry.dir);
+
+			total_size += entry.size;
+			entries.push_back(entry);
+		}
+	}
+
+	if (total_size <= max_size) {
+		return;
+	}
+
+	entries.sort();
+	for (const Entry &entry : entries) {
+		if (total_size <= max_size) {
+			break;
+		}
+		_remove_dir(entry.dir);
+		total_size -= entry.size;
+	}
+}
+
+float EditorImportCache::get_hit_rate() const {
+	const uint32_t lookups = hits.get() + misses.get();
+	return lookups ? float(hits.get()) / lookups : 0.0f;
+}
+
+void EditorImportCache::reset_stats() {
+	hits.set(0);
+	misses.set(0);
+	stores.set(0);
+}
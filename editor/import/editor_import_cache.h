@@ -0,0 +1,73 @@
+/**************************************************************************/
+/*  editor_import_cache.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef EDITOR_IMPORT_CACHE_H
+#define EDITOR_IMPORT_CACHE_H
+
+#include "core/io/resource_importer.h"
+#include "core/templates/safe_refcount.h"
+
+// Content-addressed cache of import results, shared by all the projects using
+// the same cache directory. Entries are keyed by the source file contents, the
+// importer, its options and the engine version, so a hit can be copied in place
+// of running the importer again.
+class EditorImportCache {
+	String path;
+	bool enabled = false;
+	uint64_t max_size = 0;
+
+	SafeNumeric<uint32_t> hits;
+	SafeNumeric<uint32_t> misses;
+	SafeNumeric<uint32_t> stores;
+
+	String _get_entry_dir(const String &p_key) const;
+
+public:
+	void configure(bool p_enabled, const String &p_path, uint64_t p_max_size);
+	bool is_enabled() const { return enabled; }
+	String get_path() const { return path; }
+
+	static String make_key(const Ref<ResourceImporter> &p_importer, const String &p_source_file, const String &p_source_md5, const List<ResourceImporter::ImportOption> &p_options, const HashMap<StringName, Variant> &p_params);
+
+	// Copies the files of the entry to p_base_path followed by their suffix. Returns false on a miss.
+	bool restore(const String &p_key, const String &p_base_path, List<String> &r_variants, Variant &r_metadata);
+	// Adds the files at p_base_path followed by each of p_suffixes as a new entry.
+	void store(const String &p_key, const String &p_base_path, const Vector<String> &p_suffixes, const List<String> &p_variants, const Variant &p_metadata);
+	// Removes the least recently used entries until the cache fits in its maximum size.
+	void trim();
+
+	uint32_t get_hit_count() const { return hits.get(); }
+	uint32_t get_miss_count() const { return misses.get(); }
+	uint32_t get_store_count() const { return stores.get(); }
+	float get_hit_rate() const;
+	void reset_stats();
+};
+
+#endif // EDITOR_IMPORT_CACHE_H
@@ -195,6 +195,13 @@ bool EditorImportPlugin::can_import_threaded() const {
 	}
 }
 
+void EditorImportPlugin::get_import_dependencies(const String &p_path, Vector<String> &r_dependencies) const {
+	Vector<String> dependencies;
+	if (GDVIRTUAL_CALL(_get_import_dependencies, p_path, dependencies)) {
+		r_dependencies.append_array(dependencies);
+	}
+}
+
 Error EditorImportPlugin::_append_import_external_resource(const String &p_file, const Dictionary &p_custom_options, const String &p_custom_importer, Variant p_generator_parameters) {
 	HashMap<StringName, Variant> options;
 	List<Variant> keys;
@@ -223,5 +230,6 @@ void EditorImportPlugin::_bind_methods() {
 	GDVIRTUAL_BIND(_get_option_visibility, "path", "option_name", "options")
 	GDVIRTUAL_BIND(_import, "source_file", "save_path", "options", "platform_variants", "gen_files");
 	GDVIRTUAL_BIND(_can_import_threaded);
+	GDVIRTUAL_BIND(_get_import_dependencies, "path");
 	ClassDB::bind_method(D_METHOD("append_import_external_resource", "path", "custom_options", "custom_importer", "generator_parameters"), &EditorImportPlugin::_append_import_external_resource, DEFVAL(Dictionary()), DEFVAL(String()), DEFVAL(Variant()));
 }
@@ -0,0 +1,153 @@
+/**************************************************************************/
+/*  editor_import_scheduler.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "editor_import_scheduler.h"
+
+#include "core/os/os.h"
+
+uint32_t EditorImportScheduler::add_task(bool p_threaded) {
+	Task task;
+	task.index = tasks.size();
+	task.threaded = p_threaded;
+	tasks.push_back(task);
+	return task.index;
+}
+
+void EditorImportScheduler::add_dependency(uint32_t p_task, uint32_t p_dependency) {
+	ERR_FAIL_UNSIGNED_INDEX(p_task, tasks.size());
+	ERR_FAIL_UNSIGNED_INDEX(p_dependency, tasks.size());
+
+	if (p_task == p_dependency || tasks[p_dependency].dependents.has(p_task)) {
+		return;
+	}
+	tasks[p_dependency].dependents.push_back(p_task);
+	tasks[p_task].pending_dependencies++;
+}
+
+void EditorImportScheduler::_run_task(void *p_task) {
+	Task *task = (Task *)p_task;
+	task->scheduler->import_func(task->scheduler->userdata, task->index);
+}
+
+void EditorImportScheduler::_complete(uint32_t p_index, LocalVector<uint32_t> &r_ready_threaded, LocalVector<uint32_t> &r_ready_serial) {
+	tasks[p_index].done = true;
+
+	for (uint32_t dependent : tasks[p_index].dependents) {
+		Task &task = tasks[dependent];
+		if (task.pending_dependencies > 0 && --task.pending_dependencies == 0) {
+			(task.threaded ? r_ready_threaded : r_ready_serial).push_back(dependent);
+		}
+	}
+}
+
+void EditorImportScheduler::run(ImportFunc p_import_func, ProgressFunc p_progress_func, void *p_userdata, bool p_use_threads) {
+	ERR_FAIL_NULL(p_import_func);
+
+	import_func = p_import_func;
+	userdata = p_userdata;
+
+	LocalVector<uint32_t> ready_threaded;
+	LocalVector<uint32_t> ready_serial;
+	LocalVector<uint32_t> running;
+
+	for (Task &task : tasks) {
+		task.scheduler = this;
+		if (!p_use_threads) {
+			task.threaded = false;
+		}
+		if (task.pending_dependencies == 0) {
+			(task.threaded ? ready_threaded : ready_serial).push_back(task.index);
+		}
+	}
+
+	uint32_t completed = 0;
+	while (completed < tasks.size()) {
+		for (uint32_t index : ready_threaded) {
+			tasks[index].task_id = WorkerThreadPool::get_singleton()->add_native_task(&EditorImportScheduler::_run_task, &tasks[index], false, "Import");
+			running.push_back(index);
+		}
+		ready_threaded.clear();
+
+		bool finished_any = false;
+		for (uint32_t i = 0; i < running.size();) {
+			Task &task = tasks[running[i]];
+			if (!WorkerThreadPool::get_singleton()->is_task_completed(task.task_id)) {
+				i++;
+				continue;
+			}
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(task.task_id);
+			running.remove_at_unordered(i);
+			_complete(task.index, ready_threaded, ready_serial);
+			completed++;
+			finished_any = true;
+			if (p_progress_func) {
+				p_progress_func(p_userdata, task.index, completed);
+			}
+		}
+		if (finished_any) {
+			continue; // Start what they unblocked first.
+		}
+
+		if (!ready_serial.is_empty()) {
+			uint32_t pos = 0;
+			for (uint32_t i = 1; i < ready_serial.size(); i++) {
+				if (ready_serial[i] < ready_serial[pos]) {
+					pos = i;
+				}
+			}
+			uint32_t index = ready_serial[pos];
+			ready_serial.remove_at(pos);
+
+			import_func(p_userdata, index);
+			_complete(index, ready_threaded, ready_serial);
+			completed++;
+			if (p_progress_func) {
+				p_progress_func(p_userdata, index, completed);
+			}
+			continue;
+		}
+
+		if (running.is_empty()) {
+			// Nothing runs and nothing is ready, the remaining tasks depend on each other.
+			// Break the cycle at the first of them, the order is the best guess left.
+			for (Task &task : tasks) {
+				if (!task.done && task.pending_dependencies > 0) {
+					WARN_PRINT("Cyclic import dependencies found, importing the involved files in their default order.");
+					task.pending_dependencies = 0;
+					(task.threaded ? ready_threaded : ready_serial).push_back(task.index);
+					break;
+				}
+			}
+			continue;
+		}
+
+		OS::get_singleton()->delay_usec(1);
+	}
+}
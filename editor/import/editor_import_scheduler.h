@@ -0,0 +1,75 @@
+/**************************************************************************/
+/*  editor_import_scheduler.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef EDITOR_IMPORT_SCHEDULER_H
+#define EDITOR_IMPORT_SCHEDULER_H
+
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
+
+// Runs a set of imports as a dependency graph: each import starts as soon as
+// the imports it depends on are done. Threaded imports run on the
+// WorkerThreadPool, the others one at a time on the calling thread, lowest
+// index first, while the threaded ones keep running.
+class EditorImportScheduler {
+public:
+	typedef void (*ImportFunc)(void *p_userdata, uint32_t p_index);
+	typedef void (*ProgressFunc)(void *p_userdata, uint32_t p_index, uint32_t p_completed);
+
+private:
+	struct Task {
+		EditorImportScheduler *scheduler = nullptr;
+		uint32_t index = 0;
+		bool threaded = false;
+		bool done = false;
+		uint32_t pending_dependencies = 0;
+		LocalVector<uint32_t> dependents;
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
+	};
+
+	LocalVector<Task> tasks;
+	ImportFunc import_func = nullptr;
+	void *userdata = nullptr;
+
+	static void _run_task(void *p_task);
+	void _complete(uint32_t p_index, LocalVector<uint32_t> &r_ready_threaded, LocalVector<uint32_t> &r_ready_serial);
+
+public:
+	uint32_t add_task(bool p_threaded);
+	void add_dependency(uint32_t p_task, uint32_t p_dependency);
+	uint32_t get_task_count() const { return tasks.size(); }
+
+	// Calls p_import_func once for every task and p_progress_func (optional) on the
+	// calling thread after each one is done. When p_use_threads is false, every task
+	// runs on the calling thread.
+	void run(ImportFunc p_import_func, ProgressFunc p_progress_func, void *p_userdata, bool p_use_threads);
+};
+
+#endif // EDITOR_IMPORT_SCHEDULER_H
@@ -719,6 +719,36 @@ Error ResourceImporterTexture::import(const String &p_source_file, const String
 	return OK;
 }
 
+bool ResourceImporterTexture::is_import_cacheable(const String &p_path, const HashMap<StringName, Variant> &p_options) const {
+	// Editor variants depend on the editor scale and theme, which are not part of the options.
+	if (p_options.has("editor/scale_with_editor_scale") && bool(p_options["editor/scale_with_editor_scale"])) {
+		return false;
+	}
+	if (p_options.has("editor/convert_colors_with_editor_theme") && bool(p_options["editor/convert_colors_with_editor_theme"])) {
+		return false;
+	}
+
+	// The roughness limiter reads another source file.
+	const bool mipmaps = p_options.has("mipmaps/generate") && bool(p_options["mipmaps/generate"]);
+	const int roughness = p_options.has("roughness/mode") ? int(p_options["roughness/mode"]) : 0;
+	const String normal_map = p_options.has("roughness/src_normal") ? String(p_options["roughness/src_normal"]) : String();
+	if (mipmaps && roughness > 1 && !normal_map.is_empty()) {
+		return false;
+	}
+
+	return true;
+}
+
+String ResourceImporterTexture::get_import_cache_settings_string() const {
+	// Read when saving lossless and lossy textures, see save_to_ctex_format().
+	String s;
+	s += "force_png=" + String(GLOBAL_GET("rendering/textures/lossless_compression/force_png")) + ";";
+	s += "webp=" + itos(Image::_webp_mem_loader_func != nullptr) + ";";
+	s += "webp_method=" + String(GLOBAL_GET("rendering/textures/webp_compression/compression_method")) + ";";
+	s += "webp_lossless_factor=" + String(GLOBAL_GET("rendering/textures/webp_compression/lossless_compression_factor"));
+	return s;
+}
+
 const char *ResourceImporterTexture::compression_formats[] = {
 	"s3tc_bptc",
 	"etc2_astc",
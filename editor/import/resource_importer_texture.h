@@ -101,6 +101,8 @@ public:
 	virtual bool get_option_visibility(const String &p_path, const String &p_option, const HashMap<StringName, Variant> &p_options) const override;
 
 	virtual Error import(const String &p_source_file, const String &p_save_path, const HashMap<StringName, Variant> &p_options, List<String> *r_platform_variants, List<String> *r_gen_files = nullptr, Variant *r_metadata = nullptr) override;
+	virtual bool is_import_cacheable(const String &p_path, const HashMap<StringName, Variant> &p_options) const override;
+	virtual String get_import_cache_settings_string() const override;
 
 	void update_imports();
 
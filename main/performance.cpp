@@ -49,6 +49,7 @@ Performance *Performance::singleton = nullptr;
 
 void Performance::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_monitor", "monitor"), &Performance::get_monitor);
+	ClassDB::bind_method(D_METHOD("get_physics_3d_space_step_time", "space"), &Performance::get_physics_3d_space_step_time);
 	ClassDB::bind_method(D_METHOD("add_custom_monitor", "id", "callable", "arguments"), &Performance::add_custom_monitor, DEFVAL(Array()));
 	ClassDB::bind_method(D_METHOD("remove_custom_monitor", "id"), &Performance::remove_custom_monitor);
 	ClassDB::bind_method(D_METHOD("has_custom_monitor", "id"), &Performance::has_custom_monitor);
@@ -278,6 +279,14 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 	return types[p_monitor];
 }
 
+double Performance::get_physics_3d_space_step_time(RID p_space) const {
+#ifndef _3D_DISABLED
+	return PhysicsServer3D::get_singleton()->space_get_last_step_time(p_space);
+#else
+	return 0;
+#endif // _3D_DISABLED
+}
+
 void Performance::set_process_time(double p_pt) {
 	_process_time = p_pt;
 }
@@ -114,6 +114,8 @@ public:
 
 	MonitorType get_monitor_type(Monitor p_monitor) const;
 
+	double get_physics_3d_space_step_time(RID p_space) const;
+
 	void set_process_time(double p_pt);
 	void set_physics_process_time(double p_pt);
 	void set_navigation_process_time(double p_pt);
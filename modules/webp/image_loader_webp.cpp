@@ -54,6 +54,14 @@ Error ImageLoaderWebP::load_image(Ref<Image> p_image, Ref<FileAccess> f, BitFiel
 	Vector<uint8_t> src_image;
 	uint64_t src_image_len = f->get_length();
 	ERR_FAIL_COND_V(src_image_len == 0, ERR_FILE_CORRUPT);
+
+	const uint8_t *mapped = f->get_mapped_ptr();
+	if (mapped && f->get_position() == 0) {
+		// Decode straight from the file contents when they are mapped in memory.
+		f->seek_end();
+		return WebPCommon::webp_load_image_from_buffer(p_image.ptr(), mapped, src_image_len);
+	}
+
 	src_image.resize(src_image_len);
 
 	uint8_t *w = src_image.ptrw();
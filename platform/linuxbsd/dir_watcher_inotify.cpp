@@ -0,0 +1,132 @@
+/**************************************************************************/
+/*  dir_watcher_inotify.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#include "dir_watcher_inotify.h"
+
+#ifdef __linux__
+
+#include "core/templates/hash_set.h"
+
+#include <errno.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#define WATCH_MASK (IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO | IN_MOVE_SELF | IN_ONLYDIR)
+
+DirWatcher *DirWatcherInotify::_create_func() {
+	DirWatcherInotify *watcher = memnew(DirWatcherInotify);
+	watcher->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (watcher->fd == -1) {
+		memdelete(watcher);
+		ERR_FAIL_V_MSG(nullptr, "Could not initialize inotify.");
+	}
+	return watcher;
+}
+
+void DirWatcherInotify::make_default() {
+	_create = _create_func;
+}
+
+int DirWatcherInotify::add_watch(const String &p_path) {
+	// Fails when the fs.inotify.max_user_watches limit is reached, among others.
+	return inotify_add_watch(fd, p_path.utf8().get_data(), WATCH_MASK);
+}
+
+void DirWatcherInotify::remove_watch(int p_watch_id) {
+	inotify_rm_watch(fd, p_watch_id);
+}
+
+void DirWatcherInotify::poll(LocalVector<Event> &r_events) {
+	alignas(struct inotify_event) char buffer[16384];
+
+	// Indices and cookies of the moves from a watched directory, to tell renames from moves out of them.
+	LocalVector<uint32_t> moved_from;
+	LocalVector<uint32_t> moved_from_cookies;
+	HashSet<uint32_t> moved_to_cookies;
+
+	while (true) {
+		ssize_t len = read(fd, buffer, sizeof(buffer));
+		if (len == -1 && errno == EINTR) {
+			continue;
+		}
+		if (len <= 0) {
+			break; // EAGAIN, all the pending events were read.
+		}
+
+		for (char *ptr = buffer; ptr < buffer + len;) {
+			const struct inotify_event *event = (const struct inotify_event *)ptr;
+			ptr += sizeof(struct inotify_event) + event->len;
+
+			Event ev;
+			ev.watch_id = event->wd;
+			if (event->len) {
+				ev.name = String::utf8(event->name);
+			}
+
+			if (event->mask & IN_Q_OVERFLOW) {
+				ev.type = EVENT_OVERFLOW;
+			} else if (event->mask & IN_IGNORED) {
+				ev.type = EVENT_WATCH_REMOVED;
+			} else if (event->mask & IN_MOVE_SELF) {
+				// The directory is watched under a path that is stale now.
+				inotify_rm_watch(fd, event->wd);
+				ev.type = EVENT_WATCH_REMOVED;
+			} else if (event->mask & IN_DELETE) {
+				ev.type = EVENT_REMOVED;
+			} else if (event->mask & IN_MOVED_FROM) {
+				moved_from.push_back(r_events.size());
+				moved_from_cookies.push_back(event->cookie);
+				ev.type = EVENT_REMOVED;
+			} else {
+				if (event->mask & IN_MOVED_TO) {
+					moved_to_cookies.insert(event->cookie);
+				}
+				ev.type = EVENT_CHANGED;
+			}
+			r_events.push_back(ev);
+		}
+	}
+
+	// Renames within the watched directories, e.g. when a file is saved through a temporary one, don't remove anything.
+	for (uint32_t i = 0; i < moved_from.size(); i++) {
+		if (moved_to_cookies.has(moved_from_cookies[i])) {
+			r_events[moved_from[i]].type = EVENT_CHANGED;
+		}
+	}
+}
+
+DirWatcherInotify::~DirWatcherInotify() {
+	if (fd != -1) {
+		close(fd);
+	}
+}
+
+#endif // __linux__
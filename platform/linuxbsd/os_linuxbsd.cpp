@@ -137,6 +137,10 @@ void OS_LinuxBSD::initialize() {
 
 	OS_Unix::initialize_core();
 
+#ifdef __linux__
+	DirWatcherInotify::make_default();
+#endif
+
 	system_dir_desktop_cache = get_system_dir(SYSTEM_DIR_DESKTOP);
 }
 
@@ -32,6 +32,7 @@
 #define OS_LINUXBSD_H
 
 #include "crash_handler_linuxbsd.h"
+#include "dir_watcher_inotify.h"
 #include "joypad_linux.h"
 
 #include "core/input/input.h"
@@ -0,0 +1,417 @@
+/**************************************************************************/
+/*  hlod_builder.cpp                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "hlod_builder.h"
+
+#include "core/io/marshalls.h"
+#include "scene/3d/mesh_instance_3d.h"
+#include "scene/resources/3d/skin.h"
+#include "scene/resources/surface_tool.h"
+
+void HLODBuilder::_gather_instances(Node *p_node, LocalVector<MeshInstance3D *> &r_instances) const {
+	MeshInstance3D *mi = Object::cast_to<MeshInstance3D>(p_node);
+	if (mi && mi->is_visible_in_tree()) {
+		Ref<Mesh> mesh = mi->get_mesh();
+		bool valid = true;
+
+		if (mesh.is_null() || mesh->get_surface_count() == 0) {
+			valid = false;
+		}
+
+		// Deformed meshes can't be baked into a static proxy.
+		if (valid && (mi->get_skin().is_valid() || mesh->get_blend_shape_count() > 0)) {
+			valid = false;
+		}
+
+		// Don't override manual LODs.
+		if (valid && (mi->get_visibility_range_begin() > 0.0 || mi->get_visibility_range_end() > 0.0 || !mi->get_visibility_parent().is_empty())) {
+			valid = false;
+		}
+
+		if ((mi->get_layer_mask() & bake_mask) == 0) {
+			valid = false;
+		}
+
+		if (valid) {
+			r_instances.push_back(mi);
+		}
+	}
+
+	for (int i = 0; i < p_node->get_child_count(); i++) {
+		_gather_instances(p_node->get_child(i), r_instances);
+	}
+}
+
+void HLODBuilder::_append_surface(LocalVector<SurfaceBatch> &r_batches, const Ref<Material> &p_material, const Array &p_arrays, const Transform3D &p_xform) const {
+	ERR_FAIL_COND_MSG(p_arrays.size() != Mesh::ARRAY_MAX, "Invalid surface array.");
+
+	const PackedVector3Array vertices = p_arrays[Mesh::ARRAY_VERTEX];
+	const PackedVector3Array normals = p_arrays[Mesh::ARRAY_NORMAL];
+	const PackedVector2Array uvs = p_arrays[Mesh::ARRAY_TEX_UV];
+	const PackedInt32Array indices = p_arrays[Mesh::ARRAY_INDEX];
+
+	if (vertices.is_empty()) {
+		return;
+	}
+
+	SurfaceBatch *batch = nullptr;
+	for (SurfaceBatch &E : r_batches) {
+		if (E.material == p_material) {
+			batch = &E;
+			break;
+		}
+	}
+	if (!batch) {
+		r_batches.push_back(SurfaceBatch());
+		batch = &r_batches[r_batches.size() - 1];
+		batch->material = p_material;
+	}
+
+	const int vertex_offset = batch->vertices.size();
+	batch->vertices.resize(vertex_offset + vertices.size());
+	batch->normals.resize(vertex_offset + vertices.size());
+	batch->uvs.resize(vertex_offset + vertices.size());
+
+	Vector3 *vertices_ptr = batch->vertices.ptrw() + vertex_offset;
+	Vector3 *normals_ptr = batch->normals.ptrw() + vertex_offset;
+	Vector2 *uvs_ptr = batch->uvs.ptrw() + vertex_offset;
+	const Basis normal_basis = p_xform.basis.inverse().transposed();
+
+	for (int i = 0; i < vertices.size(); i++) {
+		vertices_ptr[i] = p_xform.xform(vertices[i]);
+		normals_ptr[i] = i < normals.size() ? normal_basis.xform(normals[i]).normalized() : Vector3(0, 1, 0);
+		uvs_ptr[i] = i < uvs.size() ? uvs[i] : Vector2();
+	}
+
+	const int index_count = indices.is_empty() ? vertices.size() - vertices.size() % 3 : indices.size();
+	const int index_offset = batch->indices.size();
+	batch->indices.resize(index_offset + index_count);
+	int *indices_ptr = batch->indices.ptrw() + index_offset;
+
+	for (int i = 0; i < index_count; i++) {
+		indices_ptr[i] = vertex_offset + (indices.is_empty() ? i : indices[i]);
+	}
+}
+
+void HLODBuilder::_simplify_batch(SurfaceBatch &r_batch) const {
+	if (simplification_ratio >= 1.0 || !SurfaceTool::simplify_func) {
+		return;
+	}
+
+	const int index_count = r_batch.indices.size();
+	const int target_index_count = MAX(3, int(index_count * simplification_ratio) / 3 * 3);
+	if (target_index_count >= index_count) {
+		return;
+	}
+
+	const int vertex_count = r_batch.vertices.size();
+	Vector<float> vertices_f32 = vector3_to_float32_array(r_batch.vertices.ptr(), vertex_count);
+
+	// Proxies are only seen from far away, so the index budget drives the simplification rather than the error.
+	PackedInt32Array simplified;
+	simplified.resize(index_count);
+	float error = -1.0f;
+	uint32_t simplified_count = SurfaceTool::simplify_func(
+			(unsigned int *)simplified.ptrw(),
+			(const unsigned int *)r_batch.indices.ptr(),
+			index_count,
+			vertices_f32.ptr(), vertex_count, sizeof(float) * 3,
+			target_index_count, 1.0f, 0, &error);
+
+	// Separate meshes can't be collapsed into each other, which the sloppy simplifier doesn't care about.
+	if (simplified_count > uint32_t(target_index_count) && SurfaceTool::simplify_sloppy_func) {
+		PackedInt32Array sloppy;
+		sloppy.resize(simplified_count);
+		uint32_t sloppy_count = SurfaceTool::simplify_sloppy_func(
+				(unsigned int *)sloppy.ptrw(),
+				(const unsigned int *)simplified.ptr(),
+				simplified_count,
+				vertices_f32.ptr(), vertex_count, sizeof(float) * 3,
+				target_index_count, 1.0f, &error);
+		if (sloppy_count > 0) {
+			simplified = sloppy;
+			simplified_count = sloppy_count;
+		}
+	}
+
+	if (simplified_count == 0) {
+		return;
+	}
+	simplified.resize(simplified_count);
+
+	// Drop the vertices that are no longer referenced.
+	LocalVector<int> remap;
+	remap.resize(vertex_count);
+	for (int i = 0; i < vertex_count; i++) {
+		remap[i] = -1;
+	}
+
+	PackedVector3Array vertices;
+	PackedVector3Array normals;
+	PackedVector2Array uvs;
+	int *indices_ptr = simplified.ptrw();
+	for (uint32_t i = 0; i < simplified_count; i++) {
+		int vertex = indices_ptr[i];
+		if (remap[vertex] == -1) {
+			remap[vertex] = vertices.size();
+			vertices.push_back(r_batch.vertices[vertex]);
+			normals.push_back(r_batch.normals[vertex]);
+			uvs.push_back(r_batch.uvs[vertex]);
+		}
+		indices_ptr[i] = remap[vertex];
+	}
+
+	r_batch.vertices = vertices;
+	r_batch.normals = normals;
+	r_batch.uvs = uvs;
+	r_batch.indices = simplified;
+}
+
+static void _clear_visibility_parents(Node *p_node, const Node *p_proxy_root) {
+	if (p_node == p_proxy_root) {
+		return;
+	}
+
+	Node3D *node_3d = Object::cast_to<Node3D>(p_node);
+	if (node_3d && !node_3d->get_visibility_parent().is_empty()) {
+		Node *parent = node_3d->get_node_or_null(node_3d->get_visibility_parent());
+		if (parent && p_proxy_root->is_ancestor_of(parent)) {
+			node_3d->set_visibility_parent(NodePath());
+		}
+	}
+
+	for (int i = 0; i < p_node->get_child_count(); i++) {
+		_clear_visibility_parents(p_node->get_child(i), p_proxy_root);
+	}
+}
+
+Error HLODBuilder::build(Node3D *p_root) {
+	ERR_FAIL_NULL_V(p_root, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(!p_root->is_inside_tree(), ERR_UNCONFIGURED, "The HLOD root must be inside the scene tree, so global transforms can be used for clustering.");
+
+	clear(p_root);
+
+	LocalVector<MeshInstance3D *> instances;
+	_gather_instances(p_root, instances);
+
+	// Insertion ordered, so the same scene always yields the same proxies.
+	HashMap<Vector3i, LocalVector<MeshInstance3D *>> clusters;
+	for (MeshInstance3D *mi : instances) {
+		AABB aabb = mi->get_global_transform().xform(mi->get_aabb());
+		Vector3i cell = Vector3i((aabb.get_center() / cluster_size).floor());
+		clusters[cell].push_back(mi);
+	}
+
+	Node *owner = p_root->get_owner() ? p_root->get_owner() : p_root;
+	Node3D *proxy_root = nullptr;
+	const Transform3D root_inverse = p_root->get_global_transform().affine_inverse();
+
+	for (const KeyValue<Vector3i, LocalVector<MeshInstance3D *>> &E : clusters) {
+		if (E.value.size() < uint32_t(MAX(min_cluster_instances, 1))) {
+			continue;
+		}
+
+		AABB bounds;
+		for (uint32_t i = 0; i < E.value.size(); i++) {
+			AABB aabb = E.value[i]->get_global_transform().xform(E.value[i]->get_aabb());
+			bounds = i == 0 ? aabb : bounds.merge(aabb);
+		}
+		const Transform3D proxy_xform = Transform3D(Basis(), bounds.get_center());
+		const Transform3D proxy_inverse = proxy_xform.affine_inverse();
+
+		LocalVector<SurfaceBatch> batches;
+		for (MeshInstance3D *mi : E.value) {
+			Ref<Mesh> mesh = mi->get_mesh();
+			const Transform3D xform = proxy_inverse * mi->get_global_transform();
+			for (int i = 0; i < mesh->get_surface_count(); i++) {
+				if (mesh->surface_get_primitive_type(i) != Mesh::PRIMITIVE_TRIANGLES) {
+					continue;
+				}
+				_append_surface(batches, mi->get_active_material(i), mesh->surface_get_arrays(i), xform);
+			}
+		}
+
+		Ref<ArrayMesh> proxy_mesh;
+		proxy_mesh.instantiate();
+		for (SurfaceBatch &batch : batches) {
+			_simplify_batch(batch);
+			if (batch.indices.is_empty()) {
+				continue;
+			}
+
+			Array arrays;
+			arrays.resize(Mesh::ARRAY_MAX);
+			arrays[Mesh::ARRAY_VERTEX] = batch.vertices;
+			arrays[Mesh::ARRAY_NORMAL] = batch.normals;
+			arrays[Mesh::ARRAY_TEX_UV] = batch.uvs;
+			arrays[Mesh::ARRAY_INDEX] = batch.indices;
+			proxy_mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, arrays);
+			proxy_mesh->surface_set_material(proxy_mesh->get_surface_count() - 1, batch.material);
+		}
+
+		if (proxy_mesh->get_surface_count() == 0) {
+			continue;
+		}
+
+		if (!proxy_root) {
+			proxy_root = memnew(Node3D);
+			proxy_root->set_name(PROXY_ROOT_NAME);
+			proxy_root->set_meta(PROXY_ROOT_META, true);
+			p_root->add_child(proxy_root);
+			proxy_root->set_owner(owner);
+		}
+
+		MeshInstance3D *proxy = memnew(MeshInstance3D);
+		proxy->set_name(vformat("Cluster%d", cluster_count));
+		proxy->set_mesh(proxy_mesh);
+		proxy->set_visibility_range_begin(proxy_distance);
+		proxy->set_visibility_range_begin_margin(proxy_distance_margin);
+		proxy_root->add_child(proxy);
+		proxy->set_owner(owner);
+		proxy->set_transform(root_inverse * proxy_xform);
+
+		// The sources are only shown while the proxy is hidden by being closer than its visibility range.
+		for (MeshInstance3D *mi : E.value) {
+			mi->set_visibility_parent(mi->get_path_to(proxy));
+		}
+
+		cluster_count++;
+		clustered_instance_count += E.value.size();
+	}
+
+	return OK;
+}
+
+void HLODBuilder::clear(Node3D *p_root) {
+	ERR_FAIL_NULL(p_root);
+
+	cluster_count = 0;
+	clustered_instance_count = 0;
+
+	// Found by its marker rather than by name, so a node the user named like it is left alone.
+	LocalVector<Node *> proxy_roots;
+	for (int i = 0; i < p_root->get_child_count(); i++) {
+		Node *child = p_root->get_child(i);
+		if (child->has_meta(PROXY_ROOT_META)) {
+			proxy_roots.push_back(child);
+		}
+	}
+
+	for (Node *proxy_root : proxy_roots) {
+		_clear_visibility_parents(p_root, proxy_root);
+
+		p_root->remove_child(proxy_root);
+		memdelete(proxy_root);
+	}
+}
+
+void HLODBuilder::set_cluster_size(float p_size) {
+	ERR_FAIL_COND(p_size <= 0.0);
+	cluster_size = p_size;
+}
+
+float HLODBuilder::get_cluster_size() const {
+	return cluster_size;
+}
+
+void HLODBuilder::set_proxy_distance(float p_distance) {
+	proxy_distance = MAX(p_distance, 0.0);
+}
+
+float HLODBuilder::get_proxy_distance() const {
+	return proxy_distance;
+}
+
+void HLODBuilder::set_proxy_distance_margin(float p_margin) {
+	proxy_distance_margin = MAX(p_margin, 0.0);
+}
+
+float HLODBuilder::get_proxy_distance_margin() const {
+	return proxy_distance_margin;
+}
+
+void HLODBuilder::set_simplification_ratio(float p_ratio) {
+	simplification_ratio = CLAMP(p_ratio, 0.0, 1.0);
+}
+
+float HLODBuilder::get_simplification_ratio() const {
+	return simplification_ratio;
+}
+
+void HLODBuilder::set_min_cluster_instances(int p_count) {
+	min_cluster_instances = MAX(p_count, 1);
+}
+
+int HLODBuilder::get_min_cluster_instances() const {
+	return min_cluster_instances;
+}
+
+void HLODBuilder::set_bake_mask(uint32_t p_mask) {
+	bake_mask = p_mask;
+}
+
+uint32_t HLODBuilder::get_bake_mask() const {
+	return bake_mask;
+}
+
+int HLODBuilder::get_cluster_count() const {
+	return cluster_count;
+}
+
+int HLODBuilder::get_clustered_instance_count() const {
+	return clustered_instance_count;
+}
+
+void HLODBuilder::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_cluster_size", "size"), &HLODBuilder::set_cluster_size);
+	ClassDB::bind_method(D_METHOD("get_cluster_size"), &HLODBuilder::get_cluster_size);
+	ClassDB::bind_method(D_METHOD("set_proxy_distance", "distance"), &HLODBuilder::set_proxy_distance);
+	ClassDB::bind_method(D_METHOD("get_proxy_distance"), &HLODBuilder::get_proxy_distance);
+	ClassDB::bind_method(D_METHOD("set_proxy_distance_margin", "margin"), &HLODBuilder::set_proxy_distance_margin);
+	ClassDB::bind_method(D_METHOD("get_proxy_distance_margin"), &HLODBuilder::get_proxy_distance_margin);
+	ClassDB::bind_method(D_METHOD("set_simplification_ratio", "ratio"), &HLODBuilder::set_simplification_ratio);
+	ClassDB::bind_method(D_METHOD("get_simplification_ratio"), &HLODBuilder::get_simplification_ratio);
+	ClassDB::bind_method(D_METHOD("set_min_cluster_instances", "count"), &HLODBuilder::set_min_cluster_instances);
+	ClassDB::bind_method(D_METHOD("get_min_cluster_instances"), &HLODBuilder::get_min_cluster_instances);
+	ClassDB::bind_method(D_METHOD("set_bake_mask", "mask"), &HLODBuilder::set_bake_mask);
+	ClassDB::bind_method(D_METHOD("get_bake_mask"), &HLODBuilder::get_bake_mask);
+
+	ClassDB::bind_method(D_METHOD("build", "root"), &HLODBuilder::build);
+	ClassDB::bind_method(D_METHOD("clear", "root"), &HLODBuilder::clear);
+	ClassDB::bind_method(D_METHOD("get_cluster_count"), &HLODBuilder::get_cluster_count);
+	ClassDB::bind_method(D_METHOD("get_clustered_instance_count"), &HLODBuilder::get_clustered_instance_count);
+
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "cluster_size", PROPERTY_HINT_RANGE, "0.01,1024,0.01,or_greater,suffix:m"), "set_cluster_size", "get_cluster_size");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "proxy_distance", PROPERTY_HINT_RANGE, "0,4096,0.01,or_greater,suffix:m"), "set_proxy_distance", "get_proxy_distance");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "proxy_distance_margin", PROPERTY_HINT_RANGE, "0,4096,0.01,or_greater,suffix:m"), "set_proxy_distance_margin", "get_proxy_distance_margin");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "simplification_ratio", PROPERTY_HINT_RANGE, "0,1,0.001"), "set_simplification_ratio", "get_simplification_ratio");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "min_cluster_instances", PROPERTY_HINT_RANGE, "1,64,1,or_greater"), "set_min_cluster_instances", "get_min_cluster_instances");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "bake_mask", PROPERTY_HINT_LAYERS_3D_RENDER), "set_bake_mask", "get_bake_mask");
+}
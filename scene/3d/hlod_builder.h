@@ -0,0 +1,105 @@
+/**************************************************************************/
+/*  hlod_builder.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef HLOD_BUILDER_H
+#define HLOD_BUILDER_H
+
+#include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
+#include "scene/resources/material.h"
+
+class MeshInstance3D;
+class Node;
+class Node3D;
+
+// Clusters the static meshes below a node into merged, simplified proxy meshes. Proxies are
+// shown from a distance, and their source instances become visibility dependencies of them,
+// so far away clusters are culled and drawn as a single instance.
+class HLODBuilder : public RefCounted {
+	GDCLASS(HLODBuilder, RefCounted);
+
+	float cluster_size = 64.0;
+	float proxy_distance = 150.0;
+	float proxy_distance_margin = 0.0;
+	float simplification_ratio = 0.1;
+	int min_cluster_instances = 2;
+	uint32_t bake_mask = 0xFFFFFFFF;
+
+	int cluster_count = 0;
+	int clustered_instance_count = 0;
+
+	// Merged triangles of all surfaces sharing a material. Proxies only keep what is needed to
+	// shade from far away.
+	struct SurfaceBatch {
+		Ref<Material> material;
+		PackedVector3Array vertices;
+		PackedVector3Array normals;
+		PackedVector2Array uvs;
+		PackedInt32Array indices;
+	};
+
+	void _gather_instances(Node *p_node, LocalVector<MeshInstance3D *> &r_instances) const;
+	void _append_surface(LocalVector<SurfaceBatch> &r_batches, const Ref<Material> &p_material, const Array &p_arrays, const Transform3D &p_xform) const;
+	void _simplify_batch(SurfaceBatch &r_batch) const;
+
+protected:
+	static void _bind_methods();
+
+public:
+	static constexpr const char *PROXY_ROOT_NAME = "HLOD";
+	// Set on the proxy root by build(). clear() only removes nodes that have it.
+	static constexpr const char *PROXY_ROOT_META = "_hlod_proxy_root";
+
+	void set_cluster_size(float p_size);
+	float get_cluster_size() const;
+
+	void set_proxy_distance(float p_distance);
+	float get_proxy_distance() const;
+
+	void set_proxy_distance_margin(float p_margin);
+	float get_proxy_distance_margin() const;
+
+	void set_simplification_ratio(float p_ratio);
+	float get_simplification_ratio() const;
+
+	void set_min_cluster_instances(int p_count);
+	int get_min_cluster_instances() const;
+
+	void set_bake_mask(uint32_t p_mask);
+	uint32_t get_bake_mask() const;
+
+	Error build(Node3D *p_root);
+	void clear(Node3D *p_root);
+
+	int get_cluster_count() const;
+	int get_clustered_instance_count() const;
+};
+
+#endif // HLOD_BUILDER_H
@@ -54,7 +54,13 @@ void VisualInstance3D::_notification(int p_what) {
 
 		case NOTIFICATION_TRANSFORM_CHANGED: {
 			Transform3D gt = get_global_transform();
-			RenderingServer::get_singleton()->instance_set_transform(instance, gt);
+			SceneTree *tree = get_tree();
+			if (tree->instance_xform_batching) {
+				tree->instance_xform_rids.push_back(instance);
+				tree->instance_xform_transforms.push_back(gt);
+			} else {
+				RenderingServer::get_singleton()->instance_set_transform(instance, gt);
+			}
 		} break;
 
 		case NOTIFICATION_EXIT_WORLD: {
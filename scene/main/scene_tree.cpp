@@ -178,6 +178,11 @@ void SceneTree::make_group_changed(const StringName &p_group) {
 void SceneTree::flush_transform_notifications() {
 	_THREAD_SAFE_METHOD_
 
+#ifndef _3D_DISABLED
+	bool batch_owner = !instance_xform_batching;
+	instance_xform_batching = true;
+#endif // _3D_DISABLED
+
 	SelfList<Node> *n = xform_change_list.first();
 	while (n) {
 		Node *node = n->self();
@@ -186,6 +191,17 @@ void SceneTree::flush_transform_notifications() {
 		n = nx;
 		node->notification(NOTIFICATION_TRANSFORM_CHANGED);
 	}
+
+#ifndef _3D_DISABLED
+	if (batch_owner) {
+		instance_xform_batching = false;
+		if (!instance_xform_rids.is_empty()) {
+			RS::get_singleton()->instances_set_transforms(instance_xform_rids, instance_xform_transforms);
+			instance_xform_rids.clear();
+			instance_xform_transforms.clear();
+		}
+	}
+#endif // _3D_DISABLED
 }
 
 void SceneTree::_flush_ugc() {
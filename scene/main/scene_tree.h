@@ -33,6 +33,7 @@
 
 #include "core/os/main_loop.h"
 #include "core/os/thread_safe.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
 #include "core/templates/self_list.h"
 #include "scene/resources/mesh.h"
@@ -234,6 +235,16 @@ private:
 
 	SelfList<Node>::List xform_change_list;
 
+#ifndef _3D_DISABLED
+	// Transforms of visual instances changed while flushing transform notifications,
+	// sent to the RenderingServer in a single call afterwards. Cleared without freeing,
+	// so the buffers are only reallocated when a frame moves more instances than before.
+	friend class VisualInstance3D;
+	bool instance_xform_batching = false;
+	LocalVector<RID> instance_xform_rids;
+	LocalVector<Transform3D> instance_xform_transforms;
+#endif // _3D_DISABLED
+
 #ifdef DEBUG_ENABLED // No live editor in release build.
 	friend class LiveEditor;
 #endif
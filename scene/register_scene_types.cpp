@@ -237,6 +237,7 @@
 #include "scene/3d/fog_volume.h"
 #include "scene/3d/gpu_particles_3d.h"
 #include "scene/3d/gpu_particles_collision_3d.h"
+#include "scene/3d/hlod_builder.h"
 #include "scene/3d/importer_mesh_instance_3d.h"
 #include "scene/3d/label_3d.h"
 #include "scene/3d/light_3d.h"
@@ -342,6 +343,7 @@ void register_scene_types() {
 
 	resource_loader_text.instantiate();
 	ResourceLoader::add_resource_format_loader(resource_loader_text, true);
+	ResourceFormatLoaderText::set_binary_cache_enabled(GLOBAL_DEF("filesystem/text_resources/use_binary_cache", false));
 
 	resource_saver_shader.instantiate();
 	ResourceSaver::add_resource_format_saver(resource_saver_shader, true);
@@ -562,6 +564,7 @@ void register_scene_types() {
 	GDREGISTER_CLASS(BoxOccluder3D);
 	GDREGISTER_CLASS(SphereOccluder3D);
 	GDREGISTER_CLASS(PolygonOccluder3D);
+	GDREGISTER_CLASS(HLODBuilder);
 	GDREGISTER_ABSTRACT_CLASS(SpriteBase3D);
 	GDREGISTER_CLASS(Sprite3D);
 	GDREGISTER_CLASS(AnimatedSprite3D);
@@ -326,18 +326,26 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 				continue;
 			}
 
-			Vector<uint8_t> pv;
-			pv.resize(size);
-			{
-				uint8_t *wr = pv.ptrw();
-				f->get_buffer(wr, size);
-			}
-
 			Ref<Image> img;
-			if (data_format == DATA_FORMAT_PNG && Image::png_unpacker) {
-				img = Image::png_unpacker(pv);
-			} else if (data_format == DATA_FORMAT_WEBP && Image::webp_unpacker) {
-				img = Image::webp_unpacker(pv);
+			const uint8_t *mapped = f->get_mapped_ptr();
+			if (mapped && data_format == DATA_FORMAT_PNG && Image::_png_mem_unpacker_func && f->get_position() + size <= f->get_length()) {
+				// Decode straight from the file contents when they are mapped in memory.
+				uint64_t pos = f->get_position();
+				img = Image::_png_mem_unpacker_func(mapped + pos, size);
+				f->seek(pos + size);
+			} else {
+				Vector<uint8_t> pv;
+				pv.resize(size);
+				{
+					uint8_t *wr = pv.ptrw();
+					f->get_buffer(wr, size);
+				}
+
+				if (data_format == DATA_FORMAT_PNG && Image::png_unpacker) {
+					img = Image::png_unpacker(pv);
+				} else if (data_format == DATA_FORMAT_WEBP && Image::webp_unpacker) {
+					img = Image::webp_unpacker(pv);
+				}
 			}
 
 			if (img.is_null() || img->is_empty()) {
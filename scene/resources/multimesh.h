@@ -75,6 +75,8 @@ protected:
 	Vector<float> get_buffer() const;
 
 public:
+	void set_buffer_range(int p_first_instance, const Vector<float> &p_buffer);
+
 	void set_mesh(const Ref<Mesh> &p_mesh);
 	Ref<Mesh> get_mesh() const;
 
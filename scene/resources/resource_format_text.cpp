@@ -30,10 +30,14 @@
 
 #include "resource_format_text.h"
 
+#include "core/config/engine.h"
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
 #include "core/io/missing_resource.h"
+#include "core/io/resource_format_binary.h"
 #include "core/object/script_language.h"
+#include "core/os/thread.h"
+#include "core/version.h"
 
 // Version 2: Changed names for Basis, AABB, Vectors, etc.
 // Version 3: New string ID for ext/subresources, breaks forward compat.
@@ -160,6 +164,7 @@ Error ResourceLoaderText::_parse_ext_resource(VariantParser::Stream *p_stream, R
 						err = error;
 					} else {
 						ResourceLoader::notify_dependency_error(local_path, path, type);
+						missing_dependencies = true;
 					}
 				}
 			} else {
@@ -478,6 +483,7 @@ Error ResourceLoaderText::load() {
 				return error;
 			} else {
 				ResourceLoader::notify_dependency_error(local_path, path, type);
+				missing_dependencies = true;
 			}
 		}
 
@@ -1361,13 +1367,26 @@ Ref<Resource> ResourceFormatLoaderText::load(const String &p_path, const String
 	}
 
 	Error err;
+	String path = !p_original_path.is_empty() ? p_original_path : p_path;
+
+	// The editor relies on state only the text loader restores (e.g. ext_resource IDs), so it always parses.
+	const bool use_binary_cache = binary_cache_enabled && !Engine::get_singleton()->is_editor_hint();
+	String cache_file;
+	String source_md5;
+	if (use_binary_cache) {
+		cache_file = get_binary_cache_file(path);
+		source_md5 = FileAccess::get_md5(p_path);
+		Ref<Resource> cached = _load_binary_cache(cache_file, source_md5, path, r_error, p_use_sub_threads, r_progress, p_cache_mode);
+		if (cached.is_valid()) {
+			return cached;
+		}
+	}
 
 	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
 
 	ERR_FAIL_COND_V_MSG(err != OK, Ref<Resource>(), "Cannot open file '" + p_path + "'.");
 
 	ResourceLoaderText loader;
-	String path = !p_original_path.is_empty() ? p_original_path : p_path;
 	switch (p_cache_mode) {
 		case CACHE_MODE_IGNORE:
 		case CACHE_MODE_REUSE:
@@ -1394,12 +1413,79 @@ Ref<Resource> ResourceFormatLoaderText::load(const String &p_path, const String
 		*r_error = err;
 	}
 	if (err == OK) {
+		// Broken dependencies would be baked into the cache and stay broken once fixed.
+		if (use_binary_cache && !source_md5.is_empty() && !loader.missing_dependencies) {
+			_save_binary_cache(loader.get_resource(), cache_file, source_md5);
+		}
 		return loader.get_resource();
 	} else {
 		return Ref<Resource>();
 	}
 }
 
+void ResourceFormatLoaderText::set_binary_cache_enabled(bool p_enabled) {
+	binary_cache_enabled = p_enabled;
+}
+
+bool ResourceFormatLoaderText::is_binary_cache_enabled() {
+	return binary_cache_enabled;
+}
+
+void ResourceFormatLoaderText::set_binary_cache_dir(const String &p_dir) {
+	binary_cache_dir = p_dir;
+}
+
+String ResourceFormatLoaderText::get_binary_cache_dir() {
+	return binary_cache_dir.is_empty() ? String("user://text_resource_cache") : binary_cache_dir;
+}
+
+String ResourceFormatLoaderText::get_binary_cache_file(const String &p_path) {
+	return get_binary_cache_dir().path_join(ProjectSettings::get_singleton()->localize_path(p_path).md5_text() + ".res");
+}
+
+static String _get_binary_cache_stamp(const String &p_source_md5) {
+	return p_source_md5 + "::" + VERSION_FULL_BUILD;
+}
+
+Ref<Resource> ResourceFormatLoaderText::_load_binary_cache(const String &p_cache_file, const String &p_source_md5, const String &p_original_path, Error *r_error, bool p_use_sub_threads, float *r_progress, CacheMode p_cache_mode) {
+	Ref<FileAccess> stamp = FileAccess::open(p_cache_file + ".md5", FileAccess::READ);
+	if (stamp.is_null() || stamp->get_line() != _get_binary_cache_stamp(p_source_md5)) {
+		return Ref<Resource>();
+	}
+
+	Ref<ResourceFormatLoaderBinary> binary_loader;
+	binary_loader.instantiate();
+	return binary_loader->load(p_cache_file, p_original_path, r_error, p_use_sub_threads, r_progress, p_cache_mode);
+}
+
+void ResourceFormatLoaderText::_save_binary_cache(const Ref<Resource> &p_resource, const String &p_cache_file, const String &p_source_md5) {
+	const String dir = p_cache_file.get_base_dir();
+	Ref<DirAccess> da = DirAccess::create_for_path(dir);
+	if (da.is_null() || (!da->dir_exists(dir) && da->make_dir_recursive(dir) != OK)) {
+		return;
+	}
+
+	// Invalidate first, then write to a temporary file so concurrent loads never read a partial cache.
+	const String stamp_file = p_cache_file + ".md5";
+	if (da->file_exists(stamp_file)) {
+		da->remove(stamp_file);
+	}
+	const String tmp_file = p_cache_file + "." + itos(Thread::get_caller_id()) + ".tmp";
+	if (ResourceFormatSaverBinary::singleton->save(p_resource, tmp_file) != OK) {
+		da->remove(tmp_file);
+		return;
+	}
+	if (da->rename(tmp_file, p_cache_file) != OK) {
+		da->remove(tmp_file);
+		return;
+	}
+
+	Ref<FileAccess> stamp = FileAccess::open(stamp_file, FileAccess::WRITE);
+	if (stamp.is_valid()) {
+		stamp->store_line(_get_binary_cache_stamp(p_source_md5));
+	}
+}
+
 void ResourceFormatLoaderText::get_recognized_extensions_for_type(const String &p_type, List<String> *p_extensions) const {
 	if (p_type.is_empty()) {
 		get_recognized_extensions(p_extensions);
@@ -1540,6 +1626,8 @@ Error ResourceFormatLoaderText::rename_dependencies(const String &p_path, const
 }
 
 ResourceFormatLoaderText *ResourceFormatLoaderText::singleton = nullptr;
+bool ResourceFormatLoaderText::binary_cache_enabled = false;
+String ResourceFormatLoaderText::binary_cache_dir;
 
 /*****************************************************************************************************/
 
@@ -81,6 +81,8 @@ class ResourceLoaderText {
 
 	HashMap<String, String> remaps;
 
+	bool missing_dependencies = false;
+
 	static Error _parse_sub_resources(void *p_self, VariantParser::Stream *p_stream, Ref<Resource> &r_res, int &line, String &r_err_str) { return reinterpret_cast<ResourceLoaderText *>(p_self)->_parse_sub_resource(p_stream, r_res, line, r_err_str); }
 	static Error _parse_ext_resources(void *p_self, VariantParser::Stream *p_stream, Ref<Resource> &r_res, int &line, String &r_err_str) { return reinterpret_cast<ResourceLoaderText *>(p_self)->_parse_ext_resource(p_stream, r_res, line, r_err_str); }
 
@@ -132,8 +134,22 @@ public:
 };
 
 class ResourceFormatLoaderText : public ResourceFormatLoader {
+	static bool binary_cache_enabled;
+	static String binary_cache_dir;
+
+	Ref<Resource> _load_binary_cache(const String &p_cache_file, const String &p_source_md5, const String &p_original_path, Error *r_error, bool p_use_sub_threads, float *r_progress, CacheMode p_cache_mode);
+	void _save_binary_cache(const Ref<Resource> &p_resource, const String &p_cache_file, const String &p_source_md5);
+
 public:
 	static ResourceFormatLoaderText *singleton;
+
+	// Parsed text resources can be cached as binary resources, keyed by the MD5 of their contents.
+	static void set_binary_cache_enabled(bool p_enabled);
+	static bool is_binary_cache_enabled();
+	static void set_binary_cache_dir(const String &p_dir);
+	static String get_binary_cache_dir();
+	static String get_binary_cache_file(const String &p_path);
+
 	virtual Ref<Resource> load(const String &p_path, const String &p_original_path = "", Error *r_error = nullptr, bool p_use_sub_threads = false, float *r_progress = nullptr, CacheMode p_cache_mode = CACHE_MODE_REUSE) override;
 	virtual void get_recognized_extensions_for_type(const String &p_type, List<String> *p_extensions) const override;
 	virtual void get_recognized_extensions(List<String> *p_extensions) const override;
@@ -167,6 +167,8 @@ void PhysicsServer3DExtension::_bind_methods() {
 	GDVIRTUAL_BIND(_space_get_contacts, "space");
 	GDVIRTUAL_BIND(_space_get_contact_count, "space");
 
+	GDVIRTUAL_BIND(_space_get_last_step_time, "space");
+
 	/* AREA API */
 
 	GDVIRTUAL_BIND(_area_create);
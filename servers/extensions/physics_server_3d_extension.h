@@ -243,6 +243,14 @@ public:
 	EXBIND1RC(Vector<Vector3>, space_get_contacts, RID)
 	EXBIND1RC(int, space_get_contact_count, RID)
 
+	GDVIRTUAL1RC(double, _space_get_last_step_time, RID)
+
+	virtual double space_get_last_step_time(RID p_space) const override {
+		double ret = 0.0;
+		GDVIRTUAL_CALL(_space_get_last_step_time, p_space, ret);
+		return ret;
+	}
+
 	/* AREA API */
 
 	//EXBIND0RID(area);
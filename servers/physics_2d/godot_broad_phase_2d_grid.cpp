@@ -0,0 +1,502 @@
+/**************************************************************************/
+/*  godot_broad_phase_2d_grid.cpp                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "godot_broad_phase_2d_grid.h"
+#include "godot_collision_object_2d.h"
+
+#ifndef REAL_T_IS_DOUBLE
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GRID_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+#define GRID_USE_NEON
+#include <arm_neon.h>
+#endif
+#endif // REAL_T_IS_DOUBLE
+
+// Cell size of the finest level, each following level doubles it.
+#define GRID_BASE_CELL_SIZE 32.0
+// Keeps cell coordinates well within int32_t range for far away or degenerate bounds.
+#define GRID_CELL_COORD_LIMIT (1 << 29)
+
+uint32_t GodotBroadPhase2DGrid::_get_level(const Rect2 &p_aabb) {
+	real_t extent = MAX(p_aabb.size.x, p_aabb.size.y);
+	real_t cell_size = GRID_BASE_CELL_SIZE;
+	for (uint32_t level = 0; level < LEVEL_COUNT; level++) {
+		if (extent <= cell_size) {
+			return level;
+		}
+		cell_size *= 2.0;
+	}
+	return LEVEL_LARGE;
+}
+
+Vector2i GodotBroadPhase2DGrid::_get_cell_coord(const Vector2 &p_point, real_t p_cell_size) {
+	real_t x = CLAMP(Math::floor(p_point.x / p_cell_size), (real_t)-GRID_CELL_COORD_LIMIT, (real_t)GRID_CELL_COORD_LIMIT);
+	real_t y = CLAMP(Math::floor(p_point.y / p_cell_size), (real_t)-GRID_CELL_COORD_LIMIT, (real_t)GRID_CELL_COORD_LIMIT);
+	return Vector2i((int32_t)x, (int32_t)y);
+}
+
+void GodotBroadPhase2DGrid::_cull_cell(const Cell &p_cell, const Rect2 &p_aabb, LocalVector<ID> &r_hits) {
+	const real_t q_min_x = p_aabb.position.x;
+	const real_t q_min_y = p_aabb.position.y;
+	const real_t q_max_x = p_aabb.position.x + p_aabb.size.x;
+	const real_t q_max_y = p_aabb.position.y + p_aabb.size.y;
+
+	const uint32_t count = p_cell.ids.size();
+	const ID *ids = p_cell.ids.ptr();
+	const real_t *min_x = p_cell.min_x.ptr();
+	const real_t *min_y = p_cell.min_y.ptr();
+	const real_t *max_x = p_cell.max_x.ptr();
+	const real_t *max_y = p_cell.max_y.ptr();
+
+	uint32_t i = 0;
+
+#if defined(GRID_USE_SSE2)
+	const __m128 v_min_x = _mm_set1_ps(q_min_x);
+	const __m128 v_min_y = _mm_set1_ps(q_min_y);
+	const __m128 v_max_x = _mm_set1_ps(q_max_x);
+	const __m128 v_max_y = _mm_set1_ps(q_max_y);
+
+	for (; i + 4 <= count; i += 4) {
+		__m128 overlap_x = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(min_x + i), v_max_x), _mm_cmpge_ps(_mm_loadu_ps(max_x + i), v_min_x));
+		__m128 overlap_y = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(min_y + i), v_max_y), _mm_cmpge_ps(_mm_loadu_ps(max_y + i), v_min_y));
+		int mask = _mm_movemask_ps(_mm_and_ps(overlap_x, overlap_y));
+		if (mask) {
+			for (uint32_t j = 0; j < 4; j++) {
+				if (mask & (1 << j)) {
+					r_hits.push_back(ids[i + j]);
+				}
+			}
+		}
+	}
+#elif defined(GRID_USE_NEON)
+	const float32x4_t v_min_x = vdupq_n_f32(q_min_x);
+	const float32x4_t v_min_y = vdupq_n_f32(q_min_y);
+	const float32x4_t v_max_x = vdupq_n_f32(q_max_x);
+	const float32x4_t v_max_y = vdupq_n_f32(q_max_y);
+
+	for (; i + 4 <= count; i += 4) {
+		uint32x4_t overlap_x = vandq_u32(vcleq_f32(vld1q_f32(min_x + i), v_max_x), vcgeq_f32(vld1q_f32(max_x + i), v_min_x));
+		uint32x4_t overlap_y = vandq_u32(vcleq_f32(vld1q_f32(min_y + i), v_max_y), vcgeq_f32(vld1q_f32(max_y + i), v_min_y));
+		uint32x4_t overlap = vandq_u32(overlap_x, overlap_y);
+		if (vmaxvq_u32(overlap)) {
+			uint32_t lanes[4];
+			vst1q_u32(lanes, overlap);
+			for (uint32_t j = 0; j < 4; j++) {
+				if (lanes[j]) {
+					r_hits.push_back(ids[i + j]);
+				}
+			}
+		}
+	}
+#endif
+
+	for (; i < count; i++) {
+		if (min_x[i] <= q_max_x && max_x[i] >= q_min_x && min_y[i] <= q_max_y && max_y[i] >= q_min_y) {
+			r_hits.push_back(ids[i]);
+		}
+	}
+}
+
+bool GodotBroadPhase2DGrid::_pair_allowed(const Element &p_a, const Element &p_b) {
+	if (p_a.is_static && p_b.is_static) {
+		return false; // Static elements never pair with each other, like the static tree of the BVH.
+	}
+	if (p_a.owner == p_b.owner) {
+		return false;
+	}
+	return p_a.owner->interacts_with(p_b.owner);
+}
+
+GodotBroadPhase2DGrid::Cell *GodotBroadPhase2DGrid::_get_element_cell(const Element &p_element) {
+	if (p_element.level == LEVEL_LARGE) {
+		return &large_cell;
+	}
+	return levels[p_element.level].cells.getptr(p_element.cell);
+}
+
+void GodotBroadPhase2DGrid::_insert(ID p_id) {
+	Element &e = elements[p_id - 1];
+	e.level = _get_level(e.aabb);
+
+	Cell *cell = nullptr;
+	if (e.level == LEVEL_LARGE) {
+		cell = &large_cell;
+	} else {
+		Level &level = levels[e.level];
+		e.cell = _get_cell_coord(e.aabb.get_center(), level.cell_size);
+		cell = &level.cells[e.cell];
+		level.element_count++;
+	}
+
+	e.cell_index = cell->ids.size();
+	cell->ids.push_back(p_id);
+	cell->min_x.push_back(e.aabb.position.x);
+	cell->min_y.push_back(e.aabb.position.y);
+	cell->max_x.push_back(e.aabb.position.x + e.aabb.size.x);
+	cell->max_y.push_back(e.aabb.position.y + e.aabb.size.y);
+}
+
+void GodotBroadPhase2DGrid::_remove_from_cell(ID p_id) {
+	Element &e = elements[p_id - 1];
+	Cell *cell = _get_element_cell(e);
+	ERR_FAIL_NULL(cell);
+
+	// Swap with the last element of the cell to keep the arrays packed.
+	uint32_t last = cell->ids.size() - 1;
+	if (e.cell_index != last) {
+		ID moved = cell->ids[last];
+		cell->ids[e.cell_index] = moved;
+		cell->min_x[e.cell_index] = cell->min_x[last];
+		cell->min_y[e.cell_index] = cell->min_y[last];
+		cell->max_x[e.cell_index] = cell->max_x[last];
+		cell->max_y[e.cell_index] = cell->max_y[last];
+		elements[moved - 1].cell_index = e.cell_index;
+	}
+	cell->ids.resize(last);
+	cell->min_x.resize(last);
+	cell->min_y.resize(last);
+	cell->max_x.resize(last);
+	cell->max_y.resize(last);
+
+	if (e.level != LEVEL_LARGE) {
+		Level &level = levels[e.level];
+		level.element_count--;
+		if (last == 0) {
+			level.cells.erase(e.cell);
+		}
+	}
+}
+
+void GodotBroadPhase2DGrid::_cull(const Rect2 &p_aabb, LocalVector<ID> &r_hits) const {
+	for (uint32_t l = 0; l < LEVEL_COUNT; l++) {
+		const Level &level = levels[l];
+		if (!level.element_count) {
+			continue;
+		}
+
+		// Elements are at most one cell wide, so their center is within half a cell of anything they overlap.
+		Rect2 loose_aabb = p_aabb.grow(level.cell_size * 0.5);
+		Vector2i from = _get_cell_coord(loose_aabb.position, level.cell_size);
+		Vector2i to = _get_cell_coord(loose_aabb.get_end(), level.cell_size);
+
+		uint64_t cell_range = uint64_t(to.x - from.x + 1) * uint64_t(to.y - from.y + 1);
+		if (cell_range > level.cells.size()) {
+			// Cheaper to go through the occupied cells than to look up every cell of the range.
+			for (const KeyValue<Vector2i, Cell> &E : level.cells) {
+				if (E.key.x >= from.x && E.key.x <= to.x && E.key.y >= from.y && E.key.y <= to.y) {
+					_cull_cell(E.value, p_aabb, r_hits);
+				}
+			}
+		} else {
+			for (int32_t y = from.y; y <= to.y; y++) {
+				for (int32_t x = from.x; x <= to.x; x++) {
+					const Cell *cell = level.cells.getptr(Vector2i(x, y));
+					if (cell) {
+						_cull_cell(*cell, p_aabb, r_hits);
+					}
+				}
+			}
+		}
+	}
+
+	if (!large_cell.ids.is_empty()) {
+		_cull_cell(large_cell, p_aabb, r_hits);
+	}
+}
+
+void GodotBroadPhase2DGrid::_mark_changed(ID p_id) {
+	Element &e = elements[p_id - 1];
+	if (!e.changed) {
+		e.changed = true;
+		changed_ids.push_back(p_id);
+	}
+}
+
+void GodotBroadPhase2DGrid::_pair(ID p_a, ID p_b) {
+	if (p_a > p_b) {
+		SWAP(p_a, p_b);
+	}
+
+	Element &a = elements[p_a - 1];
+	Element &b = elements[p_b - 1];
+
+	// Only search the shorter list.
+	const Element &search = a.pairs.size() <= b.pairs.size() ? a : b;
+	ID other = &search == &a ? p_b : p_a;
+	for (const PairLink &link : search.pairs) {
+		if (link.other == other) {
+			return; // Already paired.
+		}
+	}
+
+	void *userdata = nullptr;
+	if (pair_callback) {
+		userdata = pair_callback(a.owner, a.subindex, b.owner, b.subindex, pair_userdata);
+	}
+
+	PairLink link;
+	link.userdata = userdata;
+	link.other = p_b;
+	a.pairs.push_back(link);
+	link.other = p_a;
+	b.pairs.push_back(link);
+}
+
+void GodotBroadPhase2DGrid::_unpair(ID p_a, ID p_b) {
+	if (p_a > p_b) {
+		SWAP(p_a, p_b);
+	}
+
+	Element &a = elements[p_a - 1];
+	Element &b = elements[p_b - 1];
+
+	void *userdata = nullptr;
+	for (uint32_t i = 0; i < a.pairs.size(); i++) {
+		if (a.pairs[i].other == p_b) {
+			userdata = a.pairs[i].userdata;
+			a.pairs.remove_at_unordered(i);
+			break;
+		}
+	}
+	for (uint32_t i = 0; i < b.pairs.size(); i++) {
+		if (b.pairs[i].other == p_a) {
+			b.pairs.remove_at_unordered(i);
+			break;
+		}
+	}
+
+	if (unpair_callback) {
+		unpair_callback(a.owner, a.subindex, b.owner, b.subindex, userdata, unpair_userdata);
+	}
+}
+
+GodotBroadPhase2D::ID GodotBroadPhase2DGrid::create(GodotCollisionObject2D *p_object, int p_subindex, const Rect2 &p_aabb, bool p_static) {
+	MutexLock lock(mutex);
+
+	ID id = 0;
+	if (!free_ids.is_empty()) {
+		id = free_ids[free_ids.size() - 1];
+		free_ids.resize(free_ids.size() - 1);
+	} else {
+		elements.push_back(Element());
+		id = elements.size();
+	}
+
+	Element &e = elements[id - 1];
+	e.owner = p_object;
+	e.subindex = p_subindex;
+	e.aabb = p_aabb;
+	e.is_static = p_static;
+	e.changed = false;
+	e.pairs.clear();
+
+	_insert(id);
+	_mark_changed(id);
+
+	return id;
+}
+
+void GodotBroadPhase2DGrid::move(ID p_id, const Rect2 &p_aabb) {
+	MutexLock lock(mutex);
+	ERR_FAIL_COND(!p_id || p_id > elements.size());
+	Element &e = elements[p_id - 1];
+	ERR_FAIL_NULL(e.owner);
+
+	if (e.aabb == p_aabb) {
+		return;
+	}
+	e.aabb = p_aabb;
+
+	uint32_t level = _get_level(p_aabb);
+	if (level != e.level || (level != LEVEL_LARGE && _get_cell_coord(p_aabb.get_center(), levels[level].cell_size) != e.cell)) {
+		_remove_from_cell(p_id);
+		_insert(p_id);
+	} else {
+		Cell *cell = _get_element_cell(e);
+		cell->min_x[e.cell_index] = p_aabb.position.x;
+		cell->min_y[e.cell_index] = p_aabb.position.y;
+		cell->max_x[e.cell_index] = p_aabb.position.x + p_aabb.size.x;
+		cell->max_y[e.cell_index] = p_aabb.position.y + p_aabb.size.y;
+	}
+
+	_mark_changed(p_id);
+}
+
+void GodotBroadPhase2DGrid::set_static(ID p_id, bool p_static) {
+	MutexLock lock(mutex);
+	ERR_FAIL_COND(!p_id || p_id > elements.size());
+	Element &e = elements[p_id - 1];
+	ERR_FAIL_NULL(e.owner);
+
+	e.is_static = p_static;
+	_mark_changed(p_id);
+}
+
+void GodotBroadPhase2DGrid::remove(ID p_id) {
+	MutexLock lock(mutex);
+	ERR_FAIL_COND(!p_id || p_id > elements.size());
+	Element &e = elements[p_id - 1];
+	ERR_FAIL_NULL(e.owner);
+
+	// Pairs must go right away, as the owner may be freed before the next update.
+	while (!e.pairs.is_empty()) {
+		_unpair(p_id, e.pairs[0].other);
+	}
+	_remove_from_cell(p_id);
+
+	e.owner = nullptr;
+	e.changed = false;
+	free_ids.push_back(p_id);
+}
+
+GodotCollisionObject2D *GodotBroadPhase2DGrid::get_object(ID p_id) const {
+	MutexLock lock(mutex);
+	ERR_FAIL_COND_V(!p_id || p_id > elements.size(), nullptr);
+	GodotCollisionObject2D *it = elements[p_id - 1].owner;
+	ERR_FAIL_NULL_V(it, nullptr);
+	return it;
+}
+
+bool GodotBroadPhase2DGrid::is_static(ID p_id) const {
+	MutexLock lock(mutex);
+	ERR_FAIL_COND_V(!p_id || p_id > elements.size(), false);
+	return elements[p_id - 1].is_static;
+}
+
+int GodotBroadPhase2DGrid::get_subindex(ID p_id) const {
+	MutexLock lock(mutex);
+	ERR_FAIL_COND_V(!p_id || p_id > elements.size(), 0);
+	return elements[p_id - 1].subindex;
+}
+
+int GodotBroadPhase2DGrid::cull_segment(const Vector2 &p_from, const Vector2 &p_to, GodotCollisionObject2D **p_results, int p_max_results, int *p_result_indices) {
+	MutexLock lock(mutex);
+
+	Rect2 segment_aabb(p_from, Vector2());
+	segment_aabb.expand_to(p_to);
+
+	cull_hits.clear();
+	_cull(segment_aabb, cull_hits);
+
+	int count = 0;
+	for (const ID id : cull_hits) {
+		if (count >= p_max_results) {
+			break;
+		}
+		const Element &e = elements[id - 1];
+		if (!e.aabb.intersects_segment(p_from, p_to)) {
+			continue;
+		}
+		p_results[count] = e.owner;
+		if (p_result_indices) {
+			p_result_indices[count] = e.subindex;
+		}
+		count++;
+	}
+	return count;
+}
+
+int GodotBroadPhase2DGrid::cull_aabb(const Rect2 &p_aabb, GodotCollisionObject2D **p_results, int p_max_results, int *p_result_indices) {
+	MutexLock lock(mutex);
+
+	cull_hits.clear();
+	_cull(p_aabb, cull_hits);
+
+	int count = 0;
+	for (const ID id : cull_hits) {
+		if (count >= p_max_results) {
+			break;
+		}
+		const Element &e = elements[id - 1];
+		p_results[count] = e.owner;
+		if (p_result_indices) {
+			p_result_indices[count] = e.subindex;
+		}
+		count++;
+	}
+	return count;
+}
+
+void GodotBroadPhase2DGrid::set_pair_callback(PairCallback p_pair_callback, void *p_userdata) {
+	pair_callback = p_pair_callback;
+	pair_userdata = p_userdata;
+}
+
+void GodotBroadPhase2DGrid::set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) {
+	unpair_callback = p_unpair_callback;
+	unpair_userdata = p_userdata;
+}
+
+void GodotBroadPhase2DGrid::update() {
+	MutexLock lock(mutex);
+
+	for (uint32_t i = 0; i < changed_ids.size(); i++) {
+		ID id = changed_ids[i];
+		Element &e = elements[id - 1];
+		if (!e.owner || !e.changed) {
+			continue; // Removed, or already processed through a duplicate entry after its ID got reused.
+		}
+		e.changed = false;
+
+		// Find existing pairs that no longer overlap.
+		for (uint32_t n = 0; n < e.pairs.size(); n++) {
+			const Element &other = elements[e.pairs[n].other - 1];
+			if (!e.aabb.intersects(other.aabb, true) || !_pair_allowed(e, other)) {
+				_unpair(id, e.pairs[n].other);
+				n--; // The last pair has been swapped into this slot.
+			}
+		}
+
+		// Find new pairs.
+		cull_hits.clear();
+		_cull(e.aabb, cull_hits);
+		for (const ID other_id : cull_hits) {
+			if (other_id != id && _pair_allowed(e, elements[other_id - 1])) {
+				_pair(id, other_id);
+			}
+		}
+	}
+
+	changed_ids.clear();
+}
+
+GodotBroadPhase2D *GodotBroadPhase2DGrid::_create() {
+	return memnew(GodotBroadPhase2DGrid);
+}
+
+GodotBroadPhase2DGrid::GodotBroadPhase2DGrid() {
+	real_t cell_size = GRID_BASE_CELL_SIZE;
+	for (uint32_t l = 0; l < LEVEL_COUNT; l++) {
+		levels[l].cell_size = cell_size;
+		cell_size *= 2.0;
+	}
+}
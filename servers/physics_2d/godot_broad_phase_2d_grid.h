@@ -0,0 +1,135 @@
+/**************************************************************************/
+/*  godot_broad_phase_2d_grid.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GODOT_BROAD_PHASE_2D_GRID_H
+#define GODOT_BROAD_PHASE_2D_GRID_H
+
+#include "godot_broad_phase_2d.h"
+
+#include "core/math/rect2.h"
+#include "core/math/vector2i.h"
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+// Multi-level loose grid broadphase, meant for scenes where most objects are small and move
+// every frame. Each element lives in exactly one cell, on the level whose cell size fits its
+// extents, so moving only touches the grid when the element's center crosses a cell boundary.
+// Bounds are stored per cell as SoA arrays so overlap tests can check several elements at once.
+class GodotBroadPhase2DGrid : public GodotBroadPhase2D {
+	enum {
+		LEVEL_COUNT = 16,
+		LEVEL_LARGE = LEVEL_COUNT, // Elements too big for any level are tested linearly.
+	};
+
+	struct Cell {
+		LocalVector<ID> ids;
+		LocalVector<real_t> min_x;
+		LocalVector<real_t> min_y;
+		LocalVector<real_t> max_x;
+		LocalVector<real_t> max_y;
+	};
+
+	struct Level {
+		real_t cell_size = 0.0;
+		uint32_t element_count = 0;
+		HashMap<Vector2i, Cell> cells;
+	};
+
+	struct PairLink {
+		ID other = 0;
+		void *userdata = nullptr;
+	};
+
+	struct Element {
+		GodotCollisionObject2D *owner = nullptr;
+		int subindex = 0;
+		bool is_static = false;
+		bool changed = false;
+		Rect2 aabb;
+		uint32_t level = 0;
+		Vector2i cell;
+		uint32_t cell_index = 0;
+		LocalVector<PairLink> pairs;
+	};
+
+	LocalVector<Element> elements; // Indexed by ID - 1, as 0 is an invalid ID.
+	LocalVector<ID> free_ids;
+	LocalVector<ID> changed_ids;
+
+	Level levels[LEVEL_COUNT];
+	Cell large_cell;
+
+	LocalVector<ID> cull_hits;
+	mutable Mutex mutex;
+
+	PairCallback pair_callback = nullptr;
+	void *pair_userdata = nullptr;
+	UnpairCallback unpair_callback = nullptr;
+	void *unpair_userdata = nullptr;
+
+	static uint32_t _get_level(const Rect2 &p_aabb);
+	static Vector2i _get_cell_coord(const Vector2 &p_point, real_t p_cell_size);
+	static void _cull_cell(const Cell &p_cell, const Rect2 &p_aabb, LocalVector<ID> &r_hits);
+	static bool _pair_allowed(const Element &p_a, const Element &p_b);
+
+	Cell *_get_element_cell(const Element &p_element);
+	void _insert(ID p_id);
+	void _remove_from_cell(ID p_id);
+	void _cull(const Rect2 &p_aabb, LocalVector<ID> &r_hits) const;
+	void _mark_changed(ID p_id);
+
+	void _pair(ID p_a, ID p_b);
+	void _unpair(ID p_a, ID p_b);
+
+public:
+	// 0 is an invalid ID
+	virtual ID create(GodotCollisionObject2D *p_object, int p_subindex = 0, const Rect2 &p_aabb = Rect2(), bool p_static = false) override;
+	virtual void move(ID p_id, const Rect2 &p_aabb) override;
+	virtual void set_static(ID p_id, bool p_static) override;
+	virtual void remove(ID p_id) override;
+
+	virtual GodotCollisionObject2D *get_object(ID p_id) const override;
+	virtual bool is_static(ID p_id) const override;
+	virtual int get_subindex(ID p_id) const override;
+
+	virtual int cull_segment(const Vector2 &p_from, const Vector2 &p_to, GodotCollisionObject2D **p_results, int p_max_results, int *p_result_indices = nullptr) override;
+	virtual int cull_aabb(const Rect2 &p_aabb, GodotCollisionObject2D **p_results, int p_max_results, int *p_result_indices = nullptr) override;
+
+	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata) override;
+	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) override;
+
+	virtual void update() override;
+
+	static GodotBroadPhase2D *_create();
+	GodotBroadPhase2DGrid();
+};
+
+#endif // GODOT_BROAD_PHASE_2D_GRID_H
@@ -32,6 +32,7 @@
 
 #include "godot_body_direct_state_2d.h"
 #include "godot_broad_phase_2d_bvh.h"
+#include "godot_broad_phase_2d_grid.h"
 #include "godot_collision_solver_2d.h"
 
 #include "core/config/project_settings.h"
@@ -1394,7 +1395,11 @@ GodotPhysicsServer2D *GodotPhysicsServer2D::godot_singleton = nullptr;
 
 GodotPhysicsServer2D::GodotPhysicsServer2D(bool p_using_threads) {
 	godot_singleton = this;
-	GodotBroadPhase2D::create_func = GodotBroadPhase2DBVH::_create;
+	if (int(GLOBAL_GET("physics/2d/broad_phase")) == BROAD_PHASE_GRID) {
+		GodotBroadPhase2D::create_func = GodotBroadPhase2DGrid::_create;
+	} else {
+		GodotBroadPhase2D::create_func = GodotBroadPhase2DBVH::_create;
+	}
 
 	using_threads = p_using_threads;
 }
@@ -44,6 +44,13 @@ class GodotPhysicsServer2D : public PhysicsServer2D {
 
 	friend class GodotPhysicsDirectSpaceState2D;
 	friend class GodotPhysicsDirectBodyState2D;
+
+	// Matches the "physics/2d/broad_phase" project setting.
+	enum BroadPhase {
+		BROAD_PHASE_BVH,
+		BROAD_PHASE_GRID,
+	};
+
 	bool active = true;
 	bool doing_sync = false;
 
@@ -336,6 +336,15 @@ void GodotBody3D::set_mode(PhysicsServer3D::BodyMode p_mode) {
 			set_active(true);
 		}
 	}
+
+	// Static bodies don't connect islands.
+	if (get_space() && (prev == PhysicsServer3D::BODY_MODE_STATIC) != (mode == PhysicsServer3D::BODY_MODE_STATIC)) {
+		if (island) {
+			get_space()->island_remove_body(this);
+		} else {
+			get_space()->island_add_body(this);
+		}
+	}
 }
 
 PhysicsServer3D::BodyMode GodotBody3D::get_mode() const {
@@ -448,6 +457,9 @@ void GodotBody3D::set_space(GodotSpace3D *p_space) {
 		if (direct_state_query_list.in_list()) {
 			get_space()->body_remove_from_state_query_list(&direct_state_query_list);
 		}
+		if (island) {
+			get_space()->island_remove_body(this);
+		}
 	}
 
 	_set_space(p_space);
@@ -455,6 +467,10 @@ void GodotBody3D::set_space(GodotSpace3D *p_space) {
 	if (get_space()) {
 		_mass_properties_changed();
 
+		if (mode != PhysicsServer3D::BODY_MODE_STATIC) {
+			get_space()->island_add_body(this);
+		}
+
 		if (active && !active_list.in_list()) {
 			get_space()->body_add_to_active_list(&active_list);
 		}
@@ -736,6 +752,20 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 	_update_transform_dependent();
 }
 
+void GodotBody3D::add_constraint(GodotConstraint3D *p_constraint, int p_pos) {
+	constraint_map[p_constraint] = p_pos;
+	if (island) {
+		get_space()->island_link(p_constraint);
+	}
+}
+
+void GodotBody3D::remove_constraint(GodotConstraint3D *p_constraint) {
+	constraint_map.erase(p_constraint);
+	if (island) {
+		get_space()->island_unlink(p_constraint, island);
+	}
+}
+
 void GodotBody3D::wakeup_neighbours() {
 	for (const KeyValue<GodotConstraint3D *, int> &E : constraint_map) {
 		const GodotConstraint3D *c = E.key;
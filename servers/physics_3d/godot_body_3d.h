@@ -33,6 +33,7 @@
 
 #include "godot_area_3d.h"
 #include "godot_collision_object_3d.h"
+#include "godot_island_3d.h"
 
 #include "core/templates/vset.h"
 
@@ -144,7 +145,8 @@ class GodotBody3D : public GodotCollisionObject3D {
 
 	GodotPhysicsDirectBodyState3D *direct_state = nullptr;
 
-	uint64_t island_step = 0;
+	GodotIsland3D *island = nullptr;
+	uint32_t island_index = 0;
 
 	void _update_transform_dependent();
 
@@ -192,11 +194,15 @@ public:
 	_FORCE_INLINE_ bool has_exception(const RID &p_exception) const { return exceptions.has(p_exception); }
 	_FORCE_INLINE_ const VSet<RID> &get_exceptions() const { return exceptions; }
 
-	_FORCE_INLINE_ uint64_t get_island_step() const { return island_step; }
-	_FORCE_INLINE_ void set_island_step(uint64_t p_step) { island_step = p_step; }
+	_FORCE_INLINE_ GodotIsland3D *get_island() const { return island; }
+	_FORCE_INLINE_ uint32_t get_island_index() const { return island_index; }
+	_FORCE_INLINE_ void set_island(GodotIsland3D *p_island, uint32_t p_index) {
+		island = p_island;
+		island_index = p_index;
+	}
 
-	_FORCE_INLINE_ void add_constraint(GodotConstraint3D *p_constraint, int p_pos) { constraint_map[p_constraint] = p_pos; }
-	_FORCE_INLINE_ void remove_constraint(GodotConstraint3D *p_constraint) { constraint_map.erase(p_constraint); }
+	void add_constraint(GodotConstraint3D *p_constraint, int p_pos);
+	void remove_constraint(GodotConstraint3D *p_constraint);
 	const HashMap<GodotConstraint3D *, int> &get_constraint_map() const { return constraint_map; }
 	_FORCE_INLINE_ void clear_constraint_map() { constraint_map.clear(); }
 
@@ -0,0 +1,59 @@
+/**************************************************************************/
+/*  godot_island_3d.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GODOT_ISLAND_3D_H
+#define GODOT_ISLAND_3D_H
+
+#include "core/templates/local_vector.h"
+#include "core/templates/self_list.h"
+
+class GodotBody3D;
+class GodotSoftBody3D;
+
+// A set of non-static bodies connected by constraints, kept up to date by the space
+// as constraints are added and removed (see GodotSpace3D::island_link()).
+// Removing a constraint doesn't split the island right away, it's only counted
+// and the island is split the next time one of its bodies is active.
+struct GodotIsland3D {
+	LocalVector<GodotBody3D *> bodies;
+	LocalVector<GodotSoftBody3D *> soft_bodies;
+
+	uint32_t removed_constraint_count = 0;
+	uint64_t step = 0;
+
+	SelfList<GodotIsland3D> island_list;
+
+	_FORCE_INLINE_ uint32_t get_member_count() const { return bodies.size() + soft_bodies.size(); }
+
+	GodotIsland3D() :
+			island_list(this) {}
+};
+
+#endif // GODOT_ISLAND_3D_H
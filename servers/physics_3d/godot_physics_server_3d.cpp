@@ -38,7 +38,9 @@
 #include "joints/godot_pin_joint_3d.h"
 #include "joints/godot_slider_joint_3d.h"
 
+#include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 #define FLUSH_QUERY_CHECK(m_object) \
@@ -214,6 +216,12 @@ int GodotPhysicsServer3D::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+double GodotPhysicsServer3D::space_get_last_step_time(RID p_space) const {
+	const GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, 0.0);
+	return USEC_TO_SEC(space->get_step_time());
+}
+
 RID GodotPhysicsServer3D::area_create() {
 	GodotArea3D *area = memnew(GodotArea3D);
 	RID rid = area_owner.make_rid(area);
@@ -1625,7 +1633,16 @@ void GodotPhysicsServer3D::set_active(bool p_active) {
 }
 
 void GodotPhysicsServer3D::init() {
-	stepper = memnew(GodotStep3D);
+	step_spaces_in_parallel = GLOBAL_GET("physics/3d/step_spaces_in_parallel");
+	steppers.push_back(memnew(GodotStep3D));
+}
+
+void GodotPhysicsServer3D::_step_space(uint32_t p_index, void *p_userdata) {
+	GodotSpace3D *space = stepping_spaces[p_index];
+
+	uint64_t time_beg = OS::get_singleton()->get_ticks_usec();
+	steppers[p_index]->step(space, stepping_delta);
+	space->set_step_time(OS::get_singleton()->get_ticks_usec() - time_beg);
 }
 
 void GodotPhysicsServer3D::step(real_t p_step) {
@@ -1637,15 +1654,44 @@ void GodotPhysicsServer3D::step(real_t p_step) {
 
 	_update_shapes();
 
+	stepping_spaces.clear();
+	for (const GodotSpace3D *E : active_spaces) {
+		stepping_spaces.push_back(const_cast<GodotSpace3D *>(E));
+	}
+	stepping_delta = p_step;
+
+	uint32_t space_count = stepping_spaces.size();
+	while (steppers.size() < space_count) {
+		steppers.push_back(memnew(GodotStep3D));
+	}
+
+	// Spaces share no bodies, areas or broadphase, so they can be stepped independently.
+	// In that case each space is stepped on its own task and solves its islands serially,
+	// since nested group tasks would starve the pool. Callbacks are still only dispatched
+	// from flush_queries(), in space order.
+	bool parallel = step_spaces_in_parallel && space_count > 1;
+	for (uint32_t i = 0; i < space_count; i++) {
+		steppers[i]->set_use_threads(!parallel);
+	}
+
+	if (parallel) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsServer3D::_step_space, nullptr, space_count, -1, true, SNAME("Physics3DStepSpaces"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < space_count; i++) {
+			_step_space(i);
+		}
+	}
+
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
-	for (const GodotSpace3D *E : active_spaces) {
-		stepper->step(const_cast<GodotSpace3D *>(E), p_step);
-		island_count += E->get_island_count();
-		active_objects += E->get_active_objects();
-		collision_pairs += E->get_collision_pairs();
+	for (const GodotSpace3D *space : stepping_spaces) {
+		island_count += space->get_island_count();
+		active_objects += space->get_active_objects();
+		collision_pairs += space->get_collision_pairs();
 	}
+	stepping_spaces.clear();
 #endif
 }
 
@@ -1711,7 +1757,10 @@ void GodotPhysicsServer3D::end_sync() {
 }
 
 void GodotPhysicsServer3D::finish() {
-	memdelete(stepper);
+	for (GodotStep3D *stepper : steppers) {
+		memdelete(stepper);
+	}
+	steppers.clear();
 }
 
 int GodotPhysicsServer3D::get_process_info(ProcessInfo p_info) {
@@ -52,8 +52,12 @@ class GodotPhysicsServer3D : public PhysicsServer3D {
 	bool using_threads = false;
 	bool doing_sync = false;
 	bool flushing_queries = false;
+	bool step_spaces_in_parallel = true;
 
-	GodotStep3D *stepper = nullptr;
+	// One stepper per space stepped in the current frame, so spaces can be stepped concurrently.
+	LocalVector<GodotStep3D *> steppers;
+	LocalVector<GodotSpace3D *> stepping_spaces;
+	real_t stepping_delta = 0.0;
 	HashSet<const GodotSpace3D *> active_spaces;
 
 	mutable RID_PtrOwner<GodotShape3D, true> shape_owner;
@@ -67,6 +71,7 @@ class GodotPhysicsServer3D : public PhysicsServer3D {
 	friend class GodotCollisionObject3D;
 	SelfList<GodotCollisionObject3D>::List pending_shape_update_list;
 	void _update_shapes();
+	void _step_space(uint32_t p_index, void *p_userdata = nullptr);
 
 	static GodotPhysicsServer3D *godot_singleton;
 
@@ -117,6 +122,8 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
 
+	virtual double space_get_last_step_time(RID p_space) const override;
+
 	/* AREA API */
 
 	virtual RID area_create() override;
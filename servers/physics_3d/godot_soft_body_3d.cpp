@@ -33,9 +33,20 @@
 #include "godot_space_3d.h"
 
 #include "core/math/geometry_3d.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/rb_map.h"
 #include "servers/rendering_server.h"
 
+#ifndef REAL_T_IS_DOUBLE
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SOFT_BODY_SIMD_SSE2
+#elif defined(__ARM_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+#include <arm_neon.h>
+#define SOFT_BODY_SIMD_NEON
+#endif
+#endif
+
 // Based on Bullet soft body.
 
 /*
@@ -110,9 +121,26 @@ Variant GodotSoftBody3D::get_state(PhysicsServer3D::BodyState p_state) const {
 	return Variant();
 }
 
+void GodotSoftBody3D::add_constraint(GodotConstraint3D *p_constraint) {
+	constraints.insert(p_constraint);
+	if (island) {
+		get_space()->island_link(p_constraint);
+	}
+}
+
+void GodotSoftBody3D::remove_constraint(GodotConstraint3D *p_constraint) {
+	constraints.erase(p_constraint);
+	if (island) {
+		get_space()->island_unlink(p_constraint, island);
+	}
+}
+
 void GodotSoftBody3D::set_space(GodotSpace3D *p_space) {
 	if (get_space()) {
 		get_space()->soft_body_remove_from_active_list(&active_list);
+		if (island) {
+			get_space()->island_remove_soft_body(this);
+		}
 
 		deinitialize_shape();
 	}
@@ -121,6 +149,7 @@ void GodotSoftBody3D::set_space(GodotSpace3D *p_space) {
 
 	if (get_space()) {
 		get_space()->soft_body_add_to_active_list(&active_list);
+		get_space()->island_add_soft_body(this);
 
 		if (bounds != AABB()) {
 			initialize_shape(true);
@@ -824,6 +853,84 @@ void GodotSoftBody3D::reoptimize_link_order() {
 	memdelete_arr(link_dep_free_list);
 	memdelete_arr(link_dep_list_starts);
 	memdelete_arr(link_buffer);
+
+	link_batches_dirty = true;
+}
+
+void GodotSoftBody3D::build_link_batches() {
+	link_batches_dirty = false;
+
+	link_batch_order.clear();
+	link_batch_offsets.clear();
+	link_batch_overflow = false;
+	solver_links.clear();
+
+	const uint32_t link_count = links.size();
+	if (link_count == 0) {
+		return;
+	}
+
+	// Greedy coloring, each node keeps a mask of the colors already used by its links.
+	// Links that find no free color go to an extra batch that is solved serially.
+	LocalVector<uint64_t> node_colors;
+	node_colors.resize(nodes.size());
+	memset(node_colors.ptr(), 0, sizeof(uint64_t) * node_colors.size());
+
+	LocalVector<uint8_t> link_colors;
+	link_colors.resize(link_count);
+
+	uint32_t batch_sizes[MAX_LINK_BATCHES + 1] = {};
+	uint32_t batch_count = 0;
+
+	const Node *node0 = &nodes[0];
+	for (uint32_t i = 0; i < link_count; i++) {
+		const uint32_t ia = links[i].n[0] - node0;
+		const uint32_t ib = links[i].n[1] - node0;
+		const uint64_t used = node_colors[ia] | node_colors[ib];
+		uint32_t color = 0;
+		while (color < MAX_LINK_BATCHES && (used & (uint64_t(1) << color))) {
+			color++;
+		}
+		if (color < MAX_LINK_BATCHES) {
+			node_colors[ia] |= uint64_t(1) << color;
+			node_colors[ib] |= uint64_t(1) << color;
+			batch_count = MAX(batch_count, color + 1);
+		} else {
+			link_batch_overflow = true;
+		}
+		link_colors[i] = color;
+		batch_sizes[color]++;
+	}
+
+	if (link_batch_overflow) {
+		// Move the overflow batch right after the last used color.
+		batch_sizes[batch_count] = batch_sizes[MAX_LINK_BATCHES];
+		for (uint32_t i = 0; i < link_count; i++) {
+			if (link_colors[i] == MAX_LINK_BATCHES) {
+				link_colors[i] = batch_count;
+			}
+		}
+		batch_count++;
+	}
+
+	// Counting sort by color, keeping the optimized link order within each batch.
+	link_batch_offsets.resize(batch_count + 1);
+	link_batch_offsets[0] = 0;
+	for (uint32_t i = 0; i < batch_count; i++) {
+		link_batch_offsets[i + 1] = link_batch_offsets[i] + batch_sizes[i];
+	}
+
+	uint32_t batch_fill[MAX_LINK_BATCHES + 1];
+	memcpy(batch_fill, link_batch_offsets.ptr(), sizeof(uint32_t) * batch_count);
+
+	link_batch_order.resize(link_count);
+	solver_links.resize(link_count);
+	for (uint32_t i = 0; i < link_count; i++) {
+		const uint32_t solver_index = batch_fill[link_colors[i]]++;
+		link_batch_order[solver_index] = i;
+		solver_links[solver_index].a = links[i].n[0] - node0;
+		solver_links[solver_index].b = links[i].n[1] - node0;
+	}
 }
 
 void GodotSoftBody3D::append_link(uint32_t p_node1, uint32_t p_node2) {
@@ -840,6 +947,7 @@ void GodotSoftBody3D::append_link(uint32_t p_node1, uint32_t p_node2) {
 	link.rl = (node1->x - node2->x).length();
 
 	links.push_back(link);
+	link_batches_dirty = true;
 }
 
 void GodotSoftBody3D::append_face(uint32_t p_node1, uint32_t p_node2, uint32_t p_node3) {
@@ -1067,26 +1175,48 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 	face_tree.optimize_incremental(1);
 }
 
-void GodotSoftBody3D::solve_constraints(real_t p_delta) {
+void GodotSoftBody3D::solve_constraints(real_t p_delta, bool p_use_threads) {
 	const real_t inv_delta = 1.0 / p_delta;
 
+	if (link_batches_dirty) {
+		build_link_batches();
+	}
+
 	for (Link &link : links) {
 		link.c3 = link.n[1]->q - link.n[0]->q;
 		link.c2 = 1 / (link.c3.length_squared() * link.c0);
 	}
 
+	const uint32_t link_count = solver_links.size();
+	for (uint32_t i = 0; i < link_count; i++) {
+		const Link &link = links[link_batch_order[i]];
+		solver_links[i].c0 = link.c0;
+		solver_links[i].c1 = link.c1;
+	}
+
 	// Solve velocities.
-	for (Node &node : nodes) {
-		node.x = node.q + node.v * p_delta;
+	const uint32_t node_count = nodes.size();
+	solver_nodes.resize(node_count);
+	for (uint32_t i = 0; i < node_count; i++) {
+		const Node &node = nodes[i];
+		const Vector3 x = node.q + node.v * p_delta;
+		SolverNode &solver_node = solver_nodes[i];
+		solver_node.x[0] = x.x;
+		solver_node.x[1] = x.y;
+		solver_node.x[2] = x.z;
+		solver_node.im = node.im;
 	}
 
 	// Solve positions.
 	for (int isolve = 0; isolve < iteration_count; ++isolve) {
-		const real_t ti = isolve / (real_t)iteration_count;
-		solve_links(1.0, ti);
+		solve_links(p_use_threads);
 	}
 	const real_t vc = (1.0 - damping_coefficient) * inv_delta;
-	for (Node &node : nodes) {
+	for (uint32_t i = 0; i < node_count; i++) {
+		Node &node = nodes[i];
+		const SolverNode &solver_node = solver_nodes[i];
+		node.x = Vector3(solver_node.x[0], solver_node.x[1], solver_node.x[2]);
+
 		node.x += node.bv * p_delta;
 		node.bv = Vector3();
 
@@ -1098,19 +1228,86 @@ void GodotSoftBody3D::solve_constraints(real_t p_delta) {
 	update_normals_and_centroids();
 }
 
-void GodotSoftBody3D::solve_links(real_t kst, real_t ti) {
-	for (Link &link : links) {
-		if (link.c0 > 0) {
-			Node &node_a = *link.n[0];
-			Node &node_b = *link.n[1];
-			const Vector3 del = node_b.x - node_a.x;
-			const real_t len = del.length_squared();
-			if (link.c1 + len > CMP_EPSILON) {
-				const real_t k = ((link.c1 - len) / (link.c0 * (link.c1 + len))) * kst;
-				node_a.x -= del * (k * node_a.im);
-				node_b.x += del * (k * node_b.im);
+void GodotSoftBody3D::solve_links(bool p_use_threads) {
+	if (link_batch_offsets.is_empty()) {
+		return;
+	}
+
+	const uint32_t batch_count = link_batch_offsets.size() - 1;
+	for (uint32_t batch = 0; batch < batch_count; batch++) {
+		const uint32_t begin = link_batch_offsets[batch];
+		const uint32_t end = link_batch_offsets[batch + 1];
+		const bool serial = link_batch_overflow && batch == batch_count - 1;
+		if (!p_use_threads || serial || end - begin < LINK_BATCH_PARALLEL_MIN_LINKS) {
+			_solve_link_range(begin, end);
+			continue;
+		}
+
+		solver_batch_begin = begin;
+		solver_batch_end = end;
+		const uint32_t chunk_count = (end - begin + LINK_BATCH_CHUNK_SIZE - 1) / LINK_BATCH_CHUNK_SIZE;
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotSoftBody3D::_solve_link_chunk, nullptr, chunk_count, -1, true, SNAME("SoftBody3DSolveLinks"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+}
+
+void GodotSoftBody3D::_solve_link_chunk(uint32_t p_chunk, void *p_userdata) {
+	const uint32_t from = solver_batch_begin + p_chunk * LINK_BATCH_CHUNK_SIZE;
+	_solve_link_range(from, MIN(from + LINK_BATCH_CHUNK_SIZE, solver_batch_end));
+}
+
+void GodotSoftBody3D::_solve_link_range(uint32_t p_from, uint32_t p_to) {
+	SolverNode *solver_nodes_ptr = solver_nodes.ptr();
+	const SolverLink *solver_links_ptr = solver_links.ptr();
+
+#ifdef SOFT_BODY_SIMD_SSE2
+	const __m128 xyz_mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+#endif
+
+	for (uint32_t i = p_from; i < p_to; i++) {
+		const SolverLink &link = solver_links_ptr[i];
+		if (link.c0 <= 0) {
+			continue;
+		}
+		SolverNode &node_a = solver_nodes_ptr[link.a];
+		SolverNode &node_b = solver_nodes_ptr[link.b];
+
+		// The packed paths follow the scalar operation order.
+#if defined(SOFT_BODY_SIMD_SSE2)
+		const __m128 a = _mm_loadu_ps(node_a.x);
+		const __m128 b = _mm_loadu_ps(node_b.x);
+		const __m128 del = _mm_and_ps(_mm_sub_ps(b, a), xyz_mask);
+		const __m128 sq = _mm_mul_ps(del, del);
+		const real_t len = _mm_cvtss_f32(_mm_add_ss(_mm_add_ss(sq, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(1, 1, 1, 1))), _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2, 2, 2, 2))));
+		if (link.c1 + len > CMP_EPSILON) {
+			const real_t k = (link.c1 - len) / (link.c0 * (link.c1 + len));
+			_mm_storeu_ps(node_a.x, _mm_sub_ps(a, _mm_mul_ps(del, _mm_set1_ps(k * node_a.im))));
+			_mm_storeu_ps(node_b.x, _mm_add_ps(b, _mm_mul_ps(del, _mm_set1_ps(k * node_b.im))));
+		}
+#elif defined(SOFT_BODY_SIMD_NEON)
+		const float32x4_t a = vld1q_f32(node_a.x);
+		const float32x4_t b = vld1q_f32(node_b.x);
+		const float32x4_t del = vsetq_lane_f32(0.0f, vsubq_f32(b, a), 3);
+		const float32x4_t sq = vmulq_f32(del, del);
+		const real_t len = (vgetq_lane_f32(sq, 0) + vgetq_lane_f32(sq, 1)) + vgetq_lane_f32(sq, 2);
+		if (link.c1 + len > CMP_EPSILON) {
+			const real_t k = (link.c1 - len) / (link.c0 * (link.c1 + len));
+			vst1q_f32(node_a.x, vsubq_f32(a, vmulq_f32(del, vdupq_n_f32(k * node_a.im))));
+			vst1q_f32(node_b.x, vaddq_f32(b, vmulq_f32(del, vdupq_n_f32(k * node_b.im))));
+		}
+#else
+		const real_t del[3] = { node_b.x[0] - node_a.x[0], node_b.x[1] - node_a.x[1], node_b.x[2] - node_a.x[2] };
+		const real_t len = del[0] * del[0] + del[1] * del[1] + del[2] * del[2];
+		if (link.c1 + len > CMP_EPSILON) {
+			const real_t k = (link.c1 - len) / (link.c0 * (link.c1 + len));
+			const real_t ka = k * node_a.im;
+			const real_t kb = k * node_b.im;
+			for (int c = 0; c < 3; c++) {
+				node_a.x[c] -= del[c] * ka;
+				node_b.x[c] += del[c] * kb;
 			}
 		}
+#endif
 	}
 }
 
@@ -1223,6 +1420,10 @@ void GodotSoftBody3D::destroy() {
 	links.clear();
 	faces.clear();
 
+	link_batches_dirty = true;
+	solver_nodes.clear();
+	solver_links.clear();
+
 	bounds = AABB();
 	deinitialize_shape();
 }
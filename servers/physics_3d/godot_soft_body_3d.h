@@ -33,6 +33,7 @@
 
 #include "godot_area_3d.h"
 #include "godot_collision_object_3d.h"
+#include "godot_island_3d.h"
 
 #include "core/math/aabb.h"
 #include "core/math/dynamic_bvh.h"
@@ -78,10 +79,39 @@ class GodotSoftBody3D : public GodotCollisionObject3D {
 		uint32_t index = 0;
 	};
 
+	// Hot solver state, packed so that a node fits in a single vector register.
+	struct SolverNode {
+		real_t x[3] = { 0.0, 0.0, 0.0 }; // Position
+		real_t im = 0.0; // 1/mass
+	};
+
+	struct SolverLink {
+		uint32_t a = 0; // Node indices
+		uint32_t b = 0;
+		real_t c0 = 0.0; // (ima+imb)*kLST
+		real_t c1 = 0.0; // rl^2
+	};
+
+	static const uint32_t MAX_LINK_BATCHES = 64;
+	static const uint32_t LINK_BATCH_CHUNK_SIZE = 256;
+	static const uint32_t LINK_BATCH_PARALLEL_MIN_LINKS = 1024;
+
 	LocalVector<Node> nodes;
 	LocalVector<Link> links;
 	LocalVector<Face> faces;
 
+	// Links are greedily colored into batches where no two links share a node,
+	// so each batch can be solved in any order, and in parallel.
+	LocalVector<uint32_t> link_batch_order; // Link index of each solver link.
+	LocalVector<uint32_t> link_batch_offsets; // Solver link range of each batch.
+	bool link_batch_overflow = false; // The last batch holds links that could not be colored, solved serially.
+	bool link_batches_dirty = true;
+
+	LocalVector<SolverNode> solver_nodes;
+	LocalVector<SolverLink> solver_links;
+	uint32_t solver_batch_begin = 0;
+	uint32_t solver_batch_end = 0;
+
 	DynamicBVH node_tree;
 	DynamicBVH face_tree;
 
@@ -109,7 +139,8 @@ class GodotSoftBody3D : public GodotCollisionObject3D {
 
 	VSet<RID> exceptions;
 
-	uint64_t island_step = 0;
+	GodotIsland3D *island = nullptr;
+	uint32_t island_index = 0;
 
 	_FORCE_INLINE_ Vector3 _compute_area_windforce(const GodotArea3D *p_area, const Face *p_face);
 
@@ -121,8 +152,8 @@ public:
 	void set_state(PhysicsServer3D::BodyState p_state, const Variant &p_variant);
 	Variant get_state(PhysicsServer3D::BodyState p_state) const;
 
-	_FORCE_INLINE_ void add_constraint(GodotConstraint3D *p_constraint) { constraints.insert(p_constraint); }
-	_FORCE_INLINE_ void remove_constraint(GodotConstraint3D *p_constraint) { constraints.erase(p_constraint); }
+	void add_constraint(GodotConstraint3D *p_constraint);
+	void remove_constraint(GodotConstraint3D *p_constraint);
 	_FORCE_INLINE_ const HashSet<GodotConstraint3D *> &get_constraints() const { return constraints; }
 	_FORCE_INLINE_ void clear_constraints() { constraints.clear(); }
 
@@ -131,8 +162,12 @@ public:
 	_FORCE_INLINE_ bool has_exception(const RID &p_exception) const { return exceptions.has(p_exception); }
 	_FORCE_INLINE_ const VSet<RID> &get_exceptions() const { return exceptions; }
 
-	_FORCE_INLINE_ uint64_t get_island_step() const { return island_step; }
-	_FORCE_INLINE_ void set_island_step(uint64_t p_step) { island_step = p_step; }
+	_FORCE_INLINE_ GodotIsland3D *get_island() const { return island; }
+	_FORCE_INLINE_ uint32_t get_island_index() const { return island_index; }
+	_FORCE_INLINE_ void set_island(GodotIsland3D *p_island, uint32_t p_index) {
+		island = p_island;
+		island_index = p_index;
+	}
 
 	_FORCE_INLINE_ void add_area(GodotArea3D *p_area) {
 		int index = areas.find(AreaCMP(p_area));
@@ -202,7 +237,7 @@ public:
 	_FORCE_INLINE_ real_t get_drag_coefficient() const { return drag_coefficient; }
 
 	void predict_motion(real_t p_delta);
-	void solve_constraints(real_t p_delta);
+	void solve_constraints(real_t p_delta, bool p_use_threads = false);
 
 	_FORCE_INLINE_ uint32_t get_node_index(void *p_node) const { return static_cast<Node *>(p_node)->index; }
 	_FORCE_INLINE_ uint32_t get_face_index(void *p_face) const { return static_cast<Face *>(p_face)->index; }
@@ -237,7 +272,10 @@ private:
 	void append_link(uint32_t p_node1, uint32_t p_node2);
 	void append_face(uint32_t p_node1, uint32_t p_node2, uint32_t p_node3);
 
-	void solve_links(real_t kst, real_t ti);
+	void build_link_batches();
+	void solve_links(bool p_use_threads);
+	void _solve_link_range(uint32_t p_from, uint32_t p_to);
+	void _solve_link_chunk(uint32_t p_chunk, void *p_userdata);
 
 	void initialize_face_tree();
 	void update_face_tree(real_t p_delta);
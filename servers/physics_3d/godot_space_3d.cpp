@@ -1160,6 +1160,226 @@ void GodotSpace3D::soft_body_remove_from_active_list(SelfList<GodotSoftBody3D> *
 	active_soft_body_list.remove(p_soft_body);
 }
 
+GodotIsland3D *GodotSpace3D::_island_create() {
+	GodotIsland3D *island = memnew(GodotIsland3D);
+	island_list.add(&island->island_list);
+	return island;
+}
+
+void GodotSpace3D::_island_free(GodotIsland3D *p_island) {
+	island_list.remove(&p_island->island_list);
+	memdelete(p_island);
+}
+
+void GodotSpace3D::_island_push_body(GodotIsland3D *p_island, GodotBody3D *p_body) {
+	p_body->set_island(p_island, p_island->bodies.size());
+	p_island->bodies.push_back(p_body);
+}
+
+void GodotSpace3D::_island_push_soft_body(GodotIsland3D *p_island, GodotSoftBody3D *p_soft_body) {
+	p_soft_body->set_island(p_island, p_island->soft_bodies.size());
+	p_island->soft_bodies.push_back(p_soft_body);
+}
+
+GodotIsland3D *GodotSpace3D::_island_merge(GodotIsland3D *p_a, GodotIsland3D *p_b) {
+	if (p_a == p_b) {
+		return p_a;
+	}
+
+	// Union by size, the members of the smaller island move to the bigger one.
+	if (p_a->get_member_count() < p_b->get_member_count()) {
+		SWAP(p_a, p_b);
+	}
+
+	for (GodotBody3D *body : p_b->bodies) {
+		_island_push_body(p_a, body);
+	}
+	for (GodotSoftBody3D *soft_body : p_b->soft_bodies) {
+		_island_push_soft_body(p_a, soft_body);
+	}
+	p_a->removed_constraint_count += p_b->removed_constraint_count;
+
+	_island_free(p_b);
+	return p_a;
+}
+
+void GodotSpace3D::_island_visit_constraint(GodotIsland3D *p_island, const GodotConstraint3D *p_constraint) {
+	// Only members detached by island_split() have no island, static bodies never have one.
+	for (int i = 0; i < p_constraint->get_body_count(); i++) {
+		GodotBody3D *body = p_constraint->get_body_ptr()[i];
+		if (!body->get_island() && body->get_space() == this && body->get_mode() != PhysicsServer3D::BODY_MODE_STATIC) {
+			_island_push_body(p_island, body);
+		}
+	}
+
+	for (int i = 0; i < p_constraint->get_soft_body_count(); i++) {
+		GodotSoftBody3D *soft_body = p_constraint->get_soft_body_ptr(i);
+		if (!soft_body->get_island() && soft_body->get_space() == this) {
+			_island_push_soft_body(p_island, soft_body);
+		}
+	}
+}
+
+void GodotSpace3D::_island_flood_fill(GodotIsland3D *p_island) {
+	// The member lists double as the queue of bodies left to visit.
+	uint32_t body_index = 0;
+	uint32_t soft_body_index = 0;
+
+	while (body_index < p_island->bodies.size() || soft_body_index < p_island->soft_bodies.size()) {
+		if (body_index < p_island->bodies.size()) {
+			const GodotBody3D *body = p_island->bodies[body_index++];
+			for (const KeyValue<GodotConstraint3D *, int> &E : body->get_constraint_map()) {
+				_island_visit_constraint(p_island, E.key);
+			}
+		} else {
+			const GodotSoftBody3D *soft_body = p_island->soft_bodies[soft_body_index++];
+			for (const GodotConstraint3D *constraint : soft_body->get_constraints()) {
+				_island_visit_constraint(p_island, constraint);
+			}
+		}
+	}
+}
+
+void GodotSpace3D::island_add_body(GodotBody3D *p_body) {
+	ERR_FAIL_COND(p_body->get_island());
+
+	_island_push_body(_island_create(), p_body);
+
+	for (const KeyValue<GodotConstraint3D *, int> &E : p_body->get_constraint_map()) {
+		island_link(E.key);
+	}
+}
+
+void GodotSpace3D::island_remove_body(GodotBody3D *p_body) {
+	GodotIsland3D *island = p_body->get_island();
+	ERR_FAIL_NULL(island);
+
+	uint32_t index = p_body->get_island_index();
+	island->bodies.remove_at_unordered(index);
+	if (index < island->bodies.size()) {
+		island->bodies[index]->set_island(island, index);
+	}
+	p_body->set_island(nullptr, 0);
+
+	if (island->get_member_count() == 0) {
+		_island_free(island);
+	} else {
+		// The other members may only have been connected through this body.
+		island->removed_constraint_count++;
+	}
+}
+
+void GodotSpace3D::island_add_soft_body(GodotSoftBody3D *p_soft_body) {
+	ERR_FAIL_COND(p_soft_body->get_island());
+
+	_island_push_soft_body(_island_create(), p_soft_body);
+
+	for (const GodotConstraint3D *constraint : p_soft_body->get_constraints()) {
+		island_link(constraint);
+	}
+}
+
+void GodotSpace3D::island_remove_soft_body(GodotSoftBody3D *p_soft_body) {
+	GodotIsland3D *island = p_soft_body->get_island();
+	ERR_FAIL_NULL(island);
+
+	uint32_t index = p_soft_body->get_island_index();
+	island->soft_bodies.remove_at_unordered(index);
+	if (index < island->soft_bodies.size()) {
+		island->soft_bodies[index]->set_island(island, index);
+	}
+	p_soft_body->set_island(nullptr, 0);
+
+	if (island->get_member_count() == 0) {
+		_island_free(island);
+	} else {
+		island->removed_constraint_count++;
+	}
+}
+
+void GodotSpace3D::island_link(const GodotConstraint3D *p_constraint) {
+	GodotIsland3D *island = nullptr;
+
+	for (int i = 0; i < p_constraint->get_body_count(); i++) {
+		const GodotBody3D *body = p_constraint->get_body_ptr()[i];
+		if (body->get_island() && body->get_space() == this) {
+			island = island ? _island_merge(island, body->get_island()) : body->get_island();
+		}
+	}
+
+	for (int i = 0; i < p_constraint->get_soft_body_count(); i++) {
+		const GodotSoftBody3D *soft_body = p_constraint->get_soft_body_ptr(i);
+		if (soft_body->get_island() && soft_body->get_space() == this) {
+			island = island ? _island_merge(island, soft_body->get_island()) : soft_body->get_island();
+		}
+	}
+}
+
+void GodotSpace3D::island_unlink(const GodotConstraint3D *p_constraint, GodotIsland3D *p_island) {
+	// Only a constraint between two members can leave the island disconnected.
+	int member_count = 0;
+
+	for (int i = 0; i < p_constraint->get_body_count(); i++) {
+		if (p_constraint->get_body_ptr()[i]->get_island() == p_island) {
+			member_count++;
+		}
+	}
+
+	for (int i = 0; i < p_constraint->get_soft_body_count(); i++) {
+		if (p_constraint->get_soft_body_ptr(i)->get_island() == p_island) {
+			member_count++;
+		}
+	}
+
+	if (member_count > 1) {
+		p_island->removed_constraint_count++;
+	}
+}
+
+void GodotSpace3D::island_split(GodotIsland3D *p_island) {
+	// Detach all the members, then flood fill new islands from them.
+	// The first one reuses p_island.
+	island_split_bodies = p_island->bodies;
+	island_split_soft_bodies = p_island->soft_bodies;
+
+	for (GodotBody3D *body : island_split_bodies) {
+		body->set_island(nullptr, 0);
+	}
+	for (GodotSoftBody3D *soft_body : island_split_soft_bodies) {
+		soft_body->set_island(nullptr, 0);
+	}
+
+	p_island->bodies.clear();
+	p_island->soft_bodies.clear();
+	p_island->removed_constraint_count = 0;
+
+	GodotIsland3D *island = p_island;
+
+	for (GodotBody3D *body : island_split_bodies) {
+		if (body->get_island()) {
+			continue;
+		}
+		if (!island) {
+			island = _island_create();
+		}
+		_island_push_body(island, body);
+		_island_flood_fill(island);
+		island = nullptr;
+	}
+
+	for (GodotSoftBody3D *soft_body : island_split_soft_bodies) {
+		if (soft_body->get_island()) {
+			continue;
+		}
+		if (!island) {
+			island = _island_create();
+		}
+		_island_push_soft_body(island, soft_body);
+		_island_flood_fill(island);
+		island = nullptr;
+	}
+}
+
 void GodotSpace3D::call_queries() {
 	while (state_query_list.first()) {
 		GodotBody3D *b = state_query_list.first()->self();
@@ -1272,6 +1492,9 @@ GodotSpace3D::GodotSpace3D() {
 }
 
 GodotSpace3D::~GodotSpace3D() {
+	while (island_list.first()) {
+		_island_free(island_list.first()->self());
+	}
 	memdelete(broadphase);
 	memdelete(direct_access);
 }
@@ -37,6 +37,7 @@
 #include "godot_body_pair_3d.h"
 #include "godot_broad_phase_3d.h"
 #include "godot_collision_object_3d.h"
+#include "godot_island_3d.h"
 #include "godot_soft_body_3d.h"
 
 #include "core/config/project_settings.h"
@@ -74,6 +75,7 @@ public:
 
 private:
 	uint64_t elapsed_time[ELAPSED_TIME_MAX] = {};
+	uint64_t step_time = 0;
 
 	GodotPhysicsDirectSpaceState3D *direct_access = nullptr;
 	RID self;
@@ -85,6 +87,19 @@ private:
 	SelfList<GodotArea3D>::List monitor_query_list;
 	SelfList<GodotArea3D>::List area_moved_list;
 	SelfList<GodotSoftBody3D>::List active_soft_body_list;
+	SelfList<GodotIsland3D>::List island_list;
+
+	// Members of the island being split.
+	LocalVector<GodotBody3D *> island_split_bodies;
+	LocalVector<GodotSoftBody3D *> island_split_soft_bodies;
+
+	GodotIsland3D *_island_create();
+	void _island_free(GodotIsland3D *p_island);
+	GodotIsland3D *_island_merge(GodotIsland3D *p_a, GodotIsland3D *p_b);
+	void _island_push_body(GodotIsland3D *p_island, GodotBody3D *p_body);
+	void _island_push_soft_body(GodotIsland3D *p_island, GodotSoftBody3D *p_soft_body);
+	void _island_visit_constraint(GodotIsland3D *p_island, const GodotConstraint3D *p_constraint);
+	void _island_flood_fill(GodotIsland3D *p_island);
 
 	static void *_broadphase_pair(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_self);
 	static void _broadphase_unpair(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_data, void *p_self);
@@ -154,6 +169,14 @@ public:
 	void soft_body_add_to_active_list(SelfList<GodotSoftBody3D> *p_soft_body);
 	void soft_body_remove_from_active_list(SelfList<GodotSoftBody3D> *p_soft_body);
 
+	void island_add_body(GodotBody3D *p_body);
+	void island_remove_body(GodotBody3D *p_body);
+	void island_add_soft_body(GodotSoftBody3D *p_soft_body);
+	void island_remove_soft_body(GodotSoftBody3D *p_soft_body);
+	void island_link(const GodotConstraint3D *p_constraint);
+	void island_unlink(const GodotConstraint3D *p_constraint, GodotIsland3D *p_island);
+	void island_split(GodotIsland3D *p_island);
+
 	GodotBroadPhase3D *get_broadphase();
 
 	void add_object(GodotCollisionObject3D *p_object);
@@ -209,6 +232,9 @@ public:
 	void set_elapsed_time(ElapsedTime p_time, uint64_t p_msec) { elapsed_time[p_time] = p_msec; }
 	uint64_t get_elapsed_time(ElapsedTime p_time) const { return elapsed_time[p_time]; }
 
+	void set_step_time(uint64_t p_usec) { step_time = p_usec; }
+	uint64_t get_step_time() const { return step_time; }
+
 	bool test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result);
 
 	GodotSpace3D();
@@ -34,80 +34,72 @@
 
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "core/templates/safe_refcount.h"
 
 #define BODY_ISLAND_COUNT_RESERVE 128
-#define BODY_ISLAND_SIZE_RESERVE 512
 #define ISLAND_COUNT_RESERVE 128
-#define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
 
-void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
-	p_body->set_island_step(_step);
+// Island step ids are shared by all steppers, so that a constraint between spaces
+// can never match the current step id of the other space.
+static SafeNumeric<uint64_t> island_step_counter;
 
-	if (p_body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
-		// Only rigid bodies are tested for activation.
-		p_body_island.push_back(p_body);
+template <typename T>
+void GodotStep3D::_add_active_island(GodotSpace3D *p_space, T *p_body) {
+	GodotIsland3D *island = p_body->get_island();
+	if (!island) {
+		return; // Static body.
 	}
 
-	for (const KeyValue<GodotConstraint3D *, int> &E : p_body->get_constraint_map()) {
-		GodotConstraint3D *constraint = const_cast<GodotConstraint3D *>(E.key);
-		if (constraint->get_island_step() == _step) {
-			continue; // Already processed.
-		}
-		constraint->set_island_step(_step);
-		p_constraint_island.push_back(constraint);
+	if (island->removed_constraint_count) {
+		// Constraints were removed since the island was built, it may have to be split first.
+		// The members which are no longer connected to an active body are left alone.
+		p_space->island_split(island);
+		island = p_body->get_island();
+	}
 
-		all_constraints.push_back(constraint);
+	if (island->step == _step) {
+		return; // Already added by another member.
+	}
 
-		// Find connected rigid bodies.
-		for (int i = 0; i < constraint->get_body_count(); i++) {
-			if (i == E.value) {
-				continue;
-			}
-			GodotBody3D *other_body = constraint->get_body_ptr()[i];
-			if (other_body->get_island_step() == _step) {
-				continue; // Already processed.
-			}
-			if (other_body->get_mode() == PhysicsServer3D::BODY_MODE_STATIC) {
-				continue; // Static bodies don't connect islands.
-			}
-			_populate_island(other_body, p_body_island, p_constraint_island);
+	island->step = _step;
+	active_islands.push_back(island);
+}
+
+void GodotStep3D::_populate_island(uint32_t p_island_index, void *p_userdata) {
+	const GodotIsland3D *island = active_islands[p_island_index];
+	LocalVector<GodotBody3D *> &body_island = body_islands[p_island_index];
+	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[area_island_count + p_island_index];
+
+	body_island.clear();
+	constraint_island.clear();
+
+	// Constraints only ever connect members of the same island (or static bodies and areas),
+	// so islands can be populated in parallel without sharing any constraint.
+	for (GodotBody3D *body : island->bodies) {
+		if (body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
+			// Only rigid bodies are tested for activation.
+			body_island.push_back(body);
 		}
 
-		// Find connected soft bodies.
-		for (int i = 0; i < constraint->get_soft_body_count(); i++) {
-			GodotSoftBody3D *soft_body = constraint->get_soft_body_ptr(i);
-			if (soft_body->get_island_step() == _step) {
+		for (const KeyValue<GodotConstraint3D *, int> &E : body->get_constraint_map()) {
+			GodotConstraint3D *constraint = E.key;
+			if (constraint->get_island_step() == _step) {
 				continue; // Already processed.
 			}
-			_populate_island_soft_body(soft_body, p_body_island, p_constraint_island);
+			constraint->set_island_step(_step);
+			constraint_island.push_back(constraint);
 		}
 	}
-}
-
-void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
-	p_soft_body->set_island_step(_step);
 
-	for (const GodotConstraint3D *E : p_soft_body->get_constraints()) {
-		GodotConstraint3D *constraint = const_cast<GodotConstraint3D *>(E);
-		if (constraint->get_island_step() == _step) {
-			continue; // Already processed.
-		}
-		constraint->set_island_step(_step);
-		p_constraint_island.push_back(constraint);
-
-		all_constraints.push_back(constraint);
-
-		// Find connected rigid bodies.
-		for (int i = 0; i < constraint->get_body_count(); i++) {
-			GodotBody3D *body = constraint->get_body_ptr()[i];
-			if (body->get_island_step() == _step) {
+	for (const GodotSoftBody3D *soft_body : island->soft_bodies) {
+		for (const GodotConstraint3D *E : soft_body->get_constraints()) {
+			GodotConstraint3D *constraint = const_cast<GodotConstraint3D *>(E);
+			if (constraint->get_island_step() == _step) {
 				continue; // Already processed.
 			}
-			if (body->get_mode() == PhysicsServer3D::BODY_MODE_STATIC) {
-				continue; // Static bodies don't connect islands.
-			}
-			_populate_island(body, p_body_island, p_constraint_island);
+			constraint->set_island_step(_step);
+			constraint_island.push_back(constraint);
 		}
 	}
 }
@@ -183,6 +175,8 @@ void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island
 }
 
 void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
+	_step = island_step_counter.increment();
+
 	p_space->lock(); // can't access space during this
 
 	p_space->setup(); //update inertias, etc
@@ -258,82 +252,55 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 		p_space->area_remove_from_moved_list((SelfList<GodotArea3D> *)aml.first()); //faster to remove here
 	}
 
-	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
+	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE BODIES */
 
-	b = body_list->first();
-
-	uint32_t body_island_count = 0;
+	// Islands are kept up to date by the space as constraints come and go,
+	// only the ones with an active member are stepped. Sleeping islands aren't touched.
+	area_island_count = island_count;
+	active_islands.clear();
 
+	b = body_list->first();
 	while (b) {
-		GodotBody3D *body = b->self();
-
-		if (body->get_island_step() != _step) {
-			++body_island_count;
-			if (body_islands.size() < body_island_count) {
-				body_islands.resize(body_island_count);
-			}
-			LocalVector<GodotBody3D *> &body_island = body_islands[body_island_count - 1];
-			body_island.clear();
-			body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
-
-			++island_count;
-			if (constraint_islands.size() < island_count) {
-				constraint_islands.resize(island_count);
-			}
-			LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
-			constraint_island.reserve(ISLAND_SIZE_RESERVE);
-
-			_populate_island(body, body_island, constraint_island);
-
-			if (body_island.is_empty()) {
-				--body_island_count;
-			}
-
-			if (constraint_island.is_empty()) {
-				--island_count;
-			}
-		}
+		_add_active_island(p_space, b->self());
 		b = b->next();
 	}
 
-	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE SOFT BODIES */
-
 	sb = soft_body_list->first();
 	while (sb) {
-		GodotSoftBody3D *soft_body = sb->self();
-
-		if (soft_body->get_island_step() != _step) {
-			++body_island_count;
-			if (body_islands.size() < body_island_count) {
-				body_islands.resize(body_island_count);
-			}
-			LocalVector<GodotBody3D *> &body_island = body_islands[body_island_count - 1];
-			body_island.clear();
-			body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
-
-			++island_count;
-			if (constraint_islands.size() < island_count) {
-				constraint_islands.resize(island_count);
-			}
-			LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
-			constraint_island.reserve(ISLAND_SIZE_RESERVE);
+		_add_active_island(p_space, sb->self());
+		sb = sb->next();
+	}
 
-			_populate_island_soft_body(soft_body, body_island, constraint_island);
+	uint32_t body_island_count = active_islands.size();
+	island_count += body_island_count;
+	if (body_islands.size() < body_island_count) {
+		body_islands.resize(body_island_count);
+	}
+	if (constraint_islands.size() < island_count) {
+		constraint_islands.resize(island_count);
+	}
 
-			if (body_island.is_empty()) {
-				--body_island_count;
-			}
+	if (use_threads) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_populate_island, nullptr, body_island_count, -1, true, SNAME("Physics3DPopulateIslands"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t island_index = 0; island_index < body_island_count; ++island_index) {
+			_populate_island(island_index);
+		}
+	}
 
-			if (constraint_island.is_empty()) {
-				--island_count;
-			}
+	uint32_t constraint_island_count = area_island_count;
+	for (uint32_t island_index = area_island_count; island_index < island_count; ++island_index) {
+		const LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_index];
+		for (GodotConstraint3D *constraint : constraint_island) {
+			all_constraints.push_back(constraint);
+		}
+		if (!constraint_island.is_empty()) {
+			++constraint_island_count;
 		}
-		sb = sb->next();
 	}
 
-	p_space->set_island_count((int)island_count);
+	p_space->set_island_count((int)constraint_island_count);
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -344,8 +311,14 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	if (use_threads) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t constraint_index = 0; constraint_index < total_constraint_count; ++constraint_index) {
+			_setup_constraint(constraint_index);
+		}
+	}
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -364,8 +337,14 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	// Warning: _solve_island modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	if (use_threads) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+			_solve_island(island_index);
+		}
+	}
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -392,7 +371,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	sb = soft_body_list->first();
 	while (sb) {
-		sb->self()->solve_constraints(p_delta);
+		sb->self()->solve_constraints(p_delta, use_threads);
 		sb = sb->next();
 	}
 
@@ -405,11 +384,11 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	all_constraints.clear();
 
 	p_space->unlock();
-	_step++;
 }
 
 GodotStep3D::GodotStep3D() {
 	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
+	active_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
 	all_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
 }
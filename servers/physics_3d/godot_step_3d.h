@@ -37,6 +37,7 @@
 
 class GodotStep3D {
 	uint64_t _step = 1;
+	bool use_threads = true;
 
 	int iterations = 0;
 	real_t delta = 0.0;
@@ -45,14 +46,25 @@ class GodotStep3D {
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
 
-	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
-	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
+	// Islands with an active member, in the same order as body_islands.
+	// Their constraint islands come after the ones for moving areas.
+	LocalVector<GodotIsland3D *> active_islands;
+	uint32_t area_island_count = 0;
+
+	template <typename T>
+	void _add_active_island(GodotSpace3D *p_space, T *p_body);
+	void _populate_island(uint32_t p_island_index, void *p_userdata = nullptr);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
 
 public:
+	// When disabled, constraint setup and island solving run on the calling thread.
+	// Used when several spaces are stepped in parallel, each from its own worker task.
+	void set_use_threads(bool p_use_threads) { use_threads = p_use_threads; }
+	bool is_using_threads() const { return use_threads; }
+
 	void step(GodotSpace3D *p_space, real_t p_delta);
 	GodotStep3D();
 	~GodotStep3D();
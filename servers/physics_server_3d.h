@@ -308,6 +308,9 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	// Optional, servers that don't time their steps report 0.
+	virtual double space_get_last_step_time(RID p_space) const { return 0.0; }
+
 	//missing space parameters
 
 	/* AREA API */
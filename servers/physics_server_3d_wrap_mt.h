@@ -128,6 +128,11 @@ public:
 		return physics_server_3d->space_get_contact_count(p_space);
 	}
 
+	virtual double space_get_last_step_time(RID p_space) const override {
+		ERR_FAIL_COND_V(!Thread::is_main_thread(), 0.0);
+		return physics_server_3d->space_get_last_step_time(p_space);
+	}
+
 	/* AREA API */
 
 	//FUNC0RID(area);
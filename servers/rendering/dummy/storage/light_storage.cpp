@@ -47,7 +47,16 @@ LightStorage::~LightStorage() {
 }
 
 bool LightStorage::free(RID p_rid) {
-	if (owns_lightmap(p_rid)) {
+	if (owns_light(p_rid)) {
+		light_free(p_rid);
+		return true;
+	} else if (owns_light_instance(p_rid)) {
+		light_instance_free(p_rid);
+		return true;
+	} else if (owns_shadow_atlas(p_rid)) {
+		shadow_atlas_free(p_rid);
+		return true;
+	} else if (owns_lightmap(p_rid)) {
 		lightmap_free(p_rid);
 		return true;
 	} else if (owns_lightmap_instance(p_rid)) {
@@ -58,6 +67,340 @@ bool LightStorage::free(RID p_rid) {
 	return false;
 }
 
+/* LIGHT API */
+
+void LightStorage::_light_initialize(RID p_light, RS::LightType p_type) {
+	Light light;
+	light.type = p_type;
+
+	light.param[RS::LIGHT_PARAM_ENERGY] = 1.0;
+	light.param[RS::LIGHT_PARAM_INDIRECT_ENERGY] = 1.0;
+	light.param[RS::LIGHT_PARAM_VOLUMETRIC_FOG_ENERGY] = 1.0;
+	light.param[RS::LIGHT_PARAM_SPECULAR] = 0.5;
+	light.param[RS::LIGHT_PARAM_RANGE] = 1.0;
+	light.param[RS::LIGHT_PARAM_ATTENUATION] = 1.0;
+	light.param[RS::LIGHT_PARAM_SPOT_ANGLE] = 45;
+	light.param[RS::LIGHT_PARAM_SPOT_ATTENUATION] = 1.0;
+	light.param[RS::LIGHT_PARAM_SHADOW_SPLIT_1_OFFSET] = 0.1;
+	light.param[RS::LIGHT_PARAM_SHADOW_SPLIT_2_OFFSET] = 0.3;
+	light.param[RS::LIGHT_PARAM_SHADOW_SPLIT_3_OFFSET] = 0.6;
+	light.param[RS::LIGHT_PARAM_SHADOW_FADE_START] = 0.8;
+	light.param[RS::LIGHT_PARAM_SHADOW_NORMAL_BIAS] = 1.0;
+	light.param[RS::LIGHT_PARAM_SHADOW_BIAS] = 0.02;
+	light.param[RS::LIGHT_PARAM_SHADOW_OPACITY] = 1.0;
+	light.param[RS::LIGHT_PARAM_SHADOW_PANCAKE_SIZE] = 20.0;
+	light.param[RS::LIGHT_PARAM_TRANSMITTANCE_BIAS] = 0.05;
+	light.param[RS::LIGHT_PARAM_INTENSITY] = p_type == RS::LIGHT_DIRECTIONAL ? 100000.0 : 1000.0;
+
+	light_owner.initialize_rid(p_light, light);
+}
+
+RID LightStorage::directional_light_allocate() {
+	return light_tracking ? light_owner.allocate_rid() : RID();
+}
+
+void LightStorage::directional_light_initialize(RID p_light) {
+	if (p_light.is_valid()) {
+		_light_initialize(p_light, RS::LIGHT_DIRECTIONAL);
+	}
+}
+
+RID LightStorage::omni_light_allocate() {
+	return light_tracking ? light_owner.allocate_rid() : RID();
+}
+
+void LightStorage::omni_light_initialize(RID p_light) {
+	if (p_light.is_valid()) {
+		_light_initialize(p_light, RS::LIGHT_OMNI);
+	}
+}
+
+RID LightStorage::spot_light_allocate() {
+	return light_tracking ? light_owner.allocate_rid() : RID();
+}
+
+void LightStorage::spot_light_initialize(RID p_light) {
+	if (p_light.is_valid()) {
+		_light_initialize(p_light, RS::LIGHT_SPOT);
+	}
+}
+
+void LightStorage::light_free(RID p_rid) {
+	Light *light = light_owner.get_or_null(p_rid);
+	if (light) {
+		light->dependency.deleted_notify(p_rid);
+		light_owner.free(p_rid);
+	}
+}
+
+Dependency *LightStorage::light_get_dependency(RID p_light) const {
+	Light *light = light_owner.get_or_null(p_light);
+	ERR_FAIL_NULL_V(light, nullptr);
+
+	return &light->dependency;
+}
+
+// Setters silently ignore invalid lights, as those are what allocation returns while tracking is disabled.
+
+void LightStorage::light_set_param(RID p_light, RS::LightParam p_param, float p_value) {
+	Light *light = light_owner.get_or_null(p_light);
+	if (!light) {
+		return;
+	}
+	ERR_FAIL_INDEX(p_param, RS::LIGHT_PARAM_MAX);
+
+	if (light->param[p_param] == p_value) {
+		return;
+	}
+
+	switch (p_param) {
+		case RS::LIGHT_PARAM_RANGE:
+		case RS::LIGHT_PARAM_SPOT_ANGLE:
+		case RS::LIGHT_PARAM_SHADOW_MAX_DISTANCE:
+		case RS::LIGHT_PARAM_SHADOW_SPLIT_1_OFFSET:
+		case RS::LIGHT_PARAM_SHADOW_SPLIT_2_OFFSET:
+		case RS::LIGHT_PARAM_SHADOW_SPLIT_3_OFFSET:
+		case RS::LIGHT_PARAM_SHADOW_NORMAL_BIAS:
+		case RS::LIGHT_PARAM_SHADOW_PANCAKE_SIZE:
+		case RS::LIGHT_PARAM_SHADOW_BIAS: {
+			light->version++;
+			light->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_LIGHT);
+		} break;
+		default: {
+		}
+	}
+
+	light->param[p_param] = p_value;
+}
+
+void LightStorage::light_set_shadow(RID p_light, bool p_enabled) {
+	Light *light = light_owner.get_or_null(p_light);
+	if (!light) {
+		return;
+	}
+
+	light->shadow = p_enabled;
+	light->version++;
+	light->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_LIGHT);
+}
+
+void LightStorage::light_set_cull_mask(RID p_light, uint32_t p_mask) {
+	Light *light = light_owner.get_or_null(p_light);
+	if (!light) {
+		return;
+	}
+
+	light->cull_mask = p_mask;
+	light->version++;
+	light->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_LIGHT);
+}
+
+void LightStorage::light_set_bake_mode(RID p_light, RS::LightBakeMode p_bake_mode) {
+	Light *light = light_owner.get_or_null(p_light);
+	if (!light) {
+		return;
+	}
+
+	light->bake_mode = p_bake_mode;
+	light->version++;
+	light->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_LIGHT);
+}
+
+void LightStorage::light_omni_set_shadow_mode(RID p_light, RS::LightOmniShadowMode p_mode) {
+	Light *light = light_owner.get_or_null(p_light);
+	if (!light) {
+		return;
+	}
+
+	light->omni_shadow_mode = p_mode;
+	light->version++;
+	light->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_LIGHT);
+}
+
+void LightStorage::light_directional_set_shadow_mode(RID p_light, RS::LightDirectionalShadowMode p_mode) {
+	Light *light = light_owner.get_or_null(p_light);
+	if (!light) {
+		return;
+	}
+
+	light->directional_shadow_mode = p_mode;
+	light->version++;
+	light->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_LIGHT);
+}
+
+void LightStorage::light_directional_set_blend_splits(RID p_light, bool p_enable) {
+	Light *light = light_owner.get_or_null(p_light);
+	if (!light) {
+		return;
+	}
+
+	light->directional_blend_splits = p_enable;
+	light->version++;
+	light->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_LIGHT);
+}
+
+bool LightStorage::light_directional_get_blend_splits(RID p_light) const {
+	const Light *light = light_owner.get_or_null(p_light);
+	return light ? light->directional_blend_splits : false;
+}
+
+void LightStorage::light_directional_set_sky_mode(RID p_light, RS::LightDirectionalSkyMode p_mode) {
+	Light *light = light_owner.get_or_null(p_light);
+	if (!light) {
+		return;
+	}
+
+	light->directional_sky_mode = p_mode;
+}
+
+RS::LightDirectionalSkyMode LightStorage::light_directional_get_sky_mode(RID p_light) const {
+	const Light *light = light_owner.get_or_null(p_light);
+	return light ? light->directional_sky_mode : RS::LIGHT_DIRECTIONAL_SKY_MODE_LIGHT_AND_SKY;
+}
+
+RS::LightDirectionalShadowMode LightStorage::light_directional_get_shadow_mode(RID p_light) {
+	const Light *light = light_owner.get_or_null(p_light);
+	return light ? light->directional_shadow_mode : RS::LIGHT_DIRECTIONAL_SHADOW_ORTHOGONAL;
+}
+
+RS::LightOmniShadowMode LightStorage::light_omni_get_shadow_mode(RID p_light) {
+	const Light *light = light_owner.get_or_null(p_light);
+	return light ? light->omni_shadow_mode : RS::LIGHT_OMNI_SHADOW_DUAL_PARABOLOID;
+}
+
+bool LightStorage::light_has_shadow(RID p_light) const {
+	const Light *light = light_owner.get_or_null(p_light);
+	return light ? light->shadow : false;
+}
+
+RS::LightType LightStorage::light_get_type(RID p_light) const {
+	const Light *light = light_owner.get_or_null(p_light);
+	return light ? light->type : RS::LIGHT_OMNI;
+}
+
+AABB LightStorage::light_get_aabb(RID p_light) const {
+	const Light *light = light_owner.get_or_null(p_light);
+	if (!light) {
+		return AABB();
+	}
+
+	switch (light->type) {
+		case RS::LIGHT_SPOT: {
+			float len = light->param[RS::LIGHT_PARAM_RANGE];
+			float size = Math::tan(Math::deg_to_rad(light->param[RS::LIGHT_PARAM_SPOT_ANGLE])) * len;
+			return AABB(Vector3(-size, -size, -len), Vector3(size * 2, size * 2, len));
+		};
+		case RS::LIGHT_OMNI: {
+			float r = light->param[RS::LIGHT_PARAM_RANGE];
+			return AABB(-Vector3(r, r, r), Vector3(r, r, r) * 2);
+		};
+		case RS::LIGHT_DIRECTIONAL: {
+			return AABB();
+		};
+	}
+
+	ERR_FAIL_V(AABB());
+}
+
+float LightStorage::light_get_param(RID p_light, RS::LightParam p_param) {
+	const Light *light = light_owner.get_or_null(p_light);
+	if (!light) {
+		return 0.0;
+	}
+	ERR_FAIL_INDEX_V(p_param, RS::LIGHT_PARAM_MAX, 0.0);
+
+	return light->param[p_param];
+}
+
+RS::LightBakeMode LightStorage::light_get_bake_mode(RID p_light) {
+	const Light *light = light_owner.get_or_null(p_light);
+	return light ? light->bake_mode : RS::LIGHT_BAKE_DISABLED;
+}
+
+uint64_t LightStorage::light_get_version(RID p_light) const {
+	const Light *light = light_owner.get_or_null(p_light);
+	return light ? light->version : 0;
+}
+
+uint32_t LightStorage::light_get_cull_mask(RID p_light) const {
+	const Light *light = light_owner.get_or_null(p_light);
+	return light ? light->cull_mask : 0;
+}
+
+/* LIGHT INSTANCE API */
+
+RID LightStorage::light_instance_create(RID p_light) {
+	if (!light_owner.owns(p_light)) {
+		return RID();
+	}
+
+	LightInstance light_instance;
+	light_instance.light = p_light;
+	return light_instance_owner.make_rid(light_instance);
+}
+
+void LightStorage::light_instance_free(RID p_light) {
+	if (light_instance_owner.owns(p_light)) {
+		light_instance_owner.free(p_light);
+	}
+}
+
+/* SHADOW ATLAS API */
+
+RID LightStorage::shadow_atlas_create() {
+	return light_tracking ? shadow_atlas_owner.make_rid(ShadowAtlas()) : RID();
+}
+
+void LightStorage::shadow_atlas_free(RID p_atlas) {
+	if (shadow_atlas_owner.owns(p_atlas)) {
+		shadow_atlas_owner.free(p_atlas);
+	}
+}
+
+void LightStorage::shadow_atlas_set_size(RID p_atlas, int p_size, bool p_16_bits) {
+	ShadowAtlas *shadow_atlas = shadow_atlas_owner.get_or_null(p_atlas);
+	if (shadow_atlas) {
+		shadow_atlas->size = p_size;
+	}
+}
+
+bool LightStorage::shadow_atlas_update_light(RID p_atlas, RID p_light_instance, float p_coverage, uint64_t p_light_version) {
+	const ShadowAtlas *shadow_atlas = shadow_atlas_owner.get_or_null(p_atlas);
+	LightInstance *light_instance = light_instance_owner.get_or_null(p_light_instance);
+	if (!shadow_atlas || shadow_atlas->size == 0 || !light_instance) {
+		return false;
+	}
+
+	// Nothing is drawn, but report redraws the same way a real atlas does so shadow caching behaves as on a GPU.
+	uint64_t *version = light_instance->shadow_atlas_versions.getptr(p_atlas);
+	if (!version) {
+		light_instance->shadow_atlas_versions.insert(p_atlas, p_light_version);
+		return true;
+	}
+
+	bool should_redraw = *version != p_light_version;
+	*version = p_light_version;
+	return should_redraw;
+}
+
+int LightStorage::get_directional_light_shadow_size(RID p_light_instance) {
+	const LightInstance *light_instance = light_instance_owner.get_or_null(p_light_instance);
+	if (!light_instance) {
+		return 0;
+	}
+
+	int size = directional_shadow_size;
+	switch (light_directional_get_shadow_mode(light_instance->light)) {
+		case RS::LIGHT_DIRECTIONAL_SHADOW_ORTHOGONAL:
+			break;
+		case RS::LIGHT_DIRECTIONAL_SHADOW_PARALLEL_2_SPLITS:
+		case RS::LIGHT_DIRECTIONAL_SHADOW_PARALLEL_4_SPLITS:
+			size /= 2;
+			break;
+	}
+	return size;
+}
+
 /* LIGHTMAP API */
 
 RID LightStorage::lightmap_allocate() {
@@ -31,13 +31,59 @@
 #ifndef LIGHT_STORAGE_DUMMY_H
 #define LIGHT_STORAGE_DUMMY_H
 
+#include "core/templates/hash_map.h"
 #include "servers/rendering/storage/light_storage.h"
+#include "servers/rendering/storage/utilities.h"
 
 namespace RendererDummy {
 
 class LightStorage : public RendererLightStorage {
 private:
 	static LightStorage *singleton;
+
+	/* LIGHT */
+
+	// Lights are only stored when tracking is enabled, headless exports don't need them.
+	// Tracking lets the scene culling (including shadows) run against the dummy renderer.
+	bool light_tracking = false;
+
+	struct Light {
+		RS::LightType type = RS::LIGHT_OMNI;
+		float param[RS::LIGHT_PARAM_MAX] = {};
+		bool shadow = false;
+		uint32_t cull_mask = 0xFFFFFFFF;
+		RS::LightBakeMode bake_mode = RS::LIGHT_BAKE_DYNAMIC;
+		RS::LightOmniShadowMode omni_shadow_mode = RS::LIGHT_OMNI_SHADOW_DUAL_PARABOLOID;
+		RS::LightDirectionalShadowMode directional_shadow_mode = RS::LIGHT_DIRECTIONAL_SHADOW_ORTHOGONAL;
+		bool directional_blend_splits = false;
+		RS::LightDirectionalSkyMode directional_sky_mode = RS::LIGHT_DIRECTIONAL_SKY_MODE_LIGHT_AND_SKY;
+		uint64_t version = 0;
+		Dependency dependency;
+	};
+
+	mutable RID_Owner<Light, true> light_owner;
+
+	/* LIGHT INSTANCE */
+
+	struct LightInstance {
+		RID light;
+		HashMap<RID, uint64_t> shadow_atlas_versions; // Light version last "drawn" into each atlas.
+	};
+
+	mutable RID_Owner<LightInstance> light_instance_owner;
+
+	/* SHADOW ATLAS */
+
+	struct ShadowAtlas {
+		int size = 0;
+	};
+
+	mutable RID_Owner<ShadowAtlas> shadow_atlas_owner;
+
+	int directional_shadow_size = 4096;
+
+	void _light_initialize(RID p_light, RS::LightType p_type);
+
 	/* LIGHTMAP */
 	struct Lightmap {
 		// dummy lightmap, no data
@@ -61,59 +107,67 @@ public:
 	bool free(RID p_rid);
 	/* Light API */
 
-	virtual RID directional_light_allocate() override { return RID(); }
-	virtual void directional_light_initialize(RID p_rid) override {}
-	virtual RID omni_light_allocate() override { return RID(); }
-	virtual void omni_light_initialize(RID p_rid) override {}
-	virtual RID spot_light_allocate() override { return RID(); }
-	virtual void spot_light_initialize(RID p_rid) override {}
+	void set_light_tracking_enabled(bool p_enabled) { light_tracking = p_enabled; }
+	bool is_light_tracking_enabled() const { return light_tracking; }
+
+	bool owns_light(RID p_rid) { return light_owner.owns(p_rid); }
+	Dependency *light_get_dependency(RID p_light) const;
 
-	virtual void light_free(RID p_rid) override {}
+	virtual RID directional_light_allocate() override;
+	virtual void directional_light_initialize(RID p_rid) override;
+	virtual RID omni_light_allocate() override;
+	virtual void omni_light_initialize(RID p_rid) override;
+	virtual RID spot_light_allocate() override;
+	virtual void spot_light_initialize(RID p_rid) override;
+
+	virtual void light_free(RID p_rid) override;
 
 	virtual void light_set_color(RID p_light, const Color &p_color) override {}
-	virtual void light_set_param(RID p_light, RS::LightParam p_param, float p_value) override {}
-	virtual void light_set_shadow(RID p_light, bool p_enabled) override {}
+	virtual void light_set_param(RID p_light, RS::LightParam p_param, float p_value) override;
+	virtual void light_set_shadow(RID p_light, bool p_enabled) override;
 	virtual void light_set_projector(RID p_light, RID p_texture) override {}
 	virtual void light_set_negative(RID p_light, bool p_enable) override {}
-	virtual void light_set_cull_mask(RID p_light, uint32_t p_mask) override {}
+	virtual void light_set_cull_mask(RID p_light, uint32_t p_mask) override;
 	virtual void light_set_distance_fade(RID p_light, bool p_enabled, float p_begin, float p_shadow, float p_length) override {}
 	virtual void light_set_reverse_cull_face_mode(RID p_light, bool p_enabled) override {}
-	virtual void light_set_bake_mode(RID p_light, RS::LightBakeMode p_bake_mode) override {}
+	virtual void light_set_bake_mode(RID p_light, RS::LightBakeMode p_bake_mode) override;
 	virtual void light_set_max_sdfgi_cascade(RID p_light, uint32_t p_cascade) override {}
 
-	virtual void light_omni_set_shadow_mode(RID p_light, RS::LightOmniShadowMode p_mode) override {}
+	virtual void light_omni_set_shadow_mode(RID p_light, RS::LightOmniShadowMode p_mode) override;
 
-	virtual void light_directional_set_shadow_mode(RID p_light, RS::LightDirectionalShadowMode p_mode) override {}
-	virtual void light_directional_set_blend_splits(RID p_light, bool p_enable) override {}
-	virtual bool light_directional_get_blend_splits(RID p_light) const override { return false; }
-	virtual void light_directional_set_sky_mode(RID p_light, RS::LightDirectionalSkyMode p_mode) override {}
-	virtual RS::LightDirectionalSkyMode light_directional_get_sky_mode(RID p_light) const override { return RS::LIGHT_DIRECTIONAL_SKY_MODE_LIGHT_AND_SKY; }
+	virtual void light_directional_set_shadow_mode(RID p_light, RS::LightDirectionalShadowMode p_mode) override;
+	virtual void light_directional_set_blend_splits(RID p_light, bool p_enable) override;
+	virtual bool light_directional_get_blend_splits(RID p_light) const override;
+	virtual void light_directional_set_sky_mode(RID p_light, RS::LightDirectionalSkyMode p_mode) override;
+	virtual RS::LightDirectionalSkyMode light_directional_get_sky_mode(RID p_light) const override;
 
-	virtual RS::LightDirectionalShadowMode light_directional_get_shadow_mode(RID p_light) override { return RS::LIGHT_DIRECTIONAL_SHADOW_ORTHOGONAL; }
-	virtual RS::LightOmniShadowMode light_omni_get_shadow_mode(RID p_light) override { return RS::LIGHT_OMNI_SHADOW_DUAL_PARABOLOID; }
+	virtual RS::LightDirectionalShadowMode light_directional_get_shadow_mode(RID p_light) override;
+	virtual RS::LightOmniShadowMode light_omni_get_shadow_mode(RID p_light) override;
 
-	virtual bool light_has_shadow(RID p_light) const override { return false; }
+	virtual bool light_has_shadow(RID p_light) const override;
 	virtual bool light_has_projector(RID p_light) const override { return false; }
 
-	virtual RS::LightType light_get_type(RID p_light) const override { return RS::LIGHT_OMNI; }
-	virtual AABB light_get_aabb(RID p_light) const override { return AABB(); }
-	virtual float light_get_param(RID p_light, RS::LightParam p_param) override { return 0.0; }
+	virtual RS::LightType light_get_type(RID p_light) const override;
+	virtual AABB light_get_aabb(RID p_light) const override;
+	virtual float light_get_param(RID p_light, RS::LightParam p_param) override;
 	virtual Color light_get_color(RID p_light) override { return Color(); }
 	virtual bool light_get_reverse_cull_face_mode(RID p_light) const override { return false; }
-	virtual RS::LightBakeMode light_get_bake_mode(RID p_light) override { return RS::LIGHT_BAKE_DISABLED; }
+	virtual RS::LightBakeMode light_get_bake_mode(RID p_light) override;
 	virtual uint32_t light_get_max_sdfgi_cascade(RID p_light) override { return 0; }
-	virtual uint64_t light_get_version(RID p_light) const override { return 0; }
-	virtual uint32_t light_get_cull_mask(RID p_light) const override { return 0; }
+	virtual uint64_t light_get_version(RID p_light) const override;
+	virtual uint32_t light_get_cull_mask(RID p_light) const override;
 
 	/* LIGHT INSTANCE API */
 
-	RID light_instance_create(RID p_light) override { return RID(); }
-	void light_instance_free(RID p_light) override {}
+	bool owns_light_instance(RID p_rid) { return light_instance_owner.owns(p_rid); }
+
+	RID light_instance_create(RID p_light) override;
+	void light_instance_free(RID p_light) override;
 	void light_instance_set_transform(RID p_light_instance, const Transform3D &p_transform) override {}
 	void light_instance_set_aabb(RID p_light_instance, const AABB &p_aabb) override {}
 	void light_instance_set_shadow_transform(RID p_light_instance, const Projection &p_projection, const Transform3D &p_transform, float p_far, float p_split, int p_pass, float p_shadow_texel_size, float p_bias_scale = 1.0, float p_range_begin = 0, const Vector2 &p_uv_scale = Vector2()) override {}
 	void light_instance_mark_visible(RID p_light_instance) override {}
-	virtual bool light_instance_is_shadow_visible_at_position(RID p_light_instance, const Vector3 &p_position) const override { return false; }
+	virtual bool light_instance_is_shadow_visible_at_position(RID p_light_instance, const Vector3 &p_position) const override { return light_instance_owner.owns(p_light_instance); }
 
 	/* PROBE API */
 	virtual RID reflection_probe_allocate() override { return RID(); }
@@ -198,16 +252,19 @@ public:
 	void lightmap_instance_set_transform(RID p_lightmap, const Transform3D &p_transform) override {}
 
 	/* SHADOW ATLAS API */
-	virtual RID shadow_atlas_create() override { return RID(); }
-	virtual void shadow_atlas_free(RID p_atlas) override {}
-	virtual void shadow_atlas_set_size(RID p_atlas, int p_size, bool p_16_bits = true) override {}
+
+	bool owns_shadow_atlas(RID p_rid) { return shadow_atlas_owner.owns(p_rid); }
+
+	virtual RID shadow_atlas_create() override;
+	virtual void shadow_atlas_free(RID p_atlas) override;
+	virtual void shadow_atlas_set_size(RID p_atlas, int p_size, bool p_16_bits = true) override;
 	virtual void shadow_atlas_set_quadrant_subdivision(RID p_atlas, int p_quadrant, int p_subdivision) override {}
-	virtual bool shadow_atlas_update_light(RID p_atlas, RID p_light_intance, float p_coverage, uint64_t p_light_version) override { return false; }
+	virtual bool shadow_atlas_update_light(RID p_atlas, RID p_light_intance, float p_coverage, uint64_t p_light_version) override;
 
 	virtual void shadow_atlas_update(RID p_atlas) override {}
 
-	virtual void directional_shadow_atlas_set_size(int p_size, bool p_16_bits = true) override {}
-	virtual int get_directional_light_shadow_size(RID p_light_intance) override { return 0; }
+	virtual void directional_shadow_atlas_set_size(int p_size, bool p_16_bits = true) override { directional_shadow_size = p_size; }
+	virtual int get_directional_light_shadow_size(RID p_light_intance) override;
 	virtual void set_directional_shadow_count(int p_count) override {}
 };
 
@@ -56,6 +56,8 @@ public:
 			return RS::INSTANCE_MESH;
 		} else if (RendererDummy::MeshStorage::get_singleton()->owns_multimesh(p_rid)) {
 			return RS::INSTANCE_MULTIMESH;
+		} else if (RendererDummy::LightStorage::get_singleton()->owns_light(p_rid)) {
+			return RS::INSTANCE_LIGHT;
 		} else if (RendererDummy::LightStorage::get_singleton()->owns_lightmap(p_rid)) {
 			return RS::INSTANCE_LIGHTMAP;
 		}
@@ -83,7 +85,11 @@ public:
 
 	/* DEPENDENCIES */
 
-	virtual void base_update_dependency(RID p_base, DependencyTracker *p_instance) override {}
+	virtual void base_update_dependency(RID p_base, DependencyTracker *p_instance) override {
+		if (RendererDummy::LightStorage::get_singleton()->owns_light(p_base)) {
+			p_instance->update_dependency(RendererDummy::LightStorage::get_singleton()->light_get_dependency(p_base));
+		}
+	}
 
 	/* VISIBILITY NOTIFIER */
 
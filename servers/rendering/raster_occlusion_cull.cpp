@@ -0,0 +1,594 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "raster_occlusion_cull.h"
+
+#include "core/object/worker_thread_pool.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RASTER_OCCLUSION_SIMD_SSE2
+#elif defined(__ARM_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+#include <arm_neon.h>
+#define RASTER_OCCLUSION_SIMD_NEON
+#endif
+
+void RasterOcclusionCull::RasterHZBuffer::clear() {
+	HZBuffer::clear();
+
+	tile_grid_size = Size2i();
+	stride = 0;
+	raster.clear();
+	tile_nearness.clear();
+	setup_bins.clear();
+}
+
+void RasterOcclusionCull::RasterHZBuffer::resize(const Size2i &p_size) {
+	if (p_size == Size2i()) {
+		clear();
+		return;
+	}
+
+	if (!sizes.is_empty() && p_size == sizes[0]) {
+		return; // Size didn't change
+	}
+
+	HZBuffer::resize(p_size);
+
+	// The raster is padded to whole tiles, so the rasterizer never has to handle partial vectors.
+	tile_grid_size = Size2i((p_size.x + TILE_WIDTH - 1) / TILE_WIDTH, (p_size.y + TILE_HEIGHT - 1) / TILE_HEIGHT);
+	stride = tile_grid_size.x * TILE_WIDTH;
+	raster.resize(stride * tile_grid_size.y * TILE_HEIGHT);
+	tile_nearness.resize(tile_grid_size.x * tile_grid_size.y);
+}
+
+////////////////////////////////////////////////////////
+
+bool RasterOcclusionCull::is_occluder(RID p_rid) {
+	return occluder_owner.owns(p_rid);
+}
+
+RID RasterOcclusionCull::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RasterOcclusionCull::occluder_initialize(RID p_occluder) {
+	Occluder *occluder = memnew(Occluder);
+	occluder_owner.initialize_rid(p_occluder, occluder);
+}
+
+void RasterOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+
+	occluder->vertices.clear();
+	occluder->indices.clear();
+	occluder->aabb = AABB();
+	_mark_scenarios_dirty();
+
+	const int vertex_count = p_vertices.size();
+	const int index_count = p_indices.size() - p_indices.size() % 3;
+	const int32_t *indices = p_indices.ptr();
+	for (int i = 0; i < index_count; i++) {
+		ERR_FAIL_INDEX_MSG(indices[i], vertex_count, "Occluder index out of bounds.");
+	}
+
+	occluder->vertices.resize(vertex_count);
+	for (int i = 0; i < vertex_count; i++) {
+		occluder->vertices[i] = p_vertices[i];
+		if (i == 0) {
+			occluder->aabb.position = p_vertices[i];
+		} else {
+			occluder->aabb.expand_to(p_vertices[i]);
+		}
+	}
+
+	occluder->indices.resize(index_count);
+	for (int i = 0; i < index_count; i++) {
+		occluder->indices[i] = indices[i];
+	}
+}
+
+void RasterOcclusionCull::free_occluder(RID p_occluder) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+	memdelete(occluder);
+	occluder_owner.free(p_occluder);
+	_mark_scenarios_dirty();
+}
+
+void RasterOcclusionCull::_mark_scenarios_dirty() {
+	// Occluder meshes rarely change, so instead of tracking the users of each occluder
+	// every scenario rebuilds its list of active instances.
+	for (KeyValue<RID, Scenario> &E : scenarios) {
+		E.value.dirty = true;
+	}
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_scenario(RID p_scenario) {
+	ERR_FAIL_COND(scenarios.has(p_scenario));
+	scenarios[p_scenario] = Scenario();
+}
+
+void RasterOcclusionCull::remove_scenario(RID p_scenario) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	scenarios.erase(p_scenario);
+}
+
+void RasterOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_NULL(scenario);
+
+	OccluderInstance *instance = scenario->instances.getptr(p_instance);
+	if (!instance) {
+		instance = &scenario->instances.insert(p_instance, OccluderInstance())->value;
+		scenario->dirty = true;
+	}
+
+	if (instance->occluder != p_occluder || instance->xform != p_xform || instance->enabled != p_enabled) {
+		instance->occluder = p_occluder;
+		instance->xform = p_xform;
+		instance->enabled = p_enabled;
+		scenario->dirty = true;
+	}
+}
+
+void RasterOcclusionCull::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_NULL(scenario);
+
+	if (scenario->instances.erase(p_instance)) {
+		scenario->dirty = true;
+	}
+}
+
+void RasterOcclusionCull::_update_scenario(Scenario &p_scenario) {
+	p_scenario.active_instances.clear();
+	for (KeyValue<RID, OccluderInstance> &E : p_scenario.instances) {
+		OccluderInstance &instance = E.value;
+		const Occluder *occluder = occluder_owner.get_or_null(instance.occluder);
+		if (!occluder || !instance.enabled || occluder->indices.is_empty()) {
+			continue;
+		}
+		instance.aabb = instance.xform.xform(occluder->aabb);
+		p_scenario.active_instances.push_back(&instance);
+	}
+	p_scenario.dirty = false;
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = RasterHZBuffer();
+}
+
+void RasterOcclusionCull::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+RasterOcclusionCull::HZBuffer *RasterOcclusionCull::buffer_get_ptr(RID p_buffer) {
+	return buffers.getptr(p_buffer);
+}
+
+void RasterOcclusionCull::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+}
+
+void RasterOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+RID RasterOcclusionCull::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
+
+////////////////////////////////////////////////////////
+
+static _FORCE_INLINE_ bool _aabb_outside_planes(const AABB &p_aabb, const Plane *p_planes, int p_plane_count) {
+	const Vector3 half_extents = p_aabb.size * 0.5f;
+	const Vector3 center = p_aabb.position + half_extents;
+	for (int i = 0; i < p_plane_count; i++) {
+		const Plane &p = p_planes[i];
+		const Vector3 point = center + Vector3(p.normal.x > 0 ? -half_extents.x : half_extents.x, p.normal.y > 0 ? -half_extents.y : half_extents.y, p.normal.z > 0 ? -half_extents.z : half_extents.z);
+		if (p.is_point_over(point)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void RasterOcclusionCull::_setup_triangle(const float *p_v0, const float *p_v1, const float *p_v2, const Size2i &p_size, bool p_orthogonal, LocalVector<Triangle> &r_triangles) {
+	// Project to pixel coordinates, with rows going up like NDC.
+	float x[3], y[3], n[3];
+	const float *v[3] = { p_v0, p_v1, p_v2 };
+	for (int i = 0; i < 3; i++) {
+		const float inv_w = 1.0f / v[i][3];
+		x[i] = (v[i][0] * inv_w * 0.5f + 0.5f) * p_size.x;
+		y[i] = (v[i][1] * inv_w * 0.5f + 0.5f) * p_size.y;
+		n[i] = p_orthogonal ? -v[i][2] * inv_w : inv_w;
+	}
+
+	float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+	if (area < 0.0f) {
+		// Occluders are double sided, make the winding counter-clockwise.
+		SWAP(x[1], x[2]);
+		SWAP(y[1], y[2]);
+		SWAP(n[1], n[2]);
+		area = -area;
+	}
+	if (!(area > CMP_EPSILON)) {
+		return; // Degenerate, or not finite.
+	}
+
+	// Pixels whose center lies within the bounds.
+	const int min_x = MAX(0, (int)Math::ceil(MIN(x[0], MIN(x[1], x[2])) - 0.5f));
+	const int max_x = MIN(p_size.x - 1, (int)Math::floor(MAX(x[0], MAX(x[1], x[2])) - 0.5f));
+	const int min_y = MAX(0, (int)Math::ceil(MIN(y[0], MIN(y[1], y[2])) - 0.5f));
+	const int max_y = MIN(p_size.y - 1, (int)Math::floor(MAX(y[0], MAX(y[1], y[2])) - 0.5f));
+	if (min_x > max_x || min_y > max_y) {
+		return;
+	}
+
+	Triangle triangle;
+	triangle.min_x = min_x;
+	triangle.max_x = max_x;
+	triangle.min_y = min_y;
+	triangle.max_y = max_y;
+	triangle.max_nearness = MAX(n[0], MAX(n[1], n[2]));
+
+	// Edge i is opposite to vertex i, so it is the barycentric weight of that vertex times the area.
+	const float inv_area = 1.0f / area;
+	triangle.nearness[0] = 0.0f;
+	triangle.nearness[1] = 0.0f;
+	triangle.nearness[2] = 0.0f;
+	for (int i = 0; i < 3; i++) {
+		const int a = (i + 1) % 3;
+		const int b = (i + 2) % 3;
+		float *edge = triangle.edges[i];
+		edge[0] = y[a] - y[b];
+		edge[1] = x[b] - x[a];
+		edge[2] = x[a] * y[b] - y[a] * x[b] + (edge[0] + edge[1]) * 0.5f;
+
+		for (int j = 0; j < 3; j++) {
+			triangle.nearness[j] += edge[j] * n[i] * inv_area;
+		}
+	}
+
+	r_triangles.push_back(triangle);
+}
+
+void RasterOcclusionCull::_setup_task(uint32_t p_task, UpdateData *p_data) {
+	RasterHZBuffer::SetupBin &bin = p_data->buffer->setup_bins[p_task];
+	bin.triangles.clear();
+
+	const LocalVector<OccluderInstance *> &instances = p_data->scenario->active_instances;
+	const uint32_t from = p_task * INSTANCES_PER_TASK;
+	const uint32_t to = MIN(from + INSTANCES_PER_TASK, instances.size());
+	const Size2i size = p_data->buffer->sizes[0];
+
+	for (uint32_t i = from; i < to; i++) {
+		const OccluderInstance *instance = instances[i];
+		if (_aabb_outside_planes(instance->aabb, p_data->planes.ptr(), p_data->planes.size())) {
+			continue;
+		}
+
+		const Occluder *occluder = occluder_owner.get_or_null(instance->occluder);
+		if (!occluder) {
+			continue;
+		}
+
+		// Clip space positions, four floats per vertex.
+		const Projection mvp = p_data->view_projection * Projection(instance->xform);
+		const uint32_t vertex_count = occluder->vertices.size();
+		bin.clip_vertices.resize(vertex_count * 4);
+		float *clip = bin.clip_vertices.ptr();
+		const Vector3 *vertices = occluder->vertices.ptr();
+
+#ifdef RASTER_OCCLUSION_SIMD_SSE2
+		const __m128 c0 = _mm_setr_ps(mvp.columns[0].x, mvp.columns[0].y, mvp.columns[0].z, mvp.columns[0].w);
+		const __m128 c1 = _mm_setr_ps(mvp.columns[1].x, mvp.columns[1].y, mvp.columns[1].z, mvp.columns[1].w);
+		const __m128 c2 = _mm_setr_ps(mvp.columns[2].x, mvp.columns[2].y, mvp.columns[2].z, mvp.columns[2].w);
+		const __m128 c3 = _mm_setr_ps(mvp.columns[3].x, mvp.columns[3].y, mvp.columns[3].z, mvp.columns[3].w);
+		for (uint32_t j = 0; j < vertex_count; j++) {
+			const Vector3 &vertex = vertices[j];
+			__m128 r = _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(vertex.x)), c3);
+			r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(vertex.y)));
+			r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(vertex.z)));
+			_mm_storeu_ps(&clip[j * 4], r);
+		}
+#elif defined(RASTER_OCCLUSION_SIMD_NEON)
+		float columns[4][4];
+		for (int k = 0; k < 4; k++) {
+			for (int l = 0; l < 4; l++) {
+				columns[k][l] = mvp.columns[k][l];
+			}
+		}
+		const float32x4_t c0 = vld1q_f32(columns[0]);
+		const float32x4_t c1 = vld1q_f32(columns[1]);
+		const float32x4_t c2 = vld1q_f32(columns[2]);
+		const float32x4_t c3 = vld1q_f32(columns[3]);
+		for (uint32_t j = 0; j < vertex_count; j++) {
+			const Vector3 &vertex = vertices[j];
+			float32x4_t r = vaddq_f32(vmulq_n_f32(c0, vertex.x), c3);
+			r = vaddq_f32(r, vmulq_n_f32(c1, vertex.y));
+			r = vaddq_f32(r, vmulq_n_f32(c2, vertex.z));
+			vst1q_f32(&clip[j * 4], r);
+		}
+#else
+		for (uint32_t j = 0; j < vertex_count; j++) {
+			const Vector3 &vertex = vertices[j];
+			for (int k = 0; k < 4; k++) {
+				clip[j * 4 + k] = mvp.columns[0][k] * vertex.x + mvp.columns[3][k] + mvp.columns[1][k] * vertex.y + mvp.columns[2][k] * vertex.z;
+			}
+		}
+#endif
+
+		const uint32_t *indices = occluder->indices.ptr();
+		const uint32_t index_count = occluder->indices.size();
+		for (uint32_t j = 0; j < index_count; j += 3) {
+			const float *v[3] = { &clip[indices[j] * 4], &clip[indices[j + 1] * 4], &clip[indices[j + 2] * 4] };
+
+			// Trivially reject triangles outside one of the side planes.
+			if ((v[0][0] < -v[0][3] && v[1][0] < -v[1][3] && v[2][0] < -v[2][3]) ||
+					(v[0][0] > v[0][3] && v[1][0] > v[1][3] && v[2][0] > v[2][3]) ||
+					(v[0][1] < -v[0][3] && v[1][1] < -v[1][3] && v[2][1] < -v[2][3]) ||
+					(v[0][1] > v[0][3] && v[1][1] > v[1][3] && v[2][1] > v[2][3])) {
+				continue;
+			}
+
+			// Clip against the near plane, the screen bounds are handled by the rasterizer.
+			const float d[3] = { v[0][2] + v[0][3], v[1][2] + v[1][3], v[2][2] + v[2][3] };
+			if (d[0] >= 0.0f && d[1] >= 0.0f && d[2] >= 0.0f) {
+				_setup_triangle(v[0], v[1], v[2], size, p_data->orthogonal, bin.triangles);
+				continue;
+			}
+			if (d[0] < 0.0f && d[1] < 0.0f && d[2] < 0.0f) {
+				continue;
+			}
+
+			float polygon[4][4];
+			int polygon_size = 0;
+			for (int k = 0; k < 3; k++) {
+				const int l = (k + 1) % 3;
+				if (d[k] >= 0.0f) {
+					memcpy(polygon[polygon_size++], v[k], sizeof(float) * 4);
+				}
+				if ((d[k] >= 0.0f) != (d[l] >= 0.0f)) {
+					const float t = d[k] / (d[k] - d[l]);
+					for (int c = 0; c < 4; c++) {
+						polygon[polygon_size][c] = v[k][c] + (v[l][c] - v[k][c]) * t;
+					}
+					polygon_size++;
+				}
+			}
+
+			_setup_triangle(polygon[0], polygon[1], polygon[2], size, p_data->orthogonal, bin.triangles);
+			if (polygon_size == 4) {
+				_setup_triangle(polygon[0], polygon[2], polygon[3], size, p_data->orthogonal, bin.triangles);
+			}
+		}
+	}
+}
+
+void RasterOcclusionCull::_rasterize_triangle(const Triangle &p_triangle, int p_tile_row, RasterHZBuffer *p_buffer) {
+	const int row_begin = MAX(p_triangle.min_y, p_tile_row * TILE_HEIGHT);
+	const int row_end = MIN(p_triangle.max_y, p_tile_row * TILE_HEIGHT + TILE_HEIGHT - 1);
+	const float(*e)[3] = p_triangle.edges;
+	const float *n = p_triangle.nearness;
+
+	for (int tile_x = p_triangle.min_x / TILE_WIDTH; tile_x <= p_triangle.max_x / TILE_WIDTH; tile_x++) {
+		float &tile_nearness = p_buffer->tile_nearness[p_tile_row * p_buffer->tile_grid_size.x + tile_x];
+		if (p_triangle.max_nearness <= tile_nearness) {
+			continue; // Behind something that already covers the whole tile.
+		}
+
+		const int x0 = tile_x * TILE_WIDTH;
+		const int y0 = p_tile_row * TILE_HEIGHT;
+		const int x1 = x0 + TILE_WIDTH - 1;
+		const int y1 = y0 + TILE_HEIGHT - 1;
+
+		// Edge functions are linear, so a tile is covered when its corner pixels are.
+		bool covers_tile = true;
+		for (int i = 0; i < 3 && covers_tile; i++) {
+			covers_tile = e[i][0] * x0 + e[i][1] * y0 + e[i][2] >= 0.0f && e[i][0] * x1 + e[i][1] * y0 + e[i][2] >= 0.0f &&
+					e[i][0] * x0 + e[i][1] * y1 + e[i][2] >= 0.0f && e[i][0] * x1 + e[i][1] * y1 + e[i][2] >= 0.0f;
+		}
+
+		const int column_begin = MAX(p_triangle.min_x, x0) & ~3;
+		const int column_end = MIN(p_triangle.max_x, x1);
+
+		for (int y = row_begin; y <= row_end; y++) {
+			float *row = &p_buffer->raster[y * p_buffer->stride];
+			const float row_e0 = e[0][1] * y + e[0][2];
+			const float row_e1 = e[1][1] * y + e[1][2];
+			const float row_e2 = e[2][1] * y + e[2][2];
+			const float row_n = n[1] * y + n[2];
+
+#if defined(RASTER_OCCLUSION_SIMD_SSE2)
+			const __m128 lanes = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+			const __m128 zero = _mm_setzero_ps();
+			for (int x = column_begin; x <= column_end; x += 4) {
+				const __m128 px = _mm_add_ps(_mm_set1_ps((float)x), lanes);
+				const __m128 e0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(e[0][0]), px), _mm_set1_ps(row_e0));
+				const __m128 e1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(e[1][0]), px), _mm_set1_ps(row_e1));
+				const __m128 e2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(e[2][0]), px), _mm_set1_ps(row_e2));
+				const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+				if (_mm_movemask_ps(inside) == 0) {
+					continue;
+				}
+				const __m128 nearness = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(n[0]), px), _mm_set1_ps(row_n));
+				const __m128 depth = _mm_loadu_ps(&row[x]);
+				const __m128 nearest = _mm_max_ps(depth, nearness);
+				_mm_storeu_ps(&row[x], _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, depth)));
+			}
+#elif defined(RASTER_OCCLUSION_SIMD_NEON)
+			const float lane_offsets[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+			const float32x4_t lanes = vld1q_f32(lane_offsets);
+			const float32x4_t zero = vdupq_n_f32(0.0f);
+			for (int x = column_begin; x <= column_end; x += 4) {
+				const float32x4_t px = vaddq_f32(vdupq_n_f32((float)x), lanes);
+				const float32x4_t e0 = vaddq_f32(vmulq_n_f32(px, e[0][0]), vdupq_n_f32(row_e0));
+				const float32x4_t e1 = vaddq_f32(vmulq_n_f32(px, e[1][0]), vdupq_n_f32(row_e1));
+				const float32x4_t e2 = vaddq_f32(vmulq_n_f32(px, e[2][0]), vdupq_n_f32(row_e2));
+				const uint32x4_t inside = vandq_u32(vandq_u32(vcgeq_f32(e0, zero), vcgeq_f32(e1, zero)), vcgeq_f32(e2, zero));
+				if (vmaxvq_u32(inside) == 0) {
+					continue;
+				}
+				const float32x4_t nearness = vaddq_f32(vmulq_n_f32(px, n[0]), vdupq_n_f32(row_n));
+				const float32x4_t depth = vld1q_f32(&row[x]);
+				vst1q_f32(&row[x], vbslq_f32(inside, vmaxq_f32(depth, nearness), depth));
+			}
+#else
+			for (int x = column_begin; x <= column_end; x++) {
+				const float px = x;
+				if (e[0][0] * px + row_e0 >= 0.0f && e[1][0] * px + row_e1 >= 0.0f && e[2][0] * px + row_e2 >= 0.0f) {
+					row[x] = MAX(row[x], n[0] * px + row_n);
+				}
+			}
+#endif
+		}
+
+		if (covers_tile) {
+			// The plane is linear too, so its lowest value over the tile is at a corner.
+			const float corner_nearness = MIN(MIN(n[0] * x0 + n[1] * y0 + n[2], n[0] * x1 + n[1] * y0 + n[2]), MIN(n[0] * x0 + n[1] * y1 + n[2], n[0] * x1 + n[1] * y1 + n[2]));
+			tile_nearness = MAX(tile_nearness, corner_nearness);
+		}
+	}
+}
+
+void RasterOcclusionCull::_rasterize_task(uint32_t p_tile_row, UpdateData *p_data) {
+	RasterHZBuffer *buffer = p_data->buffer;
+	const int row_begin = p_tile_row * TILE_HEIGHT;
+	const int row_end = row_begin + TILE_HEIGHT - 1;
+
+	for (const RasterHZBuffer::SetupBin &bin : buffer->setup_bins) {
+		for (const Triangle &triangle : bin.triangles) {
+			if (triangle.max_y < row_begin || triangle.min_y > row_end) {
+				continue;
+			}
+			_rasterize_triangle(triangle, p_tile_row, buffer);
+		}
+	}
+}
+
+void RasterOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	RasterHZBuffer *buffer = buffers.getptr(p_buffer);
+	if (!buffer || buffer->is_empty()) {
+		return;
+	}
+
+	Scenario *scenario = scenarios.getptr(buffer->scenario_rid);
+	if (!scenario) {
+		return;
+	}
+
+	if (scenario->dirty) {
+		_update_scenario(*scenario);
+	}
+
+	const Projection projection = _jitter_projection(p_cam_projection, buffer->get_occlusion_buffer_size());
+
+	UpdateData data;
+	data.buffer = buffer;
+	data.scenario = scenario;
+	data.view_projection = projection * Projection(p_cam_transform.affine_inverse());
+	data.planes = projection.get_projection_planes(p_cam_transform);
+	data.orthogonal = p_cam_orthogonal;
+
+	// Transform and set up the triangles, a few instances per task.
+	const uint32_t setup_count = (scenario->active_instances.size() + INSTANCES_PER_TASK - 1) / INSTANCES_PER_TASK;
+	if (buffer->setup_bins.size() < setup_count) {
+		buffer->setup_bins.resize(setup_count);
+	}
+	for (uint32_t i = setup_count; i < buffer->setup_bins.size(); i++) {
+		buffer->setup_bins[i].triangles.clear();
+	}
+	if (setup_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterOcclusionCull::_setup_task, &data, setup_count, -1, true, SNAME("RasterOcclusionCullSetup"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (setup_count == 1) {
+		_setup_task(0, &data);
+	}
+
+	// Rasterize, each row of tiles on its own task.
+	float *raster = buffer->raster.ptr();
+	for (uint32_t i = 0; i < buffer->raster.size(); i++) {
+		raster[i] = -FLT_MAX;
+	}
+	for (float &tile_nearness : buffer->tile_nearness) {
+		tile_nearness = -FLT_MAX;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterOcclusionCull::_rasterize_task, &data, buffer->tile_grid_size.y, -1, true, SNAME("RasterOcclusionCullRasterize"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Convert back to linear view depth, which is what the HZB is tested against.
+	const float z_far = p_cam_projection.get_z_far() * 1.05f;
+	const float depth_scale = 1.0f / projection.columns[2][2];
+	const float depth_offset = projection.columns[3][2];
+	const Size2i size = buffer->sizes[0];
+	float *depth = buffer->mips[0];
+	for (int y = 0; y < size.y; y++) {
+		const float *row = &raster[y * buffer->stride];
+		for (int x = 0; x < size.x; x++) {
+			const float nearness = row[x];
+			float d;
+			if (p_cam_orthogonal) {
+				d = (nearness + depth_offset) * depth_scale;
+			} else {
+				d = nearness > 0.0f ? 1.0f / nearness : z_far;
+			}
+			depth[y * size.x + x] = MIN(d, z_far);
+		}
+	}
+
+	buffer->debug_tex_range = z_far;
+	buffer->update_mips();
+}
+
+RasterOcclusionCull::RasterOcclusionCull() {
+}
+
+RasterOcclusionCull::~RasterOcclusionCull() {
+	List<RID> occluders;
+	occluder_owner.get_owned_list(&occluders);
+	for (const RID &occluder : occluders) {
+		memdelete(occluder_owner.get_or_null(occluder));
+		occluder_owner.free(occluder);
+	}
+}
@@ -0,0 +1,149 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef RASTER_OCCLUSION_CULL_H
+#define RASTER_OCCLUSION_CULL_H
+
+#include "core/math/projection.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/rid_owner.h"
+#include "servers/rendering/renderer_scene_occlusion_cull.h"
+
+// Occlusion culling backend that rasterizes the occluders on the CPU,
+// as an alternative to the Embree ray tracer of the raycast module.
+class RasterOcclusionCull : public RendererSceneOcclusionCull {
+public:
+	static const int TILE_WIDTH = 32;
+	static const int TILE_HEIGHT = 8;
+	static const int INSTANCES_PER_TASK = 16;
+
+	// A triangle set up in pixel coordinates. The rasterized value is the "nearness" of the triangle,
+	// 1/w for perspective and -z in NDC for orthogonal, which is linear in screen space and grows towards the camera.
+	struct Triangle {
+		float edges[3][3]; // A, B, C of the edge functions, positive inside, sampled at pixel centers.
+		float nearness[3]; // A, B, C of the nearness plane.
+		float max_nearness = 0.0f;
+		int min_x = 0;
+		int min_y = 0;
+		int max_x = 0;
+		int max_y = 0;
+	};
+
+	class RasterHZBuffer : public HZBuffer {
+		friend class RasterOcclusionCull;
+
+		struct SetupBin {
+			LocalVector<Triangle> triangles;
+			LocalVector<float> clip_vertices;
+		};
+
+		Size2i tile_grid_size;
+		int stride = 0;
+		LocalVector<float> raster;
+		// Conservative lowest nearness of each tile, raised when a triangle covers the whole tile,
+		// so triangles behind it can be skipped.
+		LocalVector<float> tile_nearness;
+		LocalVector<SetupBin> setup_bins;
+
+	public:
+		RID scenario_rid;
+
+		virtual void clear() override;
+		virtual void resize(const Size2i &p_size) override;
+	};
+
+private:
+	struct Occluder {
+		LocalVector<Vector3> vertices;
+		LocalVector<uint32_t> indices;
+		AABB aabb;
+	};
+
+	struct OccluderInstance {
+		RID occluder;
+		Transform3D xform;
+		AABB aabb;
+		bool enabled = true;
+	};
+
+	struct Scenario {
+		HashMap<RID, OccluderInstance> instances;
+		LocalVector<OccluderInstance *> active_instances;
+		bool dirty = false;
+	};
+
+	struct UpdateData {
+		RasterHZBuffer *buffer = nullptr;
+		const Scenario *scenario = nullptr;
+		Projection view_projection;
+		Vector<Plane> planes;
+		bool orthogonal = false;
+	};
+
+	RID_PtrOwner<Occluder> occluder_owner;
+	HashMap<RID, Scenario> scenarios;
+	HashMap<RID, RasterHZBuffer> buffers;
+
+	void _update_scenario(Scenario &p_scenario);
+	void _mark_scenarios_dirty();
+
+	static void _setup_triangle(const float *p_v0, const float *p_v1, const float *p_v2, const Size2i &p_size, bool p_orthogonal, LocalVector<Triangle> &r_triangles);
+	static void _rasterize_triangle(const Triangle &p_triangle, int p_tile_row, RasterHZBuffer *p_buffer);
+
+	void _setup_task(uint32_t p_task, UpdateData *p_data);
+	void _rasterize_task(uint32_t p_tile_row, UpdateData *p_data);
+
+public:
+	virtual bool is_occluder(RID p_rid) override;
+	virtual RID occluder_allocate() override;
+	virtual void occluder_initialize(RID p_occluder) override;
+	virtual void occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) override;
+	virtual void free_occluder(RID p_occluder) override;
+
+	virtual void add_scenario(RID p_scenario) override;
+	virtual void remove_scenario(RID p_scenario) override;
+	virtual void scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) override;
+	virtual void scenario_remove_instance(RID p_scenario, RID p_instance) override;
+
+	virtual void add_buffer(RID p_buffer) override;
+	virtual void remove_buffer(RID p_buffer) override;
+	virtual HZBuffer *buffer_get_ptr(RID p_buffer) override;
+	virtual void buffer_set_scenario(RID p_buffer, RID p_scenario) override;
+	virtual void buffer_set_size(RID p_buffer, const Vector2i &p_size) override;
+	virtual void buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) override;
+
+	virtual RID buffer_get_debug_texture(RID p_buffer) override;
+
+	RasterOcclusionCull();
+	~RasterOcclusionCull();
+};
+
+#endif // RASTER_OCCLUSION_CULL_H
@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/math/geometry_2d.h"
 #include "core/math/transform_interpolator.h"
+#include "core/object/worker_thread_pool.h"
 #include "renderer_viewport.h"
 #include "rendering_server_default.h"
 #include "rendering_server_globals.h"
@@ -44,38 +45,165 @@
 // while not making lines appear too soft.
 const static float FEATHER_SIZE = 1.25f;
 
-void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas::ChildItem *p_child_items, int p_child_item_count, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, RenderingServer::CanvasItemTextureFilter p_default_filter, RenderingServer::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, uint32_t p_canvas_cull_mask, RenderingMethod::RenderInfo *r_render_info) {
+void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas::ChildItem *p_child_items, int p_child_item_count, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, RenderingServer::CanvasItemTextureFilter p_default_filter, RenderingServer::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, uint32_t p_canvas_cull_mask, uint32_t &r_cull_item_count, RenderingMethod::RenderInfo *r_render_info) {
 	RENDER_TIMESTAMP("Cull CanvasItem Tree");
 
-	memset(z_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
-	memset(z_last_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+	RendererCanvasRender::Item *list = _cull_canvas_item_tree(p_child_items, p_child_item_count, p_transform, p_clip_rect, p_canvas_cull_mask, r_cull_item_count);
 
-	for (int i = 0; i < p_child_item_count; i++) {
-		_cull_canvas_item(p_child_items[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr, true, p_canvas_cull_mask, Point2(), 1, nullptr);
+	RENDER_TIMESTAMP("Render CanvasItems");
+
+	bool sdf_flag;
+	RSG::canvas_render->canvas_render_items(p_to_render_target, list, p_modulate, p_lights, p_directional_lights, p_transform, p_default_filter, p_default_repeat, p_snap_2d_vertices_to_pixel, sdf_flag, r_render_info);
+	if (sdf_flag) {
+		sdf_used = true;
+	}
+}
+
+RendererCanvasRender::Item *RendererCanvasCull::_cull_canvas_item_tree(Canvas::ChildItem *p_child_items, int p_child_item_count, const Transform2D &p_transform, const Rect2 &p_clip_rect, uint32_t p_canvas_cull_mask, uint32_t &r_cull_item_count) {
+
+	// Top level children are independent subtrees, so large canvases are culled in parallel.
+	// Each group of children fills its own z lists, which are concatenated in order afterwards.
+	uint32_t group_count = 1;
+	if (p_child_item_count > 1 && r_cull_item_count >= CULL_PARALLEL_MIN_ITEMS) {
+		group_count = MIN((uint32_t)p_child_item_count, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count() * 2);
+	}
+
+	if (cull_groups.size() < group_count) {
+		uint32_t from = cull_groups.size();
+		cull_groups.resize(group_count);
+		for (uint32_t i = from; i < group_count; i++) {
+			cull_groups[i].z_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
+			cull_groups[i].z_last_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
+			memset(cull_groups[i].z_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+			memset(cull_groups[i].z_last_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+		}
+	}
+
+	for (uint32_t i = 0; i < group_count; i++) {
+		int from = p_child_item_count * i / group_count;
+		int to = p_child_item_count * (i + 1) / group_count;
+		cull_groups[i].child_items = p_child_items + from;
+		cull_groups[i].child_item_count = to - from;
+	}
+
+	cull_task_data.transform = p_transform;
+	cull_task_data.clip_rect = p_clip_rect;
+	cull_task_data.canvas_cull_mask = p_canvas_cull_mask;
+
+	if (group_count > 1) {
+		cull_threaded = true;
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererCanvasCull::_cull_group_task, nullptr, group_count, -1, true, SNAME("RenderCanvasCull"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		cull_threaded = false;
+	} else {
+		_cull_group_task(0, nullptr);
 	}
 
+	r_cull_item_count = 0;
+	cull_used_z.clear();
+	for (uint32_t i = 0; i < group_count; i++) {
+		CullGroup &group = cull_groups[i];
+		r_cull_item_count += group.item_count;
+		for (int z : group.used_z) {
+			cull_used_z.push_back(z);
+		}
+
+		for (Item::VisibilityNotifierData *notifier : group.visible_notifiers) {
+			if (!notifier->visible_element.in_list()) {
+				visibility_notifier_list.add(&notifier->visible_element);
+				notifier->just_visible = true;
+			}
+		}
+		group.visible_notifiers.clear();
+
+		if (group.redraw_requested) {
+			RenderingServerDefault::redraw_request();
+			group.redraw_requested = false;
+		}
+	}
+	cull_used_z.sort();
+
 	RendererCanvasRender::Item *list = nullptr;
 	RendererCanvasRender::Item *list_end = nullptr;
 
-	for (int i = 0; i < z_range; i++) {
-		if (!z_list[i]) {
+	int last_z = -1;
+	for (int z : cull_used_z) {
+		if (z == last_z) {
 			continue;
 		}
-		if (!list) {
-			list = z_list[i];
-			list_end = z_last_list[i];
-		} else {
-			list_end->next = z_list[i];
-			list_end = z_last_list[i];
+		last_z = z;
+
+		for (uint32_t i = 0; i < group_count; i++) {
+			CullGroup &group = cull_groups[i];
+			if (!group.z_list[z]) {
+				continue;
+			}
+			if (!list) {
+				list = group.z_list[z];
+				list_end = group.z_last_list[z];
+			} else {
+				list_end->next = group.z_list[z];
+				list_end = group.z_last_list[z];
+			}
+			group.z_list[z] = nullptr;
+			group.z_last_list[z] = nullptr;
 		}
 	}
 
-	RENDER_TIMESTAMP("Render CanvasItems");
+	for (uint32_t i = 0; i < group_count; i++) {
+		cull_groups[i].used_z.clear();
+	}
 
-	bool sdf_flag;
-	RSG::canvas_render->canvas_render_items(p_to_render_target, list, p_modulate, p_lights, p_directional_lights, p_transform, p_default_filter, p_default_repeat, p_snap_2d_vertices_to_pixel, sdf_flag, r_render_info);
-	if (sdf_flag) {
-		sdf_used = true;
+	return list;
+}
+
+void RendererCanvasCull::_cull_group_task(uint32_t p_index, void *p_userdata) {
+	CullGroup &group = cull_groups[p_index];
+	group.item_count = 0;
+
+	for (int i = 0; i < group.child_item_count; i++) {
+		_cull_canvas_item(group.child_items[i].item, cull_task_data.transform, cull_task_data.clip_rect, Color(1, 1, 1, 1), 0, group, nullptr, nullptr, true, cull_task_data.canvas_cull_mask, Point2(), 1, nullptr);
+	}
+}
+
+void RendererCanvasCull::_update_subtree_bounds(Item *p_item) {
+	// Items whose drawing doesn't depend only on their own rect can't have their subtree skipped.
+	bool cullable = !p_item->vp_render && !p_item->copy_back_buffer && !p_item->canvas_group && !p_item->repeat_source && (p_item->custom_rect || !p_item->volatile_rect);
+
+	Rect2 bounds;
+	if (cullable) {
+		bounds = p_item->get_rect();
+		if (p_item->visibility_notifier && p_item->visibility_notifier->area.size != Vector2()) {
+			bounds = bounds.merge(p_item->visibility_notifier->area);
+		}
+	}
+
+	// Children are updated even when not needed, so a clean item never has dirty descendants.
+	for (Item *child : p_item->child_items) {
+		if (child->subtree_bounds_dirty) {
+			_update_subtree_bounds(child);
+		}
+		if (!cullable || !child->visible) {
+			continue;
+		}
+		if (!child->subtree_bounds_cullable || (_interpolation_data.interpolation_enabled && child->interpolated)) {
+			// Interpolated transforms can rotate out of the rect spanned by the previous and current ones.
+			cullable = false;
+			continue;
+		}
+		bounds = bounds.merge(child->xform_curr.xform(child->subtree_bounds));
+	}
+
+	p_item->subtree_bounds = bounds;
+	p_item->subtree_bounds_cullable = cullable;
+	p_item->subtree_bounds_dirty = false;
+}
+
+void RendererCanvasCull::_mark_subtree_bounds_dirty(Item *p_item) {
+	// Ancestors of a dirty item are always dirty, so the walk can stop at the first one.
+	while (p_item && !p_item->subtree_bounds_dirty) {
+		p_item->subtree_bounds_dirty = true;
+		p_item = canvas_item_owner.owns(p_item->parent) ? canvas_item_owner.get_or_null(p_item->parent) : nullptr;
 	}
 }
 
@@ -124,7 +252,7 @@ void _mark_ysort_dirty(RendererCanvasCull::Item *ysort_owner, RID_Owner<Renderer
 	} while (ysort_owner && ysort_owner->sort_y);
 }
 
-void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *ci, RendererCanvasCull::Item *p_canvas_clip, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, const Transform2D &p_transform, const Rect2 &p_clip_rect, Rect2 p_global_rect, const Color &p_modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *r_canvas_group_from) {
+void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *ci, RendererCanvasCull::Item *p_canvas_clip, CullGroup &r_group, const Transform2D &p_transform, const Rect2 &p_clip_rect, Rect2 p_global_rect, const Color &p_modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *r_canvas_group_from) {
 	if (ci->copy_back_buffer) {
 		ci->copy_back_buffer->screen_rect = p_transform.xform(ci->copy_back_buffer->rect).intersection(p_clip_rect);
 	}
@@ -133,7 +261,7 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 		int zidx = p_z - RS::CANVAS_ITEM_Z_MIN;
 		if (r_canvas_group_from == nullptr) {
 			// no list before processing this item, means must put stuff in group from the beginning of list.
-			r_canvas_group_from = r_z_list[zidx];
+			r_canvas_group_from = r_group.z_list[zidx];
 		} else {
 			// there was a list before processing, so begin group from this one.
 			r_canvas_group_from = r_canvas_group_from->next;
@@ -196,7 +324,7 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 		//something to draw?
 
 		if (ci->update_when_visible) {
-			RenderingServerDefault::redraw_request();
+			r_group.redraw_requested = true;
 		}
 
 		if (ci->commands != nullptr || ci->copy_back_buffer) {
@@ -208,13 +336,14 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 
 			int zidx = p_z - RS::CANVAS_ITEM_Z_MIN;
 
-			if (r_z_last_list[zidx]) {
-				r_z_last_list[zidx]->next = ci;
-				r_z_last_list[zidx] = ci;
+			if (r_group.z_last_list[zidx]) {
+				r_group.z_last_list[zidx]->next = ci;
+				r_group.z_last_list[zidx] = ci;
 
 			} else {
-				r_z_list[zidx] = ci;
-				r_z_last_list[zidx] = ci;
+				r_group.z_list[zidx] = ci;
+				r_group.z_last_list[zidx] = ci;
+				r_group.used_z.push_back(zidx);
 			}
 
 			ci->z_final = p_z;
@@ -223,11 +352,8 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 		}
 
 		if (ci->visibility_notifier) {
-			if (!ci->visibility_notifier->visible_element.in_list()) {
-				visibility_notifier_list.add(&ci->visibility_notifier->visible_element);
-				ci->visibility_notifier->just_visible = true;
-			}
-
+			// Added to the notifier list once culling is done, as groups may be culled in parallel.
+			r_group.visible_notifiers.push_back(ci->visibility_notifier);
 			ci->visibility_notifier->visible_in_frame = RSG::rasterizer->get_frame_number();
 		}
 	} else if (ci->repeat_source) {
@@ -236,7 +362,7 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 	}
 }
 
-void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2D &p_parent_xform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, Item *p_canvas_clip, Item *p_material_owner, bool p_allow_y_sort, uint32_t p_canvas_cull_mask, const Point2 &p_repeat_size, int p_repeat_times, RendererCanvasRender::Item *p_repeat_source_item) {
+void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2D &p_parent_xform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, CullGroup &r_group, Item *p_canvas_clip, Item *p_material_owner, bool p_allow_y_sort, uint32_t p_canvas_cull_mask, const Point2 &p_repeat_size, int p_repeat_times, RendererCanvasRender::Item *p_repeat_source_item) {
 	Item *ci = p_canvas_item;
 
 	if (!ci->visible) {
@@ -247,19 +373,13 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 		return;
 	}
 
+	r_group.item_count++;
+
 	if (ci->children_order_dirty) {
 		ci->child_items.sort_custom<ItemIndexSort>();
 		ci->children_order_dirty = false;
 	}
 
-	Rect2 rect = ci->get_rect();
-
-	if (ci->visibility_notifier) {
-		if (ci->visibility_notifier->area.size != Vector2()) {
-			rect = rect.merge(ci->visibility_notifier->area);
-		}
-	}
-
 	Transform2D final_xform;
 	if (!_interpolation_data.interpolation_enabled || !ci->interpolated) {
 		final_xform = ci->xform_curr;
@@ -291,6 +411,35 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 
 	final_xform = parent_xform * final_xform;
 
+	if (!snapping_2d_transforms_to_pixel && !repeat_source_item) {
+		// Skip the whole subtree if its cached bounds are outside the clip rect.
+		if (ci->subtree_bounds_dirty) {
+			_update_subtree_bounds(ci);
+		}
+		if (ci->subtree_bounds_cullable) {
+			Rect2 subtree_rect = final_xform.xform(ci->subtree_bounds);
+			subtree_rect.position += p_clip_rect.position;
+			if (!p_clip_rect.intersects(subtree_rect, true)) {
+				return;
+			}
+		}
+	}
+
+	Rect2 rect;
+	if (unlikely(ci->volatile_rect && cull_threaded)) {
+		// Mesh storages update their bounds lazily, which isn't safe to do from several threads.
+		MutexLock lock(volatile_rect_mutex);
+		rect = ci->get_rect();
+	} else {
+		rect = ci->get_rect();
+	}
+
+	if (ci->visibility_notifier) {
+		if (ci->visibility_notifier->area.size != Vector2()) {
+			rect = rect.merge(ci->visibility_notifier->area);
+		}
+	}
+
 	Rect2 global_rect = final_xform.xform(rect);
 	if (repeat_source_item && (repeat_size.x || repeat_size.y)) {
 		// Top-left repeated rect.
@@ -377,38 +526,38 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			sorter.sort(child_items, child_item_count);
 
 			for (i = 0; i < child_item_count; i++) {
-				_cull_canvas_item(child_items[i], final_xform * child_items[i]->ysort_xform, p_clip_rect, modulate * child_items[i]->ysort_modulate, child_items[i]->ysort_parent_abs_z_index, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, (Item *)child_items[i]->material_owner, false, p_canvas_cull_mask, child_items[i]->repeat_size, child_items[i]->repeat_times, child_items[i]->repeat_source_item);
+				_cull_canvas_item(child_items[i], final_xform * child_items[i]->ysort_xform, p_clip_rect, modulate * child_items[i]->ysort_modulate, child_items[i]->ysort_parent_abs_z_index, r_group, (Item *)ci->final_clip_owner, (Item *)child_items[i]->material_owner, false, p_canvas_cull_mask, child_items[i]->repeat_size, child_items[i]->repeat_times, child_items[i]->repeat_source_item);
 			}
 		} else {
 			RendererCanvasRender::Item *canvas_group_from = nullptr;
 			bool use_canvas_group = ci->canvas_group != nullptr && (ci->canvas_group->fit_empty || ci->commands != nullptr);
 			if (use_canvas_group) {
 				int zidx = p_z - RS::CANVAS_ITEM_Z_MIN;
-				canvas_group_from = r_z_last_list[zidx];
+				canvas_group_from = r_group.z_last_list[zidx];
 			}
 
-			_attach_canvas_item_for_draw(ci, p_canvas_clip, r_z_list, r_z_last_list, final_xform, p_clip_rect, global_rect, modulate, p_z, p_material_owner, use_canvas_group, canvas_group_from);
+			_attach_canvas_item_for_draw(ci, p_canvas_clip, r_group, final_xform, p_clip_rect, global_rect, modulate, p_z, p_material_owner, use_canvas_group, canvas_group_from);
 		}
 	} else {
 		RendererCanvasRender::Item *canvas_group_from = nullptr;
 		bool use_canvas_group = ci->canvas_group != nullptr && (ci->canvas_group->fit_empty || ci->commands != nullptr);
 		if (use_canvas_group) {
 			int zidx = p_z - RS::CANVAS_ITEM_Z_MIN;
-			canvas_group_from = r_z_last_list[zidx];
+			canvas_group_from = r_group.z_last_list[zidx];
 		}
 
 		for (int i = 0; i < child_item_count; i++) {
 			if (!child_items[i]->behind && !use_canvas_group) {
 				continue;
 			}
-			_cull_canvas_item(child_items[i], final_xform, p_clip_rect, modulate, p_z, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, p_material_owner, true, p_canvas_cull_mask, repeat_size, repeat_times, repeat_source_item);
+			_cull_canvas_item(child_items[i], final_xform, p_clip_rect, modulate, p_z, r_group, (Item *)ci->final_clip_owner, p_material_owner, true, p_canvas_cull_mask, repeat_size, repeat_times, repeat_source_item);
 		}
-		_attach_canvas_item_for_draw(ci, p_canvas_clip, r_z_list, r_z_last_list, final_xform, p_clip_rect, global_rect, modulate, p_z, p_material_owner, use_canvas_group, canvas_group_from);
+		_attach_canvas_item_for_draw(ci, p_canvas_clip, r_group, final_xform, p_clip_rect, global_rect, modulate, p_z, p_material_owner, use_canvas_group, canvas_group_from);
 		for (int i = 0; i < child_item_count; i++) {
 			if (child_items[i]->behind || use_canvas_group) {
 				continue;
 			}
-			_cull_canvas_item(child_items[i], final_xform, p_clip_rect, modulate, p_z, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, p_material_owner, true, p_canvas_cull_mask, repeat_size, repeat_times, repeat_source_item);
+			_cull_canvas_item(child_items[i], final_xform, p_clip_rect, modulate, p_z, r_group, (Item *)ci->final_clip_owner, p_material_owner, true, p_canvas_cull_mask, repeat_size, repeat_times, repeat_source_item);
 		}
 	}
 }
@@ -427,7 +576,7 @@ void RendererCanvasCull::render_canvas(RID p_render_target, Canvas *p_canvas, co
 	int l = p_canvas->child_items.size();
 	Canvas::ChildItem *ci = p_canvas->child_items.ptrw();
 
-	_render_canvas_item_tree(p_render_target, ci, l, p_transform, p_clip_rect, p_canvas->modulate, p_lights, p_directional_lights, p_default_filter, p_default_repeat, p_snap_2d_vertices_to_pixel, canvas_cull_mask, r_render_info);
+	_render_canvas_item_tree(p_render_target, ci, l, p_transform, p_clip_rect, p_canvas->modulate, p_lights, p_directional_lights, p_default_filter, p_default_repeat, p_snap_2d_vertices_to_pixel, canvas_cull_mask, p_canvas->last_cull_item_count, r_render_info);
 
 	RENDER_TIMESTAMP("< Render Canvas");
 }
@@ -452,6 +601,8 @@ void RendererCanvasCull::canvas_set_item_mirroring(RID p_canvas, RID p_item, con
 	int idx = canvas->find_item(canvas_item);
 	ERR_FAIL_COND(idx == -1);
 
+	_mark_subtree_bounds_dirty(canvas_item);
+
 	bool is_repeat_source = (p_mirroring.x || p_mirroring.y);
 	canvas_item->repeat_source = is_repeat_source;
 	canvas_item->repeat_source_item = is_repeat_source ? canvas_item : nullptr;
@@ -463,6 +614,7 @@ void RendererCanvasCull::canvas_set_item_repeat(RID p_item, const Point2 &p_repe
 	ERR_FAIL_COND(p_repeat_times < 0);
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
 
 	bool is_repeat_source = (p_repeat_size.x || p_repeat_size.y) && p_repeat_times;
 	canvas_item->repeat_source = is_repeat_source;
@@ -507,6 +659,7 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 		} else if (canvas_item_owner.owns(canvas_item->parent)) {
 			Item *item_owner = canvas_item_owner.get_or_null(canvas_item->parent);
 			item_owner->child_items.erase(canvas_item);
+			_mark_subtree_bounds_dirty(item_owner);
 
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -527,6 +680,7 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 			Item *item_owner = canvas_item_owner.get_or_null(p_parent);
 			item_owner->child_items.push_back(canvas_item);
 			item_owner->children_order_dirty = true;
+			_mark_subtree_bounds_dirty(item_owner);
 
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -543,6 +697,7 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 void RendererCanvasCull::canvas_item_set_visible(RID p_item, bool p_visible) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
 
 	canvas_item->visible = p_visible;
 
@@ -559,6 +714,7 @@ void RendererCanvasCull::canvas_item_set_light_mask(RID p_item, int p_mask) {
 void RendererCanvasCull::canvas_item_set_transform(RID p_item, const Transform2D &p_transform) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
 
 	if (_interpolation_data.interpolation_enabled && canvas_item->interpolated) {
 		if (!canvas_item->on_interpolate_transform_list) {
@@ -603,6 +759,7 @@ void RendererCanvasCull::canvas_item_set_distance_field_mode(RID p_item, bool p_
 void RendererCanvasCull::canvas_item_set_custom_rect(RID p_item, bool p_custom_rect, const Rect2 &p_rect) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
 
 	canvas_item->custom_rect = p_custom_rect;
 	canvas_item->rect = p_rect;
@@ -639,6 +796,7 @@ void RendererCanvasCull::canvas_item_set_update_when_visible(RID p_item, bool p_
 void RendererCanvasCull::canvas_item_add_line(RID p_item, const Point2 &p_from, const Point2 &p_to, const Color &p_color, float p_width, bool p_antialiased) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
 
 	Item::CommandPrimitive *line = canvas_item->alloc_command<Item::CommandPrimitive>();
 	ERR_FAIL_NULL(line);
@@ -868,6 +1026,7 @@ void RendererCanvasCull::canvas_item_add_polyline(RID p_item, const Vector<Point
 	ERR_FAIL_COND(p_points.size() < 2);
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
 
 	Color color = Color(1, 1, 1, 1);
 
@@ -1138,6 +1297,7 @@ void RendererCanvasCull::canvas_item_add_multiline(RID p_item, const Vector<Poin
 		}
 		Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 		ERR_FAIL_NULL(canvas_item);
+		_mark_subtree_bounds_dirty(canvas_item);
 
 		Vector<Color> colors;
 		if (p_colors.size() == 1) {
@@ -1180,6 +1340,7 @@ void RendererCanvasCull::canvas_item_add_multiline(RID p_item, const Vector<Poin
 void RendererCanvasCull::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, const Color &p_color, bool p_antialiased) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
@@ -1344,6 +1505,7 @@ void RendererCanvasCull::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, c
 void RendererCanvasCull::canvas_item_add_circle(RID p_item, const Point2 &p_pos, float p_radius, const Color &p_color, bool p_antialiased) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
 
 	static const int circle_segments = 64;
 
@@ -1435,6 +1597,7 @@ void RendererCanvasCull::canvas_item_add_circle(RID p_item, const Point2 &p_pos,
 void RendererCanvasCull::canvas_item_add_texture_rect(RID p_item, const Rect2 &p_rect, RID p_texture, bool p_tile, const Color &p_modulate, bool p_transpose) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
@@ -1466,6 +1629,7 @@ void RendererCanvasCull::canvas_item_add_texture_rect(RID p_item, const Rect2 &p
 void RendererCanvasCull::canvas_item_add_msdf_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, int p_outline_size, float p_px_range, float p_scale) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
@@ -1500,6 +1664,7 @@ void RendererCanvasCull::canvas_item_add_msdf_texture_rect_region(RID p_item, co
 void RendererCanvasCull::canvas_item_add_lcd_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
@@ -1532,6 +1697,7 @@ void RendererCanvasCull::canvas_item_add_lcd_texture_rect_region(RID p_item, con
 void RendererCanvasCull::canvas_item_add_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, bool p_transpose, bool p_clip_uv) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
@@ -1573,6 +1739,7 @@ void RendererCanvasCull::canvas_item_add_texture_rect_region(RID p_item, const R
 void RendererCanvasCull::canvas_item_add_nine_patch(RID p_item, const Rect2 &p_rect, const Rect2 &p_source, RID p_texture, const Vector2 &p_topleft, const Vector2 &p_bottomright, RS::NinePatchAxisMode p_x_axis_mode, RS::NinePatchAxisMode p_y_axis_mode, bool p_draw_center, const Color &p_modulate) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
 
 	Item::CommandNinePatch *style = canvas_item->alloc_command<Item::CommandNinePatch>();
 	ERR_FAIL_NULL(style);
@@ -1597,6 +1764,7 @@ void RendererCanvasCull::canvas_item_add_primitive(RID p_item, const Vector<Poin
 
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
 
 	Item::CommandPrimitive *prim = canvas_item->alloc_command<Item::CommandPrimitive>();
 	ERR_FAIL_NULL(prim);
@@ -1623,6 +1791,7 @@ void RendererCanvasCull::canvas_item_add_primitive(RID p_item, const Vector<Poin
 void RendererCanvasCull::canvas_item_add_polygon(RID p_item, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
 #ifdef DEBUG_ENABLED
 	int pointcount = p_points.size();
 	ERR_FAIL_COND(pointcount < 3);
@@ -1644,6 +1813,7 @@ void RendererCanvasCull::canvas_item_add_polygon(RID p_item, const Vector<Point2
 void RendererCanvasCull::canvas_item_add_triangle_array(RID p_item, const Vector<int> &p_indices, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, const Vector<int> &p_bones, const Vector<float> &p_weights, RID p_texture, int p_count) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
 
 	int vertex_count = p_points.size();
 	ERR_FAIL_COND(vertex_count == 0);
@@ -1665,6 +1835,7 @@ void RendererCanvasCull::canvas_item_add_triangle_array(RID p_item, const Vector
 void RendererCanvasCull::canvas_item_add_set_transform(RID p_item, const Transform2D &p_transform) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
 
 	Item::CommandTransform *tr = canvas_item->alloc_command<Item::CommandTransform>();
 	ERR_FAIL_NULL(tr);
@@ -1674,6 +1845,8 @@ void RendererCanvasCull::canvas_item_add_set_transform(RID p_item, const Transfo
 void RendererCanvasCull::canvas_item_add_mesh(RID p_item, const RID &p_mesh, const Transform2D &p_transform, const Color &p_modulate, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
+	canvas_item->volatile_rect = true;
 	ERR_FAIL_COND(!p_mesh.is_valid());
 
 	Item::CommandMesh *m = canvas_item->alloc_command<Item::CommandMesh>();
@@ -1693,6 +1866,8 @@ void RendererCanvasCull::canvas_item_add_mesh(RID p_item, const RID &p_mesh, con
 void RendererCanvasCull::canvas_item_add_particles(RID p_item, RID p_particles, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
+	canvas_item->volatile_rect = true;
 
 	Item::CommandParticles *part = canvas_item->alloc_command<Item::CommandParticles>();
 	ERR_FAIL_NULL(part);
@@ -1707,6 +1882,8 @@ void RendererCanvasCull::canvas_item_add_particles(RID p_item, RID p_particles,
 void RendererCanvasCull::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
+	canvas_item->volatile_rect = true;
 
 	Item::CommandMultiMesh *mm = canvas_item->alloc_command<Item::CommandMultiMesh>();
 	ERR_FAIL_NULL(mm);
@@ -1718,6 +1895,7 @@ void RendererCanvasCull::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p
 void RendererCanvasCull::canvas_item_add_clip_ignore(RID p_item, bool p_ignore) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
 
 	Item::CommandClipIgnore *ci = canvas_item->alloc_command<Item::CommandClipIgnore>();
 	ERR_FAIL_NULL(ci);
@@ -1727,6 +1905,7 @@ void RendererCanvasCull::canvas_item_add_clip_ignore(RID p_item, bool p_ignore)
 void RendererCanvasCull::canvas_item_add_animation_slice(RID p_item, double p_animation_length, double p_slice_begin, double p_slice_end, double p_offset) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
 
 	Item::CommandAnimationSlice *as = canvas_item->alloc_command<Item::CommandAnimationSlice>();
 	ERR_FAIL_NULL(as);
@@ -1793,6 +1972,7 @@ void RendererCanvasCull::canvas_item_attach_skeleton(RID p_item, RID p_skeleton)
 void RendererCanvasCull::canvas_item_set_copy_to_backbuffer(RID p_item, bool p_enable, const Rect2 &p_rect) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
 	if (p_enable && (canvas_item->copy_back_buffer == nullptr)) {
 		canvas_item->copy_back_buffer = memnew(RendererCanvasRender::Item::CopyBackBuffer);
 	}
@@ -1810,6 +1990,8 @@ void RendererCanvasCull::canvas_item_set_copy_to_backbuffer(RID p_item, bool p_e
 void RendererCanvasCull::canvas_item_clear(RID p_item) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
+	canvas_item->volatile_rect = false;
 
 	canvas_item->clear();
 #ifdef DEBUG_ENABLED
@@ -1855,6 +2037,7 @@ void RendererCanvasCull::canvas_item_set_use_parent_material(RID p_item, bool p_
 void RendererCanvasCull::canvas_item_set_visibility_notifier(RID p_item, bool p_enable, const Rect2 &p_area, const Callable &p_enter_callable, const Callable &p_exit_callable) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
 
 	if (p_enable) {
 		if (!canvas_item->visibility_notifier) {
@@ -1884,6 +2067,7 @@ bool RendererCanvasCull::canvas_item_get_debug_redraw() const {
 void RendererCanvasCull::canvas_item_set_interpolated(RID p_item, bool p_interpolated) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
 	canvas_item->interpolated = p_interpolated;
 }
 
@@ -1897,6 +2081,7 @@ void RendererCanvasCull::canvas_item_reset_physics_interpolation(RID p_item) {
 void RendererCanvasCull::canvas_item_transform_physics_interpolation(RID p_item, const Transform2D &p_transform) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
 	canvas_item->xform_prev = p_transform * canvas_item->xform_prev;
 	canvas_item->xform_curr = p_transform * canvas_item->xform_curr;
 }
@@ -1904,6 +2089,7 @@ void RendererCanvasCull::canvas_item_transform_physics_interpolation(RID p_item,
 void RendererCanvasCull::canvas_item_set_canvas_group_mode(RID p_item, RS::CanvasGroupMode p_mode, float p_clear_margin, bool p_fit_empty, float p_fit_margin, bool p_blur_mipmaps) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_bounds_dirty(canvas_item);
 
 	if (p_mode == RS::CANVAS_GROUP_MODE_DISABLED) {
 		if (canvas_item->canvas_group != nullptr) {
@@ -2421,6 +2607,7 @@ bool RendererCanvasCull::free(RID p_rid) {
 			} else if (canvas_item_owner.owns(canvas_item->parent)) {
 				Item *item_owner = canvas_item_owner.get_or_null(canvas_item->parent);
 				item_owner->child_items.erase(canvas_item);
+				_mark_subtree_bounds_dirty(item_owner);
 
 				if (item_owner->sort_y) {
 					_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -2532,6 +2719,20 @@ void RendererCanvasCull::tick() {
 	}
 }
 
+void RendererCanvasCull::set_physics_interpolation_enabled(bool p_enabled) {
+	if (_interpolation_data.interpolation_enabled == p_enabled) {
+		return;
+	}
+	_interpolation_data.interpolation_enabled = p_enabled;
+
+	// Interpolated children make their parent's cached bounds unusable, so refresh them all.
+	List<RID> items;
+	canvas_item_owner.get_owned_list(&items);
+	for (const RID &E : items) {
+		canvas_item_owner.get_or_null(E)->subtree_bounds_dirty = true;
+	}
+}
+
 void RendererCanvasCull::update_interpolation_tick(bool p_process) {
 #define GODOT_UPDATE_INTERPOLATION_TICK(m_list_prev, m_list_curr, m_type, m_owner_list)      \
 	/* Detect any that were on the previous transform list that are no longer active. */     \
@@ -2602,9 +2803,6 @@ void RendererCanvasCull::InterpolationData::notify_free_canvas_light_occluder(RI
 }
 
 RendererCanvasCull::RendererCanvasCull() {
-	z_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
-	z_last_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
-
 	disable_scale = false;
 
 	debug_redraw_time = GLOBAL_DEF("debug/canvas_items/debug_redraw_time", 1.0);
@@ -2612,6 +2810,8 @@ RendererCanvasCull::RendererCanvasCull() {
 }
 
 RendererCanvasCull::~RendererCanvasCull() {
-	memfree(z_list);
-	memfree(z_last_list);
+	for (CullGroup &group : cull_groups) {
+		memfree(group.z_list);
+		memfree(group.z_last_list);
+	}
 }
@@ -36,6 +36,8 @@
 #include "renderer_viewport.h"
 
 class RendererCanvasCull {
+	friend class TestRendererCanvasCullInternalsAccessor;
+
 public:
 	struct Item : public RendererCanvasRender::Item {
 		RID parent; // canvas it belongs to
@@ -58,6 +60,14 @@ public:
 
 		Vector<Item *> child_items;
 
+		// Cached bounds of this item and its visible descendants, in local space.
+		// Only usable for culling when the whole subtree has stable rects.
+		Rect2 subtree_bounds;
+		bool subtree_bounds_dirty = true;
+		bool subtree_bounds_cullable = false;
+		// The rect depends on data owned by other storages (meshes, multimeshes, particles).
+		bool volatile_rect = false;
+
 		struct VisibilityNotifierData {
 			Rect2 area;
 			Callable enter_callable;
@@ -142,6 +152,7 @@ public:
 		Color modulate;
 		RID parent;
 		float parent_scale;
+		uint32_t last_cull_item_count = 0;
 
 		int find_item(Item *p_item) {
 			for (int i = 0; i < child_items.size(); i++) {
@@ -183,16 +194,47 @@ public:
 	PagedAllocator<Item::VisibilityNotifierData> visibility_notifier_allocator;
 	SelfList<Item::VisibilityNotifierData>::List visibility_notifier_list;
 
-	_FORCE_INLINE_ void _attach_canvas_item_for_draw(Item *ci, Item *p_canvas_clip, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, const Transform2D &p_transform, const Rect2 &p_clip_rect, Rect2 p_global_rect, const Color &modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *r_canvas_group_from);
+	// Culling output of a range of top level canvas children, merged by z index once all ranges are culled.
+	struct CullGroup {
+		Canvas::ChildItem *child_items = nullptr;
+		int child_item_count = 0;
+
+		RendererCanvasRender::Item **z_list = nullptr;
+		RendererCanvasRender::Item **z_last_list = nullptr;
+		LocalVector<int> used_z;
+
+		LocalVector<Item::VisibilityNotifierData *> visible_notifiers;
+		uint32_t item_count = 0;
+		bool redraw_requested = false;
+	};
+
+	_FORCE_INLINE_ void _attach_canvas_item_for_draw(Item *ci, Item *p_canvas_clip, CullGroup &r_group, const Transform2D &p_transform, const Rect2 &p_clip_rect, Rect2 p_global_rect, const Color &modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *r_canvas_group_from);
 
 private:
-	void _render_canvas_item_tree(RID p_to_render_target, Canvas::ChildItem *p_child_items, int p_child_item_count, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, uint32_t p_canvas_cull_mask, RenderingMethod::RenderInfo *r_render_info = nullptr);
-	void _cull_canvas_item(Item *p_canvas_item, const Transform2D &p_parent_xform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, Item *p_canvas_clip, Item *p_material_owner, bool p_allow_y_sort, uint32_t p_canvas_cull_mask, const Point2 &p_repeat_size, int p_repeat_times, RendererCanvasRender::Item *p_repeat_source_item);
+	void _render_canvas_item_tree(RID p_to_render_target, Canvas::ChildItem *p_child_items, int p_child_item_count, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, uint32_t p_canvas_cull_mask, uint32_t &r_cull_item_count, RenderingMethod::RenderInfo *r_render_info = nullptr);
+	RendererCanvasRender::Item *_cull_canvas_item_tree(Canvas::ChildItem *p_child_items, int p_child_item_count, const Transform2D &p_transform, const Rect2 &p_clip_rect, uint32_t p_canvas_cull_mask, uint32_t &r_cull_item_count);
+	void _cull_canvas_item(Item *p_canvas_item, const Transform2D &p_parent_xform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, CullGroup &r_group, Item *p_canvas_clip, Item *p_material_owner, bool p_allow_y_sort, uint32_t p_canvas_cull_mask, const Point2 &p_repeat_size, int p_repeat_times, RendererCanvasRender::Item *p_repeat_source_item);
+
+	void _cull_group_task(uint32_t p_index, void *p_userdata);
+
+	void _update_subtree_bounds(Item *p_item);
+	void _mark_subtree_bounds_dirty(Item *p_item);
 
 	static constexpr int z_range = RS::CANVAS_ITEM_Z_MAX - RS::CANVAS_ITEM_Z_MIN + 1;
 
-	RendererCanvasRender::Item **z_list;
-	RendererCanvasRender::Item **z_last_list;
+	// Canvases with fewer culled items than this in the previous frame are culled on the calling thread.
+	static constexpr uint32_t CULL_PARALLEL_MIN_ITEMS = 2048;
+
+	LocalVector<CullGroup> cull_groups;
+	LocalVector<int> cull_used_z;
+	bool cull_threaded = false;
+	BinaryMutex volatile_rect_mutex;
+
+	struct CullTaskData {
+		Transform2D transform;
+		Rect2 clip_rect;
+		uint32_t canvas_cull_mask = 0;
+	} cull_task_data;
 
 public:
 	void render_canvas(RID p_render_target, Canvas *p_canvas, const Transform2D &p_transform, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, const Rect2 &p_clip_rect, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_transforms_to_pixel, bool p_snap_2d_vertices_to_pixel, uint32_t p_canvas_cull_mask, RenderingMethod::RenderInfo *r_render_info = nullptr);
@@ -351,7 +393,7 @@ public:
 
 	void tick();
 	void update_interpolation_tick(bool p_process = true);
-	void set_physics_interpolation_enabled(bool p_enabled) { _interpolation_data.interpolation_enabled = p_enabled; }
+	void set_physics_interpolation_enabled(bool p_enabled);
 
 	struct InterpolationData {
 		void notify_free_canvas_item(RID p_rid, RendererCanvasCull::Item &r_canvas_item);
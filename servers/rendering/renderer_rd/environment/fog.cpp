@@ -368,6 +368,12 @@ RS::ShaderNativeSourceCode Fog::FogShaderData::get_native_source_code() const {
 	return fog_singleton->volumetric_fog.shader.version_get_native_source_code(version);
 }
 
+ShaderCompiler *Fog::FogShaderData::get_compiler() const {
+	Fog *fog_singleton = Fog::get_singleton();
+
+	return &fog_singleton->volumetric_fog.compiler;
+}
+
 Fog::FogShaderData::~FogShaderData() {
 	Fog *fog_singleton = Fog::get_singleton();
 	ERR_FAIL_NULL(fog_singleton);
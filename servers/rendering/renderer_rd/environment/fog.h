@@ -203,6 +203,7 @@ private:
 		virtual bool is_animated() const;
 		virtual bool casts_shadows() const;
 		virtual RS::ShaderNativeSourceCode get_native_source_code() const;
+		virtual ShaderCompiler *get_compiler() const;
 
 		FogShaderData() {}
 		virtual ~FogShaderData();
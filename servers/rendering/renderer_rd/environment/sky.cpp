@@ -168,6 +168,12 @@ RS::ShaderNativeSourceCode SkyRD::SkyShaderData::get_native_source_code() const
 	return scene_singleton->sky.sky_shader.shader.version_get_native_source_code(version);
 }
 
+ShaderCompiler *SkyRD::SkyShaderData::get_compiler() const {
+	RendererSceneRenderRD *scene_singleton = static_cast<RendererSceneRenderRD *>(RendererSceneRenderRD::singleton);
+
+	return &scene_singleton->sky.sky_shader.compiler;
+}
+
 SkyRD::SkyShaderData::~SkyShaderData() {
 	RendererSceneRenderRD *scene_singleton = static_cast<RendererSceneRenderRD *>(RendererSceneRenderRD::singleton);
 	ERR_FAIL_NULL(scene_singleton);
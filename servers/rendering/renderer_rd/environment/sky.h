@@ -127,6 +127,7 @@ private:
 		virtual bool is_animated() const;
 		virtual bool casts_shadows() const;
 		virtual RS::ShaderNativeSourceCode get_native_source_code() const;
+		virtual ShaderCompiler *get_compiler() const;
 
 		SkyShaderData() {}
 		virtual ~SkyShaderData();
@@ -427,6 +427,12 @@ RS::ShaderNativeSourceCode SceneShaderForwardClustered::ShaderData::get_native_s
 	return shader_singleton->shader.version_get_native_source_code(version);
 }
 
+ShaderCompiler *SceneShaderForwardClustered::ShaderData::get_compiler() const {
+	SceneShaderForwardClustered *shader_singleton = (SceneShaderForwardClustered *)SceneShaderForwardClustered::singleton;
+
+	return &shader_singleton->compiler;
+}
+
 SceneShaderForwardClustered::ShaderData::ShaderData() :
 		shader_list_element(this) {
 }
@@ -193,6 +193,7 @@ public:
 		virtual bool is_animated() const;
 		virtual bool casts_shadows() const;
 		virtual RS::ShaderNativeSourceCode get_native_source_code() const;
+		virtual ShaderCompiler *get_compiler() const;
 
 		SelfList<ShaderData> shader_list_element;
 		ShaderData();
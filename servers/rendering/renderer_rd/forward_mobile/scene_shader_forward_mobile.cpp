@@ -379,6 +379,12 @@ RS::ShaderNativeSourceCode SceneShaderForwardMobile::ShaderData::get_native_sour
 	return shader_singleton->shader.version_get_native_source_code(version);
 }
 
+ShaderCompiler *SceneShaderForwardMobile::ShaderData::get_compiler() const {
+	SceneShaderForwardMobile *shader_singleton = (SceneShaderForwardMobile *)SceneShaderForwardMobile::singleton;
+
+	return &shader_singleton->compiler;
+}
+
 SceneShaderForwardMobile::ShaderData::ShaderData() :
 		shader_list_element(this) {
 }
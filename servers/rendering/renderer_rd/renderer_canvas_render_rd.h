@@ -183,6 +183,7 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 		virtual bool is_animated() const;
 		virtual bool casts_shadows() const;
 		virtual RS::ShaderNativeSourceCode get_native_source_code() const;
+		virtual ShaderCompiler *get_compiler() const;
 
 		CanvasShaderData() {}
 		virtual ~CanvasShaderData();
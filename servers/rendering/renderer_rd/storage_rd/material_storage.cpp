@@ -1824,11 +1824,7 @@ RID MaterialStorage::shader_allocate() {
 }
 
 void MaterialStorage::shader_initialize(RID p_rid) {
-	Shader shader;
-	shader.data = nullptr;
-	shader.type = SHADER_TYPE_MAX;
-
-	shader_owner.initialize_rid(p_rid, shader);
+	shader_owner.initialize_rid(p_rid);
 }
 
 void MaterialStorage::shader_free(RID p_rid) {
@@ -1840,6 +1836,10 @@ void MaterialStorage::shader_free(RID p_rid) {
 		material_set_shader((*shader->owners.begin())->self, RID());
 	}
 
+	if (shader->update_element.in_list()) {
+		shader_update_list.remove(&shader->update_element);
+	}
+
 	//clear data if exists
 	if (shader->data) {
 		memdelete(shader->data);
@@ -1914,7 +1914,10 @@ void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
 
 	if (shader->data) {
 		shader->data->set_path_hint(shader->path_hint);
-		shader->data->set_code(p_code);
+		// Compiled by _update_queued_shaders(), together with the other shaders changed before use.
+		if (!shader->update_element.in_list()) {
+			shader_update_list.add(&shader->update_element);
+		}
 	}
 
 	for (Material *E : shader->owners) {
@@ -1941,6 +1944,8 @@ String MaterialStorage::shader_get_code(RID p_shader) const {
 }
 
 void MaterialStorage::get_shader_parameter_list(RID p_shader, List<PropertyInfo> *p_param_list) const {
+	_update_queued_shaders();
+
 	Shader *shader = shader_owner.get_or_null(p_shader);
 	ERR_FAIL_NULL(shader);
 	if (shader->data) {
@@ -1986,6 +1991,8 @@ RID MaterialStorage::shader_get_default_texture_parameter(RID p_shader, const St
 }
 
 Variant MaterialStorage::shader_get_parameter_default(RID p_shader, const StringName &p_param) const {
+	_update_queued_shaders();
+
 	Shader *shader = shader_owner.get_or_null(p_shader);
 	ERR_FAIL_NULL_V(shader, Variant());
 	if (shader->data) {
@@ -2000,6 +2007,8 @@ void MaterialStorage::shader_set_data_request_function(ShaderType p_shader_type,
 }
 
 RS::ShaderNativeSourceCode MaterialStorage::shader_get_native_source_code(RID p_shader) const {
+	_update_queued_shaders();
+
 	Shader *shader = shader_owner.get_or_null(p_shader);
 	ERR_FAIL_NULL_V(shader, RS::ShaderNativeSourceCode());
 	if (shader->data) {
@@ -2008,6 +2017,34 @@ RS::ShaderNativeSourceCode MaterialStorage::shader_get_native_source_code(RID p_
 	return RS::ShaderNativeSourceCode();
 }
 
+void MaterialStorage::_update_queued_shaders() const {
+	if (!shader_update_list.first()) {
+		return;
+	}
+
+	// Shaders are independent, so the new code of all of them is compiled on the
+	// WorkerThreadPool first. Each set_code() below then gets it from the compiler cache.
+	HashMap<ShaderCompiler *, LocalVector<String>> batches;
+	for (SelfList<Shader> *E = shader_update_list.first(); E; E = E->next()) {
+		const Shader *shader = E->self();
+		ShaderCompiler *compiler = shader->data ? shader->data->get_compiler() : nullptr;
+		if (compiler && !shader->code.is_empty()) {
+			batches[compiler].push_back(shader->code);
+		}
+	}
+	for (KeyValue<ShaderCompiler *, LocalVector<String>> &E : batches) {
+		E.key->precompile(E.value);
+	}
+
+	while (shader_update_list.first()) {
+		Shader *shader = shader_update_list.first()->self();
+		shader_update_list.remove(&shader->update_element);
+		if (shader->data) {
+			shader->data->set_code(shader->code);
+		}
+	}
+}
+
 /* MATERIAL API */
 
 void MaterialStorage::_material_uniform_set_erased(void *p_material) {
@@ -2035,6 +2072,9 @@ void MaterialStorage::_material_queue_update(Material *material, bool p_uniform,
 }
 
 void MaterialStorage::_update_queued_materials() {
+	// Materials read the uniforms of their shader.
+	_update_queued_shaders();
+
 	while (material_update_list.first()) {
 		Material *material = material_update_list.first()->self();
 		bool uniforms_changed = false;
@@ -2126,6 +2166,8 @@ void MaterialStorage::material_set_shader(RID p_material, RID p_shader) {
 }
 
 MaterialStorage::ShaderData *MaterialStorage::material_get_shader_data(RID p_material) {
+	_update_queued_shaders();
+
 	const MaterialStorage::Material *material = MaterialStorage::get_singleton()->get_material(p_material);
 	if (material && material->shader && material->shader->data) {
 		return material->shader->data;
@@ -2145,7 +2187,7 @@ void MaterialStorage::material_set_param(RID p_material, const StringName &p_par
 		material->params[p_param] = p_value;
 	}
 
-	if (material->shader && material->shader->data) { //shader is valid
+	if (material->shader && material->shader->data && !material->shader->update_element.in_list()) { //shader is valid and compiled
 		bool is_texture = material->shader->data->is_parameter_texture(p_param);
 		_material_queue_update(material, !is_texture, is_texture);
 	} else {
@@ -2190,6 +2232,8 @@ void MaterialStorage::material_set_render_priority(RID p_material, int priority)
 }
 
 bool MaterialStorage::material_is_animated(RID p_material) {
+	_update_queued_shaders();
+
 	Material *material = material_owner.get_or_null(p_material);
 	ERR_FAIL_NULL_V(material, false);
 	if (material->shader && material->shader->data) {
@@ -2203,6 +2247,8 @@ bool MaterialStorage::material_is_animated(RID p_material) {
 }
 
 bool MaterialStorage::material_casts_shadows(RID p_material) {
+	_update_queued_shaders();
+
 	Material *material = material_owner.get_or_null(p_material);
 	ERR_FAIL_NULL_V(material, true);
 	if (material->shader && material->shader->data) {
@@ -2216,6 +2262,8 @@ bool MaterialStorage::material_casts_shadows(RID p_material) {
 }
 
 void MaterialStorage::material_get_instance_shader_parameters(RID p_material, List<InstanceShaderParam> *r_parameters) {
+	_update_queued_shaders();
+
 	Material *material = material_owner.get_or_null(p_material);
 	ERR_FAIL_NULL(material);
 	if (material->shader && material->shader->data) {
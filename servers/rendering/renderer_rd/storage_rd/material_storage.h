@@ -71,6 +71,8 @@ public:
 		virtual bool is_animated() const = 0;
 		virtual bool casts_shadows() const = 0;
 		virtual RS::ShaderNativeSourceCode get_native_source_code() const { return RS::ShaderNativeSourceCode(); }
+		// The compiler set_code() uses, so queued shaders can be compiled together.
+		virtual ShaderCompiler *get_compiler() const { return nullptr; }
 
 		virtual ~ShaderData() {}
 	};
@@ -204,9 +206,13 @@ private:
 		ShaderData *data = nullptr;
 		String code;
 		String path_hint;
-		ShaderType type;
+		ShaderType type = SHADER_TYPE_MAX;
 		HashMap<StringName, HashMap<int, RID>> default_texture_parameter;
 		HashSet<Material *> owners;
+		SelfList<Shader> update_element;
+
+		Shader() :
+				update_element(this) {}
 	};
 
 	typedef ShaderData *(*ShaderDataRequestFunction)();
@@ -215,6 +221,9 @@ private:
 	mutable RID_Owner<Shader, true> shader_owner;
 	Shader *get_shader(RID p_rid) { return shader_owner.get_or_null(p_rid); }
 
+	// Shaders whose code changed, compiled together on first use.
+	mutable SelfList<Shader>::List shader_update_list;
+
 	/* MATERIAL API */
 
 	typedef MaterialData *(*MaterialDataRequestFunction)(ShaderData *);
@@ -407,6 +416,8 @@ public:
 
 	virtual RS::ShaderNativeSourceCode shader_get_native_source_code(RID p_shader) const override;
 
+	void _update_queued_shaders() const;
+
 	/* MATERIAL API */
 
 	bool owns_material(RID p_rid) { return material_owner.owns(p_rid); };
@@ -443,6 +454,9 @@ public:
 	}
 
 	_FORCE_INLINE_ MaterialData *material_get_data(RID p_material, ShaderType p_shader_type) {
+		if (unlikely(shader_update_list.first())) {
+			_update_queued_shaders();
+		}
 		Material *material = material_owner.get_or_null(p_material);
 		if (!material || material->shader_type != p_shader_type) {
 			return nullptr;
@@ -1976,6 +1976,35 @@ void MeshStorage::multimesh_set_buffer(RID p_multimesh, const Vector<float> &p_b
 	}
 }
 
+void MeshStorage::multimesh_set_buffer_range(RID p_multimesh, int p_first_instance, const Vector<float> &p_buffer) {
+	MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+	ERR_FAIL_NULL(multimesh);
+	ERR_FAIL_COND(multimesh->stride_cache == 0 || p_buffer.size() % multimesh->stride_cache != 0);
+	int count = p_buffer.size() / multimesh->stride_cache;
+	ERR_FAIL_COND(p_first_instance < 0 || p_first_instance + count > multimesh->instances);
+	if (count == 0) {
+		return;
+	}
+
+	// Write through the data cache, so only the dirty regions covering the range get uploaded.
+	_multimesh_make_local(multimesh);
+
+	bool uses_motion_vectors = (RSG::viewport->get_num_viewports_with_motion_vectors() > 0) || (RendererCompositorStorage::get_singleton()->get_num_compositor_effects_with_motion_vectors() > 0);
+	if (uses_motion_vectors) {
+		_multimesh_enable_motion_vectors(multimesh);
+	}
+
+	_multimesh_update_motion_vectors_data_cache(multimesh);
+
+	float *w = multimesh->data_cache.ptrw();
+	memcpy(w + (multimesh->motion_vectors_current_offset + p_first_instance) * multimesh->stride_cache, p_buffer.ptr(), p_buffer.size() * sizeof(float));
+
+	uint32_t last_region = (p_first_instance + count - 1) / MULTIMESH_DIRTY_REGION_SIZE;
+	for (uint32_t region = p_first_instance / MULTIMESH_DIRTY_REGION_SIZE; region <= last_region; region++) {
+		_multimesh_mark_dirty(multimesh, region * MULTIMESH_DIRTY_REGION_SIZE, true);
+	}
+}
+
 Vector<float> MeshStorage::multimesh_get_buffer(RID p_multimesh) const {
 	MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
 	ERR_FAIL_NULL_V(multimesh, Vector<float>());
@@ -2068,18 +2097,38 @@ void MeshStorage::_update_dirty_multimeshes() {
 				uint32_t visible_region_count = visible_instances == 0 ? 0 : Math::division_round_up(visible_instances, (uint32_t)MULTIMESH_DIRTY_REGION_SIZE);
 
 				uint32_t region_size = multimesh->stride_cache * MULTIMESH_DIRTY_REGION_SIZE * sizeof(float);
-				if (total_dirty_regions > 32 || total_dirty_regions > visible_region_count / 2) {
+
+				// Adjacent dirty regions are uploaded together, so count the runs of them.
+				uint32_t dirty_runs = 0;
+				bool previous_dirty = false;
+				for (uint32_t i = 0; i < visible_region_count; i++) {
+					bool dirty = multimesh->data_cache_dirty_regions[i] || multimesh->previous_data_cache_dirty_regions[i];
+					if (dirty && !previous_dirty) {
+						dirty_runs++;
+					}
+					previous_dirty = dirty;
+				}
+
+				if (dirty_runs > 32 || total_dirty_regions > visible_region_count / 2) {
 					//if there too many dirty regions, or represent the majority of regions, just copy all, else transfer cost piles up too much
 					RD::get_singleton()->buffer_update(multimesh->buffer, buffer_offset * sizeof(float), MIN(visible_region_count * region_size, multimesh->instances * (uint32_t)multimesh->stride_cache * (uint32_t)sizeof(float)), data);
 				} else {
-					//not that many regions? update them all
-					for (uint32_t i = 0; i < visible_region_count; i++) {
-						if (multimesh->data_cache_dirty_regions[i] || multimesh->previous_data_cache_dirty_regions[i]) {
-							uint32_t offset = i * region_size;
-							uint32_t size = multimesh->stride_cache * (uint32_t)multimesh->instances * (uint32_t)sizeof(float);
-							uint32_t region_start_index = multimesh->stride_cache * MULTIMESH_DIRTY_REGION_SIZE * i;
-							RD::get_singleton()->buffer_update(multimesh->buffer, buffer_offset * sizeof(float) + offset, MIN(region_size, size - offset), &data[region_start_index]);
+					//not that many runs? update them all
+					uint32_t size = multimesh->stride_cache * (uint32_t)multimesh->instances * (uint32_t)sizeof(float);
+					uint32_t i = 0;
+					while (i < visible_region_count) {
+						if (!multimesh->data_cache_dirty_regions[i] && !multimesh->previous_data_cache_dirty_regions[i]) {
+							i++;
+							continue;
+						}
+						uint32_t run_end = i + 1;
+						while (run_end < visible_region_count && (multimesh->data_cache_dirty_regions[run_end] || multimesh->previous_data_cache_dirty_regions[run_end])) {
+							run_end++;
 						}
+						uint32_t offset = i * region_size;
+						uint32_t region_start_index = multimesh->stride_cache * MULTIMESH_DIRTY_REGION_SIZE * i;
+						RD::get_singleton()->buffer_update(multimesh->buffer, buffer_offset * sizeof(float) + offset, MIN((run_end - i) * region_size, size - offset), &data[region_start_index]);
+						i = run_end;
 					}
 				}
 
@@ -1721,6 +1721,10 @@ RS::ShaderNativeSourceCode ParticlesStorage::ParticlesShaderData::get_native_sou
 	return ParticlesStorage::get_singleton()->particles_shader.shader.version_get_native_source_code(version);
 }
 
+ShaderCompiler *ParticlesStorage::ParticlesShaderData::get_compiler() const {
+	return &ParticlesStorage::get_singleton()->particles_shader.compiler;
+}
+
 ParticlesStorage::ParticlesShaderData::~ParticlesShaderData() {
 	//pipeline variants will clear themselves if shader is gone
 	if (version.is_valid()) {
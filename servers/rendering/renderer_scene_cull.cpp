@@ -33,6 +33,8 @@
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "modules/modules_enabled.gen.h" // For raycast.
+#include "raster_occlusion_cull.h"
 #include "rendering_light_culler.h"
 #include "rendering_server_default.h"
 
@@ -791,6 +793,10 @@ void RendererSceneCull::instance_set_scenario(RID p_instance, RID p_scenario) {
 					instance->scenario->directional_lights.erase(light->D);
 					light->D = nullptr;
 				}
+				for (InstanceLightData::DirectionalShadowCache &cache : light->directional_shadow_cache) {
+					cache.valid = false;
+					cache.casters.clear();
+				}
 			} break;
 			case RS::INSTANCE_REFLECTION_PROBE: {
 				InstanceReflectionProbeData *reflection_probe = static_cast<InstanceReflectionProbeData *>(instance->base_data);
@@ -874,6 +880,7 @@ void RendererSceneCull::instance_set_layer_mask(RID p_instance, uint32_t p_mask)
 	instance->layer_mask = p_mask;
 	if (instance->scenario && instance->array_index >= 0) {
 		instance->scenario->instance_data[instance->array_index].layer_mask = p_mask;
+		_directional_shadow_cache_invalidate(instance->scenario, instance->scenario->instance_aabbs[instance->array_index]);
 	}
 
 	if ((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK && instance->base_data) {
@@ -920,11 +927,8 @@ void RendererSceneCull::instance_geometry_set_transparency(RID p_instance, float
 	}
 }
 
-void RendererSceneCull::instance_set_transform(RID p_instance, const Transform3D &p_transform) {
-	Instance *instance = instance_owner.get_or_null(p_instance);
-	ERR_FAIL_NULL(instance);
-
-	if (instance->transform == p_transform) {
+void RendererSceneCull::_instance_set_transform(Instance *p_instance, const Transform3D &p_transform) {
+	if (p_instance->transform == p_transform) {
 		return; //must be checked to avoid worst evil
 	}
 
@@ -936,8 +940,28 @@ void RendererSceneCull::instance_set_transform(RID p_instance, const Transform3D
 	}
 
 #endif
-	instance->transform = p_transform;
-	_instance_queue_update(instance, true);
+	p_instance->transform = p_transform;
+	_instance_queue_update(p_instance, true);
+}
+
+void RendererSceneCull::instance_set_transform(RID p_instance, const Transform3D &p_transform) {
+	Instance *instance = instance_owner.get_or_null(p_instance);
+	ERR_FAIL_NULL(instance);
+
+	_instance_set_transform(instance, p_transform);
+}
+
+void RendererSceneCull::instances_set_transforms(const LocalVector<RID> &p_instances, const LocalVector<Transform3D> &p_transforms) {
+	ERR_FAIL_COND(p_instances.size() != p_transforms.size());
+
+	// Moved instances are only queued here, their bounds are updated in one pass over the queue by update_dirty_instances().
+	for (uint32_t i = 0; i < p_instances.size(); i++) {
+		// Batches are built ahead of time, so instances freed in the meantime are skipped silently.
+		Instance *instance = instance_owner.get_or_null(p_instances[i]);
+		if (instance) {
+			_instance_set_transform(instance, p_transforms[i]);
+		}
+	}
 }
 
 void RendererSceneCull::instance_attach_object_instance_id(RID p_instance, ObjectID p_id) {
@@ -1270,6 +1294,8 @@ void RendererSceneCull::instance_geometry_set_cast_shadows_setting(RID p_instanc
 		} else {
 			idata.flags &= ~uint32_t(InstanceData::FLAG_CAST_SHADOWS_ONLY);
 		}
+
+		_directional_shadow_cache_invalidate(instance->scenario, instance->scenario->instance_aabbs[instance->array_index]);
 	}
 
 	if ((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK && instance->base_data) {
@@ -1441,6 +1467,11 @@ void RendererSceneCull::_update_instance_visibility_dependencies(Instance *p_ins
 			idata.flags &= ~InstanceData::FLAG_VISIBILITY_DEPENDENCY_NEEDS_CHECK;
 		}
 
+		if (is_geometry_instance) {
+			// Casters with camera dependent visibility aren't cached, this may have changed.
+			_directional_shadow_cache_invalidate(p_instance->scenario, p_instance->scenario->instance_aabbs[p_instance->array_index]);
+		}
+
 		if (p_instance->visibility_parent) {
 			idata.parent_array_index = p_instance->visibility_parent->array_index;
 		} else {
@@ -1571,6 +1602,17 @@ void RendererSceneCull::instance_geometry_get_shader_parameter_list(RID p_instan
 	}
 }
 
+void RendererSceneCull::_directional_shadow_cache_invalidate(Scenario *p_scenario, const InstanceBounds &p_bounds) {
+	for (Instance *E : p_scenario->directional_lights) {
+		InstanceLightData *light = static_cast<InstanceLightData *>(E->base_data);
+		for (InstanceLightData::DirectionalShadowCache &cache : light->directional_shadow_cache) {
+			if (cache.valid && p_bounds.in_frustum(cache.frustum)) {
+				cache.valid = false;
+			}
+		}
+	}
+}
+
 void RendererSceneCull::_update_instance(Instance *p_instance) {
 	p_instance->version++;
 
@@ -1798,9 +1840,15 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		p_instance->scenario->instance_data.push_back(idata);
 		p_instance->scenario->instance_aabbs.push_back(InstanceBounds(p_instance->transformed_aabb));
 		_update_instance_visibility_dependencies(p_instance);
+		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
+			_directional_shadow_cache_invalidate(p_instance->scenario, p_instance->scenario->instance_aabbs[p_instance->array_index]);
+		}
 	} else {
 		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
 			p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].update(p_instance->indexer_id, bvh_aabb);
+			// Both where it was and where it is now.
+			_directional_shadow_cache_invalidate(p_instance->scenario, p_instance->scenario->instance_aabbs[p_instance->array_index]);
+			_directional_shadow_cache_invalidate(p_instance->scenario, InstanceBounds(p_instance->transformed_aabb));
 		} else {
 			p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].update(p_instance->indexer_id, bvh_aabb);
 		}
@@ -1879,6 +1927,7 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 
 	if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
 		p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].remove(p_instance->indexer_id);
+		_directional_shadow_cache_invalidate(p_instance->scenario, p_instance->scenario->instance_aabbs[p_instance->array_index]);
 	} else {
 		p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].remove(p_instance->indexer_id);
 	}
@@ -2091,7 +2140,61 @@ void RendererSceneCull::_update_instance_lightmap_captures(Instance *p_instance)
 	geom->geometry_instance->set_lightmap_capture(p_instance->lightmap_sh.ptr());
 }
 
-void RendererSceneCull::_light_instance_setup_directional_shadow(int p_shadow_index, Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect) {
+Vector<Plane> RendererSceneCull::_directional_shadow_get_cull_planes(const Vector3 *p_endpoints, const Vector3 &p_x_vec, const Vector3 &p_y_vec, const Vector3 &p_z_vec, real_t p_soft_shadow_expand, real_t p_margin) {
+	real_t x_min = 0.f, x_max = 0.f;
+	real_t y_min = 0.f, y_max = 0.f;
+	real_t z_min = 0.f, z_max = 0.f;
+
+	for (int j = 0; j < 8; j++) {
+		real_t d_x = p_x_vec.dot(p_endpoints[j]);
+		real_t d_y = p_y_vec.dot(p_endpoints[j]);
+		real_t d_z = p_z_vec.dot(p_endpoints[j]);
+
+		if (j == 0 || d_x < x_min) {
+			x_min = d_x;
+		}
+		if (j == 0 || d_x > x_max) {
+			x_max = d_x;
+		}
+
+		if (j == 0 || d_y < y_min) {
+			y_min = d_y;
+		}
+		if (j == 0 || d_y > y_max) {
+			y_max = d_y;
+		}
+
+		if (j == 0 || d_z < z_min) {
+			z_min = d_z;
+		}
+		if (j == 0 || d_z > z_max) {
+			z_max = d_z;
+		}
+	}
+
+	x_max += p_soft_shadow_expand + p_margin;
+	y_max += p_soft_shadow_expand + p_margin;
+	x_min -= p_soft_shadow_expand + p_margin;
+	y_min -= p_soft_shadow_expand + p_margin;
+	z_min -= p_margin;
+
+	Vector<Plane> planes;
+	planes.resize(6);
+
+	//right/left
+	planes.write[0] = Plane(p_x_vec, x_max);
+	planes.write[1] = Plane(-p_x_vec, -x_min);
+	//top/bottom
+	planes.write[2] = Plane(p_y_vec, y_max);
+	planes.write[3] = Plane(-p_y_vec, -y_min);
+	//near/far
+	planes.write[4] = Plane(p_z_vec, z_max + 1e6);
+	planes.write[5] = Plane(-p_z_vec, -z_min); // z_min is ok, since casters further than far-light plane are not needed
+
+	return planes;
+}
+
+void RendererSceneCull::_light_instance_setup_directional_shadow(int p_shadow_index, Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, uint32_t p_visible_layers) {
 	// For later tight culling, the light culler needs to know the details of the directional light.
 	light_culler->prepare_directional_light(p_instance, p_shadow_index);
 
@@ -2141,6 +2244,7 @@ void RendererSceneCull::_light_instance_setup_directional_shadow(int p_shadow_in
 	cull.shadow_count = p_shadow_index + 1;
 	cull.shadows[p_shadow_index].cascade_count = splits;
 	cull.shadows[p_shadow_index].light_instance = light->instance;
+	cull.shadows[p_shadow_index].light = light;
 
 	for (int i = 0; i < splits; i++) {
 		RENDER_TIMESTAMP("Cull DirectionalLight3D, Split " + itos(i));
@@ -2174,10 +2278,6 @@ void RendererSceneCull::_light_instance_setup_directional_shadow(int p_shadow_in
 		Vector3 z_vec = transform.basis.get_column(Vector3::AXIS_Z).normalized();
 		//z_vec points against the camera, like in default opengl
 
-		real_t x_min = 0.f, x_max = 0.f;
-		real_t y_min = 0.f, y_max = 0.f;
-		real_t z_min = 0.f, z_max = 0.f;
-
 		// FIXME: z_max_cam is defined, computed, but not used below when setting up
 		// ortho_camera. Commented out for now to fix warnings but should be investigated.
 		real_t x_min_cam = 0.f, x_max_cam = 0.f;
@@ -2188,35 +2288,6 @@ void RendererSceneCull::_light_instance_setup_directional_shadow(int p_shadow_in
 		//real_t bias_scale = 1.0;
 		//real_t aspect_bias_scale = 1.0;
 
-		//used for culling
-
-		for (int j = 0; j < 8; j++) {
-			real_t d_x = x_vec.dot(endpoints[j]);
-			real_t d_y = y_vec.dot(endpoints[j]);
-			real_t d_z = z_vec.dot(endpoints[j]);
-
-			if (j == 0 || d_x < x_min) {
-				x_min = d_x;
-			}
-			if (j == 0 || d_x > x_max) {
-				x_max = d_x;
-			}
-
-			if (j == 0 || d_y < y_min) {
-				y_min = d_y;
-			}
-			if (j == 0 || d_y > y_max) {
-				y_max = d_y;
-			}
-
-			if (j == 0 || d_z < z_min) {
-				z_min = d_z;
-			}
-			if (j == 0 || d_z > z_max) {
-				z_max = d_z;
-			}
-		}
-
 		real_t radius = 0;
 		real_t soft_shadow_expand = 0;
 		Vector3 center;
@@ -2248,12 +2319,6 @@ void RendererSceneCull::_light_instance_setup_directional_shadow(int p_shadow_in
 				if (soft_shadow_angle > 0.0) {
 					float z_range = (z_vec.dot(center) + radius + pancake_size) - z_min_cam;
 					soft_shadow_expand = Math::tan(Math::deg_to_rad(soft_shadow_angle)) * z_range;
-
-					x_max += soft_shadow_expand;
-					y_max += soft_shadow_expand;
-
-					x_min -= soft_shadow_expand;
-					y_min -= soft_shadow_expand;
 				}
 			}
 
@@ -2266,24 +2331,21 @@ void RendererSceneCull::_light_instance_setup_directional_shadow(int p_shadow_in
 			y_min_cam = Math::snapped(y_vec.dot(center) - radius - soft_shadow_expand, unit);
 		}
 
-		//now that we know all ranges, we can proceed to make the light frustum planes, for culling octree
-
-		Vector<Plane> light_frustum_planes;
-		light_frustum_planes.resize(6);
-
-		//right/left
-		light_frustum_planes.write[0] = Plane(x_vec, x_max);
-		light_frustum_planes.write[1] = Plane(-x_vec, -x_min);
-		//top/bottom
-		light_frustum_planes.write[2] = Plane(y_vec, y_max);
-		light_frustum_planes.write[3] = Plane(-y_vec, -y_min);
-		//near/far
-		light_frustum_planes.write[4] = Plane(z_vec, z_max + 1e6);
-		light_frustum_planes.write[5] = Plane(-z_vec, -z_min); // z_min is ok, since casters further than far-light plane are not needed
+		// Reuse the casters cached for this cascade while its culling frustum is contained in the cached one.
+		// Otherwise, cull with a frustum grown by a fraction of the cascade depth, so the next frames can keep
+		// reusing it. The margin only depends on the camera projection, not on where the camera is.
+		const InstanceLightData::DirectionalShadowCache &cache = light->directional_shadow_cache[i];
+		const Vector<Plane> caster_frustum_planes = _directional_shadow_get_cull_planes(endpoints, x_vec, y_vec, z_vec, soft_shadow_expand, 0.0);
+		const bool rebuild_cache = !cache.covers(caster_frustum_planes, p_visible_layers);
+		Vector<Plane> light_frustum_planes = caster_frustum_planes;
+		if (rebuild_cache) {
+			const real_t cache_margin = (distances[i + 1] - distances[(i == 0 || !overlap) ? i : i - 1]) * DIRECTIONAL_SHADOW_CACHE_MARGIN;
+			light_frustum_planes = _directional_shadow_get_cull_planes(endpoints, x_vec, y_vec, z_vec, soft_shadow_expand, cache_margin);
+		}
 
 		// a pre pass will need to be needed to determine the actual z-near to be used
 
-		z_max = z_vec.dot(center) + radius + pancake_size;
+		real_t z_max = z_vec.dot(center) + radius + pancake_size;
 
 		{
 			Projection ortho_camera;
@@ -2298,7 +2360,9 @@ void RendererSceneCull::_light_instance_setup_directional_shadow(int p_shadow_in
 			ortho_transform.basis = transform.basis;
 			ortho_transform.origin = x_vec * (x_min_cam + half_x) + y_vec * (y_min_cam + half_y) + z_vec * z_max;
 
-			cull.shadows[p_shadow_index].cascades[i].frustum = Frustum(light_frustum_planes);
+			cull.shadows[p_shadow_index].cascades[i].frustum = rebuild_cache ? Frustum(light_frustum_planes) : cache.frustum;
+			cull.shadows[p_shadow_index].cascades[i].caster_frustum = Frustum(caster_frustum_planes);
+			cull.shadows[p_shadow_index].cascades[i].rebuild_cache = rebuild_cache;
 			cull.shadows[p_shadow_index].cascades[i].projection = ortho_camera;
 			cull.shadows[p_shadow_index].cascades[i].transform = ortho_transform;
 			cull.shadows[p_shadow_index].cascades[i].zfar = z_max - z_min_cam;
@@ -2779,6 +2843,8 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 #define VIS_RANGE_CHECK ((idata.visibility_index == -1) || _visibility_range_check<false>(cull_data.scenario->instance_visibility[idata.visibility_index], cull_data.cam_transform.origin, cull_data.visibility_viewport_mask) == 0)
 #define VIS_PARENT_CHECK (_visibility_parent_check(cull_data, idata))
 #define VIS_CHECK (visibility_check < 0 ? (visibility_check = (visibility_flags != InstanceData::FLAG_VISIBILITY_DEPENDENCY_NEEDS_CHECK || (VIS_RANGE_CHECK && VIS_PARENT_CHECK))) : visibility_check)
+// Instances whose visibility doesn't depend on the camera, their shadow casting can be cached.
+#define SHADOW_CACHEABLE (visibility_flags == 0 && idata.visibility_index == -1 && idata.parent_array_index == -1)
 #define OCCLUSION_CULLED (cull_data.occlusion_buffer != nullptr && (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_OCCLUSION_CULLING) == 0 && cull_data.occlusion_buffer->is_occluded(cull_data.scenario->instance_aabbs[i].bounds, cull_data.cam_transform.origin, inv_cam_transform, *cull_data.camera_matrix, z_near, cull_data.scenario->instance_data[i].occlusion_timeout))
 
 		if (!HIDDEN_BY_VISIBILITY_CHECKS) {
@@ -2973,6 +3039,20 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 			}
 
 			for (uint32_t j = 0; j < cull_data.cull->shadow_count; j++) {
+				if (cull_data.cull->shadows[j].light && SHADOW_CACHEABLE) {
+					// Cached casters are tested against the cascade's own frustum after the loop, only cascades that changed need testing here.
+					for (uint32_t k = 0; k < cull_data.cull->shadows[j].cascade_count; k++) {
+						if (cull_data.cull->shadows[j].cascades[k].rebuild_cache && IN_FRUSTUM(cull_data.cull->shadows[j].cascades[k].frustum)) {
+							uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
+
+							if (((1 << base_type) & RS::INSTANCE_GEOMETRY_MASK) && idata.flags & InstanceData::FLAG_CAST_SHADOWS && LAYER_CHECK) {
+								cull_result.directional_shadows[j].cascade_cache_instances[k].push_back(idata.instance);
+							}
+						}
+					}
+					continue;
+				}
+
 				if (!light_culler->cull_directional_light(cull_data.scenario->instance_aabbs[i], j)) {
 					continue;
 				}
@@ -2992,6 +3072,7 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 #undef HIDDEN_BY_VISIBILITY_CHECKS
 #undef LAYER_CHECK
 #undef IN_FRUSTUM
+#undef SHADOW_CACHEABLE
 #undef VIS_RANGE_CHECK
 #undef VIS_PARENT_CHECK
 #undef VIS_CHECK
@@ -3115,7 +3196,7 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		RSG::light_storage->set_directional_shadow_count(lights_with_shadow.size());
 
 		for (int i = 0; i < lights_with_shadow.size(); i++) {
-			_light_instance_setup_directional_shadow(i, lights_with_shadow[i], p_camera_data->main_transform, p_camera_data->main_projection, p_camera_data->is_orthogonal, p_camera_data->vaspect);
+			_light_instance_setup_directional_shadow(i, lights_with_shadow[i], p_camera_data->main_transform, p_camera_data->main_projection, p_camera_data->is_orthogonal, p_camera_data->vaspect, p_visible_layers);
 		}
 	}
 
@@ -3193,6 +3274,40 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		print_line("time taken: " + rtos(time_avg / time_count));
 #endif
 
+		for (uint32_t i = 0; i < cull.shadow_count; i++) {
+			InstanceLightData *light = cull.shadows[i].light;
+			if (!light) {
+				continue;
+			}
+
+			for (uint32_t j = 0; j < cull.shadows[i].cascade_count; j++) {
+				InstanceLightData::DirectionalShadowCache &cache = light->directional_shadow_cache[j];
+				if (cull.shadows[i].cascades[j].rebuild_cache) {
+					const PagedArray<Instance *> &found = scene_cull_result.directional_shadows[i].cascade_cache_instances[j];
+					cache.casters.resize(found.size());
+					for (uint64_t k = 0; k < found.size(); k++) {
+						cache.casters[k] = found[k];
+					}
+					cache.frustum = cull.shadows[i].cascades[j].frustum;
+					cache.visible_layers = p_visible_layers;
+					cache.valid = true;
+				}
+
+				// The cache holds the casters of a larger frustum, so they are culled again for this frame.
+				const Frustum &caster_frustum = cull.shadows[i].cascades[j].caster_frustum;
+				for (Instance *instance : cache.casters) {
+					const InstanceBounds &bounds = scenario->instance_aabbs[instance->array_index];
+					if (!bounds.in_frustum(caster_frustum) || !light_culler->cull_directional_light(bounds, i)) {
+						continue;
+					}
+					scene_cull_result.directional_shadows[i].cascade_geometry_instances[j].push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
+					if (instance->mesh_instance.is_valid()) {
+						scene_cull_result.mesh_instances.push_back(instance->mesh_instance);
+					}
+				}
+			}
+		}
+
 		if (scene_cull_result.mesh_instances.size()) {
 			for (uint64_t i = 0; i < scene_cull_result.mesh_instances.size(); i++) {
 				RSG::mesh_storage->mesh_instance_check_for_update(scene_cull_result.mesh_instances[i]);
@@ -4267,7 +4382,17 @@ RendererSceneCull::RendererSceneCull() {
 	thread_cull_threshold = MAX(thread_cull_threshold, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count()); //make sure there is at least one thread per CPU
 	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = GLOBAL_GET("rendering/occlusion_culling/jitter_projection");
 
-	dummy_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	// The raycast module replaces the default backend when it is selected.
+#ifdef MODULE_RAYCAST_ENABLED
+	bool use_raster_occlusion_culling = int(GLOBAL_GET("rendering/occlusion_culling/backend")) == 1;
+#else
+	bool use_raster_occlusion_culling = true;
+#endif
+	if (use_raster_occlusion_culling) {
+		default_occlusion_culling = memnew(RasterOcclusionCull);
+	} else {
+		default_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	}
 
 	light_culler = memnew(RenderingLightCuller);
 
@@ -4293,8 +4418,8 @@ RendererSceneCull::~RendererSceneCull() {
 	}
 	scene_cull_result_threads.clear();
 
-	if (dummy_occlusion_culling) {
-		memdelete(dummy_occlusion_culling);
+	if (default_occlusion_culling) {
+		memdelete(default_occlusion_culling);
 	}
 
 	if (light_culler) {
@@ -123,7 +123,7 @@ public:
 
 	/* VISIBILITY NOTIFIER API */
 
-	RendererSceneOcclusionCull *dummy_occlusion_culling = nullptr;
+	RendererSceneOcclusionCull *default_occlusion_culling = nullptr;
 
 	/* SCENARIO API */
 
@@ -705,6 +705,32 @@ public:
 		RS::LightBakeMode bake_mode;
 		uint32_t max_sdfgi_cascade = 2;
 
+		// Casters found in each directional shadow cascade, reused while the cascade culling frustum
+		// stays inside the cached one and no instance enters, leaves or moves inside it.
+		struct DirectionalShadowCache {
+			Frustum frustum;
+			uint32_t visible_layers = 0;
+			bool valid = false;
+			LocalVector<Instance *> casters;
+
+			// Whether the casters cached here can be used for the given culling planes, which must be contained in the cached frustum.
+			bool covers(const Vector<Plane> &p_planes, uint32_t p_visible_layers) const {
+				if (!valid || visible_layers != p_visible_layers || frustum.planes.size() != p_planes.size()) {
+					return false;
+				}
+				for (int i = 0; i < p_planes.size(); i++) {
+					if (frustum.planes[i].normal != p_planes[i].normal) {
+						return false;
+					}
+					// The light side plane is pushed far away, only its direction matters.
+					if (i != 4 && p_planes[i].d > frustum.planes[i].d) {
+						return false;
+					}
+				}
+				return true;
+			}
+		} directional_shadow_cache[RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES];
+
 	private:
 		// Instead of a single dirty flag, we maintain a count
 		// so that we can detect lights that are being made dirty
@@ -894,6 +920,7 @@ public:
 
 		struct DirectionalShadow {
 			PagedArray<RenderGeometryInstance *> cascade_geometry_instances[RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES];
+			PagedArray<Instance *> cascade_cache_instances[RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES];
 		} directional_shadows[RendererSceneRender::MAX_DIRECTIONAL_LIGHTS];
 
 		PagedArray<RenderGeometryInstance *> sdfgi_region_geometry_instances[SDFGI_MAX_CASCADES * SDFGI_MAX_REGIONS_PER_CASCADE];
@@ -912,6 +939,7 @@ public:
 			for (int i = 0; i < RendererSceneRender::MAX_DIRECTIONAL_LIGHTS; i++) {
 				for (int j = 0; j < RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES; j++) {
 					directional_shadows[i].cascade_geometry_instances[j].clear();
+					directional_shadows[i].cascade_cache_instances[j].clear();
 				}
 			}
 
@@ -937,6 +965,7 @@ public:
 			for (int i = 0; i < RendererSceneRender::MAX_DIRECTIONAL_LIGHTS; i++) {
 				for (int j = 0; j < RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES; j++) {
 					directional_shadows[i].cascade_geometry_instances[j].reset();
+					directional_shadows[i].cascade_cache_instances[j].reset();
 				}
 			}
 
@@ -963,6 +992,7 @@ public:
 			for (int i = 0; i < RendererSceneRender::MAX_DIRECTIONAL_LIGHTS; i++) {
 				for (int j = 0; j < RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES; j++) {
 					directional_shadows[i].cascade_geometry_instances[j].merge_unordered(p_cull_result.directional_shadows[i].cascade_geometry_instances[j]);
+					directional_shadows[i].cascade_cache_instances[j].merge_unordered(p_cull_result.directional_shadows[i].cascade_cache_instances[j]);
 				}
 			}
 
@@ -988,6 +1018,7 @@ public:
 			for (int i = 0; i < RendererSceneRender::MAX_DIRECTIONAL_LIGHTS; i++) {
 				for (int j = 0; j < RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES; j++) {
 					directional_shadows[i].cascade_geometry_instances[j].set_page_pool(p_geometry_instance_pool);
+					directional_shadows[i].cascade_cache_instances[j].set_page_pool(p_instance_pool);
 				}
 			}
 
@@ -1026,7 +1057,9 @@ public:
 	virtual void instance_set_scenario(RID p_instance, RID p_scenario);
 	virtual void instance_set_layer_mask(RID p_instance, uint32_t p_mask);
 	virtual void instance_set_pivot_data(RID p_instance, float p_sorting_offset, bool p_use_aabb_center);
+	_FORCE_INLINE_ void _instance_set_transform(Instance *p_instance, const Transform3D &p_transform);
 	virtual void instance_set_transform(RID p_instance, const Transform3D &p_transform);
+	virtual void instances_set_transforms(const LocalVector<RID> &p_instances, const LocalVector<Transform3D> &p_transforms);
 	virtual void instance_attach_object_instance_id(RID p_instance, ObjectID p_id);
 	virtual void instance_set_blend_shape_weight(RID p_instance, int p_shape, float p_weight);
 	virtual void instance_set_surface_override_material(RID p_instance, int p_surface, RID p_material);
@@ -1074,7 +1107,13 @@ public:
 	_FORCE_INLINE_ void _update_instance_lightmap_captures(Instance *p_instance);
 	void _unpair_instance(Instance *p_instance);
 
-	void _light_instance_setup_directional_shadow(int p_shadow_index, Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect);
+	// Fraction of a cascade's depth its culling frustum is grown by, so small camera motions keep the cached casters.
+	static constexpr real_t DIRECTIONAL_SHADOW_CACHE_MARGIN = 0.125;
+
+	static Vector<Plane> _directional_shadow_get_cull_planes(const Vector3 *p_endpoints, const Vector3 &p_x_vec, const Vector3 &p_y_vec, const Vector3 &p_z_vec, real_t p_soft_shadow_expand, real_t p_margin);
+
+	void _light_instance_setup_directional_shadow(int p_shadow_index, Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, uint32_t p_visible_layers);
+	void _directional_shadow_cache_invalidate(Scenario *p_scenario, const InstanceBounds &p_bounds);
 
 	_FORCE_INLINE_ bool _light_instance_update_shadow(Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario, float p_scren_mesh_lod_threshold, uint32_t p_visible_layers = 0xFFFFFF);
 
@@ -1086,6 +1125,8 @@ public:
 			RID light_instance;
 			struct Cascade {
 				Frustum frustum;
+				// The cascade's own frustum. The one above is grown, or comes from the cache, when the casters are cached.
+				Frustum caster_frustum;
 
 				Projection projection;
 				Transform3D transform;
@@ -1096,8 +1137,11 @@ public:
 				real_t range_begin;
 				Vector2 uv_scale;
 
+				bool rebuild_cache = false;
+
 			} cascades[RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES]; //max 4 cascades
 			uint32_t cascade_count;
+			InstanceLightData *light = nullptr;
 
 		} shadows[RendererSceneRender::MAX_DIRECTIONAL_LIGHTS];
 
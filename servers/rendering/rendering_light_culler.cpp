@@ -34,6 +34,16 @@
 #include "core/math/projection.h"
 #include "rendering_server_globals.h"
 
+#ifndef REAL_T_IS_DOUBLE
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LIGHT_CULLER_SIMD_SSE2
+#elif defined(__ARM_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+#include <arm_neon.h>
+#define LIGHT_CULLER_SIMD_NEON
+#endif
+#endif
+
 #ifdef RENDERING_LIGHT_CULLER_DEBUG_STRINGS
 const char *RenderingLightCuller::Data::string_planes[] = {
 	"NEAR",
@@ -150,6 +160,94 @@ bool RenderingLightCuller::cull_directional_light(const RendererSceneCull::Insta
 	return true;
 }
 
+void RenderingLightCuller::cull_blocks(const Plane *p_planes, int p_plane_count, const CullBlock *p_blocks, uint32_t p_block_count, uint8_t *r_culled_masks) {
+	static_assert(CULL_BLOCK_SIZE == 4, "The SIMD paths test four casters at a time.");
+	DEV_ASSERT(p_plane_count <= MAX_CULL_PLANES);
+
+#if defined(LIGHT_CULLER_SIMD_SSE2)
+	__m128 normal[MAX_CULL_PLANES][3];
+	__m128 abs_normal[MAX_CULL_PLANES][3];
+	__m128 d[MAX_CULL_PLANES];
+	for (int p = 0; p < p_plane_count; p++) {
+		for (int i = 0; i < 3; i++) {
+			normal[p][i] = _mm_set1_ps(p_planes[p].normal[i]);
+			abs_normal[p][i] = _mm_set1_ps(Math::abs(p_planes[p].normal[i]));
+		}
+		d[p] = _mm_set1_ps(p_planes[p].d);
+	}
+
+	const __m128 zero = _mm_setzero_ps();
+	for (uint32_t b = 0; b < p_block_count; b++) {
+		const CullBlock &block = p_blocks[b];
+		const __m128 cx = _mm_loadu_ps(block.center[0]);
+		const __m128 cy = _mm_loadu_ps(block.center[1]);
+		const __m128 cz = _mm_loadu_ps(block.center[2]);
+		const __m128 hx = _mm_loadu_ps(block.half_extents[0]);
+		const __m128 hy = _mm_loadu_ps(block.half_extents[1]);
+		const __m128 hz = _mm_loadu_ps(block.half_extents[2]);
+
+		int mask = 0;
+		for (int p = 0; p < p_plane_count && mask != 0xF; p++) {
+			// Operations in the same order as the scalar version, so rounding is identical.
+			const __m128 length = _mm_add_ps(_mm_add_ps(_mm_mul_ps(abs_normal[p][0], hx), _mm_mul_ps(abs_normal[p][1], hy)), _mm_mul_ps(abs_normal[p][2], hz));
+			const __m128 distance = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(normal[p][0], cx), _mm_mul_ps(normal[p][1], cy)), _mm_mul_ps(normal[p][2], cz)), d[p]);
+			mask |= _mm_movemask_ps(_mm_cmpgt_ps(_mm_sub_ps(distance, length), zero));
+		}
+		r_culled_masks[b] = mask;
+	}
+#elif defined(LIGHT_CULLER_SIMD_NEON)
+	float32x4_t normal[MAX_CULL_PLANES][3];
+	float32x4_t abs_normal[MAX_CULL_PLANES][3];
+	float32x4_t d[MAX_CULL_PLANES];
+	for (int p = 0; p < p_plane_count; p++) {
+		for (int i = 0; i < 3; i++) {
+			normal[p][i] = vdupq_n_f32(p_planes[p].normal[i]);
+			abs_normal[p][i] = vdupq_n_f32(Math::abs(p_planes[p].normal[i]));
+		}
+		d[p] = vdupq_n_f32(p_planes[p].d);
+	}
+
+	static const uint32_t lane_bits_data[4] = { 1, 2, 4, 8 };
+	const uint32x4_t lane_bits = vld1q_u32(lane_bits_data);
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+	for (uint32_t b = 0; b < p_block_count; b++) {
+		const CullBlock &block = p_blocks[b];
+		const float32x4_t cx = vld1q_f32(block.center[0]);
+		const float32x4_t cy = vld1q_f32(block.center[1]);
+		const float32x4_t cz = vld1q_f32(block.center[2]);
+		const float32x4_t hx = vld1q_f32(block.half_extents[0]);
+		const float32x4_t hy = vld1q_f32(block.half_extents[1]);
+		const float32x4_t hz = vld1q_f32(block.half_extents[2]);
+
+		uint32_t mask = 0;
+		for (int p = 0; p < p_plane_count && mask != 0xF; p++) {
+			// Separate multiplies and adds (no fused multiply-add), so rounding matches the scalar version.
+			const float32x4_t length = vaddq_f32(vaddq_f32(vmulq_f32(abs_normal[p][0], hx), vmulq_f32(abs_normal[p][1], hy)), vmulq_f32(abs_normal[p][2], hz));
+			const float32x4_t distance = vsubq_f32(vaddq_f32(vaddq_f32(vmulq_f32(normal[p][0], cx), vmulq_f32(normal[p][1], cy)), vmulq_f32(normal[p][2], cz)), d[p]);
+			mask |= vaddvq_u32(vandq_u32(vcgtq_f32(vsubq_f32(distance, length), zero), lane_bits));
+		}
+		r_culled_masks[b] = mask;
+	}
+#else
+	for (uint32_t b = 0; b < p_block_count; b++) {
+		const CullBlock &block = p_blocks[b];
+		uint8_t mask = 0;
+		for (int p = 0; p < p_plane_count; p++) {
+			const Plane &plane = p_planes[p];
+			const Vector3 abs_normal = plane.normal.abs();
+			for (int l = 0; l < CULL_BLOCK_SIZE; l++) {
+				const real_t length = abs_normal.x * block.half_extents[0][l] + abs_normal.y * block.half_extents[1][l] + abs_normal.z * block.half_extents[2][l];
+				const real_t distance = plane.normal.x * block.center[0][l] + plane.normal.y * block.center[1][l] + plane.normal.z * block.center[2][l] - plane.d;
+				if (distance - length > 0.0f) {
+					mask |= 1 << l;
+				}
+			}
+		}
+		r_culled_masks[b] = mask;
+	}
+#endif
+}
+
 void RenderingLightCuller::cull_regular_light(PagedArray<RendererSceneCull::Instance *> &r_instance_shadow_cull_result) {
 	if (!data.is_active() || !is_caster_culling_active()) {
 		return;
@@ -168,49 +266,60 @@ void RenderingLightCuller::cull_regular_light(PagedArray<RendererSceneCull::Inst
 	uint32_t count_before = r_instance_shadow_cull_result.size();
 #endif
 
-	// Go through all the casters in the list (the list will hopefully shrink as we go).
-	for (int n = 0; n < (int)list.size(); n++) {
-		// World space aabb.
-		const AABB &bb = list[n]->transformed_aabb;
+	const uint32_t count = list.size();
+	if (count == 0 || data.regular_cull_planes.num_cull_planes == 0) {
+		return;
+	}
 
-#ifdef LIGHT_CULLER_DEBUG_LOGGING
-		if (is_logging()) {
-			print_line("bb : " + String(bb));
-		}
-#endif
+	// Gather the world space AABBs into a packed array, so the cull itself streams through contiguous memory.
+	const uint32_t block_count = (count + CULL_BLOCK_SIZE - 1) / CULL_BLOCK_SIZE;
+	data.regular_cull_blocks.resize(block_count);
+	data.regular_culled_masks.resize(block_count);
+	CullBlock *blocks = data.regular_cull_blocks.ptr();
+	for (uint32_t n = 0; n < count; n++) {
+		blocks[n / CULL_BLOCK_SIZE].set(n % CULL_BLOCK_SIZE, list[n]->transformed_aabb);
+	}
+	// Keep the unused lanes of the last block deterministic.
+	for (uint32_t n = count; n < block_count * CULL_BLOCK_SIZE; n++) {
+		blocks[n / CULL_BLOCK_SIZE].set(n % CULL_BLOCK_SIZE, AABB());
+	}
 
-		real_t r_min, r_max;
-		bool show = true;
+	uint8_t *culled = data.regular_culled_masks.ptr();
+	cull_blocks(data.regular_cull_planes.cull_planes, data.regular_cull_planes.num_cull_planes, blocks, block_count, culled);
 
-		for (int p = 0; p < data.regular_cull_planes.num_cull_planes; p++) {
-			// As we only need r_min, could this be optimized?
-			bb.project_range_in_plane(data.regular_cull_planes.cull_planes[p], r_min, r_max);
+#define LIGHT_CULLER_IS_CULLED(m_index) (culled[(m_index) / CULL_BLOCK_SIZE] & (1 << ((m_index) % CULL_BLOCK_SIZE)))
+
+	// Remove in the same order as testing the casters one at a time did, so the resulting list is unchanged.
+	uint32_t size = count;
+	uint32_t n = 0;
+	while (n < size) {
+		if (!LIGHT_CULLER_IS_CULLED(n)) {
+			n++;
+			continue;
+		}
 
 #ifdef LIGHT_CULLER_DEBUG_LOGGING
-			if (is_logging()) {
-				print_line("\tplane " + itos(p) + " : " + String(data.regular_cull_planes.cull_planes[p]) + " r_min " + String(Variant(r_min)) + " r_max " + String(Variant(r_max)));
-			}
+		if (is_logging()) {
+			print_line("culled bb : " + String(list[n]->transformed_aabb));
+		}
 #endif
 
-			if (r_min > 0.0f) {
-				show = false;
-				break;
-			}
+		// The last element is moved into this slot, so its culled bit moves with it and this slot is tested again.
+		size--;
+		list.remove_at_unordered(n);
+		if (LIGHT_CULLER_IS_CULLED(size)) {
+			culled[n / CULL_BLOCK_SIZE] |= 1 << (n % CULL_BLOCK_SIZE);
+		} else {
+			culled[n / CULL_BLOCK_SIZE] &= ~(1 << (n % CULL_BLOCK_SIZE));
 		}
 
-		// Remove.
-		if (!show) {
-			list.remove_at_unordered(n);
-
-			// Repeat this element next iteration of the loop as it has been removed and replaced by the last.
-			n--;
-
 #ifdef LIGHT_CULLER_DEBUG_REGULAR_LIGHT
-			data.regular_rejected_count++;
+		data.regular_rejected_count++;
 #endif
-		}
 	}
 
+#undef LIGHT_CULLER_IS_CULLED
+
 #ifdef LIGHT_CULLER_DEBUG_LOGGING
 	uint32_t removed = r_instance_shadow_cull_result.size() - count_before;
 	if (removed) {
@@ -147,6 +147,31 @@ public:
 	// Return false if the instance is to be culled.
 	bool cull_directional_light(const RendererSceneCull::InstanceBounds &p_bound, int32_t p_directional_light_id);
 
+	// Caster bounds are packed CULL_BLOCK_SIZE at a time as structure of arrays,
+	// so that several casters can be tested against a plane at once.
+	enum {
+		CULL_BLOCK_SIZE = 4,
+	};
+
+	struct CullBlock {
+		real_t center[3][CULL_BLOCK_SIZE];
+		real_t half_extents[3][CULL_BLOCK_SIZE];
+
+		void set(uint32_t p_lane, const AABB &p_aabb) {
+			// Same arithmetic as AABB::project_range_in_plane(), so the results match exactly.
+			for (int i = 0; i < 3; i++) {
+				const real_t half = p_aabb.size[i] * 0.5f;
+				center[i][p_lane] = p_aabb.position[i] + half;
+				half_extents[i][p_lane] = half;
+			}
+		}
+	};
+
+	// Writes one mask per block, with bit n set if the caster in lane n is entirely
+	// on the outside of any of the planes. Gives the same result as calling
+	// AABB::project_range_in_plane() for every caster and plane.
+	static void cull_blocks(const Plane *p_planes, int p_plane_count, const CullBlock *p_blocks, uint32_t p_block_count, uint8_t *r_culled_masks);
+
 	// Can turn on and off from the engine if desired.
 	void set_caster_culling_active(bool p_active) { data.caster_culling_active = p_active; }
 	void set_light_culling_active(bool p_active) { data.light_culling_active = p_active; }
@@ -227,6 +252,10 @@ private:
 		// (OMNI, SPOT). These lights reuse the same set of cull plane data.
 		LightCullPlanes regular_cull_planes;
 
+		// Scratch for culling the casters of regular lights, reused between lights.
+		LocalVector<CullBlock> regular_cull_blocks;
+		LocalVector<uint8_t> regular_culled_masks;
+
 #ifdef LIGHT_CULLER_DEBUG_REGULAR_LIGHT
 		uint32_t regular_rejected_count = 0;
 #endif
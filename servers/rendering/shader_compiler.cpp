@@ -31,6 +31,7 @@
 #include "shader_compiler.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "servers/rendering/rendering_server_globals.h"
 #include "servers/rendering/shader_types.h"
@@ -1462,7 +1463,7 @@ ShaderLanguage::DataType ShaderCompiler::_get_global_shader_uniform_type(const S
 	return (ShaderLanguage::DataType)RS::global_shader_uniform_type_get_shader_datatype(gvt);
 }
 
-Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
+Error ShaderCompiler::_compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
 	SL::ShaderCompileInfo info;
 	info.functions = ShaderTypes::get_singleton()->get_functions(p_mode);
 	info.render_modes = ShaderTypes::get_singleton()->get_modes(p_mode);
@@ -1472,6 +1473,10 @@ Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, Ident
 	Error err = parser.compile(p_code, info);
 
 	if (err != OK) {
+		if (!report_errors) {
+			return err;
+		}
+
 		Vector<ShaderLanguage::FilePosition> include_positions = parser.get_include_positions();
 
 		String current;
@@ -1570,9 +1575,323 @@ Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, Ident
 	return OK;
 }
 
+uint64_t ShaderCompiler::_get_cache_key(RS::ShaderMode p_mode, const String &p_code, const IdentifierActions &p_actions) {
+	uint64_t h = hash_djb2_one_64(p_code.hash64());
+	h = hash_djb2_one_64(p_code.length(), h);
+	h = hash_djb2_one_64(p_mode, h);
+
+	// Callers decide which flags are tracked, so they are part of the key.
+	for (const KeyValue<StringName, Stage> &E : p_actions.entry_point_stages) {
+		h = hash_djb2_one_64(E.key.hash(), h);
+		h = hash_djb2_one_64(E.value, h);
+	}
+	for (const KeyValue<StringName, Pair<int *, int>> &E : p_actions.render_mode_values) {
+		h = hash_djb2_one_64(E.key.hash(), h);
+		h = hash_djb2_one_64(E.value.second, h);
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions.render_mode_flags) {
+		h = hash_djb2_one_64(E.key.hash(), h);
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions.usage_flag_pointers) {
+		h = hash_djb2_one_64(E.key.hash(), h);
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions.write_flag_pointers) {
+		h = hash_djb2_one_64(E.key.hash(), h);
+	}
+
+	return h;
+}
+
+const ShaderCompiler::CacheEntry *ShaderCompiler::_cache_get(uint64_t p_key, RS::ShaderMode p_mode, const String &p_code) const {
+	const CacheEntry *cached = cache.getptr(p_key);
+	if (cached && cached->mode == p_mode && cached->code == p_code) {
+		return cached;
+	}
+	return nullptr;
+}
+
+void ShaderCompiler::_apply_cache_entry(const CacheEntry &p_entry, IdentifierActions *p_actions, GeneratedCode &r_gen_code) {
+	r_gen_code = p_entry.gen_code;
+
+	for (const KeyValue<StringName, int> &E : p_entry.render_mode_values) {
+		Pair<int *, int> *value = E.value ? p_actions->render_mode_values.getptr(E.key) : nullptr;
+		if (value) {
+			*value->first = value->second;
+		}
+	}
+	for (const KeyValue<StringName, bool> &E : p_entry.render_mode_flags) {
+		if (E.value) {
+			*p_actions->render_mode_flags[E.key] = true;
+		}
+	}
+	for (const KeyValue<StringName, bool> &E : p_entry.usage_flags) {
+		if (E.value) {
+			*p_actions->usage_flag_pointers[E.key] = true;
+		}
+	}
+	for (const KeyValue<StringName, bool> &E : p_entry.write_flags) {
+		if (E.value) {
+			*p_actions->write_flag_pointers[E.key] = true;
+		}
+	}
+
+	if (p_actions->uniforms) {
+		for (const KeyValue<StringName, SL::ShaderNode::Uniform> &E : p_entry.uniforms) {
+			p_actions->uniforms->insert(E.key, E.value);
+		}
+	}
+}
+
+void ShaderCompiler::_cache_insert(uint64_t p_key, const CacheEntry &p_entry) {
+	if (!cache_enabled) {
+		return;
+	}
+
+	for (const KeyValue<StringName, SL::ShaderNode::Uniform> &E : p_entry.uniforms) {
+		if (E.value.scope == SL::ShaderNode::Uniform::SCOPE_GLOBAL) {
+			return; // Depends on the global uniforms defined in the project, which may change.
+		}
+	}
+
+	if (cache.size() >= CACHE_MAX_ENTRIES) {
+		// Iteration follows insertion order, drop the oldest.
+		const uint64_t oldest = cache.begin()->key;
+		cache.erase(oldest);
+	}
+	cache.insert(p_key, p_entry);
+}
+
+Error ShaderCompiler::_compile_recorded(RS::ShaderMode p_mode, const String &p_code, const IdentifierActions &p_actions, const String &p_path, CacheEntry &r_entry) {
+	// Same actions as the caller's, but writing to the entry.
+	IdentifierActions recording;
+	recording.entry_point_stages = p_actions.entry_point_stages;
+	recording.uniforms = &r_entry.uniforms;
+
+	for (const KeyValue<StringName, Pair<int *, int>> &E : p_actions.render_mode_values) {
+		int &value = r_entry.render_mode_values[E.key];
+		value = 0;
+		recording.render_mode_values[E.key] = Pair<int *, int>(&value, 1);
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions.render_mode_flags) {
+		bool &flag = r_entry.render_mode_flags[E.key];
+		flag = false;
+		recording.render_mode_flags[E.key] = &flag;
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions.usage_flag_pointers) {
+		bool &flag = r_entry.usage_flags[E.key];
+		flag = false;
+		recording.usage_flag_pointers[E.key] = &flag;
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions.write_flag_pointers) {
+		bool &flag = r_entry.write_flags[E.key];
+		flag = false;
+		recording.write_flag_pointers[E.key] = &flag;
+	}
+
+	return _compile(p_mode, p_code, &recording, p_path, r_entry.gen_code);
+}
+
+Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
+	if (!cache_enabled) {
+		return _compile(p_mode, p_code, p_actions, p_path, r_gen_code);
+	}
+
+	const uint64_t key = _get_cache_key(p_mode, p_code, *p_actions);
+	const CacheEntry *cached = _cache_get(key, p_mode, p_code);
+	if (cached) {
+		_apply_cache_entry(*cached, p_actions, r_gen_code);
+		return OK;
+	}
+
+	precompile_actions = *p_actions;
+	precompile_mode = p_mode;
+
+	CacheEntry entry;
+	entry.mode = p_mode;
+	entry.code = p_code;
+	Error err = _compile_recorded(p_mode, p_code, *p_actions, p_path, entry);
+	if (err != OK) {
+		return err;
+	}
+
+	_apply_cache_entry(entry, p_actions, r_gen_code);
+	_cache_insert(key, entry);
+	return OK;
+}
+
+void ShaderCompiler::_compile_batch_task(uint32_t p_worker, BatchContext *p_context) {
+	ShaderCompiler *compiler = batch_compilers[p_worker];
+	LocalVector<BatchJob> &jobs = *p_context->jobs;
+
+	for (uint32_t i = p_worker; i < jobs.size(); i += p_context->worker_count) {
+		BatchJob &job = jobs[i];
+		job.error = compiler->_compile_recorded(job.entry.mode, job.entry.code, *job.actions, job.path, job.entry);
+	}
+}
+
+void ShaderCompiler::_compile_batch_jobs(LocalVector<BatchJob> &r_jobs, bool p_report_errors) {
+	const uint32_t worker_count = MIN(r_jobs.size(), uint32_t(WorkerThreadPool::get_singleton()->get_thread_count()));
+	if (worker_count > 1) {
+		// The parser keeps its state in the compiler, so each worker needs its own.
+		while (batch_compilers.size() < worker_count) {
+			ShaderCompiler *compiler = memnew(ShaderCompiler);
+			compiler->actions = actions;
+			compiler->time_name = time_name;
+			compiler->internal_functions = internal_functions;
+			compiler->texture_functions = texture_functions;
+			compiler->cache_enabled = false;
+			batch_compilers.push_back(compiler);
+		}
+		for (ShaderCompiler *compiler : batch_compilers) {
+			compiler->report_errors = p_report_errors;
+		}
+
+		BatchContext context;
+		context.jobs = &r_jobs;
+		context.worker_count = worker_count;
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &ShaderCompiler::_compile_batch_task, &context, worker_count, -1, true, SNAME("ShaderCompileBatch"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		const bool was_reporting = report_errors;
+		report_errors = p_report_errors;
+		for (BatchJob &job : r_jobs) {
+			job.error = _compile_recorded(job.entry.mode, job.entry.code, *job.actions, job.path, job.entry);
+		}
+		report_errors = was_reporting;
+	}
+}
+
+void ShaderCompiler::compile_batch(LocalVector<BatchItem> &r_items) {
+	LocalVector<BatchJob> jobs;
+	LocalVector<int> item_jobs;
+	item_jobs.resize(r_items.size());
+	HashMap<uint64_t, uint32_t> key_jobs;
+
+	// Cache hits and duplicated code are resolved here, only the rest is compiled.
+	for (uint32_t i = 0; i < r_items.size(); i++) {
+		BatchItem &item = r_items[i];
+		item_jobs[i] = -1;
+		if (!item.actions || !item.gen_code) {
+			item.error = ERR_INVALID_PARAMETER;
+			ERR_CONTINUE_MSG(true, "Batch items need actions and generated code to write to.");
+		}
+
+		const uint64_t key = _get_cache_key(item.mode, item.code, *item.actions);
+		const CacheEntry *cached = cache_enabled ? _cache_get(key, item.mode, item.code) : nullptr;
+		if (cached) {
+			_apply_cache_entry(*cached, item.actions, *item.gen_code);
+			item.error = OK;
+			continue;
+		}
+
+		const uint32_t *job = key_jobs.getptr(key);
+		if (job && jobs[*job].entry.mode == item.mode && jobs[*job].entry.code == item.code) {
+			item_jobs[i] = *job;
+			continue;
+		}
+
+		key_jobs.insert(key, jobs.size());
+		item_jobs[i] = jobs.size();
+		jobs.push_back(BatchJob());
+		BatchJob &new_job = jobs[jobs.size() - 1];
+		new_job.actions = item.actions;
+		new_job.path = item.path;
+		new_job.key = key;
+		new_job.entry.mode = item.mode;
+		new_job.entry.code = item.code;
+	}
+
+	_compile_batch_jobs(jobs, true);
+
+	for (uint32_t i = 0; i < r_items.size(); i++) {
+		if (item_jobs[i] == -1) {
+			continue;
+		}
+		const BatchJob &job = jobs[item_jobs[i]];
+		r_items[i].error = job.error;
+		if (job.error == OK) {
+			_apply_cache_entry(job.entry, r_items[i].actions, *r_items[i].gen_code);
+		}
+	}
+
+	for (const BatchJob &job : jobs) {
+		if (job.error == OK) {
+			_cache_insert(job.key, job.entry);
+		}
+	}
+}
+
+void ShaderCompiler::precompile(const LocalVector<String> &p_codes) {
+	if (!cache_enabled || precompile_mode == RS::SHADER_MAX) {
+		return;
+	}
+
+	LocalVector<BatchJob> jobs;
+	HashSet<uint64_t> keys;
+	for (const String &code : p_codes) {
+		const uint64_t key = _get_cache_key(precompile_mode, code, precompile_actions);
+		if (keys.has(key) || _cache_get(key, precompile_mode, code)) {
+			continue;
+		}
+		keys.insert(key);
+
+		jobs.push_back(BatchJob());
+		BatchJob &job = jobs[jobs.size() - 1];
+		job.actions = &precompile_actions;
+		job.key = key;
+		job.entry.mode = precompile_mode;
+		job.entry.code = code;
+	}
+
+	if (jobs.size() < 2) {
+		return; // Nothing to gain over compiling it when it's used.
+	}
+
+	_compile_batch_jobs(jobs, false);
+
+	for (const BatchJob &job : jobs) {
+		if (job.error == OK) {
+			_cache_insert(job.key, job.entry);
+		}
+	}
+}
+
+void ShaderCompiler::set_cache_enabled(bool p_enabled) {
+	cache_enabled = p_enabled;
+	if (!cache_enabled) {
+		cache.clear();
+	}
+}
+
+bool ShaderCompiler::is_cache_enabled() const {
+	return cache_enabled;
+}
+
+void ShaderCompiler::clear_cache() {
+	cache.clear();
+}
+
+uint32_t ShaderCompiler::get_cache_size() const {
+	return cache.size();
+}
+
+void ShaderCompiler::_free_batch_compilers() {
+	for (ShaderCompiler *compiler : batch_compilers) {
+		memdelete(compiler);
+	}
+	batch_compilers.clear();
+}
+
 void ShaderCompiler::initialize(DefaultIdentifierActions p_actions) {
 	actions = p_actions;
 
+	// Generated code depends on the default actions.
+	clear_cache();
+	_free_batch_compilers();
+	precompile_actions = IdentifierActions();
+	precompile_mode = RS::SHADER_MAX;
+
 	time_name = "TIME";
 
 	List<String> func_list;
@@ -1597,3 +1916,7 @@ void ShaderCompiler::initialize(DefaultIdentifierActions p_actions) {
 
 ShaderCompiler::ShaderCompiler() {
 }
+
+ShaderCompiler::~ShaderCompiler() {
+	_free_batch_compilers();
+}
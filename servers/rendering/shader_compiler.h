@@ -31,6 +31,7 @@
 #ifndef SHADER_COMPILER_H
 #define SHADER_COMPILER_H
 
+#include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
 #include "servers/rendering/shader_language.h"
 #include "servers/rendering_server.h"
@@ -103,7 +104,67 @@ public:
 		bool check_multiview_samplers = false;
 	};
 
+	// A shader compiled by compile_batch(), as passed to compile().
+	struct BatchItem {
+		RS::ShaderMode mode = RS::SHADER_SPATIAL;
+		String code;
+		IdentifierActions *actions = nullptr;
+		String path;
+		GeneratedCode *gen_code = nullptr;
+		Error error = OK;
+	};
+
+	static constexpr uint32_t CACHE_MAX_ENTRIES = 1024;
+
 private:
+	// The generated code of a shader, and the flags and uniforms its compilation wrote to
+	// the IdentifierActions, so they can be replayed when identical code is compiled again.
+	struct CacheEntry {
+		// The key is a hash, these are compared on lookup so a collision can't return another shader's code.
+		RS::ShaderMode mode = RS::SHADER_SPATIAL;
+		String code;
+
+		GeneratedCode gen_code;
+		HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+		HashMap<StringName, int> render_mode_values;
+		HashMap<StringName, bool> render_mode_flags;
+		HashMap<StringName, bool> usage_flags;
+		HashMap<StringName, bool> write_flags;
+	};
+
+	struct BatchJob {
+		const IdentifierActions *actions = nullptr;
+		String path;
+		uint64_t key = 0;
+		CacheEntry entry;
+		Error error = FAILED;
+	};
+
+	struct BatchContext {
+		LocalVector<BatchJob> *jobs = nullptr;
+		uint32_t worker_count = 0;
+	};
+
+	HashMap<uint64_t, CacheEntry> cache;
+	bool cache_enabled = true;
+	bool report_errors = true;
+	LocalVector<ShaderCompiler *> batch_compilers;
+
+	// The actions of the last shader compiled, used by precompile(). Only the tracked names
+	// are read, the pointers may be gone.
+	IdentifierActions precompile_actions;
+	RS::ShaderMode precompile_mode = RS::SHADER_MAX;
+
+	static uint64_t _get_cache_key(RS::ShaderMode p_mode, const String &p_code, const IdentifierActions &p_actions);
+	const CacheEntry *_cache_get(uint64_t p_key, RS::ShaderMode p_mode, const String &p_code) const;
+	static void _apply_cache_entry(const CacheEntry &p_entry, IdentifierActions *p_actions, GeneratedCode &r_gen_code);
+	void _cache_insert(uint64_t p_key, const CacheEntry &p_entry);
+	Error _compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
+	Error _compile_recorded(RS::ShaderMode p_mode, const String &p_code, const IdentifierActions &p_actions, const String &p_path, CacheEntry &r_entry);
+	void _compile_batch_task(uint32_t p_worker, BatchContext *p_context);
+	void _compile_batch_jobs(LocalVector<BatchJob> &r_jobs, bool p_report_errors);
+	void _free_batch_compilers();
+
 	ShaderLanguage parser;
 
 	String _get_sampler_name(ShaderLanguage::TextureFilter p_filter, ShaderLanguage::TextureRepeat p_repeat);
@@ -129,9 +190,20 @@ private:
 
 public:
 	Error compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
+	// Compiles independent shaders in parallel, identical ones only once. Each item's error is set.
+	void compile_batch(LocalVector<BatchItem> &r_items);
+	// Compiles shaders in parallel into the cache, with the actions of the last compile() call.
+	// Errors are not reported, compile() reports them when the shader is actually compiled.
+	void precompile(const LocalVector<String> &p_codes);
+
+	void set_cache_enabled(bool p_enabled);
+	bool is_cache_enabled() const;
+	void clear_cache();
+	uint32_t get_cache_size() const;
 
 	void initialize(DefaultIdentifierActions p_actions);
 	ShaderCompiler();
+	~ShaderCompiler();
 };
 
 #endif // SHADER_COMPILER_H
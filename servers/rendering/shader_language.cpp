@@ -672,21 +672,22 @@ ShaderLanguage::Token ShaderLanguage::_get_token() {
 						CASE_MAX,
 					} lut_case = CASE_ALL;
 
-					static bool suffix_lut[CASE_MAX][127];
-
-					if (!is_const_suffix_lut_initialized) {
-						is_const_suffix_lut_initialized = true;
-
-						for (int i = 0; i < 127; i++) {
-							char t = char(i);
-
-							suffix_lut[CASE_ALL][i] = t == '.' || t == 'x' || t == 'e' || t == 'f' || t == 'u' || t == '-' || t == '+';
-							suffix_lut[CASE_HEXA_PERIOD][i] = t == 'e' || t == 'f' || t == 'u';
-							suffix_lut[CASE_EXPONENT][i] = t == 'f' || t == '-' || t == '+';
-							suffix_lut[CASE_SIGN_AFTER_EXPONENT][i] = t == 'f';
-							suffix_lut[CASE_NONE][i] = false;
+					// Filled on first use, function-local statics are initialized once even when shaders are parsed from several threads.
+					static const struct SuffixLUT {
+						bool table[CASE_MAX][127];
+
+						SuffixLUT() {
+							for (int i = 0; i < 127; i++) {
+								char t = char(i);
+
+								table[CASE_ALL][i] = t == '.' || t == 'x' || t == 'e' || t == 'f' || t == 'u' || t == '-' || t == '+';
+								table[CASE_HEXA_PERIOD][i] = t == 'e' || t == 'f' || t == 'u';
+								table[CASE_EXPONENT][i] = t == 'f' || t == '-' || t == '+';
+								table[CASE_SIGN_AFTER_EXPONENT][i] = t == 'f';
+								table[CASE_NONE][i] = false;
+							}
 						}
-					}
+					} suffix_lut;
 
 					String str;
 					int i = 0;
@@ -704,7 +705,7 @@ ShaderLanguage::Token ShaderLanguage::_get_token() {
 								error = true;
 							}
 						} else {
-							if (symbol < 0x7F && suffix_lut[lut_case][symbol]) {
+							if (symbol < 0x7F && suffix_lut.table[lut_case][symbol]) {
 								if (symbol == 'x') {
 									hexa_found = true;
 									lut_case = CASE_HEXA_PERIOD;
@@ -3112,8 +3113,6 @@ const ShaderLanguage::BuiltinEntry ShaderLanguage::frag_only_func_defs[] = {
 	{ nullptr }
 };
 
-bool ShaderLanguage::is_const_suffix_lut_initialized = false;
-
 bool ShaderLanguage::_validate_function_call(BlockNode *p_block, const FunctionInfo &p_function_info, OperatorNode *p_func, DataType *r_ret_type, StringName *r_ret_type_str, bool *r_is_custom_function) {
 	ERR_FAIL_COND_V(p_func->op != OP_CALL && p_func->op != OP_CONSTRUCT, false);
 
@@ -82,6 +82,29 @@ static PackedInt64Array to_int_array(const Vector<ObjectID> &ids) {
 	return a;
 }
 
+void RenderingServer::_instances_set_transforms_bind(const TypedArray<RID> &p_instances, const PackedFloat32Array &p_transforms) {
+	ERR_FAIL_COND_MSG(p_transforms.size() != p_instances.size() * 12, "The transforms array must contain 12 floats per instance.");
+
+	LocalVector<RID> instances;
+	LocalVector<Transform3D> transforms;
+	instances.resize(p_instances.size());
+	transforms.resize(p_instances.size());
+
+	const float *src = p_transforms.ptr();
+	for (int i = 0; i < p_instances.size(); i++) {
+		instances[i] = p_instances[i];
+
+		// Same layout as MultiMesh buffers.
+		const float *t = src + i * 12;
+		transforms[i].basis.rows[0] = Vector3(t[0], t[1], t[2]);
+		transforms[i].basis.rows[1] = Vector3(t[4], t[5], t[6]);
+		transforms[i].basis.rows[2] = Vector3(t[8], t[9], t[10]);
+		transforms[i].origin = Vector3(t[3], t[7], t[11]);
+	}
+
+	instances_set_transforms(instances, transforms);
+}
+
 PackedInt64Array RenderingServer::_instances_cull_aabb_bind(const AABB &p_aabb, RID p_scenario) const {
 	Vector<ObjectID> ids = instances_cull_aabb(p_aabb, p_scenario);
 	return to_int_array(ids);
@@ -2437,6 +2460,7 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("multimesh_set_visible_instances", "multimesh", "visible"), &RenderingServer::multimesh_set_visible_instances);
 	ClassDB::bind_method(D_METHOD("multimesh_get_visible_instances", "multimesh"), &RenderingServer::multimesh_get_visible_instances);
 	ClassDB::bind_method(D_METHOD("multimesh_set_buffer", "multimesh", "buffer"), &RenderingServer::multimesh_set_buffer);
+	ClassDB::bind_method(D_METHOD("multimesh_set_buffer_range", "multimesh", "first_instance", "buffer"), &RenderingServer::multimesh_set_buffer_range);
 	ClassDB::bind_method(D_METHOD("multimesh_get_buffer", "multimesh"), &RenderingServer::multimesh_get_buffer);
 
 	BIND_ENUM_CONSTANT(MULTIMESH_TRANSFORM_2D);
@@ -3116,6 +3140,7 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("instance_set_layer_mask", "instance", "mask"), &RenderingServer::instance_set_layer_mask);
 	ClassDB::bind_method(D_METHOD("instance_set_pivot_data", "instance", "sorting_offset", "use_aabb_center"), &RenderingServer::instance_set_pivot_data);
 	ClassDB::bind_method(D_METHOD("instance_set_transform", "instance", "transform"), &RenderingServer::instance_set_transform);
+	ClassDB::bind_method(D_METHOD("instances_set_transforms", "instances", "transforms"), &RenderingServer::_instances_set_transforms_bind);
 	ClassDB::bind_method(D_METHOD("instance_attach_object_instance_id", "instance", "id"), &RenderingServer::instance_attach_object_instance_id);
 	ClassDB::bind_method(D_METHOD("instance_set_blend_shape_weight", "instance", "shape", "weight"), &RenderingServer::instance_set_blend_shape_weight);
 	ClassDB::bind_method(D_METHOD("instance_set_surface_override_material", "instance", "surface", "material"), &RenderingServer::instance_set_surface_override_material);
@@ -32,6 +32,8 @@
 #define TEST_FILE_ACCESS_H
 
 #include "core/io/file_access.h"
+#include "core/io/file_access_compressed.h"
+#include "core/os/os.h"
 #include "tests/test_macros.h"
 #include "tests/test_utils.h"
 
@@ -107,6 +109,155 @@ TEST_CASE("[FileAccess] Get as UTF-8 String") {
 	CHECK(s_cr == "Hello darkness\rMy old friend\rI've come to talk\rWith you again\r");
 	CHECK(s_cr_nocr == "Hello darknessMy old friendI've come to talkWith you again");
 }
+
+static Vector<uint8_t> make_compressible_data(uint64_t p_size) {
+	Vector<uint8_t> data;
+	data.resize(p_size);
+	uint8_t *w = data.ptrw();
+	uint32_t seed = 12345;
+	for (uint64_t i = 0; i < p_size; i++) {
+		// Mix of runs and noise so every codec has some work to do.
+		seed = seed * 1103515245 + 12345;
+		w[i] = (i % 64 < 48) ? uint8_t(i / 64) : uint8_t(seed >> 16);
+	}
+	return data;
+}
+
+static String write_compressed(const String &p_name, const Vector<uint8_t> &p_data, Compression::Mode p_mode, uint32_t p_block_size) {
+	const String path = TestUtils::get_temp_path(p_name);
+	Ref<FileAccessCompressed> fac;
+	fac.instantiate();
+	fac->configure("GCPF", p_mode, p_block_size);
+	if (fac->open_internal(path, FileAccess::WRITE) != OK) {
+		return String();
+	}
+	fac->store_buffer(p_data.ptr(), p_data.size());
+	fac->close();
+	return path;
+}
+
+static Ref<FileAccessCompressed> open_compressed(const String &p_path) {
+	Ref<FileAccessCompressed> fac;
+	fac.instantiate();
+	fac->configure("GCPF");
+	if (fac->open_internal(p_path, FileAccess::READ) != OK) {
+		return Ref<FileAccessCompressed>();
+	}
+	return fac;
+}
+
+TEST_CASE("[FileAccess] Compressed files round trip with any block size") {
+	const Compression::Mode modes[] = { Compression::MODE_FASTLZ, Compression::MODE_DEFLATE, Compression::MODE_ZSTD, Compression::MODE_GZIP };
+	const uint32_t block_sizes[] = { FileAccessCompressed::DEFAULT_BLOCK_SIZE, FileAccessCompressed::LARGE_BLOCK_SIZE };
+	const bool read_ahead_was_enabled = FileAccessCompressed::is_read_ahead_enabled();
+
+	for (bool read_ahead : { false, true }) {
+		FileAccessCompressed::set_read_ahead_enabled(read_ahead);
+		for (Compression::Mode mode : modes) {
+			for (uint32_t block_size : block_sizes) {
+				// Includes an exact multiple of the block size, which ends with an empty block.
+				for (uint64_t size : { (uint64_t)0, (uint64_t)1000, (uint64_t)block_size * 4, (uint64_t)block_size * 4 + 777 }) {
+					const Vector<uint8_t> data = make_compressible_data(size);
+					const String path = write_compressed("compressed.bin", data, mode, block_size);
+					REQUIRE(!path.is_empty());
+
+					Ref<FileAccessCompressed> f = open_compressed(path);
+					REQUIRE(f.is_valid());
+					CHECK(f->get_length() == size);
+
+					Vector<uint8_t> read;
+					read.resize(size);
+					CHECK(f->get_buffer(read.ptrw(), size) == size);
+					CHECK(read == data);
+					CHECK(f->get_position() == size);
+					CHECK_FALSE(f->eof_reached());
+
+					uint8_t extra = 0;
+					CHECK(f->get_buffer(&extra, 1) == 0);
+					CHECK(f->eof_reached());
+
+					if (size > 0) {
+						// Random access, backwards and across blocks.
+						for (uint64_t pos : { size - 1, size / 2, (uint64_t)0, size / 3 }) {
+							f->seek(pos);
+							CHECK(f->get_position() == pos);
+							CHECK(f->get_8() == data[pos]);
+						}
+
+						f->seek(size / 3);
+						uint64_t pos = size / 3;
+						bool matches = true;
+						while (pos < size) {
+							if (f->get_8() != data[pos]) {
+								matches = false;
+							}
+							pos++;
+						}
+						CHECK(matches);
+						CHECK_FALSE(f->eof_reached());
+						f->get_8();
+						CHECK(f->eof_reached());
+					}
+				}
+			}
+		}
+	}
+
+	FileAccessCompressed::set_read_ahead_enabled(read_ahead_was_enabled);
+}
+
+TEST_CASE("[FileAccess] Compressed files open with the block size they were written with") {
+	const Vector<uint8_t> data = make_compressible_data(100000);
+	const String path = write_compressed("compressed_small_blocks.bin", data, Compression::MODE_ZSTD, 1024);
+	REQUIRE(!path.is_empty());
+
+	// The reader takes the block size from the header, not from configure().
+	Ref<FileAccessCompressed> fac;
+	fac.instantiate();
+	fac->configure("GCPF", Compression::MODE_FASTLZ, FileAccessCompressed::LARGE_BLOCK_SIZE);
+	REQUIRE(fac->open_internal(path, FileAccess::READ) == OK);
+	Ref<FileAccess> f = fac;
+	CHECK(f->get_buffer(data.size()) == data);
+
+	f = FileAccess::open_compressed(path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	CHECK(f->get_buffer(data.size()) == data);
+}
+
+TEST_CASE_BENCHMARK("[FileAccess][Benchmark] Compressed file read throughput") {
+	const uint64_t size = 32 * 1024 * 1024;
+	const Vector<uint8_t> data = make_compressible_data(size);
+	const bool read_ahead_was_enabled = FileAccessCompressed::is_read_ahead_enabled();
+
+	Vector<uint8_t> read;
+	read.resize(size);
+
+	const Compression::Mode modes[] = { Compression::MODE_FASTLZ, Compression::MODE_DEFLATE, Compression::MODE_ZSTD };
+	const char *mode_names[] = { "FastLZ", "Deflate", "Zstd" };
+	const uint32_t block_sizes[] = { 4 * 1024, 64 * 1024, 256 * 1024, 1024 * 1024 };
+
+	for (int m = 0; m < 3; m++) {
+		for (uint32_t block_size : block_sizes) {
+			const String path = write_compressed("compressed_benchmark.bin", data, modes[m], block_size);
+			REQUIRE(!path.is_empty());
+
+			for (bool read_ahead : { false, true }) {
+				FileAccessCompressed::set_read_ahead_enabled(read_ahead);
+				Ref<FileAccessCompressed> f = open_compressed(path);
+				REQUIRE(f.is_valid());
+
+				uint64_t begin = OS::get_singleton()->get_ticks_usec();
+				f->get_buffer(read.ptrw(), size);
+				uint64_t usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+
+				CHECK(read == data);
+				MESSAGE(mode_names[m], ", ", block_size / 1024, " KiB blocks, read-ahead ", (read_ahead ? "on" : "off"), ": ", size / usec, " MB/s.");
+			}
+		}
+	}
+
+	FileAccessCompressed::set_read_ahead_enabled(read_ahead_was_enabled);
+}
 } // namespace TestFileAccess
 
 #endif // TEST_FILE_ACCESS_H
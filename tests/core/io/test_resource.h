@@ -31,15 +31,34 @@
 #ifndef TEST_RESOURCE_H
 #define TEST_RESOURCE_H
 
+#include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
 #include "core/io/resource.h"
+#include "core/io/resource_format_binary.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
 #include "core/os/os.h"
+#include "core/os/semaphore.h"
+#include "scene/resources/resource_format_text.h"
 
 #include "thirdparty/doctest/doctest.h"
 
 #include "tests/test_macros.h"
 
+class TestResourceLoaderInternalsAccessor {
+public:
+	// Drops a queued load the way shutdown does, leaving the user request to be collected.
+	static bool cancel_queued_load(const String &p_path) {
+		MutexLock thread_load_lock(ResourceLoader::thread_load_mutex);
+		ResourceLoader::ThreadLoadTask *load_task = ResourceLoader::_get_user_load_task(p_path);
+		if (!load_task || !ResourceLoader::_unqueue_load_task(load_task)) {
+			return false;
+		}
+		ResourceLoader::_cancel_queued_load_task(load_task);
+		return true;
+	}
+};
+
 namespace TestResource {
 
 TEST_CASE("[Resource] Duplication") {
@@ -166,6 +185,337 @@ TEST_CASE("[Resource] Breaking circular references on save") {
 	// Break circular reference to avoid memory leak
 	resource_c->remove_meta("next");
 }
+
+static Ref<Resource> create_library(int p_item_count, int p_floats_per_item) {
+	Ref<Resource> library = memnew(Resource);
+	Ref<Resource> shared = memnew(Resource);
+	shared->set_name("Shared");
+	shared->set_scene_unique_id("shared");
+
+	Vector<float> payload;
+	payload.resize(p_floats_per_item);
+	for (int i = 0; i < p_floats_per_item; i++) {
+		payload.write[i] = i * 0.5;
+	}
+
+	Array items;
+	for (int i = 0; i < p_item_count; i++) {
+		Ref<Resource> item = memnew(Resource);
+		item->set_name(vformat("Item %d", i));
+		item->set_scene_unique_id(vformat("item_%d", i));
+		item->set_meta("shared", shared);
+		item->set_meta("payload", payload);
+		items.push_back(item);
+	}
+	library->set_meta("items", items);
+	return library;
+}
+
+TEST_CASE("[Resource] Loading a single sub-resource from a binary file") {
+	const String save_path = TestUtils::get_temp_path("library.res");
+	REQUIRE(ResourceSaver::save(create_library(8, 16), save_path) == OK);
+	const String local_path = ProjectSettings::get_singleton()->localize_path(save_path);
+
+	Ref<Resource> item = ResourceLoader::load(save_path + "::item_3");
+	REQUIRE(item.is_valid());
+	CHECK(item->get_name() == "Item 3");
+	CHECK(item->get_scene_unique_id() == "item_3");
+	CHECK(item->get_path() == local_path + "::item_3");
+	CHECK(Vector<float>(item->get_meta("payload")).size() == 16);
+
+	// Referenced sub-resources are loaded on demand, the rest of the file is not.
+	Ref<Resource> shared = item->get_meta("shared");
+	REQUIRE(shared.is_valid());
+	CHECK(shared->get_name() == "Shared");
+	CHECK(ResourceCache::has(local_path + "::shared"));
+	CHECK_FALSE(ResourceCache::has(local_path + "::item_4"));
+	CHECK_FALSE(ResourceCache::has(local_path));
+
+	// Loading the whole file afterwards reuses what was already loaded.
+	Ref<Resource> library = ResourceLoader::load(save_path);
+	REQUIRE(library.is_valid());
+	Array items = library->get_meta("items");
+	REQUIRE(items.size() == 8);
+	CHECK(Ref<Resource>(items[3]) == item);
+	CHECK(Ref<Resource>(Ref<Resource>(items[4])->get_meta("shared")) == shared);
+
+	ERR_PRINT_OFF;
+	CHECK(ResourceLoader::load(save_path + "::missing", "", ResourceFormatLoader::CACHE_MODE_IGNORE).is_null());
+	ERR_PRINT_ON;
+}
+
+TEST_CASE_BENCHMARK("[Resource][Benchmark] Loading a single sub-resource from a large library") {
+	const String save_path = TestUtils::get_temp_path("large_library.res");
+	REQUIRE(ResourceSaver::save(create_library(500, 20000), save_path) == OK);
+
+	uint64_t mem = Memory::get_mem_usage();
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	Ref<Resource> library = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	uint64_t full_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	uint64_t full_mem = Memory::get_mem_usage() - mem;
+	REQUIRE(library.is_valid());
+	library.unref();
+
+	mem = Memory::get_mem_usage();
+	begin = OS::get_singleton()->get_ticks_usec();
+	Ref<Resource> item = ResourceLoader::load(save_path + "::item_250", "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	uint64_t single_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	uint64_t single_mem = Memory::get_mem_usage() - mem;
+	REQUIRE(item.is_valid());
+
+	MESSAGE("Whole library: ", full_usec, " usec, ", full_mem / 1024, " KiB.");
+	MESSAGE("Single sub-resource: ", single_usec, " usec, ", single_mem / 1024, " KiB.");
+}
+
+TEST_CASE("[Resource] Text resources are loaded from the binary cache until edited") {
+	const bool was_enabled = ResourceFormatLoaderText::is_binary_cache_enabled();
+	const String old_cache_dir = ResourceFormatLoaderText::get_binary_cache_dir();
+	ResourceFormatLoaderText::set_binary_cache_enabled(true);
+	ResourceFormatLoaderText::set_binary_cache_dir(TestUtils::get_temp_path("text_resource_cache"));
+
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_name("Text");
+	Ref<Resource> child_resource = memnew(Resource);
+	child_resource->set_name("Child");
+	resource->set_meta("child", child_resource);
+	const String save_path = TestUtils::get_temp_path("cached_resource.tres");
+	REQUIRE(ResourceSaver::save(resource, save_path) == OK);
+
+	// The first load parses the text and fills the cache.
+	Ref<Resource> loaded = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(loaded.is_valid());
+	CHECK(loaded->get_name() == "Text");
+	const String cache_file = ResourceFormatLoaderText::get_binary_cache_file(save_path);
+	CHECK(FileAccess::exists(cache_file));
+
+	Ref<Resource> cached = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(cached.is_valid());
+	CHECK(cached->get_name() == "Text");
+	CHECK(Ref<Resource>(cached->get_meta("child"))->get_name() == "Child");
+
+	// Replace the cached copy to tell where the next load comes from.
+	Ref<Resource> marker = memnew(Resource);
+	marker->set_name("From cache");
+	REQUIRE(ResourceFormatSaverBinary::singleton->save(marker, cache_file) == OK);
+	cached = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(cached.is_valid());
+	CHECK(cached->get_name() == "From cache");
+
+	// Editing the text file invalidates the cache.
+	resource->set_name("Edited");
+	REQUIRE(ResourceSaver::save(resource, save_path) == OK);
+	loaded = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(loaded.is_valid());
+	CHECK(loaded->get_name() == "Edited");
+	cached = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(cached.is_valid());
+	CHECK(cached->get_name() == "Edited");
+
+	ResourceFormatLoaderText::set_binary_cache_dir(old_cache_dir);
+	ResourceFormatLoaderText::set_binary_cache_enabled(was_enabled);
+}
+
+TEST_CASE_BENCHMARK("[Resource][Benchmark] Loading text resources through the binary cache") {
+	const bool was_enabled = ResourceFormatLoaderText::is_binary_cache_enabled();
+	const String old_cache_dir = ResourceFormatLoaderText::get_binary_cache_dir();
+	ResourceFormatLoaderText::set_binary_cache_dir(TestUtils::get_temp_path("text_resource_cache"));
+
+	const String save_path = TestUtils::get_temp_path("large_library.tres");
+	REQUIRE(ResourceSaver::save(create_library(500, 2000), save_path) == OK);
+
+	const char *names[] = { "Text parser", "First load (parse and fill cache)", "Cached load" };
+	for (int i = 0; i < 3; i++) {
+		ResourceFormatLoaderText::set_binary_cache_enabled(i > 0);
+		if (i == 1) {
+			DirAccess::remove_absolute(ResourceFormatLoaderText::get_binary_cache_file(save_path) + ".md5");
+		}
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		Ref<Resource> library = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+		REQUIRE(library.is_valid());
+		MESSAGE(names[i], ": ", usec, " usec.");
+	}
+
+	ResourceFormatLoaderText::set_binary_cache_dir(old_cache_dir);
+	ResourceFormatLoaderText::set_binary_cache_enabled(was_enabled);
+}
+
+TEST_CASE("[SceneTree][ResourceLoader] Prioritized and cancellable threaded loads") {
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_name("Streamed");
+	const String save_path = TestUtils::get_temp_path("streamed_resource.res");
+	REQUIRE(ResourceSaver::save(resource, save_path) == OK);
+
+	ResourceLoader::ThreadLoadMetrics metrics;
+	CHECK(ResourceLoader::load_threaded_set_priority(save_path, 1) == ERR_INVALID_PARAMETER);
+	CHECK(ResourceLoader::load_threaded_cancel(save_path) == ERR_INVALID_PARAMETER);
+	CHECK_FALSE(ResourceLoader::load_threaded_get_metrics(save_path, metrics));
+
+	REQUIRE(ResourceLoader::load_threaded_request(save_path, "", false, ResourceFormatLoader::CACHE_MODE_IGNORE, 5) == OK);
+	REQUIRE(ResourceLoader::load_threaded_get_metrics(save_path, metrics));
+	CHECK(metrics.priority == 5);
+	CHECK(ResourceLoader::load_threaded_set_priority(save_path, 10) == OK);
+	REQUIRE(ResourceLoader::load_threaded_get_metrics(save_path, metrics));
+	CHECK(metrics.priority == 10);
+
+	// Withdrawing one of two requests of the same path keeps the load going for the other.
+	REQUIRE(ResourceLoader::load_threaded_request(save_path, "", false, ResourceFormatLoader::CACHE_MODE_IGNORE) == OK);
+	CHECK(ResourceLoader::load_threaded_cancel(save_path) == OK);
+
+	Error err = FAILED;
+	Ref<Resource> loaded = ResourceLoader::load_threaded_get(save_path, &err);
+	CHECK(err == OK);
+	REQUIRE(loaded.is_valid());
+	CHECK(loaded->get_name() == "Streamed");
+	CHECK_MESSAGE(ResourceLoader::load_threaded_cancel(save_path) == ERR_INVALID_PARAMETER, "The result has already been collected.");
+}
+
+// Records the order in which loads run. Loads of "blocker" files wait until released.
+class ResourceFormatLoaderQueueTest : public ResourceFormatLoader {
+public:
+	Mutex mutex;
+	Semaphore blocker_release;
+	LocalVector<String> loaded;
+
+	virtual Ref<Resource> load(const String &p_path, const String &p_original_path = "", Error *r_error = nullptr, bool p_use_sub_threads = false, float *r_progress = nullptr, CacheMode p_cache_mode = CACHE_MODE_REUSE) override {
+		const String name = p_path.get_file().get_basename();
+		{
+			MutexLock lock(mutex);
+			loaded.push_back(name);
+		}
+		if (name == "blocker") {
+			blocker_release.wait();
+		}
+
+		Ref<Resource> resource = memnew(Resource);
+		resource->set_name(name);
+		if (r_error) {
+			*r_error = OK;
+		}
+		return resource;
+	}
+
+	virtual void get_recognized_extensions(List<String> *p_extensions) const override {
+		p_extensions->push_back("queuetest");
+	}
+
+	virtual bool handles_type(const String &p_type) const override {
+		return p_type == "Resource";
+	}
+
+	virtual String get_resource_type(const String &p_path) const override {
+		return p_path.get_extension() == "queuetest" ? "Resource" : "";
+	}
+
+	LocalVector<String> get_loaded() {
+		MutexLock lock(mutex);
+		return loaded;
+	}
+
+	bool wait_for_load(const String &p_name) {
+		for (int i = 0; i < 5000; i++) {
+			if (get_loaded().has(p_name)) {
+				return true;
+			}
+			OS::get_singleton()->delay_usec(1000);
+		}
+		return false;
+	}
+};
+
+static String queue_test_path(const String &p_name) {
+	return TestUtils::get_temp_path(p_name + ".queuetest");
+}
+
+static Error request_queue_test_load(const String &p_name, int p_priority) {
+	return ResourceLoader::load_threaded_request(queue_test_path(p_name), "", false, ResourceFormatLoader::CACHE_MODE_IGNORE, p_priority);
+}
+
+static Ref<Resource> get_queue_test_load(const String &p_name, Error *r_error = nullptr) {
+	return ResourceLoader::load_threaded_get(queue_test_path(p_name), r_error);
+}
+
+TEST_CASE("[SceneTree][ResourceLoader] Queued threaded loads with a limit of one") {
+	const String setting = "threading/resource_loading/max_concurrent_requests";
+	const Variant old_limit = ProjectSettings::get_singleton()->get_setting(setting);
+	ProjectSettings::get_singleton()->set_setting(setting, 1);
+
+	Ref<ResourceFormatLoaderQueueTest> loader = memnew(ResourceFormatLoaderQueueTest);
+	ResourceLoader::add_resource_format_loader(loader, true);
+
+	// The blocker takes the only slot, so every later request is queued until it's released.
+	REQUIRE(request_queue_test_load("blocker", 0) == OK);
+
+	SUBCASE("Queued loads start in order of priority") {
+		REQUIRE(request_queue_test_load("low", 1) == OK);
+		REQUIRE(request_queue_test_load("high", 5) == OK);
+		REQUIRE(request_queue_test_load("raised", 0) == OK);
+		CHECK(ResourceLoader::load_threaded_set_priority(queue_test_path("raised"), 3) == OK);
+		loader->blocker_release.post();
+
+		const char *order[] = { "blocker", "high", "raised", "low" };
+		for (const char *name : order) {
+			Ref<Resource> loaded = get_queue_test_load(name);
+			REQUIRE(loaded.is_valid());
+			CHECK(loaded->get_name() == name);
+		}
+
+		LocalVector<String> loaded = loader->get_loaded();
+		REQUIRE(loaded.size() == 4);
+		for (uint32_t i = 0; i < loaded.size(); i++) {
+			CHECK(loaded[i] == order[i]);
+		}
+	}
+
+	SUBCASE("Cancelled loads never run") {
+		REQUIRE(request_queue_test_load("cancelled", 10) == OK);
+		REQUIRE(request_queue_test_load("kept", 0) == OK);
+		CHECK(ResourceLoader::load_threaded_cancel(queue_test_path("cancelled")) == OK);
+		CHECK(ResourceLoader::load_threaded_get_status(queue_test_path("cancelled")) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE);
+		CHECK_MESSAGE(ResourceLoader::load_threaded_cancel(queue_test_path("blocker")) == ERR_BUSY, "Running loads can't be cancelled.");
+		loader->blocker_release.post();
+
+		CHECK(get_queue_test_load("blocker").is_valid());
+		CHECK(get_queue_test_load("kept").is_valid());
+
+		LocalVector<String> loaded = loader->get_loaded();
+		REQUIRE(loaded.size() == 2);
+		CHECK(loaded[0] == "blocker");
+		CHECK(loaded[1] == "kept");
+	}
+
+	SUBCASE("Dropped loads report ERR_SKIP") {
+		REQUIRE(request_queue_test_load("skipped", 0) == OK);
+		CHECK(TestResourceLoaderInternalsAccessor::cancel_queued_load(queue_test_path("skipped")));
+		CHECK(ResourceLoader::load_threaded_get_status(queue_test_path("skipped")) == ResourceLoader::THREAD_LOAD_FAILED);
+
+		Error err = OK;
+		CHECK(get_queue_test_load("skipped", &err).is_null());
+		CHECK(err == ERR_SKIP);
+
+		loader->blocker_release.post();
+		CHECK(get_queue_test_load("blocker").is_valid());
+		CHECK_FALSE(loader->get_loaded().has("skipped"));
+	}
+
+	SUBCASE("Raising the limit starts queued loads") {
+		REQUIRE(request_queue_test_load("first", 0) == OK);
+		ProjectSettings::get_singleton()->set_setting(setting, 2);
+		REQUIRE(request_queue_test_load("second", 0) == OK);
+
+		// The blocker still holds its slot, so the new one goes to the load queued first.
+		CHECK(loader->wait_for_load("first"));
+		CHECK_FALSE(loader->get_loaded().has("second"));
+
+		loader->blocker_release.post();
+		CHECK(get_queue_test_load("blocker").is_valid());
+		CHECK(get_queue_test_load("first").is_valid());
+		CHECK(get_queue_test_load("second").is_valid());
+	}
+
+	ResourceLoader::remove_resource_format_loader(loader);
+	ProjectSettings::get_singleton()->set_setting(setting, old_limit);
+}
 } // namespace TestResource
 
 #endif // TEST_RESOURCE_H
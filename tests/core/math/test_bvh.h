@@ -0,0 +1,220 @@
+/**************************************************************************/
+/*  test_bvh.h                                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_BVH_H
+#define TEST_BVH_H
+
+#include "core/math/bvh.h"
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestBVH {
+
+struct Item {
+	uint32_t index = 0;
+};
+
+typedef BVH_Manager<Item, 1, false, 32> BVH3D;
+
+struct Scene {
+	LocalVector<Item> items;
+	LocalVector<AABB> aabbs;
+	LocalVector<BVHHandle> handles;
+
+	static AABB random_aabb(RandomPCG &p_rng, real_t p_world_size, real_t p_max_size) {
+		Vector3 size(p_rng.random(0.1, p_max_size), p_rng.random(0.1, p_max_size), p_rng.random(0.1, p_max_size));
+		Vector3 position(p_rng.random(-p_world_size, p_world_size), p_rng.random(-p_world_size, p_world_size), p_rng.random(-p_world_size, p_world_size));
+		return AABB(position, size);
+	}
+
+	void create(BVH3D &p_bvh, RandomPCG &p_rng, uint32_t p_count, real_t p_world_size, real_t p_max_size) {
+		// Resize up front, the BVH keeps pointers to the items.
+		items.resize(p_count);
+		for (uint32_t i = 0; i < p_count; i++) {
+			items[i].index = i;
+			aabbs.push_back(random_aabb(p_rng, p_world_size, p_max_size));
+			handles.push_back(p_bvh.create(&items[i], true, 0, 1, aabbs[i]));
+		}
+	}
+
+	void move(BVH3D &p_bvh, RandomPCG &p_rng, real_t p_distance, uint32_t p_every) {
+		for (uint32_t i = 0; i < items.size(); i += p_every) {
+			aabbs[i].position += Vector3(p_rng.random(-p_distance, p_distance), p_rng.random(-p_distance, p_distance), p_rng.random(-p_distance, p_distance));
+			p_bvh.move(handles[i], aabbs[i]);
+		}
+	}
+
+	void destroy(BVH3D &p_bvh) {
+		for (uint32_t i = 0; i < handles.size(); i++) {
+			p_bvh.erase(handles[i]);
+		}
+	}
+
+	bool cull_matches(BVH3D &p_bvh, const AABB &p_aabb) {
+		LocalVector<Item *> results;
+		results.resize(items.size());
+		int count = p_bvh.cull_aabb(p_aabb, results.ptr(), results.size(), nullptr);
+
+		LocalVector<bool> found;
+		found.resize(items.size());
+		for (uint32_t i = 0; i < items.size(); i++) {
+			found[i] = false;
+		}
+		for (int i = 0; i < count; i++) {
+			if (found[results[i]->index]) {
+				return false;
+			}
+			found[results[i]->index] = true;
+		}
+
+		for (uint32_t i = 0; i < items.size(); i++) {
+			if (found[i] != aabbs[i].intersects_inclusive(p_aabb)) {
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+TEST_CASE("[BVH] Packed comparisons match the per axis tests") {
+	BVH_ABB<AABB, Vector3> a;
+	BVH_ABB<AABB, Vector3> b;
+	a.set(Vector3(0, 0, 0), Vector3(1, 1, 1));
+	b = a;
+	CHECK(a.is_other_within(b));
+	CHECK(b.is_other_within(a));
+
+	// Each of the 6 components on its own must be able to fail the tests.
+	for (int axis = 0; axis < 3; axis++) {
+		b = a;
+		b.min[axis] -= 0.5;
+		CHECK_FALSE(a.is_other_within(b));
+		CHECK(b.is_other_within(a));
+
+		b = a;
+		b.neg_max[axis] -= 0.5;
+		CHECK_FALSE(a.is_other_within(b));
+		CHECK(b.is_other_within(a));
+	}
+
+	BVH_ABB<Rect2, Vector2> a2;
+	BVH_ABB<Rect2, Vector2> b2;
+	a2.set(Vector2(0, 0), Vector2(1, 1));
+	for (int axis = 0; axis < 2; axis++) {
+		b2 = a2;
+		b2.min[axis] -= 0.5;
+		CHECK_FALSE(a2.is_other_within(b2));
+		CHECK(b2.is_other_within(a2));
+
+		b2 = a2;
+		b2.neg_max[axis] -= 0.5;
+		CHECK_FALSE(a2.is_other_within(b2));
+		CHECK(b2.is_other_within(a2));
+	}
+}
+
+TEST_CASE("[BVH] AABB culling matches brute force") {
+	RandomPCG rng(1234);
+	BVH3D bvh;
+	// Moved items are otherwise expanded, and would be culled by a slightly larger bound.
+	bvh.params_set_pairing_expansion(0.0);
+
+	// Enough items for the refit to be split over several threads.
+	Scene scene;
+	scene.create(bvh, rng, 5000, 200.0, 8.0);
+	bvh.update();
+
+	for (int query = 0; query < 20; query++) {
+		CHECK(scene.cull_matches(bvh, Scene::random_aabb(rng, 200.0, 100.0)));
+	}
+
+	for (int frame = 0; frame < 10; frame++) {
+		scene.move(bvh, rng, 4.0, 3);
+		bvh.update();
+	}
+
+	for (int query = 0; query < 20; query++) {
+		CHECK_MESSAGE(scene.cull_matches(bvh, Scene::random_aabb(rng, 200.0, 100.0)), "Culling should match a brute force search after refitting.");
+	}
+
+	// A few moved items are refit on the calling thread.
+	for (int frame = 0; frame < 10; frame++) {
+		scene.move(bvh, rng, 4.0, 1000);
+		bvh.update();
+	}
+
+	for (int query = 0; query < 20; query++) {
+		CHECK_MESSAGE(scene.cull_matches(bvh, Scene::random_aabb(rng, 200.0, 100.0)), "Culling should match a brute force search after refitting a few leaves.");
+	}
+
+	// Everything is within this, which exercises the fully within path.
+	CHECK(scene.cull_matches(bvh, AABB(Vector3(-500, -500, -500), Vector3(1000, 1000, 1000))));
+
+	scene.destroy(bvh);
+}
+
+TEST_CASE_BENCHMARK("[BVH][Benchmark] Refit and cull") {
+	const uint32_t item_count = 50000;
+	const int frame_count = 60;
+	const int query_count = 500;
+
+	RandomPCG rng(42);
+	BVH3D bvh;
+	Scene scene;
+	scene.create(bvh, rng, item_count, 1000.0, 4.0);
+	bvh.update();
+
+	uint64_t update_usec = 0;
+	for (int frame = 0; frame < frame_count; frame++) {
+		scene.move(bvh, rng, 1.0, 4);
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		bvh.update();
+		update_usec += OS::get_singleton()->get_ticks_usec() - begin;
+	}
+
+	LocalVector<Item *> results;
+	results.resize(item_count);
+	uint64_t hit_count = 0;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int query = 0; query < query_count; query++) {
+		hit_count += bvh.cull_aabb(Scene::random_aabb(rng, 1000.0, 100.0), results.ptr(), results.size(), nullptr);
+	}
+	uint64_t cull_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	MESSAGE(vformat("Update: %.3f ms/frame, cull: %.3f us/query (%d hits).", update_usec / 1000.0 / frame_count, double(cull_usec) / query_count, hit_count));
+
+	scene.destroy(bvh);
+}
+
+} // namespace TestBVH
+
+#endif // TEST_BVH_H
@@ -446,6 +446,115 @@ TEST_CASE("[Stress][CommandQueue] Stress test command queue") {
 	ProjectSettings::get_singleton()->set_setting(COMMAND_QUEUE_SETTING,
 			ProjectSettings::get_singleton()->property_get_revert(COMMAND_QUEUE_SETTING));
 }
+
+class OrderState {
+public:
+	CommandQueueMT command_queue;
+	LocalVector<int> values;
+
+	void append(int p_value) {
+		values.push_back(p_value);
+	}
+	void append_and_push(int p_value) {
+		values.push_back(p_value);
+		command_queue.push(this, &OrderState::append, -p_value);
+	}
+};
+
+TEST_CASE("[CommandQueue] Commands keep their order across chunks") {
+	OrderState state;
+	const int command_count = 20000;
+
+	for (int i = 0; i < command_count; i++) {
+		state.command_queue.push(&state, &OrderState::append, i);
+	}
+	// Commands pushed while flushing run in the same flush.
+	state.command_queue.push(&state, &OrderState::append_and_push, command_count);
+	state.command_queue.flush_all();
+
+	REQUIRE(state.values.size() == uint32_t(command_count + 2));
+	bool in_order = true;
+	for (int i = 0; i <= command_count; i++) {
+		in_order = in_order && state.values[i] == i;
+	}
+	CHECK(in_order);
+	CHECK(state.values[command_count + 1] == -command_count);
+
+	// The queue is reused once empty.
+	state.values.clear();
+	state.command_queue.push(&state, &OrderState::append, 7);
+	state.command_queue.flush_if_pending();
+	REQUIRE(state.values.size() == 1);
+	CHECK(state.values[0] == 7);
+}
+
+class BenchmarkState {
+public:
+	CommandQueueMT command_queue;
+	SafeFlag producer_done;
+	uint64_t sum = 0;
+
+	void add(uint64_t p_value) {
+		sum += p_value;
+	}
+	void add_transform(Transform3D p_transform, float p_value) {
+		sum += uint64_t(p_value);
+	}
+
+	static void static_consumer_loop(void *p_state) {
+		BenchmarkState *state = static_cast<BenchmarkState *>(p_state);
+		while (!state->producer_done.is_set()) {
+			state->command_queue.flush_if_pending();
+		}
+		state->command_queue.flush_all();
+	}
+};
+
+TEST_CASE_BENCHMARK("[CommandQueue][Benchmark] Push and flush throughput") {
+	const int command_count = 4000000;
+
+	SUBCASE("Single thread") {
+		BenchmarkState state;
+		Transform3D transform;
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < command_count; i++) {
+			state.command_queue.push(&state, &BenchmarkState::add_transform, transform, 1.0f);
+			if ((i & 4095) == 4095) {
+				state.command_queue.flush_all();
+			}
+		}
+		state.command_queue.flush_all();
+		uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+		CHECK(state.sum == uint64_t(command_count));
+		MESSAGE(vformat("Push and flush, same thread: %.2f M commands/s.", double(command_count) / MAX(elapsed, uint64_t(1))));
+	}
+
+	SUBCASE("Producer and consumer threads") {
+		BenchmarkState state;
+		Thread consumer;
+		consumer.start(&BenchmarkState::static_consumer_loop, &state);
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < command_count; i++) {
+			state.command_queue.push(&state, &BenchmarkState::add, uint64_t(1));
+		}
+		uint64_t pushed = OS::get_singleton()->get_ticks_usec();
+		// Sync points still wait for everything pushed before them.
+		state.command_queue.sync();
+		uint64_t synced = OS::get_singleton()->get_ticks_usec();
+
+		CHECK(state.sum == uint64_t(command_count));
+
+		state.producer_done.set();
+		consumer.wait_to_finish();
+
+		MESSAGE(vformat("Push while flushing on another thread: %.2f M commands/s.", double(command_count) / MAX(pushed - begin, uint64_t(1))));
+		MESSAGE(vformat("Push and flush until synced: %.2f M commands/s.", double(command_count) / MAX(synced - begin, uint64_t(1))));
+	}
+}
+
 } // namespace TestCommandQueue
 
 #endif // TEST_COMMAND_QUEUE_H
@@ -31,10 +31,12 @@
 #ifndef TEST_VARIANT_H
 #define TEST_VARIANT_H
 
+#include "core/os/os.h"
 #include "core/variant/variant.h"
 #include "core/variant/variant_parser.h"
 
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 namespace TestVariant {
 
@@ -2208,6 +2210,129 @@ TEST_CASE("[Variant] Operator NOT") {
 	}
 }
 
+static Variant parse_string(const String &p_str, Error *r_err = nullptr, int *r_line = nullptr) {
+	VariantParser::StreamString ss;
+	ss.s = p_str;
+	String errs;
+	int line = 1;
+	Variant parsed;
+	Error err = VariantParser::parse(&ss, parsed, errs, line);
+	if (r_err) {
+		*r_err = err;
+	}
+	if (r_line) {
+		*r_line = line;
+	}
+	return parsed;
+}
+
+TEST_CASE("[Variant] Parser packed numeric arrays") {
+	Vector<float> floats = { 1, -2.5, 300, 0.125, -4 };
+	CHECK(parse_string("PackedFloat32Array(1, -2.5, 3e2, 0.125, -4)") == Variant(floats));
+	CHECK(parse_string("PackedFloat32Array()") == Variant(Vector<float>()));
+	CHECK(parse_string("PackedFloat32Array( )") == Variant(Vector<float>()));
+
+	Vector<int32_t> ints = { 1, 2, -3 };
+	CHECK(parse_string("PackedInt32Array(1, 2.9, -3)") == Variant(ints));
+	Vector<int64_t> longs = { 9007199254740993, -1 };
+	CHECK(parse_string("PackedInt64Array(9007199254740993, -1)") == Variant(longs));
+
+	// Special values, comments and line breaks inside the constructor.
+	int line = 0;
+	Variant special = parse_string("PackedFloat64Array(inf, inf_neg, ; comment\n 1,\n2)", nullptr, &line);
+	Vector<double> special_values = special;
+	REQUIRE(special_values.size() == 4);
+	CHECK(special_values[0] == INFINITY);
+	CHECK(special_values[1] == -INFINITY);
+	CHECK(special_values[3] == 2);
+	CHECK(line == 3);
+
+	Vector<Vector3> vectors = { Vector3(1, 2, 3), Vector3(-0.5, 0, 1e-3) };
+	String vectors_str;
+	VariantWriter::write_to_string(vectors, vectors_str);
+	CHECK(parse_string(vectors_str) == Variant(vectors));
+
+	Error err = OK;
+	ERR_PRINT_OFF;
+	parse_string("PackedFloat32Array(1 2)", &err);
+	CHECK(err == ERR_PARSE_ERROR);
+	parse_string("PackedFloat32Array(1, 2", &err);
+	CHECK(err == ERR_PARSE_ERROR);
+	parse_string("PackedFloat32Array(1, x)", &err);
+	CHECK(err == ERR_PARSE_ERROR);
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[Variant] Parser strings from UTF-8 files") {
+	const String path = TestUtils::get_temp_path("variant_parser_utf8.txt");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(String::utf8("[\"h\u00E9llo w\u00F6rld\", \"tab\\there \\\"quoted\\\"\", &\"name\", \"\"]"));
+	}
+
+	VariantParser::StreamFile stream;
+	stream.f = FileAccess::open(path, FileAccess::READ);
+	REQUIRE(stream.f.is_valid());
+	String errs;
+	int line = 1;
+	Variant parsed;
+	REQUIRE(VariantParser::parse(&stream, parsed, errs, line) == OK);
+
+	Array strings = parsed;
+	REQUIRE(strings.size() == 4);
+	CHECK(strings[0] == Variant(String::utf8("h\u00E9llo w\u00F6rld")));
+	CHECK(strings[1] == Variant("tab\there \"quoted\""));
+	CHECK(strings[2].get_type() == Variant::STRING_NAME);
+	CHECK(strings[2] == Variant(StringName("name")));
+	CHECK(strings[3] == Variant(String()));
+}
+
+TEST_CASE_BENCHMARK("[Variant][Benchmark] Parser throughput on mesh data") {
+	// Roughly what a mesh surface in a .tres file looks like.
+	Dictionary surface;
+	Vector<Vector3> vertices;
+	Vector<float> uvs;
+	Vector<int32_t> indices;
+	for (int i = 0; i < 200000; i++) {
+		vertices.push_back(Vector3(Math::sin(i * 0.1), Math::cos(i * 0.37), i * 0.001));
+		uvs.push_back(Math::fmod(i * 0.013, 1.0));
+		indices.push_back(i % 65536);
+	}
+	surface["vertex_data"] = vertices;
+	surface["uv_data"] = uvs;
+	surface["index_data"] = indices;
+	surface["name"] = "Surface with a \"quoted\" name";
+
+	String text;
+	VariantWriter::write_to_string(surface, text);
+	const String path = TestUtils::get_temp_path("variant_parser_benchmark.txt");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(text);
+	}
+
+	for (int pass = 0; pass < 2; pass++) {
+		String errs;
+		int line = 1;
+		Variant parsed;
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		if (pass == 0) {
+			VariantParser::StreamString stream;
+			stream.s = text;
+			REQUIRE(VariantParser::parse(&stream, parsed, errs, line) == OK);
+		} else {
+			VariantParser::StreamFile stream;
+			stream.f = FileAccess::open(path, FileAccess::READ);
+			REQUIRE(VariantParser::parse(&stream, parsed, errs, line) == OK);
+		}
+		uint64_t usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+		CHECK(Dictionary(parsed).size() == 4);
+		MESSAGE((pass == 0 ? "String" : "File"), " stream: ", text.length() / usec, " MB/s (", usec / 1000, " msec).");
+	}
+}
+
 } // namespace TestVariant
 
 #endif // TEST_VARIANT_H
@@ -0,0 +1,218 @@
+/**************************************************************************/
+/*  test_editor_file_system.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_EDITOR_FILE_SYSTEM_H
+#define TEST_EDITOR_FILE_SYSTEM_H
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "editor/editor_file_system.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+class TestEditorFileSystemInternalsAccessor {
+public:
+	typedef EditorFileSystem::ScannedDirectory ScannedDirectory;
+
+	static ScannedDirectory *scan(const String &p_path, bool p_use_threads, int &r_file_count) {
+		ScannedDirectory *sd = memnew(ScannedDirectory);
+		sd->full_path = p_path;
+		Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_RESOURCES);
+		if (da->change_dir(p_path) != OK) {
+			memdelete(sd);
+			return nullptr;
+		}
+		r_file_count = EditorFileSystem::_scan_new_dir(sd, da, p_use_threads);
+		return sd;
+	}
+
+	static void free_scan(ScannedDirectory *p_dir) {
+		memdelete(p_dir);
+	}
+
+	static String get_files_stamp(const Vector<String> &p_files) {
+		return EditorFileSystem::_get_files_stamp(p_files);
+	}
+
+	static bool is_md5_outdated(const Vector<String> &p_files, const String &p_md5, const String &p_stamp) {
+		return EditorFileSystem::_is_md5_outdated(p_files, p_md5, p_stamp);
+	}
+};
+
+namespace TestEditorFileSystem {
+
+typedef TestEditorFileSystemInternalsAccessor Accessor;
+
+static void write_file(const String &p_path, const String &p_contents) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_string(p_contents);
+}
+
+static void remove_dir(const String &p_path) {
+	Ref<DirAccess> da = DirAccess::open(p_path);
+	if (da.is_valid()) {
+		da->erase_contents_recursive();
+		DirAccess::remove_absolute(p_path);
+	}
+}
+
+static void check_same_tree(const Accessor::ScannedDirectory *p_a, const Accessor::ScannedDirectory *p_b) {
+	CHECK(p_a->name == p_b->name);
+	CHECK(p_a->full_path == p_b->full_path);
+
+	REQUIRE(p_a->files.size() == p_b->files.size());
+	const List<String>::Element *file_b = p_b->files.front();
+	for (const String &file_a : p_a->files) {
+		CHECK(file_a == file_b->get());
+		file_b = file_b->next();
+	}
+
+	REQUIRE(p_a->subdirs.size() == p_b->subdirs.size());
+	for (int i = 0; i < p_a->subdirs.size(); i++) {
+		check_same_tree(p_a->subdirs[i], p_b->subdirs[i]);
+	}
+}
+
+TEST_CASE("[EditorFileSystem] Parallel and serial scans find the same tree") {
+	const String root = TestUtils::get_temp_path("editor_file_system_scan");
+	remove_dir(root);
+
+	// Several directories per level so the parallel walk actually splits the work.
+	for (int i = 0; i < 4; i++) {
+		const String dir = root.path_join(vformat("Dir_%d", i));
+		for (int j = 0; j < 3; j++) {
+			const String sub_dir = dir.path_join(vformat("sub_%d", j));
+			REQUIRE(DirAccess::make_dir_recursive_absolute(sub_dir) == OK);
+			for (int k = 0; k < 5; k++) {
+				write_file(sub_dir.path_join(vformat("%s_%d.tres", k % 2 ? "b" : "A", k)), "");
+			}
+		}
+		write_file(dir.path_join("file.txt"), "");
+	}
+	write_file(root.path_join("root.txt"), "");
+
+	const String ignored = root.path_join("ignored");
+	REQUIRE(DirAccess::make_dir_recursive_absolute(ignored.path_join("inside")) == OK);
+	write_file(ignored.path_join(".gdignore"), "");
+	write_file(ignored.path_join("inside").path_join("file.txt"), "");
+
+	int serial_count = 0;
+	int parallel_count = 0;
+	Accessor::ScannedDirectory *serial = Accessor::scan(root, false, serial_count);
+	Accessor::ScannedDirectory *parallel = Accessor::scan(root, true, parallel_count);
+	REQUIRE(serial);
+	REQUIRE(parallel);
+
+	CHECK(serial_count == 4 * 3 * 5 + 4 + 1);
+	CHECK(parallel_count == serial_count);
+	CHECK_MESSAGE(serial->subdirs.size() == 4, "Directories with a .gdignore should be skipped.");
+	check_same_tree(serial, parallel);
+
+	Accessor::free_scan(serial);
+	Accessor::free_scan(parallel);
+	remove_dir(root);
+}
+
+TEST_CASE("[EditorFileSystem] Changed file stamps still check the MD5") {
+	const String root = TestUtils::get_temp_path("editor_file_system_stamp");
+	remove_dir(root);
+	REQUIRE(DirAccess::make_dir_recursive_absolute(root) == OK);
+
+	const String source = root.path_join("source.txt");
+	write_file(source, "Hello");
+	const String md5 = FileAccess::get_md5(source);
+	const String stamp = Accessor::get_files_stamp({ source });
+	REQUIRE_FALSE(stamp.is_empty());
+
+	CHECK_FALSE(Accessor::is_md5_outdated({ source }, md5, stamp));
+	CHECK_MESSAGE(Accessor::is_md5_outdated({ source }, "0123456789abcdef0123456789abcdef", ""), "Without a stamp (older .md5 files) the MD5 should always be checked.");
+	CHECK_MESSAGE(Accessor::is_md5_outdated({ source }, "0123456789abcdef0123456789abcdef", "0:0"), "A changed stamp should lead to the MD5 being checked.");
+	CHECK_FALSE_MESSAGE(Accessor::is_md5_outdated({ source }, md5, "0:0"), "A changed stamp with the same contents should not need a reimport.");
+	CHECK_FALSE_MESSAGE(Accessor::is_md5_outdated({ source }, "0123456789abcdef0123456789abcdef", stamp), "An unchanged stamp should skip hashing.");
+
+	write_file(source, "Hello, world");
+	CHECK(Accessor::get_files_stamp({ source }) != stamp);
+	CHECK(Accessor::is_md5_outdated({ source }, md5, stamp));
+
+	const String other = root.path_join("other.txt");
+	write_file(other, "Other");
+	const Vector<String> dest_files = { source, other };
+	const String dest_md5 = FileAccess::get_multiple_md5(dest_files);
+	CHECK_FALSE(Accessor::is_md5_outdated(dest_files, dest_md5, Accessor::get_files_stamp(dest_files)));
+	CHECK(Accessor::is_md5_outdated(dest_files, md5, "0:0;0:0"));
+
+	DirAccess::remove_absolute(other);
+	CHECK_MESSAGE(Accessor::get_files_stamp(dest_files).is_empty(), "Missing files have no stamp.");
+
+	remove_dir(root);
+}
+
+TEST_CASE_BENCHMARK("[EditorFileSystem][Benchmark] Scan a synthetic tree of 100k files") {
+	const int dir_count = 100;
+	const int sub_dir_count = 10;
+	const int files_per_dir = 100;
+	const String root = TestUtils::get_temp_path("editor_file_system_scan_benchmark");
+	remove_dir(root);
+
+	for (int i = 0; i < dir_count; i++) {
+		for (int j = 0; j < sub_dir_count; j++) {
+			const String dir = root.path_join(vformat("dir_%d", i)).path_join(vformat("sub_%d", j));
+			REQUIRE(DirAccess::make_dir_recursive_absolute(dir) == OK);
+			for (int k = 0; k < files_per_dir; k++) {
+				write_file(dir.path_join(vformat("file_%d.tres", k)), "");
+			}
+		}
+	}
+
+	int serial_count = 0;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	Accessor::ScannedDirectory *serial = Accessor::scan(root, false, serial_count);
+	const uint64_t serial_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	int parallel_count = 0;
+	begin = OS::get_singleton()->get_ticks_usec();
+	Accessor::ScannedDirectory *parallel = Accessor::scan(root, true, parallel_count);
+	const uint64_t parallel_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(serial_count == dir_count * sub_dir_count * files_per_dir);
+	CHECK(parallel_count == serial_count);
+
+	MESSAGE(serial_count, " files, serial scan: ", serial_usec / 1000, " ms, parallel scan: ", parallel_usec / 1000, " ms.");
+
+	Accessor::free_scan(serial);
+	Accessor::free_scan(parallel);
+	remove_dir(root);
+}
+
+} // namespace TestEditorFileSystem
+
+#endif // TEST_EDITOR_FILE_SYSTEM_H
@@ -0,0 +1,220 @@
+/**************************************************************************/
+/*  test_editor_file_system_watcher.h                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_EDITOR_FILE_SYSTEM_WATCHER_H
+#define TEST_EDITOR_FILE_SYSTEM_WATCHER_H
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "editor/editor_file_system_watcher.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestEditorFileSystemWatcher {
+
+static void write_file(const String &p_path, const String &p_contents) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_string(p_contents);
+}
+
+static void remove_dir(const String &p_path) {
+	Ref<DirAccess> da = DirAccess::open(p_path);
+	if (da.is_valid()) {
+		da->erase_contents_recursive();
+		DirAccess::remove_absolute(p_path);
+	}
+}
+
+TEST_CASE("[EditorFileSystemWatcher] Report the directories with changes") {
+	if (!EditorFileSystemWatcher::is_supported()) {
+		return;
+	}
+
+	// Directory paths end with a slash, like EditorFileSystemDirectory::get_path().
+	const String root = TestUtils::get_temp_path("file_system_watcher") + "/";
+	const String dir_a = root + "a/";
+	const String dir_b = root + "b/";
+	remove_dir(root);
+	REQUIRE(DirAccess::make_dir_recursive_absolute(dir_a) == OK);
+	REQUIRE(DirAccess::make_dir_recursive_absolute(dir_b) == OK);
+
+	EditorFileSystemWatcher watcher;
+	REQUIRE(watcher.start());
+	REQUIRE(watcher.add_directory(root));
+	REQUIRE(watcher.add_directory(dir_a));
+	REQUIRE(watcher.add_directory(dir_b));
+	CHECK(watcher.get_watched_directory_count() == 3);
+
+	HashSet<String> changed;
+	CHECK_MESSAGE(!watcher.poll_changes(changed), "Changes made before watching are unknown.");
+
+	changed.clear();
+	CHECK(watcher.poll_changes(changed));
+	CHECK(changed.is_empty());
+
+	write_file(dir_a.path_join("file.txt"), "Hello");
+	CHECK(watcher.poll_changes(changed));
+	CHECK(changed.size() == 1);
+	CHECK(changed.has(dir_a));
+
+	changed.clear();
+	write_file(dir_b.path_join(".gdignore"), "");
+	CHECK(watcher.poll_changes(changed));
+	CHECK_MESSAGE(changed.has(root), "Ignoring a directory is checked from its parent.");
+	CHECK(changed.has(dir_b));
+	CHECK_FALSE(changed.has(dir_a));
+
+	changed.clear();
+	remove_dir(dir_b);
+	CHECK(watcher.poll_changes(changed));
+	CHECK(changed.has(root));
+	CHECK_FALSE(watcher.is_watching(dir_b));
+
+	watcher.stop();
+	CHECK_FALSE(watcher.is_active());
+	CHECK_FALSE(watcher.poll_changes(changed));
+
+	remove_dir(root);
+}
+
+TEST_CASE("[EditorFileSystemWatcher] Request full rescans") {
+	if (!EditorFileSystemWatcher::is_supported()) {
+		return;
+	}
+
+	const String root = TestUtils::get_temp_path("file_system_watcher_full_scan") + "/";
+	const String dir = root + "a/";
+	const String imported = root + "imported/";
+	remove_dir(root);
+	REQUIRE(DirAccess::make_dir_recursive_absolute(dir) == OK);
+	REQUIRE(DirAccess::make_dir_recursive_absolute(imported) == OK);
+	write_file(imported.path_join("icon.png-0123.ctex"), "GST2");
+
+	EditorFileSystemWatcher watcher;
+	REQUIRE(watcher.start());
+	REQUIRE(watcher.add_directory(dir));
+	REQUIRE(watcher.watch_imported_files(imported));
+	HashSet<String> changed;
+	watcher.poll_changes(changed);
+
+	changed.clear();
+	CHECK(watcher.poll_changes(changed));
+
+	watcher.request_full_scan();
+	CHECK_FALSE_MESSAGE(watcher.poll_changes(changed), "A requested full rescan should be reported as unknown changes.");
+	CHECK(watcher.poll_changes(changed));
+
+	write_file(imported.path_join("icon.png-4567.ctex"), "GST2");
+	CHECK_MESSAGE(watcher.poll_changes(changed), "Writing imported files shouldn't need a full rescan.");
+	CHECK(changed.is_empty());
+
+	REQUIRE(DirAccess::remove_absolute(imported.path_join("icon.png-0123.ctex")) == OK);
+	CHECK_FALSE_MESSAGE(watcher.poll_changes(changed), "Removing imported files should need a full rescan.");
+
+	remove_dir(imported);
+	CHECK_FALSE(watcher.poll_changes(changed));
+	CHECK_FALSE(watcher.is_watching_imported_files());
+
+	watcher.stop();
+	remove_dir(root);
+}
+
+TEST_CASE_BENCHMARK("[EditorFileSystemWatcher][Benchmark] Detect a single modified file among 100k") {
+	if (!EditorFileSystemWatcher::is_supported()) {
+		return;
+	}
+
+	const int dir_count = 1000;
+	const int files_per_dir = 100;
+	const String root = TestUtils::get_temp_path("file_system_watcher_benchmark");
+	remove_dir(root);
+
+	Vector<String> dirs;
+	for (int i = 0; i < dir_count; i++) {
+		const String dir = root.path_join(vformat("dir_%d", i));
+		REQUIRE(DirAccess::make_dir_recursive_absolute(dir) == OK);
+		for (int j = 0; j < files_per_dir; j++) {
+			write_file(dir.path_join(vformat("file_%d.tres", j)), "[gd_resource type=\"Resource\" format=3]\n");
+		}
+		dirs.push_back(dir);
+	}
+
+	EditorFileSystemWatcher watcher;
+	REQUIRE(watcher.start());
+	REQUIRE(watcher.add_directory(root));
+	for (const String &dir : dirs) {
+		REQUIRE(watcher.add_directory(dir));
+	}
+	HashSet<String> changed;
+	watcher.poll_changes(changed);
+
+	// What a rescan without the watcher has to do: list every directory and stat every file.
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	uint64_t checksum = 0;
+	for (const String &dir : dirs) {
+		Ref<DirAccess> da = DirAccess::open(dir);
+		REQUIRE(da.is_valid());
+		for (const String &file : da->get_files()) {
+			checksum += FileAccess::get_modified_time(dir.path_join(file));
+		}
+	}
+	const uint64_t full_scan_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	CHECK(checksum > 0);
+
+	write_file(dirs[dir_count / 2].path_join("file_0.tres"), "[gd_resource type=\"Resource\" format=3]\n\n");
+
+	changed.clear();
+	begin = OS::get_singleton()->get_ticks_usec();
+	REQUIRE(watcher.poll_changes(changed));
+	const uint64_t detect_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	CHECK(changed.size() == 1);
+	CHECK(changed.has(dirs[dir_count / 2]));
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (const String &dir : changed) {
+		Ref<DirAccess> da = DirAccess::open(dir);
+		REQUIRE(da.is_valid());
+		for (const String &file : da->get_files()) {
+			checksum += FileAccess::get_modified_time(dir.path_join(file));
+		}
+	}
+	const uint64_t watched_scan_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	MESSAGE(dir_count * files_per_dir, " files, full rescan: ", full_scan_usec / 1000, " ms.");
+	MESSAGE("Watcher: change detected in ", detect_usec, " us, rescan of the changed directory: ", watched_scan_usec, " us.");
+
+	watcher.stop();
+	remove_dir(root);
+}
+} // namespace TestEditorFileSystemWatcher
+
+#endif // TEST_EDITOR_FILE_SYSTEM_WATCHER_H
@@ -0,0 +1,227 @@
+/**************************************************************************/
+/*  test_editor_import_cache.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_EDITOR_IMPORT_CACHE_H
+#define TEST_EDITOR_IMPORT_CACHE_H
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "editor/import/editor_import_cache.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestEditorImportCache {
+
+class TestImporter : public ResourceImporter {
+public:
+	String cache_settings;
+
+	virtual String get_importer_name() const override { return "test_importer"; }
+	virtual String get_visible_name() const override { return "Test Importer"; }
+	virtual void get_recognized_extensions(List<String> *p_extensions) const override { p_extensions->push_back("txt"); }
+	virtual String get_save_extension() const override { return "res"; }
+	virtual String get_resource_type() const override { return "Resource"; }
+
+	virtual void get_import_options(const String &p_path, List<ImportOption> *r_options, int p_preset = 0) const override {
+		r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "quality"), 1));
+	}
+	virtual bool get_option_visibility(const String &p_path, const String &p_option, const HashMap<StringName, Variant> &p_options) const override { return true; }
+
+	virtual Error import(const String &p_source_file, const String &p_save_path, const HashMap<StringName, Variant> &p_options, List<String> *r_platform_variants, List<String> *r_gen_files = nullptr, Variant *r_metadata = nullptr) override { return OK; }
+	virtual String get_import_cache_settings_string() const override { return cache_settings; }
+};
+
+static void write_file(const String &p_path, const String &p_contents) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_string(p_contents);
+}
+
+static void remove_dir(const String &p_path) {
+	Ref<DirAccess> da = DirAccess::open(p_path);
+	if (da.is_valid()) {
+		da->erase_contents_recursive();
+		DirAccess::remove_absolute(p_path);
+	}
+}
+
+static String make_key(const Ref<ResourceImporter> &p_importer, const String &p_source_md5, int p_quality) {
+	List<ResourceImporter::ImportOption> options;
+	p_importer->get_import_options("res://source.txt", &options);
+	HashMap<StringName, Variant> params;
+	params["quality"] = p_quality;
+	return EditorImportCache::make_key(p_importer, "res://source.txt", p_source_md5, options, params);
+}
+
+TEST_CASE("[EditorImportCache] Keys depend on the source contents and the options") {
+	Ref<TestImporter> importer;
+	importer.instantiate();
+
+	const String key = make_key(importer, "0123", 1);
+	CHECK(key.length() == 64);
+	CHECK(make_key(importer, "0123", 1) == key);
+	CHECK(make_key(importer, "4567", 1) != key);
+	CHECK(make_key(importer, "0123", 2) != key);
+
+	// Project settings that change the imported files.
+	importer->cache_settings = "force_png=true";
+	CHECK(make_key(importer, "0123", 1) != key);
+}
+
+TEST_CASE("[EditorImportCache] Store and restore import results") {
+	const String root = TestUtils::get_temp_path("import_cache");
+	const String cache_dir = root.path_join("cache");
+	const String project_dir = root.path_join("project");
+	remove_dir(root);
+	REQUIRE(DirAccess::make_dir_recursive_absolute(project_dir) == OK);
+
+	Ref<TestImporter> importer;
+	importer.instantiate();
+
+	EditorImportCache cache;
+	cache.configure(true, cache_dir, 0);
+	REQUIRE(cache.is_enabled());
+
+	const String key = make_key(importer, "0123", 1);
+	const String base_path = project_dir.path_join("source.txt-0123");
+
+	List<String> variants;
+	Variant metadata;
+	CHECK_FALSE(cache.restore(key, base_path, variants, metadata));
+	CHECK(cache.get_miss_count() == 1);
+
+	write_file(base_path + ".s3tc.res", "s3tc data");
+	write_file(base_path + ".etc2.res", "etc2 data");
+	Vector<String> suffixes = { ".s3tc.res", ".etc2.res" };
+	List<String> stored_variants;
+	stored_variants.push_back("s3tc");
+	stored_variants.push_back("etc2");
+	Dictionary stored_metadata;
+	stored_metadata["vram_texture"] = true;
+	cache.store(key, base_path, suffixes, stored_variants, stored_metadata);
+	CHECK(cache.get_store_count() == 1);
+
+	// Restore into another project.
+	const String other_base_path = root.path_join("other").path_join("source.txt-0123");
+	REQUIRE(DirAccess::make_dir_recursive_absolute(other_base_path.get_base_dir()) == OK);
+	CHECK(cache.restore(key, other_base_path, variants, metadata));
+	CHECK(cache.get_hit_count() == 1);
+	CHECK(FileAccess::get_file_as_string(other_base_path + ".s3tc.res") == "s3tc data");
+	CHECK(FileAccess::get_file_as_string(other_base_path + ".etc2.res") == "etc2 data");
+	REQUIRE(variants.size() == 2);
+	CHECK(variants.front()->get() == "s3tc");
+	CHECK(variants.back()->get() == "etc2");
+	CHECK(Dictionary(metadata)["vram_texture"] == Variant(true));
+	CHECK(cache.get_hit_rate() == doctest::Approx(0.5));
+
+	cache.reset_stats();
+	CHECK(cache.get_hit_count() == 0);
+	CHECK(cache.get_miss_count() == 0);
+	CHECK(cache.get_store_count() == 0);
+
+	remove_dir(root);
+}
+
+TEST_CASE("[EditorImportCache] Trim the cache to its maximum size") {
+	const String root = TestUtils::get_temp_path("import_cache_trim");
+	const String cache_dir = root.path_join("cache");
+	remove_dir(root);
+	REQUIRE(DirAccess::make_dir_recursive_absolute(root) == OK);
+
+	Ref<TestImporter> importer;
+	importer.instantiate();
+
+	const String base_path = root.path_join("source.txt-0123");
+	write_file(base_path + ".res", "imported data");
+
+	EditorImportCache cache;
+	cache.configure(true, cache_dir, 1024 * 1024);
+	const String key_a = make_key(importer, "0123", 1);
+	const String key_b = make_key(importer, "0123", 2);
+	cache.store(key_a, base_path, { ".res" }, List<String>(), Variant());
+	cache.store(key_b, base_path, { ".res" }, List<String>(), Variant());
+	CHECK(cache.get_store_count() == 2);
+
+	List<String> variants;
+	Variant metadata;
+	cache.trim();
+	CHECK_MESSAGE(cache.restore(key_a, base_path, variants, metadata), "The cache fits in its maximum size.");
+	CHECK(cache.restore(key_b, base_path, variants, metadata));
+
+	cache.configure(true, cache_dir, 1);
+	cache.trim();
+	CHECK_FALSE(cache.restore(key_a, base_path, variants, metadata));
+	CHECK_FALSE(cache.restore(key_b, base_path, variants, metadata));
+
+	remove_dir(root);
+}
+
+TEST_CASE("[EditorImportCache] Trimming removes the least recently used entries") {
+	const String root = TestUtils::get_temp_path("import_cache_lru");
+	const String cache_dir = root.path_join("cache");
+	remove_dir(root);
+	REQUIRE(DirAccess::make_dir_recursive_absolute(root) == OK);
+
+	Ref<TestImporter> importer;
+	importer.instantiate();
+
+	// Large enough for the entry files to be negligible.
+	const int data_size = 4096;
+	const String base_path = root.path_join("source.txt-0123");
+	write_file(base_path + ".res", String("x").repeat(data_size));
+
+	EditorImportCache cache;
+	cache.configure(true, cache_dir, 1024 * 1024);
+	const String key_a = make_key(importer, "0123", 1);
+	const String key_b = make_key(importer, "0123", 2);
+	const String key_c = make_key(importer, "0123", 3);
+	cache.store(key_a, base_path, { ".res" }, List<String>(), Variant());
+	cache.store(key_b, base_path, { ".res" }, List<String>(), Variant());
+	cache.store(key_c, base_path, { ".res" }, List<String>(), Variant());
+	CHECK(cache.get_store_count() == 3);
+
+	// Using the oldest entry makes the second one the least recently used.
+	List<String> variants;
+	Variant metadata;
+	REQUIRE(cache.restore(key_a, base_path, variants, metadata));
+
+	// Fits two entries.
+	cache.configure(true, cache_dir, data_size * 2 + 1024);
+	cache.trim();
+	CHECK(cache.restore(key_a, base_path, variants, metadata));
+	CHECK_FALSE(cache.restore(key_b, base_path, variants, metadata));
+	CHECK(cache.restore(key_c, base_path, variants, metadata));
+
+	remove_dir(root);
+}
+
+} // namespace TestEditorImportCache
+
+#endif // TEST_EDITOR_IMPORT_CACHE_H
@@ -0,0 +1,235 @@
+/**************************************************************************/
+/*  test_editor_import_scheduler.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_EDITOR_IMPORT_SCHEDULER_H
+#define TEST_EDITOR_IMPORT_SCHEDULER_H
+
+#include "core/os/mutex.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "editor/import/editor_import_scheduler.h"
+#include "tests/test_macros.h"
+
+namespace TestEditorImportScheduler {
+
+struct ImportLog {
+	Mutex mutex;
+	LocalVector<uint32_t> finished;
+	LocalVector<uint32_t> finished_when_started; // How many imports were finished when each one started.
+	LocalVector<Thread::ID> threads;
+	uint32_t progress_calls = 0;
+	uint64_t import_usec = 0;
+
+	ImportLog(uint32_t p_tasks) {
+		finished_when_started.resize(p_tasks);
+		threads.resize(p_tasks);
+	}
+
+	bool finished_before_started(uint32_t p_dependency, uint32_t p_task) const {
+		int64_t pos = finished.find(p_dependency);
+		return pos != -1 && pos < finished_when_started[p_task];
+	}
+};
+
+static void log_import(void *p_userdata, uint32_t p_index) {
+	ImportLog *log = (ImportLog *)p_userdata;
+	{
+		MutexLock lock(log->mutex);
+		log->finished_when_started[p_index] = log->finished.size();
+		log->threads[p_index] = Thread::get_caller_id();
+	}
+	if (log->import_usec) {
+		OS::get_singleton()->delay_usec(log->import_usec);
+	}
+	MutexLock lock(log->mutex);
+	log->finished.push_back(p_index);
+}
+
+static void log_progress(void *p_userdata, uint32_t p_index, uint32_t p_completed) {
+	ImportLog *log = (ImportLog *)p_userdata;
+	log->progress_calls++;
+	CHECK(p_completed == log->progress_calls);
+}
+
+TEST_CASE("[EditorImportScheduler] Dependencies are imported first") {
+	// Two textures, a material using both and a scene using the material.
+	EditorImportScheduler scheduler;
+	const uint32_t texture_a = scheduler.add_task(true);
+	const uint32_t texture_b = scheduler.add_task(true);
+	const uint32_t material = scheduler.add_task(true);
+	const uint32_t scene = scheduler.add_task(false);
+	const uint32_t unrelated = scheduler.add_task(true);
+	scheduler.add_dependency(material, texture_a);
+	scheduler.add_dependency(material, texture_b);
+	scheduler.add_dependency(material, texture_b); // Duplicates are ignored.
+	scheduler.add_dependency(scene, material);
+	CHECK(scheduler.get_task_count() == 5);
+
+	ImportLog log(scheduler.get_task_count());
+	log.import_usec = 1000;
+	scheduler.run(log_import, log_progress, &log, true);
+
+	REQUIRE(log.finished.size() == 5);
+	CHECK(log.progress_calls == 5);
+	CHECK(log.finished_before_started(texture_a, material));
+	CHECK(log.finished_before_started(texture_b, material));
+	CHECK(log.finished_before_started(material, scene));
+	CHECK_MESSAGE(log.threads[scene] == Thread::get_caller_id(), "Non-threaded imports run on the calling thread.");
+	CHECK(log.finished.has(unrelated));
+}
+
+TEST_CASE("[EditorImportScheduler] Serial imports keep their order") {
+	EditorImportScheduler scheduler;
+	for (int i = 0; i < 8; i++) {
+		scheduler.add_task(false);
+	}
+	scheduler.add_dependency(2, 5);
+
+	ImportLog log(scheduler.get_task_count());
+	scheduler.run(log_import, nullptr, &log, true);
+
+	const uint32_t expected[] = { 0, 1, 3, 4, 5, 2, 6, 7 };
+	REQUIRE(log.finished.size() == 8);
+	for (uint32_t i = 0; i < 8; i++) {
+		CHECK(log.finished[i] == expected[i]);
+		CHECK(log.threads[i] == Thread::get_caller_id());
+	}
+}
+
+TEST_CASE("[EditorImportScheduler] Cycles do not block the import") {
+	EditorImportScheduler scheduler;
+	scheduler.add_task(true);
+	scheduler.add_task(true);
+	scheduler.add_task(true);
+	scheduler.add_dependency(0, 1);
+	scheduler.add_dependency(1, 0);
+	scheduler.add_dependency(2, 1);
+
+	ImportLog log(scheduler.get_task_count());
+	ERR_PRINT_OFF;
+	scheduler.run(log_import, nullptr, &log, true);
+	ERR_PRINT_ON;
+
+	REQUIRE(log.finished.size() == 3);
+	CHECK(log.finished_before_started(1, 2));
+}
+
+TEST_CASE("[EditorImportScheduler] Without threads everything runs on the calling thread") {
+	EditorImportScheduler scheduler;
+	for (int i = 0; i < 4; i++) {
+		scheduler.add_task(true);
+	}
+	scheduler.add_dependency(0, 3);
+
+	ImportLog log(scheduler.get_task_count());
+	scheduler.run(log_import, nullptr, &log, false);
+
+	const uint32_t expected[] = { 1, 2, 3, 0 };
+	REQUIRE(log.finished.size() == 4);
+	for (uint32_t i = 0; i < 4; i++) {
+		CHECK(log.finished[i] == expected[i]);
+		CHECK(log.threads[i] == Thread::get_caller_id());
+	}
+}
+
+struct SyntheticAsset {
+	bool threaded = false;
+	uint32_t usec = 0;
+};
+
+static void import_synthetic_asset(void *p_userdata, uint32_t p_index) {
+	const SyntheticAsset *assets = (const SyntheticAsset *)p_userdata;
+	OS::get_singleton()->delay_usec(assets[p_index].usec);
+}
+
+TEST_CASE_BENCHMARK("[EditorImportScheduler][Benchmark] Synthetic asset set") {
+	// One import order worth of files, sorted by importer like EditorFileSystem does:
+	// translations and bitmap fonts (serial), then audio, then textures (threaded),
+	// then OBJ models (serial) which use some of the textures.
+	LocalVector<SyntheticAsset> assets;
+	LocalVector<uint32_t> batch_ends;
+	const struct {
+		uint32_t count;
+		bool threaded;
+		uint32_t usec;
+	} batches[] = {
+		{ 20, false, 5000 },
+		{ 100, true, 3000 },
+		{ 400, true, 4000 },
+		{ 20, false, 10000 },
+	};
+	for (const auto &batch : batches) {
+		for (uint32_t i = 0; i < batch.count; i++) {
+			SyntheticAsset asset;
+			asset.threaded = batch.threaded;
+			asset.usec = batch.usec;
+			assets.push_back(asset);
+		}
+		batch_ends.push_back(assets.size());
+	}
+
+	// Batch by batch, as the reimport did before: a group task per run of threaded files.
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	uint32_t from = 0;
+	for (uint32_t end : batch_ends) {
+		if (assets[from].threaded) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(import_synthetic_asset, assets.ptr() + from, end - from);
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			for (uint32_t i = from; i < end; i++) {
+				import_synthetic_asset(assets.ptr(), i);
+			}
+		}
+		from = end;
+	}
+	const uint64_t batched_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	// The same files as a dependency graph, with the same implicit ordering of serial files.
+	EditorImportScheduler scheduler;
+	int last_serial = -1;
+	for (uint32_t i = 0; i < assets.size(); i++) {
+		scheduler.add_task(assets[i].threaded);
+		if (!assets[i].threaded) {
+			for (int j = MAX(last_serial, 0); j < (int)i; j++) {
+				scheduler.add_dependency(i, j);
+			}
+			last_serial = i;
+		}
+	}
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	scheduler.run(import_synthetic_asset, nullptr, assets.ptr(), true);
+	const uint64_t scheduled_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	MESSAGE(assets.size(), " synthetic imports, batched: ", batched_usec / 1000, " ms, dependency graph: ", scheduled_usec / 1000, " ms.");
+}
+} // namespace TestEditorImportScheduler
+
+#endif // TEST_EDITOR_IMPORT_SCHEDULER_H
@@ -0,0 +1,180 @@
+/**************************************************************************/
+/*  test_hlod_builder.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_HLOD_BUILDER_H
+#define TEST_HLOD_BUILDER_H
+
+#include "scene/3d/hlod_builder.h"
+#include "scene/3d/mesh_instance_3d.h"
+#include "scene/main/window.h"
+#include "scene/resources/3d/primitive_meshes.h"
+#include "scene/resources/3d/world_3d.h"
+#include "scene/resources/surface_tool.h"
+#include "servers/rendering/rendering_server_globals.h"
+#include "servers/xr/xr_interface.h"
+
+#include "tests/test_macros.h"
+
+namespace TestHLODBuilder {
+
+static int count_indices(const Ref<Mesh> &p_mesh) {
+	int count = 0;
+	for (int i = 0; i < p_mesh->get_surface_count(); i++) {
+		PackedInt32Array indices = p_mesh->surface_get_arrays(i)[Mesh::ARRAY_INDEX];
+		count += indices.size();
+	}
+	return count;
+}
+
+TEST_CASE("[SceneTree][HLODBuilder] Build and clear proxies") {
+	Node3D *root = memnew(Node3D);
+	SceneTree::get_singleton()->get_root()->add_child(root);
+
+	Ref<BoxMesh> box;
+	box.instantiate();
+	Ref<ArrayMesh> mesh;
+	mesh.instantiate();
+	mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, box->get_mesh_arrays());
+
+	// Two groups of eight instances, one near the camera and one far away from it.
+	Vector<MeshInstance3D *> instances;
+	for (int i = 0; i < 16; i++) {
+		MeshInstance3D *mi = memnew(MeshInstance3D);
+		mi->set_mesh(mesh);
+		mi->set_position(Vector3((i % 8) * 2.0, 0, i < 8 ? -20.0 : -1000.0));
+		root->add_child(mi);
+		instances.push_back(mi);
+	}
+
+	// Left out, it already has a manual LOD.
+	MeshInstance3D *manual_lod = memnew(MeshInstance3D);
+	manual_lod->set_mesh(mesh);
+	manual_lod->set_position(Vector3(0, 0, -20.0));
+	manual_lod->set_visibility_range_end(100.0);
+	root->add_child(manual_lod);
+
+	Ref<HLODBuilder> builder;
+	builder.instantiate();
+	builder->set_proxy_distance(150.0);
+
+	CHECK(builder->build(root) == OK);
+	CHECK(builder->get_cluster_count() == 2);
+	CHECK(builder->get_clustered_instance_count() == 16);
+
+	Node *proxy_root = root->get_node_or_null(NodePath(HLODBuilder::PROXY_ROOT_NAME));
+	REQUIRE(proxy_root);
+	CHECK(proxy_root->get_child_count() == 2);
+
+	MeshInstance3D *near_proxy = Object::cast_to<MeshInstance3D>(proxy_root->get_child(0));
+	MeshInstance3D *far_proxy = Object::cast_to<MeshInstance3D>(proxy_root->get_child(1));
+	REQUIRE(near_proxy);
+	REQUIRE(far_proxy);
+	CHECK(near_proxy->get_visibility_range_begin() == doctest::Approx(150.0));
+	CHECK(near_proxy->get_global_position().is_equal_approx(Vector3(7.0, 0, -20.0)));
+	CHECK(instances[0]->get_node_or_null(instances[0]->get_visibility_parent()) == near_proxy);
+	CHECK(instances[15]->get_node_or_null(instances[15]->get_visibility_parent()) == far_proxy);
+	CHECK(manual_lod->get_visibility_parent().is_empty());
+
+	if (SurfaceTool::simplify_func) {
+		CHECK(count_indices(near_proxy->get_mesh()) < count_indices(mesh) * 8);
+	} else {
+		CHECK(count_indices(near_proxy->get_mesh()) == count_indices(mesh) * 8);
+	}
+
+	SUBCASE("Proxies replace far away instances when culling") {
+		RS *rs = RS::get_singleton();
+		RID scenario = root->get_world_3d()->get_scenario();
+		RID camera = rs->camera_create();
+		rs->camera_set_perspective(camera, 70.0, 0.05, 4000.0);
+		RID shadow_atlas = rs->shadow_atlas_create();
+		Ref<RenderSceneBuffers> render_buffers = RSG::scene->render_buffers_create();
+		Ref<XRInterface> xr_interface;
+
+		RSG::scene->update();
+		RenderingMethod::RenderInfo info;
+		RSG::scene->render_camera(render_buffers, camera, scenario, RID(), Size2i(1920, 1080), 0, 1.0 / 1920, shadow_atlas, xr_interface, &info);
+		// The near instances, the far proxy and the manual LOD.
+		CHECK(info.info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE][RS::VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME] == 10);
+
+		builder->clear(root);
+		RSG::scene->update();
+		info = RenderingMethod::RenderInfo();
+		RSG::scene->render_camera(render_buffers, camera, scenario, RID(), Size2i(1920, 1080), 0, 1.0 / 1920, shadow_atlas, xr_interface, &info);
+		CHECK(info.info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE][RS::VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME] == 17);
+
+		render_buffers.unref();
+		rs->free(shadow_atlas);
+		rs->free(camera);
+	}
+
+	SUBCASE("Clear") {
+		builder->clear(root);
+		CHECK(root->get_node_or_null(NodePath(HLODBuilder::PROXY_ROOT_NAME)) == nullptr);
+		CHECK(builder->get_cluster_count() == 0);
+		for (MeshInstance3D *mi : instances) {
+			CHECK(mi->get_visibility_parent().is_empty());
+		}
+	}
+
+	SUBCASE("Clear only removes the built proxies") {
+		builder->clear(root);
+
+		// A node of the user, named like the proxy root.
+		Node3D *user_node = memnew(Node3D);
+		user_node->set_name(HLODBuilder::PROXY_ROOT_NAME);
+		root->add_child(user_node);
+
+		CHECK(builder->build(root) == OK);
+		CHECK(builder->get_cluster_count() == 2);
+		CHECK(root->get_node_or_null(NodePath(HLODBuilder::PROXY_ROOT_NAME)) == user_node);
+
+		builder->clear(root);
+		CHECK(root->get_node_or_null(NodePath(HLODBuilder::PROXY_ROOT_NAME)) == user_node);
+		for (int i = 0; i < root->get_child_count(); i++) {
+			CHECK_FALSE(root->get_child(i)->has_meta(HLODBuilder::PROXY_ROOT_META));
+		}
+		for (MeshInstance3D *mi : instances) {
+			CHECK(mi->get_visibility_parent().is_empty());
+		}
+	}
+
+	SUBCASE("Minimum cluster size") {
+		builder->set_min_cluster_instances(9);
+		CHECK(builder->build(root) == OK);
+		CHECK(builder->get_cluster_count() == 0);
+		CHECK(root->get_node_or_null(NodePath(HLODBuilder::PROXY_ROOT_NAME)) == nullptr);
+	}
+
+	memdelete(root);
+}
+
+} // namespace TestHLODBuilder
+
+#endif // TEST_HLOD_BUILDER_H
@@ -0,0 +1,89 @@
+/**************************************************************************/
+/*  test_multimesh.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MULTIMESH_H
+#define TEST_MULTIMESH_H
+
+#include "scene/resources/multimesh.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMultiMesh {
+
+static Vector<float> make_buffer(int p_instances, int p_stride, float p_base) {
+	Vector<float> buffer;
+	buffer.resize(p_instances * p_stride);
+	for (int i = 0; i < buffer.size(); i++) {
+		buffer.set(i, p_base + i);
+	}
+	return buffer;
+}
+
+TEST_CASE("[SceneTree][MultiMesh] Setting a range of the buffer") {
+	Ref<MultiMesh> multimesh;
+	multimesh.instantiate();
+	multimesh->set_transform_format(MultiMesh::TRANSFORM_3D);
+	multimesh->set_use_colors(true);
+	multimesh->set_instance_count(8);
+	const int stride = 16;
+
+	Vector<float> expected = make_buffer(8, stride, 0.0);
+	multimesh->set("buffer", expected);
+
+	SUBCASE("Only the given instances are replaced") {
+		const Vector<float> range = make_buffer(3, stride, 1000.0);
+		multimesh->set_buffer_range(2, range);
+		for (int i = 0; i < range.size(); i++) {
+			expected.set(2 * stride + i, range[i]);
+		}
+		CHECK(Vector<float>(multimesh->get("buffer")) == expected);
+
+		// The last instances can be written too.
+		const Vector<float> tail = make_buffer(1, stride, 5000.0);
+		multimesh->set_buffer_range(7, tail);
+		for (int i = 0; i < stride; i++) {
+			expected.set(7 * stride + i, tail[i]);
+		}
+		CHECK(Vector<float>(multimesh->get("buffer")) == expected);
+	}
+
+	SUBCASE("Invalid ranges are rejected") {
+		ERR_PRINT_OFF;
+		multimesh->set_buffer_range(6, make_buffer(3, stride, 1000.0));
+		multimesh->set_buffer_range(-1, make_buffer(1, stride, 1000.0));
+		multimesh->set_buffer_range(0, make_buffer(1, 12, 1000.0));
+		ERR_PRINT_ON;
+		CHECK(Vector<float>(multimesh->get("buffer")) == expected);
+	}
+}
+
+} // namespace TestMultiMesh
+
+#endif // TEST_MULTIMESH_H
@@ -0,0 +1,99 @@
+/**************************************************************************/
+/*  test_visual_instance_3d.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_VISUAL_INSTANCE_3D_H
+#define TEST_VISUAL_INSTANCE_3D_H
+
+#include "scene/3d/visual_instance_3d.h"
+#include "scene/main/window.h"
+#include "servers/rendering/renderer_scene_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+
+namespace TestVisualInstance3D {
+
+static Transform3D get_instance_transform(const VisualInstance3D *p_node) {
+	RendererSceneCull::Instance *instance = static_cast<RendererSceneCull *>(RSG::scene)->instance_owner.get_or_null(p_node->get_instance());
+	REQUIRE(instance);
+	return instance->transform;
+}
+
+TEST_CASE("[SceneTree][VisualInstance3D] Transforms changed in one frame are sent on flush") {
+	SceneTree *tree = SceneTree::get_singleton();
+	Node3D *parent = memnew(Node3D);
+	tree->get_root()->add_child(parent);
+
+	// Children of a moved parent and top level nodes moved directly end up in the same batch.
+	Vector<VisualInstance3D *> children;
+	for (int i = 0; i < 3; i++) {
+		VisualInstance3D *child = memnew(VisualInstance3D);
+		child->set_position(Vector3(i, 0, 0));
+		parent->add_child(child);
+		children.push_back(child);
+	}
+	Vector<VisualInstance3D *> top_level;
+	for (int i = 0; i < 3; i++) {
+		VisualInstance3D *node = memnew(VisualInstance3D);
+		tree->get_root()->add_child(node);
+		top_level.push_back(node);
+	}
+	tree->flush_transform_notifications();
+
+	for (int frame = 1; frame <= 2; frame++) {
+		parent->set_position(Vector3(0, frame * 10, 0));
+		top_level[0]->set_position(Vector3(frame * 5, 0, 0));
+		top_level[2]->set_rotation(Vector3(0, frame * 0.5, 0));
+
+		// Nothing is sent until transform notifications are flushed.
+		CHECK(get_instance_transform(children[1]).origin.is_equal_approx(Vector3(1, (frame - 1) * 10, 0)));
+
+		tree->flush_transform_notifications();
+
+		for (int i = 0; i < children.size(); i++) {
+			CHECK(get_instance_transform(children[i]).is_equal_approx(children[i]->get_global_transform()));
+			CHECK(get_instance_transform(children[i]).origin.is_equal_approx(Vector3(i, frame * 10, 0)));
+		}
+		for (VisualInstance3D *node : top_level) {
+			CHECK(get_instance_transform(node).is_equal_approx(node->get_global_transform()));
+		}
+		CHECK(get_instance_transform(top_level[0]).origin.is_equal_approx(Vector3(frame * 5, 0, 0)));
+		CHECK(get_instance_transform(top_level[1]).is_equal_approx(Transform3D()));
+	}
+
+	for (VisualInstance3D *node : top_level) {
+		memdelete(node);
+	}
+	memdelete(parent);
+}
+
+} // namespace TestVisualInstance3D
+
+#endif // TEST_VISUAL_INSTANCE_3D_H
@@ -0,0 +1,179 @@
+/**************************************************************************/
+/*  test_canvas_cull.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_CANVAS_CULL_H
+#define TEST_CANVAS_CULL_H
+
+#include "servers/rendering/renderer_canvas_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+#include "servers/rendering_server.h"
+
+#include "tests/test_macros.h"
+
+class TestRendererCanvasCullInternalsAccessor {
+public:
+	static bool is_subtree_bounds_dirty(RID p_item) {
+		RendererCanvasCull::Item *item = RSG::canvas->canvas_item_owner.get_or_null(p_item);
+		return item->subtree_bounds_dirty;
+	}
+
+	static Rect2 get_subtree_bounds(RID p_item) {
+		RendererCanvasCull::Item *item = RSG::canvas->canvas_item_owner.get_or_null(p_item);
+		if (item->subtree_bounds_dirty) {
+			RSG::canvas->_update_subtree_bounds(item);
+		}
+		return item->subtree_bounds;
+	}
+
+	// Culls the canvas the way render_canvas() does and returns the items in draw order.
+	static LocalVector<RendererCanvasRender::Item *> cull(RID p_canvas, const Rect2 &p_clip_rect, bool p_parallel) {
+		RendererCanvasCull::Canvas *canvas = RSG::canvas->canvas_owner.get_or_null(p_canvas);
+		if (canvas->children_order_dirty) {
+			canvas->child_items.sort();
+			canvas->children_order_dirty = false;
+		}
+
+		// The previous frame's item count decides whether the top level children are culled in parallel.
+		uint32_t cull_item_count = p_parallel ? RendererCanvasCull::CULL_PARALLEL_MIN_ITEMS : 0;
+		RendererCanvasRender::Item *list = RSG::canvas->_cull_canvas_item_tree(canvas->child_items.ptrw(), canvas->child_items.size(), Transform2D(), p_clip_rect, 0xFFFFFFFF, cull_item_count);
+
+		LocalVector<RendererCanvasRender::Item *> items;
+		for (RendererCanvasRender::Item *item = list; item; item = item->next) {
+			items.push_back(item);
+		}
+		return items;
+	}
+};
+
+namespace TestCanvasCull {
+
+typedef TestRendererCanvasCullInternalsAccessor Accessor;
+
+TEST_CASE("[SceneTree][RenderingServer] Canvas subtree bounds") {
+	RS *rs = RS::get_singleton();
+	RID canvas = rs->canvas_create();
+	RID root = rs->canvas_item_create();
+	RID middle = rs->canvas_item_create();
+	RID leaf = rs->canvas_item_create();
+	rs->canvas_item_set_parent(root, canvas);
+	rs->canvas_item_set_parent(middle, root);
+	rs->canvas_item_set_parent(leaf, middle);
+	rs->canvas_item_add_rect(leaf, Rect2(0, 0, 10, 10), Color(1, 1, 1));
+	rs->canvas_item_set_transform(leaf, Transform2D(0, Vector2(100, 0)));
+
+	CHECK(Accessor::get_subtree_bounds(root).has_point(Vector2(105, 5)));
+	CHECK_FALSE(Accessor::is_subtree_bounds_dirty(root));
+	CHECK_FALSE(Accessor::is_subtree_bounds_dirty(middle));
+	CHECK_FALSE(Accessor::is_subtree_bounds_dirty(leaf));
+
+	SUBCASE("Moving a child invalidates its ancestors") {
+		rs->canvas_item_set_transform(leaf, Transform2D(0, Vector2(200, 0)));
+		CHECK(Accessor::is_subtree_bounds_dirty(middle));
+		CHECK(Accessor::is_subtree_bounds_dirty(root));
+
+		Rect2 bounds = Accessor::get_subtree_bounds(root);
+		CHECK_FALSE(bounds.has_point(Vector2(105, 5)));
+		CHECK(bounds.has_point(Vector2(205, 5)));
+		CHECK_FALSE(Accessor::is_subtree_bounds_dirty(middle));
+	}
+
+	SUBCASE("Hiding a child invalidates its ancestors") {
+		rs->canvas_item_set_visible(leaf, false);
+		CHECK(Accessor::is_subtree_bounds_dirty(middle));
+		CHECK(Accessor::is_subtree_bounds_dirty(root));
+
+		CHECK_FALSE(Accessor::get_subtree_bounds(root).has_point(Vector2(105, 5)));
+		CHECK(Accessor::cull(canvas, Rect2(0, 0, 1024, 1024), false).is_empty());
+
+		rs->canvas_item_set_visible(leaf, true);
+		CHECK(Accessor::is_subtree_bounds_dirty(root));
+		CHECK(Accessor::get_subtree_bounds(root).has_point(Vector2(105, 5)));
+	}
+
+	SUBCASE("Subtrees outside the clip rect are skipped") {
+		CHECK(Accessor::cull(canvas, Rect2(0, 0, 1024, 1024), false).size() == 1);
+		CHECK(Accessor::cull(canvas, Rect2(0, 0, 50, 50), false).is_empty());
+
+		rs->canvas_item_set_transform(middle, Transform2D(0, Vector2(-100, 0)));
+		CHECK(Accessor::cull(canvas, Rect2(0, 0, 50, 50), false).size() == 1);
+	}
+
+	rs->free(leaf);
+	rs->free(middle);
+	rs->free(root);
+	rs->free(canvas);
+}
+
+TEST_CASE("[SceneTree][RenderingServer] Parallel canvas culling keeps the draw order") {
+	RS *rs = RS::get_singleton();
+	RID canvas = rs->canvas_create();
+	Vector<RID> items;
+
+	// Enough top level children for several groups, with every group drawing into several z indices.
+	for (int i = 0; i < 64; i++) {
+		RID parent = rs->canvas_item_create();
+		rs->canvas_item_set_parent(parent, canvas);
+		rs->canvas_item_set_z_index(parent, i % 3);
+		rs->canvas_item_add_rect(parent, Rect2(i * 10, 0, 8, 8), Color(1, 1, 1));
+		items.push_back(parent);
+
+		for (int j = 0; j < 2; j++) {
+			RID child = rs->canvas_item_create();
+			rs->canvas_item_set_parent(child, parent);
+			rs->canvas_item_set_z_index(child, (i + j) % 4 - 2);
+			rs->canvas_item_add_rect(child, Rect2(i * 10, 10 + j * 10, 8, 8), Color(1, 1, 1));
+			items.push_back(child);
+		}
+	}
+
+	LocalVector<RendererCanvasRender::Item *> serial = Accessor::cull(canvas, Rect2(0, 0, 1024, 1024), false);
+	LocalVector<RendererCanvasRender::Item *> parallel = Accessor::cull(canvas, Rect2(0, 0, 1024, 1024), true);
+
+	REQUIRE(serial.size() == (uint32_t)items.size());
+	REQUIRE(parallel.size() == serial.size());
+
+	bool same_order = true;
+	bool sorted_by_z = true;
+	for (uint32_t i = 0; i < serial.size(); i++) {
+		same_order = same_order && parallel[i] == serial[i];
+		sorted_by_z = sorted_by_z && (i == 0 || serial[i - 1]->z_final <= serial[i]->z_final);
+	}
+	CHECK(same_order);
+	CHECK(sorted_by_z);
+
+	for (const RID &item : items) {
+		rs->free(item);
+	}
+	rs->free(canvas);
+}
+
+} // namespace TestCanvasCull
+
+#endif // TEST_CANVAS_CULL_H
@@ -0,0 +1,124 @@
+/**************************************************************************/
+/*  test_directional_shadow_cache.h                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_DIRECTIONAL_SHADOW_CACHE_H
+#define TEST_DIRECTIONAL_SHADOW_CACHE_H
+
+#include "servers/rendering/renderer_scene_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestDirectionalShadowCache {
+
+typedef RendererSceneCull::InstanceLightData::DirectionalShadowCache DirectionalShadowCache;
+
+static const real_t cascade_near = 0.05;
+static const real_t cascade_far = 10.0;
+
+static Vector<Plane> get_cull_planes(const Transform3D &p_camera_transform, const Basis &p_light_basis, real_t p_margin) {
+	Projection camera_matrix;
+	camera_matrix.set_perspective(75.0, 16.0 / 9.0, cascade_near, cascade_far, true);
+
+	Vector3 endpoints[8];
+	camera_matrix.get_endpoints(p_camera_transform, endpoints);
+
+	return RendererSceneCull::_directional_shadow_get_cull_planes(endpoints, p_light_basis.get_column(Vector3::AXIS_X), p_light_basis.get_column(Vector3::AXIS_Y), p_light_basis.get_column(Vector3::AXIS_Z), 0.0, p_margin);
+}
+
+TEST_CASE("[RenderingServer] Directional shadow cache survives small camera motions") {
+	const Basis light_basis = Basis::from_euler(Vector3(-Math_PI / 3.0, Math_PI / 4.0, 0.0));
+	const Transform3D camera_transform(Basis::from_euler(Vector3(-0.2, 0.5, 0.0)), Vector3(3.0, 2.0, -4.0));
+	const real_t margin = (cascade_far - cascade_near) * RendererSceneCull::DIRECTIONAL_SHADOW_CACHE_MARGIN;
+
+	DirectionalShadowCache cache;
+	cache.frustum = RendererSceneCull::Frustum(get_cull_planes(camera_transform, light_basis, margin));
+	cache.visible_layers = 1;
+	cache.valid = true;
+
+	CHECK_MESSAGE(cache.covers(get_cull_planes(camera_transform, light_basis, 0.0), 1), "The frustum the cache was built for should hit it.");
+
+	Transform3D moved = camera_transform;
+	moved.origin += Vector3(0.1, -0.05, 0.2);
+	CHECK_MESSAGE(cache.covers(get_cull_planes(moved, light_basis, 0.0), 1), "A slightly translated camera should hit the cache.");
+
+	Transform3D rotated = camera_transform;
+	rotated.basis = Basis(Vector3(0, 1, 0), Math::deg_to_rad(1.0)) * rotated.basis;
+	CHECK_MESSAGE(cache.covers(get_cull_planes(rotated, light_basis, 0.0), 1), "A slightly rotated camera should hit the cache.");
+
+	Transform3D both = moved;
+	both.basis = rotated.basis;
+	CHECK_MESSAGE(cache.covers(get_cull_planes(both, light_basis, 0.0), 1), "A slightly translated and rotated camera should hit the cache.");
+
+	Transform3D far = camera_transform;
+	far.origin += Vector3(20.0, 0.0, 0.0);
+	CHECK_FALSE_MESSAGE(cache.covers(get_cull_planes(far, light_basis, 0.0), 1), "A camera that moved away should miss the cache.");
+
+	Transform3D turned = camera_transform;
+	turned.basis = Basis(Vector3(0, 1, 0), Math_PI) * turned.basis;
+	CHECK_FALSE_MESSAGE(cache.covers(get_cull_planes(turned, light_basis, 0.0), 1), "A camera that turned around should miss the cache.");
+
+	const Basis light_moved = Basis(Vector3(1, 0, 0), Math::deg_to_rad(1.0)) * light_basis;
+	CHECK_FALSE_MESSAGE(cache.covers(get_cull_planes(camera_transform, light_moved, 0.0), 1), "A rotated light should miss the cache.");
+
+	CHECK_FALSE_MESSAGE(cache.covers(get_cull_planes(camera_transform, light_basis, 0.0), 2), "Other visible layers should miss the cache.");
+
+	cache.valid = false;
+	CHECK_FALSE_MESSAGE(cache.covers(get_cull_planes(camera_transform, light_basis, 0.0), 1), "An invalidated cache should miss.");
+}
+
+TEST_CASE("[RenderingServer] Cached directional shadow casters can be outside the cascade") {
+	const Basis light_basis = Basis::from_euler(Vector3(-Math_PI / 3.0, Math_PI / 4.0, 0.0));
+	const Transform3D camera_transform(Basis::from_euler(Vector3(-0.2, 0.5, 0.0)), Vector3(3.0, 2.0, -4.0));
+	const real_t margin = (cascade_far - cascade_near) * RendererSceneCull::DIRECTIONAL_SHADOW_CACHE_MARGIN;
+
+	const RendererSceneCull::Frustum cache_frustum(get_cull_planes(camera_transform, light_basis, margin));
+	const RendererSceneCull::Frustum caster_frustum(get_cull_planes(camera_transform, light_basis, 0.0));
+
+	// Walk sideways from the middle of the cascade until leaving it.
+	const Vector3 center = camera_transform.xform(Vector3(0.0, 0.0, -(cascade_near + cascade_far) * 0.5));
+	const Vector3 side = light_basis.get_column(Vector3::AXIS_X);
+	RendererSceneCull::InstanceBounds bounds;
+	bool left_cascade = false;
+	for (real_t offset = 0.0; offset < cascade_far * 4.0; offset += 0.05) {
+		bounds = RendererSceneCull::InstanceBounds(AABB(center + side * offset, Vector3(0.01, 0.01, 0.01)));
+		if (!bounds.in_frustum(caster_frustum)) {
+			left_cascade = true;
+			break;
+		}
+	}
+	REQUIRE(left_cascade);
+
+	// Caching keeps this caster, so it has to be culled against the cascade before rendering.
+	CHECK(bounds.in_frustum(cache_frustum));
+}
+
+} // namespace TestDirectionalShadowCache
+
+#endif // TEST_DIRECTIONAL_SHADOW_CACHE_H
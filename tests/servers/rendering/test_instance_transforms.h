@@ -0,0 +1,153 @@
+/**************************************************************************/
+/*  test_instance_transforms.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_INSTANCE_TRANSFORMS_H
+#define TEST_INSTANCE_TRANSFORMS_H
+
+#include "core/os/os.h"
+#include "servers/rendering_server.h"
+
+#include "tests/test_macros.h"
+
+namespace TestInstanceTransforms {
+
+struct InstanceGrid {
+	RID scenario;
+	RID mesh;
+	LocalVector<RID> instances;
+
+	InstanceGrid(int p_count) {
+		RS *rs = RS::get_singleton();
+		scenario = rs->scenario_create();
+		mesh = rs->mesh_create();
+		instances.resize(p_count);
+		for (int i = 0; i < p_count; i++) {
+			RID instance = rs->instance_create2(mesh, scenario);
+			rs->instance_set_custom_aabb(instance, AABB(Vector3(-0.5, -0.5, -0.5), Vector3(1, 1, 1)));
+			rs->instance_attach_object_instance_id(instance, ObjectID(uint64_t(i + 1)));
+			instances[i] = instance;
+		}
+	}
+
+	LocalVector<Transform3D> make_transforms(real_t p_offset) const {
+		LocalVector<Transform3D> transforms;
+		transforms.resize(instances.size());
+		for (uint32_t i = 0; i < instances.size(); i++) {
+			transforms[i] = Transform3D(Basis(), Vector3(i * 10.0 + p_offset, 0, 0));
+		}
+		return transforms;
+	}
+
+	~InstanceGrid() {
+		RS *rs = RS::get_singleton();
+		for (const RID &instance : instances) {
+			rs->free(instance);
+		}
+		rs->free(mesh);
+		rs->free(scenario);
+	}
+};
+
+TEST_CASE("[SceneTree][RenderingServer] Batched instance transforms") {
+	InstanceGrid grid(8);
+	RS *rs = RS::get_singleton();
+
+	rs->instances_set_transforms(grid.instances, grid.make_transforms(0.0));
+
+	Vector<ObjectID> found = rs->instances_cull_aabb(AABB(Vector3(29, -1, -1), Vector3(2, 2, 2)), grid.scenario);
+	REQUIRE(found.size() == 1);
+	CHECK(found[0] == ObjectID(uint64_t(4)));
+
+	SUBCASE("Later batches move the instances again") {
+		rs->instances_set_transforms(grid.instances, grid.make_transforms(5.0));
+		found = rs->instances_cull_aabb(AABB(Vector3(29, -1, -1), Vector3(2, 2, 2)), grid.scenario);
+		CHECK(found.is_empty());
+		found = rs->instances_cull_aabb(AABB(Vector3(34, -1, -1), Vector3(2, 2, 2)), grid.scenario);
+		REQUIRE(found.size() == 1);
+		CHECK(found[0] == ObjectID(uint64_t(4)));
+	}
+
+	SUBCASE("Script binding uses the MultiMesh buffer layout") {
+		TypedArray<RID> instances;
+		instances.push_back(grid.instances[0]);
+		PackedFloat32Array transforms;
+		const float transform[12] = { 1, 0, 0, 100, 0, 1, 0, 0, 0, 0, 1, -50 };
+		for (int i = 0; i < 12; i++) {
+			transforms.push_back(transform[i]);
+		}
+		rs->call("instances_set_transforms", instances, transforms);
+
+		found = rs->instances_cull_aabb(AABB(Vector3(99, -1, -51), Vector3(2, 2, 2)), grid.scenario);
+		REQUIRE(found.size() == 1);
+		CHECK(found[0] == ObjectID(uint64_t(1)));
+	}
+
+	SUBCASE("Mismatched array sizes are rejected") {
+		LocalVector<Transform3D> transforms = grid.make_transforms(5.0);
+		transforms.resize(3);
+		ERR_PRINT_OFF;
+		rs->instances_set_transforms(grid.instances, transforms);
+		ERR_PRINT_ON;
+		found = rs->instances_cull_aabb(AABB(Vector3(29, -1, -1), Vector3(2, 2, 2)), grid.scenario);
+		CHECK(found.size() == 1);
+	}
+}
+
+TEST_CASE_BENCHMARK("[SceneTree][RenderingServer][Benchmark] Per-call and batched instance transforms") {
+	const int instance_count = 40000;
+	const int frame_count = 20;
+	InstanceGrid grid(instance_count);
+	RS *rs = RS::get_singleton();
+
+	uint64_t single_usec = 0;
+	uint64_t batched_usec = 0;
+	for (int frame = 0; frame < frame_count; frame++) {
+		// Alternate offsets so every call actually moves the instances.
+		LocalVector<Transform3D> transforms = grid.make_transforms(frame * 2.0);
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < instance_count; i++) {
+			rs->instance_set_transform(grid.instances[i], transforms[i]);
+		}
+		rs->sync();
+		single_usec += OS::get_singleton()->get_ticks_usec() - begin;
+
+		transforms = grid.make_transforms(frame * 2.0 + 1.0);
+		begin = OS::get_singleton()->get_ticks_usec();
+		rs->instances_set_transforms(grid.instances, transforms);
+		rs->sync();
+		batched_usec += OS::get_singleton()->get_ticks_usec() - begin;
+	}
+
+	MESSAGE(vformat("%d instances: %.3f ms per frame with instance_set_transform(), %.3f ms per frame with instances_set_transforms().", instance_count, single_usec / 1000.0 / frame_count, batched_usec / 1000.0 / frame_count));
+}
+
+} // namespace TestInstanceTransforms
+
+#endif // TEST_INSTANCE_TRANSFORMS_H
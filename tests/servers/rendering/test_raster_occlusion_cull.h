@@ -0,0 +1,215 @@
+/**************************************************************************/
+/*  test_raster_occlusion_cull.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RASTER_OCCLUSION_CULL_H
+#define TEST_RASTER_OCCLUSION_CULL_H
+
+#include "servers/rendering/raster_occlusion_cull.h"
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "modules/modules_enabled.gen.h" // For raycast.
+
+#ifdef MODULE_RAYCAST_ENABLED
+#include "modules/raycast/raycast_occlusion_cull.h"
+#endif
+
+#include "tests/test_macros.h"
+
+namespace TestRasterOcclusionCull {
+
+// Drives an occlusion culling backend through the same calls the scene cull makes.
+struct OcclusionScene {
+	RendererSceneOcclusionCull *cull = nullptr;
+	RID scenario = RID::from_uint64(1);
+	RID buffer = RID::from_uint64(2);
+	LocalVector<RID> occluders;
+	uint64_t next_instance = 100;
+
+	OcclusionScene(RendererSceneOcclusionCull *p_cull, const Size2i &p_size) {
+		cull = p_cull;
+		cull->add_scenario(scenario);
+		cull->add_buffer(buffer);
+		cull->buffer_set_scenario(buffer, scenario);
+		cull->buffer_set_size(buffer, p_size);
+	}
+
+	RID add_box(const Vector3 &p_position, const Vector3 &p_size) {
+		PackedVector3Array vertices;
+		for (int i = 0; i < 8; i++) {
+			vertices.push_back(p_position + Vector3(i & 1 ? p_size.x : 0.0, i & 2 ? p_size.y : 0.0, i & 4 ? p_size.z : 0.0));
+		}
+		const int faces[6][4] = { { 0, 1, 3, 2 }, { 4, 6, 7, 5 }, { 0, 4, 5, 1 }, { 2, 3, 7, 6 }, { 0, 2, 6, 4 }, { 1, 5, 7, 3 } };
+		PackedInt32Array indices;
+		for (int i = 0; i < 6; i++) {
+			indices.push_back(faces[i][0]);
+			indices.push_back(faces[i][1]);
+			indices.push_back(faces[i][2]);
+			indices.push_back(faces[i][0]);
+			indices.push_back(faces[i][2]);
+			indices.push_back(faces[i][3]);
+		}
+
+		RID occluder = cull->occluder_allocate();
+		cull->occluder_initialize(occluder);
+		cull->occluder_set_mesh(occluder, vertices, indices);
+		occluders.push_back(occluder);
+
+		RID instance = RID::from_uint64(next_instance++);
+		cull->scenario_set_instance(scenario, instance, occluder, Transform3D(), true);
+		return instance;
+	}
+
+	bool is_occluded(const AABB &p_aabb, const Transform3D &p_camera, const Projection &p_projection) {
+		const real_t bounds[6] = { p_aabb.position.x, p_aabb.position.y, p_aabb.position.z, p_aabb.get_end().x, p_aabb.get_end().y, p_aabb.get_end().z };
+		uint64_t timeout = 0;
+		return cull->buffer_get_ptr(buffer)->is_occluded(bounds, p_camera.origin, p_camera.affine_inverse(), p_projection, p_projection.get_z_near(), timeout);
+	}
+
+	~OcclusionScene() {
+		cull->remove_buffer(buffer);
+		cull->remove_scenario(scenario);
+		for (const RID &occluder : occluders) {
+			cull->free_occluder(occluder);
+		}
+	}
+};
+
+TEST_CASE("[RasterOcclusionCull] Perspective occlusion") {
+	RasterOcclusionCull raster;
+	OcclusionScene scene(&raster, Size2i(64, 64));
+
+	// A wall in front of the camera.
+	RID wall = scene.add_box(Vector3(-5.0, -5.0, -11.0), Vector3(10.0, 10.0, 1.0));
+
+	Transform3D camera;
+	Projection projection;
+	projection.set_perspective(90.0, 1.0, 0.1, 100.0);
+	raster.buffer_update(scene.buffer, camera, projection, false);
+
+	CHECK_MESSAGE(scene.is_occluded(AABB(Vector3(-1.0, -1.0, -21.0), Vector3(2.0, 2.0, 1.0)), camera, projection), "A box behind the wall should be occluded.");
+	CHECK_FALSE_MESSAGE(scene.is_occluded(AABB(Vector3(-1.0, -1.0, -6.0), Vector3(2.0, 2.0, 1.0)), camera, projection), "A box in front of the wall should be visible.");
+	CHECK_FALSE_MESSAGE(scene.is_occluded(AABB(Vector3(20.0, -1.0, -31.0), Vector3(2.0, 2.0, 1.0)), camera, projection), "A box beside the wall should be visible.");
+
+	raster.scenario_remove_instance(scene.scenario, wall);
+	raster.buffer_update(scene.buffer, camera, projection, false);
+	CHECK_FALSE_MESSAGE(scene.is_occluded(AABB(Vector3(-1.0, -1.0, -21.0), Vector3(2.0, 2.0, 1.0)), camera, projection), "Removed occluders should not occlude.");
+}
+
+TEST_CASE("[RasterOcclusionCull] Orthogonal occlusion") {
+	RasterOcclusionCull raster;
+	OcclusionScene scene(&raster, Size2i(64, 64));
+	scene.add_box(Vector3(-5.0, -5.0, -11.0), Vector3(10.0, 10.0, 1.0));
+
+	Transform3D camera;
+	Projection projection;
+	projection.set_orthogonal(-10.0, 10.0, -10.0, 10.0, 0.1, 100.0);
+	raster.buffer_update(scene.buffer, camera, projection, true);
+
+	CHECK(scene.is_occluded(AABB(Vector3(-1.0, -1.0, -21.0), Vector3(2.0, 2.0, 1.0)), camera, projection));
+	CHECK_FALSE(scene.is_occluded(AABB(Vector3(-1.0, -1.0, -6.0), Vector3(2.0, 2.0, 1.0)), camera, projection));
+	CHECK_FALSE(scene.is_occluded(AABB(Vector3(7.0, -1.0, -21.0), Vector3(2.0, 2.0, 1.0)), camera, projection));
+}
+
+static void fill_city(OcclusionScene &p_scene) {
+	// A grid of buildings around the camera.
+	for (int x = -20; x < 20; x++) {
+		for (int z = -20; z < 20; z++) {
+			p_scene.add_box(Vector3(x * 10.0 + 2.0, 0.0, z * 10.0 + 2.0), Vector3(6.0, 10.0 + ((x * 7 + z * 13) & 15), 6.0));
+		}
+	}
+}
+
+TEST_CASE_BENCHMARK("[RasterOcclusionCull][Benchmark] Occlusion buffer update") {
+	const Size2i size(256, 144);
+	const int frame_count = 100;
+
+	Transform3D camera(Basis(), Vector3(1.0, 5.0, 1.0));
+	Projection projection;
+	projection.set_perspective(75.0, size.aspect(), 0.05, 500.0);
+
+	RandomPCG rng(1234);
+	LocalVector<AABB> queries;
+	for (int i = 0; i < 1000; i++) {
+		queries.push_back(AABB(Vector3(rng.random(-150.0, 150.0), rng.random(0.0, 20.0), rng.random(-150.0, -5.0)), Vector3(1.0, 1.0, 1.0)));
+	}
+
+	LocalVector<bool> raster_results;
+	{
+		RasterOcclusionCull raster;
+		OcclusionScene scene(&raster, size);
+		fill_city(scene);
+
+		raster.buffer_update(scene.buffer, camera, projection, false);
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < frame_count; i++) {
+			raster.buffer_update(scene.buffer, camera, projection, false);
+		}
+		double seconds = USEC_TO_SEC(OS::get_singleton()->get_ticks_usec() - begin);
+
+		int occluded = 0;
+		for (const AABB &query : queries) {
+			raster_results.push_back(scene.is_occluded(query, camera, projection));
+			occluded += raster_results[raster_results.size() - 1];
+		}
+		MESSAGE(vformat("Raster: %.3f ms/update, %d of %d boxes occluded.", seconds * 1000.0 / frame_count, occluded, queries.size()));
+	}
+
+#ifdef MODULE_RAYCAST_ENABLED
+	RaycastOcclusionCull raycast;
+	OcclusionScene scene(&raycast, size);
+	fill_city(scene);
+
+	// The ray tracing scene is committed on a thread, give it time to be ready.
+	for (int i = 0; i < 20; i++) {
+		raycast.buffer_update(scene.buffer, camera, projection, false);
+		OS::get_singleton()->delay_usec(20000);
+	}
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < frame_count; i++) {
+		raycast.buffer_update(scene.buffer, camera, projection, false);
+	}
+	double seconds = USEC_TO_SEC(OS::get_singleton()->get_ticks_usec() - begin);
+
+	int occluded = 0;
+	int agree = 0;
+	for (uint32_t i = 0; i < queries.size(); i++) {
+		bool result = scene.is_occluded(queries[i], camera, projection);
+		occluded += result;
+		agree += result == raster_results[i];
+	}
+	MESSAGE(vformat("Raycast: %.3f ms/update, %d of %d boxes occluded, %d results agree with raster.", seconds * 1000.0 / frame_count, occluded, queries.size(), agree));
+#endif
+}
+
+} // namespace TestRasterOcclusionCull
+
+#endif // TEST_RASTER_OCCLUSION_CULL_H
@@ -0,0 +1,182 @@
+/**************************************************************************/
+/*  test_rendering_light_culler.h                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERING_LIGHT_CULLER_H
+#define TEST_RENDERING_LIGHT_CULLER_H
+
+#include "servers/rendering/rendering_light_culler.h"
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRenderingLightCuller {
+
+typedef RenderingLightCuller::CullBlock CullBlock;
+
+// The per caster test the light culler used before casters were culled in blocks.
+static bool is_culled_reference(const AABB &p_aabb, const Plane *p_planes, int p_plane_count) {
+	real_t r_min, r_max;
+	for (int p = 0; p < p_plane_count; p++) {
+		p_aabb.project_range_in_plane(p_planes[p], r_min, r_max);
+		if (r_min > 0.0f) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static void pack(const LocalVector<AABB> &p_aabbs, LocalVector<CullBlock> &r_blocks) {
+	r_blocks.resize((p_aabbs.size() + RenderingLightCuller::CULL_BLOCK_SIZE - 1) / RenderingLightCuller::CULL_BLOCK_SIZE);
+	for (uint32_t i = 0; i < r_blocks.size() * RenderingLightCuller::CULL_BLOCK_SIZE; i++) {
+		r_blocks[i / RenderingLightCuller::CULL_BLOCK_SIZE].set(i % RenderingLightCuller::CULL_BLOCK_SIZE, i < p_aabbs.size() ? p_aabbs[i] : AABB());
+	}
+}
+
+static uint32_t count_mismatches(const LocalVector<AABB> &p_aabbs, const Plane *p_planes, int p_plane_count) {
+	LocalVector<CullBlock> blocks;
+	pack(p_aabbs, blocks);
+	LocalVector<uint8_t> masks;
+	masks.resize(blocks.size());
+	RenderingLightCuller::cull_blocks(p_planes, p_plane_count, blocks.ptr(), blocks.size(), masks.ptr());
+
+	uint32_t mismatches = 0;
+	for (uint32_t i = 0; i < p_aabbs.size(); i++) {
+		const bool culled = masks[i / RenderingLightCuller::CULL_BLOCK_SIZE] & (1 << (i % RenderingLightCuller::CULL_BLOCK_SIZE));
+		if (culled != is_culled_reference(p_aabbs[i], p_planes, p_plane_count)) {
+			mismatches++;
+		}
+	}
+	return mismatches;
+}
+
+static Plane random_plane(RandomPCG &p_rng) {
+	Vector3 normal(p_rng.random(-1.0f, 1.0f), p_rng.random(-1.0f, 1.0f), p_rng.random(-1.0f, 1.0f));
+	if (normal.is_zero_approx()) {
+		normal = Vector3(0, 1, 0);
+	}
+	return Plane(normal.normalized(), p_rng.random(-50.0f, 50.0f));
+}
+
+static AABB random_aabb(RandomPCG &p_rng) {
+	const Vector3 position(p_rng.random(-100.0f, 100.0f), p_rng.random(-100.0f, 100.0f), p_rng.random(-100.0f, 100.0f));
+	const Vector3 size(p_rng.random(0.0f, 20.0f), p_rng.random(0.0f, 20.0f), p_rng.random(0.0f, 20.0f));
+	return AABB(position, size);
+}
+
+TEST_CASE("[RenderingLightCuller] Block culling matches per caster culling") {
+	RandomPCG rng(4321);
+
+	LocalVector<AABB> aabbs;
+	// Not a multiple of the block size, so the last block is partially used.
+	for (int i = 0; i < 1023; i++) {
+		aabbs.push_back(random_aabb(rng));
+	}
+
+	for (int plane_count = 0; plane_count <= 17; plane_count++) {
+		Plane planes[17];
+		for (int p = 0; p < plane_count; p++) {
+			planes[p] = random_plane(rng);
+		}
+		CHECK_MESSAGE(count_mismatches(aabbs, planes, plane_count) == 0, "Results differ with ", plane_count, " planes.");
+	}
+}
+
+TEST_CASE("[RenderingLightCuller] Block culling edge cases") {
+	const Plane planes[2] = {
+		Plane(Vector3(1, 0, 0), 10),
+		Plane(Vector3(0, -1, 0), 10),
+	};
+
+	LocalVector<AABB> aabbs;
+	aabbs.push_back(AABB(Vector3(10, 0, 0), Vector3(1, 1, 1))); // Touching the first plane, kept.
+	aabbs.push_back(AABB(Vector3(10.5, 0, 0), Vector3(1, 1, 1))); // Outside the first plane.
+	aabbs.push_back(AABB(Vector3(0, -12, 0), Vector3(1, 1, 1))); // Outside the second plane.
+	aabbs.push_back(AABB(Vector3(0, 0, 0), Vector3(0, 0, 0))); // Degenerate, inside.
+	aabbs.push_back(AABB(Vector3(20, 0, 0), Vector3(0, 0, 0))); // Degenerate, outside.
+	aabbs.push_back(AABB(Vector3(-1000, -1000, -1000), Vector3(2000, 2000, 2000))); // Spans both planes.
+
+	LocalVector<CullBlock> blocks;
+	pack(aabbs, blocks);
+	LocalVector<uint8_t> masks;
+	masks.resize(blocks.size());
+	RenderingLightCuller::cull_blocks(planes, 2, blocks.ptr(), blocks.size(), masks.ptr());
+
+	CHECK(masks[0] == 0b0110);
+	CHECK((masks[1] & 0b11) == 0b01);
+	CHECK(count_mismatches(aabbs, planes, 2) == 0);
+}
+
+TEST_CASE_BENCHMARK("[RenderingLightCuller][Benchmark] Block culling against per caster culling") {
+	RandomPCG rng(99);
+	const uint32_t caster_count = 100000;
+	const int plane_count = 10;
+	const int repeats = 20;
+
+	LocalVector<AABB> aabbs;
+	for (uint32_t i = 0; i < caster_count; i++) {
+		aabbs.push_back(random_aabb(rng));
+	}
+	Plane planes[plane_count];
+	for (int p = 0; p < plane_count; p++) {
+		planes[p] = random_plane(rng);
+	}
+
+	uint32_t reference_culled = 0;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int r = 0; r < repeats; r++) {
+		for (const AABB &aabb : aabbs) {
+			reference_culled += is_culled_reference(aabb, planes, plane_count);
+		}
+	}
+	const uint64_t reference_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	LocalVector<CullBlock> blocks;
+	LocalVector<uint8_t> masks;
+	uint32_t block_culled = 0;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int r = 0; r < repeats; r++) {
+		pack(aabbs, blocks);
+		masks.resize(blocks.size());
+		RenderingLightCuller::cull_blocks(planes, plane_count, blocks.ptr(), blocks.size(), masks.ptr());
+		for (uint8_t mask : masks) {
+			block_culled += ((mask >> 0) & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + ((mask >> 3) & 1);
+		}
+	}
+	const uint64_t block_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(block_culled == reference_culled);
+	MESSAGE("Per caster: ", reference_usec / repeats, " usec, blocks (including packing): ", block_usec / repeats, " usec for ", caster_count, " casters.");
+}
+
+} // namespace TestRenderingLightCuller
+
+#endif // TEST_RENDERING_LIGHT_CULLER_H
@@ -0,0 +1,423 @@
+/**************************************************************************/
+/*  test_rendering_server_benchmark.h                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERING_SERVER_BENCHMARK_H
+#define TEST_RENDERING_SERVER_BENCHMARK_H
+
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "servers/rendering/dummy/storage/light_storage.h"
+#include "servers/rendering/renderer_canvas_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+#include "servers/rendering_server.h"
+#include "servers/xr/xr_interface.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRenderingServerBenchmark {
+
+struct SceneParams {
+	String name;
+	int instance_count = 0;
+	int omni_light_count = 0;
+	bool omni_shadows = false;
+	bool directional_shadows = false;
+	float visibility_range_end = 0.0;
+	float lod_bias = 1.0;
+	int canvas_item_count = 0;
+	// Static scenes only move the camera, shadow casters stay put.
+	bool static_instances = false;
+};
+
+// Synthetic scene built through the RenderingServer API. The dummy renderer draws nothing, so
+// culling is driven directly with render_camera() and render_canvas(), the same calls a viewport makes.
+struct SyntheticScene {
+	SceneParams params;
+	Size2i viewport_size = Size2i(1920, 1080);
+
+	RID scenario;
+	RID mesh;
+	RID camera;
+	RID shadow_atlas;
+	RID directional_light;
+	RID directional_light_instance;
+	LocalVector<RID> instances;
+	Vector<RID> omni_lights;
+	Vector<RID> omni_light_instances;
+	Ref<RenderSceneBuffers> render_buffers;
+
+	RID canvas;
+	Vector<RID> canvas_items;
+
+	SyntheticScene(const SceneParams &p_params) {
+		params = p_params;
+		RS *rs = RS::get_singleton();
+		RendererDummy::LightStorage::get_singleton()->set_light_tracking_enabled(true);
+
+		scenario = rs->scenario_create();
+		camera = rs->camera_create();
+		rs->camera_set_perspective(camera, 70.0, 0.05, 500.0);
+		rs->camera_set_transform(camera, Transform3D(Basis(), Vector3(0, 2, 0)));
+		shadow_atlas = rs->shadow_atlas_create();
+		rs->shadow_atlas_set_size(shadow_atlas, 4096);
+		render_buffers = RSG::scene->render_buffers_create();
+
+		// A single triangle is enough for the instances to be treated as shadow casters.
+		Array arrays;
+		arrays.resize(RS::ARRAY_MAX);
+		PackedVector3Array vertices;
+		vertices.push_back(Vector3(-0.5, 0, 0));
+		vertices.push_back(Vector3(0.5, 0, 0));
+		vertices.push_back(Vector3(0, 1, 0));
+		arrays[RS::ARRAY_VERTEX] = vertices;
+		mesh = rs->mesh_create();
+		rs->mesh_add_surface_from_arrays(mesh, RS::PRIMITIVE_TRIANGLES, arrays);
+
+		instances.resize(params.instance_count);
+		for (int i = 0; i < params.instance_count; i++) {
+			RID instance = rs->instance_create2(mesh, scenario);
+			rs->instance_set_custom_aabb(instance, AABB(Vector3(-0.5, -0.5, -0.5), Vector3(1, 1, 1)));
+			rs->instance_set_transform(instance, instance_transform(i, 0.0));
+			if (params.visibility_range_end > 0.0) {
+				rs->instance_geometry_set_visibility_range(instance, 0.0, params.visibility_range_end, 0.0, 0.0, RS::VISIBILITY_RANGE_FADE_DISABLED);
+			}
+			rs->instance_geometry_set_lod_bias(instance, params.lod_bias);
+			instances[i] = instance;
+		}
+
+		for (int i = 0; i < params.omni_light_count; i++) {
+			RID light = rs->omni_light_create();
+			rs->light_set_param(light, RS::LIGHT_PARAM_RANGE, 12.0);
+			rs->light_set_shadow(light, params.omni_shadows);
+			RID light_instance = rs->instance_create2(light, scenario);
+			// Spread the lights over the instance grid.
+			rs->instance_set_transform(light_instance, instance_transform((i * 7919) % MAX(1, params.instance_count), 3.0));
+			omni_lights.push_back(light);
+			omni_light_instances.push_back(light_instance);
+		}
+
+		if (params.directional_shadows) {
+			directional_light = rs->directional_light_create();
+			rs->light_set_shadow(directional_light, true);
+			rs->light_set_param(directional_light, RS::LIGHT_PARAM_SHADOW_MAX_DISTANCE, 100.0);
+			rs->light_directional_set_shadow_mode(directional_light, RS::LIGHT_DIRECTIONAL_SHADOW_PARALLEL_4_SPLITS);
+			directional_light_instance = rs->instance_create2(directional_light, scenario);
+			rs->instance_set_transform(directional_light_instance, Transform3D(Basis::from_euler(Vector3(-Math_PI * 0.3, Math_PI * 0.2, 0)), Vector3()));
+		}
+
+		canvas = rs->canvas_create();
+		canvas_items.resize(params.canvas_item_count);
+		for (int i = 0; i < params.canvas_item_count; i++) {
+			RID item = rs->canvas_item_create();
+			rs->canvas_item_set_parent(item, canvas);
+			// Twice the viewport in each direction, so most of the items are culled.
+			rs->canvas_item_set_transform(item, Transform2D(0.0, Vector2((i * 37) % (viewport_size.width * 2), (i * 53) % (viewport_size.height * 2))));
+			rs->canvas_item_add_rect(item, Rect2(0, 0, 16, 16), Color(1, 1, 1));
+			canvas_items.write[i] = item;
+		}
+	}
+
+	// Instances are laid out on a grid around the camera, which looks down -Z.
+	Transform3D instance_transform(int p_index, real_t p_height) const {
+		const int side = MAX(1, (int)Math::ceil(Math::sqrt((double)params.instance_count)));
+		const real_t spacing = 4.0;
+		Vector3 origin((p_index % side - side / 2) * spacing, p_height, (p_index / side - side / 2) * spacing);
+		return Transform3D(Basis(), origin);
+	}
+
+	RenderingMethod::RenderInfo cull_3d() {
+		RenderingMethod::RenderInfo info;
+		Ref<XRInterface> xr_interface;
+		RSG::scene->render_camera(render_buffers, camera, scenario, RID(), viewport_size, 0, 1.0 / viewport_size.width, shadow_atlas, xr_interface, &info);
+		return info;
+	}
+
+	RenderingMethod::RenderInfo update_and_cull_3d() {
+		RSG::scene->update();
+		return cull_3d();
+	}
+
+	uint32_t cull_canvas() {
+		RendererCanvasCull::Canvas *canvas_ptr = RSG::canvas->canvas_owner.get_or_null(canvas);
+		RSG::canvas->render_canvas(RID(), canvas_ptr, Transform2D(), nullptr, nullptr, Rect2(Point2(), viewport_size), RS::CANVAS_ITEM_TEXTURE_FILTER_LINEAR, RS::CANVAS_ITEM_TEXTURE_REPEAT_DISABLED, false, false, 0xFFFFFFFF);
+		return canvas_ptr->last_cull_item_count;
+	}
+
+	~SyntheticScene() {
+		RS *rs = RS::get_singleton();
+		for (const RID &item : canvas_items) {
+			rs->free(item);
+		}
+		rs->free(canvas);
+		for (int i = 0; i < omni_lights.size(); i++) {
+			rs->free(omni_light_instances[i]);
+			rs->free(omni_lights[i]);
+		}
+		if (directional_light.is_valid()) {
+			rs->free(directional_light_instance);
+			rs->free(directional_light);
+		}
+		for (const RID &instance : instances) {
+			rs->free(instance);
+		}
+		render_buffers.unref();
+		rs->free(mesh);
+		rs->free(shadow_atlas);
+		rs->free(camera);
+		rs->free(scenario);
+		RendererDummy::LightStorage::get_singleton()->set_light_tracking_enabled(false);
+	}
+};
+
+TEST_CASE("[SceneTree][RenderingServer] Scenes are culled with the dummy renderer") {
+	SceneParams params;
+	params.instance_count = 20;
+	SyntheticScene scene(params);
+	RS *rs = RS::get_singleton();
+
+	// Ten instances in front of the camera and ten behind it.
+	LocalVector<Transform3D> transforms;
+	for (int i = 0; i < params.instance_count; i++) {
+		transforms.push_back(Transform3D(Basis(), Vector3(0, 2, i < 10 ? -5 - i : i)));
+	}
+	rs->instances_set_transforms(scene.instances, transforms);
+
+	RenderingMethod::RenderInfo info = scene.update_and_cull_3d();
+	CHECK(info.info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE][RS::VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME] == 10);
+	CHECK(info.info[RS::VIEWPORT_RENDER_INFO_TYPE_SHADOW][RS::VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME] == 0);
+
+	SUBCASE("Visibility ranges") {
+		for (const RID &instance : scene.instances) {
+			rs->instance_geometry_set_visibility_range(instance, 0.0, 9.5, 0.0, 0.0, RS::VISIBILITY_RANGE_FADE_DISABLED);
+		}
+		info = scene.update_and_cull_3d();
+		CHECK(info.info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE][RS::VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME] == 5);
+	}
+
+	SUBCASE("Shadow casters") {
+		RID light = rs->omni_light_create();
+		rs->light_set_param(light, RS::LIGHT_PARAM_RANGE, 4.0);
+		rs->light_set_shadow(light, true);
+		RID light_instance = rs->instance_create2(light, scene.scenario);
+		rs->instance_set_transform(light_instance, Transform3D(Basis(), Vector3(0, 2, -7)));
+
+		info = scene.update_and_cull_3d();
+		CHECK(info.info[RS::VIEWPORT_RENDER_INFO_TYPE_SHADOW][RS::VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME] > 0);
+
+		// Once the initial updates settle, the shadow is cached until a caster moves.
+		for (int i = 0; i < 3; i++) {
+			info = scene.update_and_cull_3d();
+		}
+		CHECK(info.info[RS::VIEWPORT_RENDER_INFO_TYPE_SHADOW][RS::VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME] == 0);
+
+		rs->instance_set_transform(scene.instances[2], Transform3D(Basis(), Vector3(1, 2, -7)));
+		info = scene.update_and_cull_3d();
+		CHECK(info.info[RS::VIEWPORT_RENDER_INFO_TYPE_SHADOW][RS::VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME] > 0);
+
+		rs->free(light_instance);
+		rs->free(light);
+	}
+
+	SUBCASE("Directional shadow casters") {
+		RID light = rs->directional_light_create();
+		rs->light_set_shadow(light, true);
+		rs->light_set_param(light, RS::LIGHT_PARAM_SHADOW_MAX_DISTANCE, 50.0);
+		RID light_instance = rs->instance_create2(light, scene.scenario);
+
+		info = scene.update_and_cull_3d();
+		const int casters = info.info[RS::VIEWPORT_RENDER_INFO_TYPE_SHADOW][RS::VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME];
+		CHECK(casters > 0);
+
+		// Culled again from the cached casters.
+		info = scene.update_and_cull_3d();
+		CHECK(info.info[RS::VIEWPORT_RENDER_INFO_TYPE_SHADOW][RS::VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME] == casters);
+
+		// Leaving and entering the cascades updates the cache.
+		rs->instance_set_transform(scene.instances[2], Transform3D(Basis(), Vector3(10000, 2, -7)));
+		info = scene.update_and_cull_3d();
+		CHECK(info.info[RS::VIEWPORT_RENDER_INFO_TYPE_SHADOW][RS::VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME] < casters);
+
+		rs->instance_set_transform(scene.instances[2], transforms[2]);
+		info = scene.update_and_cull_3d();
+		CHECK(info.info[RS::VIEWPORT_RENDER_INFO_TYPE_SHADOW][RS::VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME] == casters);
+
+		for (const RID &instance : scene.instances) {
+			rs->instance_geometry_set_cast_shadows_setting(instance, RS::SHADOW_CASTING_SETTING_OFF);
+		}
+		info = scene.update_and_cull_3d();
+		CHECK(info.info[RS::VIEWPORT_RENDER_INFO_TYPE_SHADOW][RS::VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME] == 0);
+
+		rs->free(light_instance);
+		rs->free(light);
+	}
+}
+
+// Set RENDERING_BENCHMARK_OUTPUT to also write the JSON report to that path.
+TEST_CASE_BENCHMARK("[SceneTree][RenderingServer][Benchmark] CPU culling of synthetic scenes") {
+	const int frame_count = 60;
+	// Fraction of the instances moved every frame.
+	const int moving_divisor = 10;
+
+	Vector<SceneParams> scenes;
+	{
+		SceneParams params;
+		params.name = "instances_10k";
+		params.instance_count = 10000;
+		params.canvas_item_count = 1000;
+		scenes.push_back(params);
+
+		params.name = "instances_100k";
+		params.instance_count = 100000;
+		params.canvas_item_count = 10000;
+		scenes.push_back(params);
+
+		params.name = "lights_shadows_20k";
+		params.instance_count = 20000;
+		params.omni_light_count = 64;
+		params.omni_shadows = true;
+		params.directional_shadows = true;
+		params.canvas_item_count = 0;
+		scenes.push_back(params);
+
+		params.name = "static_shadows_20k";
+		params.instance_count = 20000;
+		params.omni_light_count = 0;
+		params.directional_shadows = true;
+		params.static_instances = true;
+		scenes.push_back(params);
+
+		params.name = "visibility_ranges_lod_50k";
+		params.instance_count = 50000;
+		params.omni_light_count = 16;
+		params.omni_shadows = false;
+		params.directional_shadows = true;
+		params.static_instances = false;
+		params.visibility_range_end = 80.0;
+		params.lod_bias = 0.5;
+		scenes.push_back(params);
+	}
+
+	Array results;
+	for (const SceneParams &params : scenes) {
+		SyntheticScene scene(params);
+		RS *rs = RS::get_singleton();
+
+		LocalVector<RID> moving_instances;
+		for (int i = 0; i < params.instance_count && !params.static_instances; i += moving_divisor) {
+			moving_instances.push_back(scene.instances[i]);
+		}
+		LocalVector<Transform3D> moving_transforms;
+		moving_transforms.resize(moving_instances.size());
+
+		// Let the first frame pair everything before measuring.
+		scene.update_and_cull_3d();
+
+		uint64_t transform_usec = 0;
+		uint64_t update_usec = 0;
+		uint64_t cull_3d_usec = 0;
+		uint64_t cull_canvas_usec = 0;
+		RenderingMethod::RenderInfo info;
+		uint32_t canvas_items_visited = 0;
+
+		for (int frame = 0; frame < frame_count; frame++) {
+			for (uint32_t i = 0; i < moving_instances.size(); i++) {
+				moving_transforms[i] = scene.instance_transform(i * moving_divisor, (frame % 2) * 0.5);
+			}
+
+			if (params.static_instances) {
+				// Walk forward slowly, as a player would.
+				rs->camera_set_transform(scene.camera, Transform3D(Basis(), Vector3(0, 2, -0.05 * frame)));
+			}
+
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			rs->instances_set_transforms(moving_instances, moving_transforms);
+			rs->sync();
+			uint64_t transforms_set = OS::get_singleton()->get_ticks_usec();
+			RSG::scene->update();
+			uint64_t updated = OS::get_singleton()->get_ticks_usec();
+			info = scene.cull_3d();
+			uint64_t culled_3d = OS::get_singleton()->get_ticks_usec();
+			canvas_items_visited = scene.cull_canvas();
+			uint64_t culled_canvas = OS::get_singleton()->get_ticks_usec();
+
+			transform_usec += transforms_set - begin;
+			update_usec += updated - transforms_set;
+			cull_3d_usec += culled_3d - updated;
+			cull_canvas_usec += culled_canvas - culled_3d;
+		}
+
+		Dictionary phases;
+		phases["set_transforms_usec"] = double(transform_usec) / frame_count;
+		phases["scene_update_usec"] = double(update_usec) / frame_count;
+		phases["scene_cull_usec"] = double(cull_3d_usec) / frame_count;
+		phases["canvas_cull_usec"] = double(cull_canvas_usec) / frame_count;
+		const int shadowed_lights = (params.omni_shadows ? params.omni_light_count : 0) + (params.directional_shadows ? 1 : 0);
+		if (shadowed_lights > 0) {
+			phases["scene_cull_usec_per_shadowed_light"] = double(cull_3d_usec) / frame_count / shadowed_lights;
+		}
+
+		Dictionary counts;
+		counts["instances"] = params.instance_count;
+		counts["moved_instances"] = moving_instances.size();
+		counts["omni_lights"] = params.omni_light_count;
+		counts["visible_instances"] = info.info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE][RS::VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME];
+		counts["shadow_casters"] = info.info[RS::VIEWPORT_RENDER_INFO_TYPE_SHADOW][RS::VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME];
+		counts["canvas_items"] = params.canvas_item_count;
+		counts["canvas_items_visited"] = canvas_items_visited;
+
+		Dictionary result;
+		result["scene"] = params.name;
+		result["phases"] = phases;
+		result["counts"] = counts;
+		results.push_back(result);
+	}
+
+	Dictionary report;
+	report["frames"] = frame_count;
+	report["worker_threads"] = WorkerThreadPool::get_singleton()->get_thread_count();
+	report["processor_count"] = OS::get_singleton()->get_processor_count();
+	report["scenes"] = results;
+
+	const String json = JSON::stringify(report, "\t", false);
+	MESSAGE(json);
+
+	const String output_path = OS::get_singleton()->get_environment("RENDERING_BENCHMARK_OUTPUT");
+	if (!output_path.is_empty()) {
+		Ref<FileAccess> file = FileAccess::open(output_path, FileAccess::WRITE);
+		REQUIRE(file.is_valid());
+		file->store_string(json);
+	}
+}
+
+} // namespace TestRenderingServerBenchmark
+
+#endif // TEST_RENDERING_SERVER_BENCHMARK_H
@@ -0,0 +1,249 @@
+/**************************************************************************/
+/*  test_shader_compiler.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SHADER_COMPILER_H
+#define TEST_SHADER_COMPILER_H
+
+#include "servers/rendering/shader_compiler.h"
+
+#include "tests/test_macros.h"
+
+namespace TestShaderCompiler {
+
+static String spatial_shader(const String &p_uniform) {
+	return vformat(R"(
+shader_type spatial;
+render_mode unshaded;
+
+uniform vec4 %s : source_color = vec4(1.0);
+
+void fragment() {
+	ALBEDO = %s.rgb;
+	ALPHA = %s.a;
+}
+)",
+			p_uniform, p_uniform, p_uniform);
+}
+
+// Flags a caller would read back after compiling.
+struct ShaderFlags {
+	bool unshaded = false;
+	bool uses_alpha = false;
+	bool writes_albedo = false;
+	int cull_mode = 0;
+	HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+	ShaderCompiler::IdentifierActions actions;
+	ShaderCompiler::GeneratedCode gen_code;
+
+	ShaderFlags() {
+		actions.entry_point_stages["fragment"] = ShaderCompiler::STAGE_FRAGMENT;
+		actions.render_mode_flags["unshaded"] = &unshaded;
+		actions.render_mode_values["cull_front"] = Pair<int *, int>(&cull_mode, 1);
+		actions.usage_flag_pointers["ALPHA"] = &uses_alpha;
+		actions.write_flag_pointers["ALBEDO"] = &writes_albedo;
+		actions.uniforms = &uniforms;
+	}
+
+	// Actions point to the members, so reset in place instead of copying.
+	void reset() {
+		unshaded = false;
+		uses_alpha = false;
+		writes_albedo = false;
+		cull_mode = 0;
+		uniforms.clear();
+		gen_code = ShaderCompiler::GeneratedCode();
+	}
+};
+
+static void check_same_output(const ShaderFlags &p_a, const ShaderFlags &p_b) {
+	CHECK(p_a.unshaded == p_b.unshaded);
+	CHECK(p_a.uses_alpha == p_b.uses_alpha);
+	CHECK(p_a.writes_albedo == p_b.writes_albedo);
+	CHECK(p_a.cull_mode == p_b.cull_mode);
+	CHECK(p_a.uniforms.size() == p_b.uniforms.size());
+	CHECK(p_a.gen_code.code["fragment"] == p_b.gen_code.code["fragment"]);
+	CHECK(p_a.gen_code.uniforms == p_b.gen_code.uniforms);
+	CHECK(p_a.gen_code.stage_globals[ShaderCompiler::STAGE_FRAGMENT] == p_b.gen_code.stage_globals[ShaderCompiler::STAGE_FRAGMENT]);
+}
+
+TEST_CASE("[SceneTree][ShaderCompiler] Compiled shaders are cached") {
+	ShaderCompiler compiler;
+	compiler.initialize(ShaderCompiler::DefaultIdentifierActions());
+
+	ShaderFlags first;
+	REQUIRE(compiler.compile(RS::SHADER_SPATIAL, spatial_shader("tint"), &first.actions, "", first.gen_code) == OK);
+	CHECK(first.unshaded);
+	CHECK(first.uses_alpha);
+	CHECK(first.writes_albedo);
+	CHECK(first.cull_mode == 0);
+	CHECK(first.uniforms.has("tint"));
+	CHECK(first.gen_code.code.has("fragment"));
+	CHECK(compiler.get_cache_size() == 1);
+
+	SUBCASE("Identical code is replayed from the cache") {
+		ShaderFlags second;
+		REQUIRE(compiler.compile(RS::SHADER_SPATIAL, spatial_shader("tint"), &second.actions, "", second.gen_code) == OK);
+		CHECK(compiler.get_cache_size() == 1);
+		check_same_output(first, second);
+	}
+
+	SUBCASE("Different code or tracked flags are compiled again") {
+		ShaderFlags other_code;
+		REQUIRE(compiler.compile(RS::SHADER_SPATIAL, spatial_shader("color"), &other_code.actions, "", other_code.gen_code) == OK);
+		CHECK(other_code.uniforms.has("color"));
+		CHECK(compiler.get_cache_size() == 2);
+
+		ShaderFlags other_flags;
+		other_flags.actions.render_mode_flags.erase("unshaded");
+		REQUIRE(compiler.compile(RS::SHADER_SPATIAL, spatial_shader("tint"), &other_flags.actions, "", other_flags.gen_code) == OK);
+		CHECK_FALSE(other_flags.unshaded);
+		CHECK(compiler.get_cache_size() == 3);
+	}
+
+	SUBCASE("Failed compilations are not cached") {
+		ShaderFlags broken;
+		ERR_PRINT_OFF;
+		CHECK(compiler.compile(RS::SHADER_SPATIAL, "shader_type spatial; void fragment() { ALBEDO = ; }", &broken.actions, "", broken.gen_code) != OK);
+		ERR_PRINT_ON;
+		CHECK(compiler.get_cache_size() == 1);
+	}
+
+	SUBCASE("Disabling the cache") {
+		compiler.set_cache_enabled(false);
+		CHECK(compiler.get_cache_size() == 0);
+
+		ShaderFlags uncached;
+		REQUIRE(compiler.compile(RS::SHADER_SPATIAL, spatial_shader("tint"), &uncached.actions, "", uncached.gen_code) == OK);
+		CHECK(compiler.get_cache_size() == 0);
+		check_same_output(first, uncached);
+	}
+}
+
+TEST_CASE("[SceneTree][ShaderCompiler] Shaders are compiled in batches") {
+	ShaderCompiler compiler;
+	compiler.initialize(ShaderCompiler::DefaultIdentifierActions());
+
+	const int item_count = 32;
+	const int unique_count = 8;
+	Vector<ShaderFlags> flags;
+	flags.resize(item_count);
+
+	LocalVector<ShaderCompiler::BatchItem> items;
+	for (int i = 0; i < item_count; i++) {
+		ShaderCompiler::BatchItem item;
+		item.mode = RS::SHADER_SPATIAL;
+		item.code = spatial_shader(vformat("tint_%d", i % unique_count));
+		item.actions = &flags.write[i].actions;
+		item.gen_code = &flags.write[i].gen_code;
+		items.push_back(item);
+	}
+	// Errors only affect their own item.
+	ShaderFlags broken;
+	ShaderCompiler::BatchItem broken_item;
+	broken_item.mode = RS::SHADER_SPATIAL;
+	broken_item.code = "shader_type spatial; void fragment() { ALBEDO = ; }";
+	broken_item.actions = &broken.actions;
+	broken_item.gen_code = &broken.gen_code;
+	items.push_back(broken_item);
+
+	ERR_PRINT_OFF;
+	compiler.compile_batch(items);
+	ERR_PRINT_ON;
+
+	CHECK(items[item_count].error != OK);
+	CHECK(compiler.get_cache_size() == unique_count);
+
+	ShaderCompiler reference;
+	reference.initialize(ShaderCompiler::DefaultIdentifierActions());
+	reference.set_cache_enabled(false);
+	for (int i = 0; i < item_count; i++) {
+		CHECK(items[i].error == OK);
+		CHECK(flags[i].uniforms.has(StringName(vformat("tint_%d", i % unique_count))));
+
+		ShaderFlags expected;
+		REQUIRE(reference.compile(RS::SHADER_SPATIAL, items[i].code, &expected.actions, "", expected.gen_code) == OK);
+		check_same_output(expected, flags[i]);
+	}
+
+	// Everything is cached now.
+	for (int i = 0; i < item_count; i++) {
+		flags.write[i].reset();
+	}
+	items.resize(item_count);
+	compiler.compile_batch(items);
+	CHECK(compiler.get_cache_size() == unique_count);
+	for (int i = 0; i < item_count; i++) {
+		CHECK(items[i].error == OK);
+		CHECK(flags[i].unshaded);
+	}
+}
+
+TEST_CASE("[SceneTree][ShaderCompiler] Shaders are precompiled with the last actions") {
+	ShaderCompiler compiler;
+	compiler.initialize(ShaderCompiler::DefaultIdentifierActions());
+
+	LocalVector<String> codes;
+	for (int i = 0; i < 8; i++) {
+		codes.push_back(spatial_shader(vformat("tint_%d", i)));
+	}
+	codes.push_back(codes[0]);
+
+	// Nothing to take the actions from yet.
+	compiler.precompile(codes);
+	CHECK(compiler.get_cache_size() == 0);
+
+	ShaderFlags first;
+	REQUIRE(compiler.compile(RS::SHADER_SPATIAL, spatial_shader("color"), &first.actions, "", first.gen_code) == OK);
+	CHECK(compiler.get_cache_size() == 1);
+
+	// Errors are left for compile() to report.
+	codes.push_back("shader_type spatial; void fragment() { ALBEDO = ; }");
+	compiler.precompile(codes);
+	CHECK(compiler.get_cache_size() == 9);
+
+	ShaderCompiler reference;
+	reference.initialize(ShaderCompiler::DefaultIdentifierActions());
+	reference.set_cache_enabled(false);
+	for (int i = 0; i < 8; i++) {
+		ShaderFlags flags;
+		REQUIRE(compiler.compile(RS::SHADER_SPATIAL, codes[i], &flags.actions, "", flags.gen_code) == OK);
+		CHECK(flags.uniforms.has(StringName(vformat("tint_%d", i))));
+
+		ShaderFlags expected;
+		REQUIRE(reference.compile(RS::SHADER_SPATIAL, codes[i], &expected.actions, "", expected.gen_code) == OK);
+		check_same_output(expected, flags);
+	}
+	// All of them were cache hits.
+	CHECK(compiler.get_cache_size() == 9);
+}
+
+} // namespace TestShaderCompiler
+
+#endif // TEST_SHADER_COMPILER_H
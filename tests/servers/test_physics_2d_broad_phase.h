@@ -0,0 +1,255 @@
+/**************************************************************************/
+/*  test_physics_2d_broad_phase.h                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_2D_BROAD_PHASE_H
+#define TEST_PHYSICS_2D_BROAD_PHASE_H
+
+#include "servers/physics_2d/godot_area_2d.h"
+#include "servers/physics_2d/godot_broad_phase_2d_bvh.h"
+#include "servers/physics_2d/godot_broad_phase_2d_grid.h"
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "core/templates/hash_set.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysics2DBroadPhase {
+
+struct PairTracker {
+	HashMap<GodotCollisionObject2D *, uint32_t> indices;
+	HashSet<uint64_t> pairs;
+
+	uint64_t key(GodotCollisionObject2D *p_a, GodotCollisionObject2D *p_b) const {
+		uint64_t a = indices[p_a];
+		uint64_t b = indices[p_b];
+		return a < b ? (a << 32 | b) : (b << 32 | a);
+	}
+
+	static void *pair(GodotCollisionObject2D *p_a, int p_subindex_a, GodotCollisionObject2D *p_b, int p_subindex_b, void *p_userdata) {
+		PairTracker *self = static_cast<PairTracker *>(p_userdata);
+		uint64_t k = self->key(p_a, p_b);
+		CHECK_MESSAGE(!self->pairs.has(k), "Pairs should not be reported twice.");
+		self->pairs.insert(k);
+		return nullptr;
+	}
+
+	static void unpair(GodotCollisionObject2D *p_a, int p_subindex_a, GodotCollisionObject2D *p_b, int p_subindex_b, void *p_data, void *p_userdata) {
+		PairTracker *self = static_cast<PairTracker *>(p_userdata);
+		uint64_t k = self->key(p_a, p_b);
+		CHECK_MESSAGE(self->pairs.has(k), "Only existing pairs should be unpaired.");
+		self->pairs.erase(k);
+	}
+};
+
+struct Scene {
+	LocalVector<GodotArea2D *> areas;
+	LocalVector<Rect2> rects;
+	LocalVector<GodotBroadPhase2D::ID> ids;
+	LocalVector<bool> statics;
+	LocalVector<bool> alive;
+	PairTracker tracker;
+
+	static Rect2 random_rect(RandomPCG &p_rng, real_t p_world_size, real_t p_max_size) {
+		Vector2 size(p_rng.random(1.0, p_max_size), p_rng.random(1.0, p_max_size));
+		Vector2 position(p_rng.random(-p_world_size, p_world_size), p_rng.random(-p_world_size, p_world_size));
+		return Rect2(position, size);
+	}
+
+	void create(GodotBroadPhase2D *p_broad_phase, RandomPCG &p_rng, uint32_t p_count, real_t p_world_size, real_t p_max_size, uint32_t p_static_every = 0) {
+		p_broad_phase->set_pair_callback(PairTracker::pair, &tracker);
+		p_broad_phase->set_unpair_callback(PairTracker::unpair, &tracker);
+		for (uint32_t i = 0; i < p_count; i++) {
+			GodotArea2D *area = memnew(GodotArea2D);
+			tracker.indices[area] = i;
+			areas.push_back(area);
+			rects.push_back(random_rect(p_rng, p_world_size, p_max_size));
+			statics.push_back(p_static_every && (i % p_static_every) == 0);
+			alive.push_back(true);
+			ids.push_back(p_broad_phase->create(area, 0, rects[i], statics[i]));
+		}
+	}
+
+	void move(GodotBroadPhase2D *p_broad_phase, RandomPCG &p_rng, real_t p_distance) {
+		for (uint32_t i = 0; i < areas.size(); i++) {
+			if (!alive[i] || statics[i]) {
+				continue;
+			}
+			rects[i].position += Vector2(p_rng.random(-p_distance, p_distance), p_rng.random(-p_distance, p_distance));
+			p_broad_phase->move(ids[i], rects[i]);
+		}
+	}
+
+	HashSet<uint64_t> brute_force_pairs() const {
+		HashSet<uint64_t> result;
+		for (uint32_t i = 0; i < areas.size(); i++) {
+			for (uint32_t j = i + 1; j < areas.size(); j++) {
+				if (alive[i] && alive[j] && !(statics[i] && statics[j]) && rects[i].intersects(rects[j], true)) {
+					result.insert(uint64_t(i) << 32 | j);
+				}
+			}
+		}
+		return result;
+	}
+
+	bool pairs_match() const {
+		HashSet<uint64_t> expected = brute_force_pairs();
+		if (expected.size() != tracker.pairs.size()) {
+			return false;
+		}
+		for (const uint64_t &k : expected) {
+			if (!tracker.pairs.has(k)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void destroy(GodotBroadPhase2D *p_broad_phase) {
+		for (uint32_t i = 0; i < areas.size(); i++) {
+			if (alive[i]) {
+				p_broad_phase->remove(ids[i]);
+			}
+			memdelete(areas[i]);
+		}
+	}
+};
+
+TEST_CASE("[Physics2D][BroadPhase] Grid pairs match brute force") {
+	RandomPCG rng(1234);
+	GodotBroadPhase2D *broad_phase = GodotBroadPhase2DGrid::_create();
+
+	Scene scene;
+	// A few large elements make sure several levels are in use.
+	scene.create(broad_phase, rng, 400, 500.0, 60.0, 7);
+	for (uint32_t i = 0; i < 8; i++) {
+		scene.rects[i].size *= 20.0;
+		broad_phase->move(scene.ids[i], scene.rects[i]);
+	}
+
+	broad_phase->update();
+	CHECK_MESSAGE(scene.pairs_match(), "Initial pairs should match a brute force search.");
+
+	for (int frame = 0; frame < 10; frame++) {
+		scene.move(broad_phase, rng, 40.0);
+		broad_phase->update();
+	}
+	CHECK_MESSAGE(scene.pairs_match(), "Pairs should match a brute force search after moving.");
+
+	for (uint32_t i = 0; i < scene.areas.size(); i += 3) {
+		broad_phase->remove(scene.ids[i]);
+		scene.alive[i] = false;
+	}
+	CHECK_MESSAGE(scene.pairs_match(), "Removing elements should unpair them right away.");
+
+	for (uint32_t i = 1; i < scene.areas.size(); i += 3) {
+		scene.statics[i] = !scene.statics[i];
+		broad_phase->set_static(scene.ids[i], scene.statics[i]);
+	}
+	broad_phase->update();
+	CHECK_MESSAGE(scene.pairs_match(), "Static elements should not pair with each other.");
+
+	scene.destroy(broad_phase);
+	CHECK(scene.tracker.pairs.is_empty());
+	memdelete(broad_phase);
+}
+
+TEST_CASE("[Physics2D][BroadPhase] Grid queries match brute force") {
+	RandomPCG rng(4321);
+	GodotBroadPhase2D *broad_phase = GodotBroadPhase2DGrid::_create();
+
+	Scene scene;
+	scene.create(broad_phase, rng, 300, 500.0, 80.0);
+	broad_phase->update();
+
+	GodotCollisionObject2D *results[512];
+	for (int query = 0; query < 20; query++) {
+		Rect2 query_rect = Scene::random_rect(rng, 500.0, 300.0);
+		int count = broad_phase->cull_aabb(query_rect, results, 512);
+
+		int expected = 0;
+		for (uint32_t i = 0; i < scene.areas.size(); i++) {
+			if (scene.rects[i].intersects(query_rect, true)) {
+				expected++;
+			}
+		}
+		CHECK(count == expected);
+		for (int i = 0; i < count; i++) {
+			CHECK(scene.rects[scene.tracker.indices[results[i]]].intersects(query_rect, true));
+		}
+	}
+
+	Vector2 from(-600.0, -600.0);
+	Vector2 to(600.0, 600.0);
+	int count = broad_phase->cull_segment(from, to, results, 512);
+	int expected = 0;
+	for (uint32_t i = 0; i < scene.areas.size(); i++) {
+		if (scene.rects[i].intersects_segment(from, to)) {
+			expected++;
+		}
+	}
+	CHECK(count == expected);
+
+	scene.destroy(broad_phase);
+	memdelete(broad_phase);
+}
+
+TEST_CASE_BENCHMARK("[Physics2D][BroadPhase][Benchmark] Grid and BVH under high motion") {
+	const uint32_t object_count = 30000;
+	const int frame_count = 60;
+
+	GodotBroadPhase2D *broad_phases[2] = { GodotBroadPhase2DBVH::_create(), GodotBroadPhase2DGrid::_create() };
+	const char *names[2] = { "BVH", "Grid" };
+
+	for (int b = 0; b < 2; b++) {
+		RandomPCG rng(42);
+		Scene scene;
+		scene.create(broad_phases[b], rng, object_count, 4000.0, 16.0);
+		broad_phases[b]->update();
+
+		uint64_t pair_count = 0;
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int frame = 0; frame < frame_count; frame++) {
+			scene.move(broad_phases[b], rng, 8.0);
+			broad_phases[b]->update();
+			pair_count += scene.tracker.pairs.size();
+		}
+		double seconds = USEC_TO_SEC(OS::get_singleton()->get_ticks_usec() - begin);
+
+		MESSAGE(vformat("%s: %.2f ms/frame, %.0f pairs/sec.", names[b], seconds * 1000.0 / frame_count, pair_count / seconds));
+
+		scene.destroy(broad_phases[b]);
+		memdelete(broad_phases[b]);
+	}
+}
+
+} // namespace TestPhysics2DBroadPhase
+
+#endif // TEST_PHYSICS_2D_BROAD_PHASE_H
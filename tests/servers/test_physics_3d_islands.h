@@ -0,0 +1,183 @@
+/**************************************************************************/
+/*  test_physics_3d_islands.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_3D_ISLANDS_H
+#define TEST_PHYSICS_3D_ISLANDS_H
+
+#include "servers/physics_3d/godot_physics_server_3d.h"
+
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysics3DIslands {
+
+struct World {
+	GodotPhysicsServer3D *server = nullptr;
+	RID space;
+	RID box;
+	RID floor_shape;
+	RID floor;
+	LocalVector<RID> bodies;
+
+	World() {
+		server = memnew(GodotPhysicsServer3D);
+		server->init();
+
+		space = server->space_create();
+		server->space_set_active(space, true);
+
+		box = server->box_shape_create();
+		server->shape_set_data(box, Vector3(0.5, 0.5, 0.5));
+
+		floor_shape = server->box_shape_create();
+		server->shape_set_data(floor_shape, Vector3(1000.0, 1.0, 1000.0));
+		floor = server->body_create();
+		server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+		server->body_add_shape(floor, floor_shape);
+		server->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0.0, -1.0, 0.0)));
+		server->body_set_space(floor, space);
+	}
+
+	RID add_box(const Vector3 &p_position, bool p_gravity = true) {
+		RID body = server->body_create();
+		server->body_add_shape(body, box);
+		server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), p_position));
+		if (!p_gravity) {
+			server->body_set_param(body, PhysicsServer3D::BODY_PARAM_GRAVITY_SCALE, 0.0);
+			server->body_set_state(body, PhysicsServer3D::BODY_STATE_CAN_SLEEP, false);
+		}
+		server->body_set_space(body, space);
+		bodies.push_back(body);
+		return body;
+	}
+
+	void step(int p_count = 1) {
+		for (int i = 0; i < p_count; i++) {
+			server->step(1.0 / 60.0);
+		}
+	}
+
+	int get_info(PhysicsServer3D::ProcessInfo p_info) const {
+		return server->get_process_info(p_info);
+	}
+
+	~World() {
+		for (const RID &body : bodies) {
+			server->free(body);
+		}
+		server->free(floor);
+		server->free(floor_shape);
+		server->free(box);
+		server->free(space);
+		server->finish();
+		memdelete(server);
+	}
+};
+
+TEST_CASE("[Physics3D][Islands] Islands are merged and split as contacts come and go") {
+	World world;
+
+	// Three floating boxes in a row, each one overlapping the next.
+	world.add_box(Vector3(0.0, 10.0, 0.0), false);
+	world.add_box(Vector3(0.9, 10.0, 0.0), false);
+	RID last = world.add_box(Vector3(1.8, 10.0, 0.0), false);
+
+	// Two more on their own.
+	world.add_box(Vector3(20.0, 10.0, 0.0), false);
+	world.add_box(Vector3(40.0, 10.0, 0.0), false);
+
+	world.step();
+	CHECK_MESSAGE(world.get_info(PhysicsServer3D::INFO_ISLAND_COUNT) == 1, "Touching boxes should be a single island, lone boxes have no constraints.");
+	CHECK(world.get_info(PhysicsServer3D::INFO_ACTIVE_OBJECTS) == 5);
+
+	// Moving the last box away must split it from the others, which still touch.
+	world.server->body_set_state(last, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(60.0, 10.0, 0.0)));
+	world.step();
+	CHECK_MESSAGE(world.get_info(PhysicsServer3D::INFO_ISLAND_COUNT) == 1, "The remaining boxes should still be an island.");
+
+	// Bringing it next to a lone box merges them.
+	world.server->body_set_state(last, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(20.9, 10.0, 0.0)));
+	world.step();
+	CHECK(world.get_info(PhysicsServer3D::INFO_ISLAND_COUNT) == 2);
+}
+
+TEST_CASE("[Physics3D][Islands] Sleeping islands are skipped") {
+	World world;
+
+	const int box_count = 16;
+	for (int i = 0; i < box_count; i++) {
+		world.add_box(Vector3(i * 4.0, 0.5, 0.0));
+	}
+
+	world.step();
+	CHECK_MESSAGE(world.get_info(PhysicsServer3D::INFO_ISLAND_COUNT) == box_count, "Boxes only touching the static floor should be separate islands.");
+
+	// Resting boxes fall asleep after a short while.
+	world.step(600);
+	CHECK(world.get_info(PhysicsServer3D::INFO_ACTIVE_OBJECTS) == 0);
+	CHECK_MESSAGE(world.get_info(PhysicsServer3D::INFO_ISLAND_COUNT) == 0, "Sleeping islands should not be stepped.");
+
+	world.server->body_set_state(world.bodies[3], PhysicsServer3D::BODY_STATE_SLEEPING, false);
+	world.step();
+	CHECK(world.get_info(PhysicsServer3D::INFO_ACTIVE_OBJECTS) == 1);
+	CHECK_MESSAGE(world.get_info(PhysicsServer3D::INFO_ISLAND_COUNT) == 1, "Waking a body should only step its own island.");
+}
+
+TEST_CASE_BENCHMARK("[Physics3D][Islands][Benchmark] Mostly sleeping debris") {
+	World world;
+
+	// 50k debris boxes resting on the floor, put to sleep right away.
+	const int side = 224;
+	for (int x = 0; x < side; x++) {
+		for (int z = 0; z < side; z++) {
+			RID body = world.add_box(Vector3(x * 1.5, 0.5, z * 1.5));
+			world.server->body_set_state(body, PhysicsServer3D::BODY_STATE_SLEEPING, true);
+		}
+	}
+
+	// A few active bodies bouncing around on top.
+	for (int i = 0; i < 100; i++) {
+		world.add_box(Vector3((i % 10) * 30.0, 5.0 + i * 0.1, (i / 10) * 30.0));
+	}
+
+	world.step();
+
+	const int frame_count = 120;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	world.step(frame_count);
+	double seconds = USEC_TO_SEC(OS::get_singleton()->get_ticks_usec() - begin);
+
+	MESSAGE(vformat("%d bodies: %.3f ms/step, %d active, %d islands.", world.bodies.size(), seconds * 1000.0 / frame_count, world.get_info(PhysicsServer3D::INFO_ACTIVE_OBJECTS), world.get_info(PhysicsServer3D::INFO_ISLAND_COUNT)));
+}
+
+} // namespace TestPhysics3DIslands
+
+#endif // TEST_PHYSICS_3D_ISLANDS_H
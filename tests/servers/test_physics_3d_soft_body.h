@@ -0,0 +1,183 @@
+/**************************************************************************/
+/*  test_physics_3d_soft_body.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_3D_SOFT_BODY_H
+#define TEST_PHYSICS_3D_SOFT_BODY_H
+
+#include "servers/physics_server_3d.h"
+#include "servers/rendering_server.h"
+
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysics3DSoftBody {
+
+// A square cloth in the XZ plane, hanging from its first row.
+struct Cloth {
+	PhysicsServer3D *server = nullptr;
+	LocalVector<RID> spaces;
+	RID mesh;
+	RID body;
+	int side = 0;
+
+	Cloth(int p_side, int p_space_count = 1) {
+		server = PhysicsServer3D::get_singleton();
+		side = p_side;
+
+		for (int i = 0; i < p_space_count; i++) {
+			RID space = server->space_create();
+			server->space_set_active(space, true);
+			spaces.push_back(space);
+		}
+
+		Vector<Vector3> vertices;
+		for (int z = 0; z < side; z++) {
+			for (int x = 0; x < side; x++) {
+				vertices.push_back(Vector3(x * 0.1, 0.0, z * 0.1));
+			}
+		}
+
+		Vector<int> indices;
+		for (int z = 0; z < side - 1; z++) {
+			for (int x = 0; x < side - 1; x++) {
+				const int i = z * side + x;
+				indices.push_back(i);
+				indices.push_back(i + 1);
+				indices.push_back(i + side);
+				indices.push_back(i + 1);
+				indices.push_back(i + side + 1);
+				indices.push_back(i + side);
+			}
+		}
+
+		Array arrays;
+		arrays.resize(RS::ARRAY_MAX);
+		arrays[RS::ARRAY_VERTEX] = vertices;
+		arrays[RS::ARRAY_INDEX] = indices;
+		mesh = RS::get_singleton()->mesh_create();
+		RS::get_singleton()->mesh_add_surface_from_arrays(mesh, RS::PRIMITIVE_TRIANGLES, arrays);
+
+		body = server->soft_body_create();
+		server->soft_body_set_mesh(body, mesh);
+		server->soft_body_set_space(body, spaces[0]);
+		for (int x = 0; x < side; x++) {
+			server->soft_body_pin_point(body, x, true);
+		}
+	}
+
+	void step(int p_count = 1) {
+		for (int i = 0; i < p_count; i++) {
+			server->step(1.0 / 60.0);
+		}
+	}
+
+	int get_point_count() const {
+		return side * side;
+	}
+
+	Vector3 get_point(int p_index) const {
+		return server->soft_body_get_point_global_position(body, p_index);
+	}
+
+	~Cloth() {
+		server->free(body);
+		RS::get_singleton()->free(mesh);
+		for (const RID &space : spaces) {
+			server->free(space);
+		}
+	}
+};
+
+TEST_CASE("[SceneTree][Physics3D][SoftBody] Hanging cloth keeps its shape") {
+	Cloth cloth(16);
+	cloth.step(120);
+
+	bool finite = true;
+	real_t max_stretch = 0.0;
+	for (int z = 0; z < cloth.side; z++) {
+		for (int x = 0; x < cloth.side; x++) {
+			const Vector3 point = cloth.get_point(z * cloth.side + x);
+			finite = finite && point.is_finite();
+			if (x + 1 < cloth.side) {
+				max_stretch = MAX(max_stretch, point.distance_to(cloth.get_point(z * cloth.side + x + 1)) / 0.1);
+			}
+			if (z + 1 < cloth.side) {
+				max_stretch = MAX(max_stretch, point.distance_to(cloth.get_point((z + 1) * cloth.side + x)) / 0.1);
+			}
+		}
+	}
+
+	CHECK(finite);
+	CHECK_MESSAGE(cloth.get_point(0).is_equal_approx(Vector3()), "Pinned points should not move.");
+	CHECK_MESSAGE(cloth.get_point(cloth.get_point_count() - 1).y < -0.5, "The free edge should fall.");
+	CHECK_MESSAGE(max_stretch < 1.5, "Links should stay close to their rest length.");
+}
+
+TEST_CASE("[SceneTree][Physics3D][SoftBody] Link batches give the same result solved in parallel or serially") {
+	// Large enough for link batches to be split across threads.
+	const int side = 64;
+
+	LocalVector<Vector3> threaded;
+	{
+		Cloth cloth(side);
+		cloth.step(30);
+		for (int i = 0; i < cloth.get_point_count(); i++) {
+			threaded.push_back(cloth.get_point(i));
+		}
+	}
+
+	// Spaces stepped in parallel solve their soft bodies serially.
+	Cloth cloth(side, 2);
+	cloth.step(30);
+	int mismatches = 0;
+	for (int i = 0; i < cloth.get_point_count(); i++) {
+		if (cloth.get_point(i) != threaded[i]) {
+			mismatches++;
+		}
+	}
+	CHECK(mismatches == 0);
+}
+
+TEST_CASE_BENCHMARK("[SceneTree][Physics3D][SoftBody][Benchmark] Large cloth") {
+	Cloth cloth(64);
+	cloth.step();
+
+	const int frame_count = 120;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	cloth.step(frame_count);
+	double seconds = USEC_TO_SEC(OS::get_singleton()->get_ticks_usec() - begin);
+
+	MESSAGE(vformat("%d points: %.3f ms/step.", cloth.get_point_count(), seconds * 1000.0 / frame_count));
+}
+
+} // namespace TestPhysics3DSoftBody
+
+#endif // TEST_PHYSICS_3D_SOFT_BODY_H
@@ -0,0 +1,134 @@
+/**************************************************************************/
+/*  test_physics_3d_spaces.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_3D_SPACES_H
+#define TEST_PHYSICS_3D_SPACES_H
+
+#include "servers/physics_3d/godot_physics_server_3d.h"
+
+#include "core/config/project_settings.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysics3DSpaces {
+
+static LocalVector<int> synced_spaces;
+
+static void record_state_sync(Object *p_state, int p_space_index) {
+	synced_spaces.push_back(p_space_index);
+}
+
+struct Spaces {
+	GodotPhysicsServer3D *server = nullptr;
+	RID box;
+	LocalVector<RID> spaces;
+	LocalVector<RID> bodies;
+
+	Spaces(int p_count, bool p_parallel) {
+		server = memnew(GodotPhysicsServer3D);
+		ProjectSettings::get_singleton()->set_setting("physics/3d/step_spaces_in_parallel", p_parallel);
+		server->init();
+
+		box = server->box_shape_create();
+		server->shape_set_data(box, Vector3(0.5, 0.5, 0.5));
+
+		for (int i = 0; i < p_count; i++) {
+			RID space = server->space_create();
+			server->space_set_active(space, true);
+			spaces.push_back(space);
+
+			// Falling and spinning, so its state is synced every step.
+			RID body = server->body_create();
+			server->body_add_shape(body, box);
+			server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(i, 10.0, 0.0)));
+			server->body_set_state(body, PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY, Vector3(0.0, i + 1.0, 0.0));
+			server->body_set_state(body, PhysicsServer3D::BODY_STATE_CAN_SLEEP, false);
+			server->body_set_space(body, space);
+			server->body_set_state_sync_callback(body, callable_mp_static(&record_state_sync).bind(i));
+			bodies.push_back(body);
+		}
+	}
+
+	void step() {
+		server->step(1.0 / 60.0);
+		server->flush_queries();
+	}
+
+	~Spaces() {
+		for (const RID &body : bodies) {
+			server->free(body);
+		}
+		for (const RID &space : spaces) {
+			server->free(space);
+		}
+		server->free(box);
+		server->finish();
+		memdelete(server);
+		ProjectSettings::get_singleton()->set_setting("physics/3d/step_spaces_in_parallel", true);
+	}
+};
+
+TEST_CASE("[Physics3D][Spaces] Spaces stepped in parallel flush their queries in order") {
+	const int space_count = 4;
+	const int step_count = 10;
+
+	LocalVector<Transform3D> serial_transforms;
+	{
+		Spaces serial(space_count, false);
+		for (int i = 0; i < step_count; i++) {
+			serial.step();
+		}
+		for (const RID &body : serial.bodies) {
+			serial_transforms.push_back(serial.server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM));
+		}
+	}
+
+	Spaces parallel(space_count, true);
+	for (int i = 0; i < step_count; i++) {
+		synced_spaces.clear();
+		parallel.step();
+
+		REQUIRE(synced_spaces.size() == space_count);
+		for (int j = 0; j < space_count; j++) {
+			CHECK_MESSAGE(synced_spaces[j] == j, "State sync callbacks should be called in space order.");
+		}
+	}
+	synced_spaces.clear();
+
+	for (int i = 0; i < space_count; i++) {
+		const Transform3D transform = parallel.server->body_get_state(parallel.bodies[i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+		CHECK_MESSAGE(transform.is_equal_approx(serial_transforms[i]), "Stepping in parallel should give the same results as stepping serially.");
+		CHECK(parallel.server->space_get_last_step_time(parallel.spaces[i]) >= 0.0);
+	}
+}
+
+} // namespace TestPhysics3DSpaces
+
+#endif // TEST_PHYSICS_3D_SPACES_H
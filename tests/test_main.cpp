@@ -55,6 +55,7 @@
 #include "tests/core/math/test_aabb.h"
 #include "tests/core/math/test_astar.h"
 #include "tests/core/math/test_basis.h"
+#include "tests/core/math/test_bvh.h"
 #include "tests/core/math/test_color.h"
 #include "tests/core/math/test_expression.h"
 #include "tests/core/math/test_geometry_2d.h"
@@ -113,6 +114,7 @@
 #include "tests/scene/test_image_texture.h"
 #include "tests/scene/test_image_texture_3d.h"
 #include "tests/scene/test_instance_placeholder.h"
+#include "tests/scene/test_multimesh.h"
 #include "tests/scene/test_node.h"
 #include "tests/scene/test_node_2d.h"
 #include "tests/scene/test_packed_scene.h"
@@ -124,10 +126,25 @@
 #include "tests/scene/test_viewport.h"
 #include "tests/scene/test_visual_shader.h"
 #include "tests/scene/test_window.h"
+#include "tests/servers/rendering/test_canvas_cull.h"
+#include "tests/servers/rendering/test_directional_shadow_cache.h"
+#include "tests/servers/rendering/test_instance_transforms.h"
+#include "tests/servers/rendering/test_raster_occlusion_cull.h"
+#include "tests/servers/rendering/test_rendering_light_culler.h"
+#include "tests/servers/rendering/test_rendering_server_benchmark.h"
+#include "tests/servers/rendering/test_shader_compiler.h"
 #include "tests/servers/rendering/test_shader_preprocessor.h"
+#include "tests/servers/test_physics_2d_broad_phase.h"
 #include "tests/servers/test_text_server.h"
 #include "tests/test_validate_testing.h"
 
+#ifdef TOOLS_ENABLED
+#include "tests/editor/test_editor_file_system.h"
+#include "tests/editor/test_editor_file_system_watcher.h"
+#include "tests/editor/test_editor_import_cache.h"
+#include "tests/editor/test_editor_import_scheduler.h"
+#endif // TOOLS_ENABLED
+
 #ifndef ADVANCED_GUI_DISABLED
 #include "tests/scene/test_code_edit.h"
 #include "tests/scene/test_color_picker.h"
@@ -149,9 +166,14 @@
 
 #include "tests/scene/test_arraymesh.h"
 #include "tests/scene/test_camera_3d.h"
+#include "tests/scene/test_hlod_builder.h"
 #include "tests/scene/test_path_3d.h"
 #include "tests/scene/test_path_follow_3d.h"
 #include "tests/scene/test_primitives.h"
+#include "tests/scene/test_visual_instance_3d.h"
+#include "tests/servers/test_physics_3d_islands.h"
+#include "tests/servers/test_physics_3d_soft_body.h"
+#include "tests/servers/test_physics_3d_spaces.h"
 #endif // _3D_DISABLED
 
 #include "modules/modules_tests.gen.h"